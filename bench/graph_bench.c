@@ -0,0 +1,382 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "graph.h"
+#include "bfs.h"
+#include "dfs.h"
+#include "dijkstra.h"
+#include "astar.h"
+#include "bellman_ford.h"
+#include "compressed_graph.h"
+#include "float_graph.h"
+#include "graph_generators.h"
+
+// Benchmark driver: generates synthetic graphs, runs every algorithm over a
+// fixed random query set and writes latency percentiles as JSON.
+//
+//   graphpath_bench [--size tiny|small|medium|large] [--queries N] [--reps N]
+//                   [--warmup N] [--seed N] [--family NAME] [--output FILE]
+
+#define MAX_ALGORITHMS 12
+#define BELLMAN_FORD_MAX_VERTICES 5000
+
+typedef enum {
+    SIZE_TINY,
+    SIZE_SMALL,
+    SIZE_MEDIUM,
+    SIZE_LARGE
+} BenchSize;
+
+typedef struct {
+    BenchSize size;
+    int num_queries;
+    int repetitions;
+    int warmup;
+    unsigned int seed;
+    const char* family;       // NULL runs every family
+    const char* output;       // NULL writes to stdout
+} BenchConfig;
+
+// All representations one query may run against
+typedef struct {
+    const Graph* graph;
+    const CompressedGraph* cgraph;
+    const FloatGraph* fgraph;
+} BenchGraphs;
+
+typedef PathResult* (*BenchQuery)(const BenchGraphs* graphs, int start, int end);
+
+typedef struct {
+    const char* name;
+    BenchQuery run;
+    bool needs_coordinates;
+} BenchAlgorithm;
+
+static PathResult* run_bfs(const BenchGraphs* g, int s, int t) { return bfs_find_path(g->graph, s, t); }
+static PathResult* run_dfs(const BenchGraphs* g, int s, int t) { return dfs_find_path(g->graph, s, t); }
+static PathResult* run_dijkstra(const BenchGraphs* g, int s, int t) { return dijkstra_find_path(g->graph, s, t); }
+static PathResult* run_astar_zero(const BenchGraphs* g, int s, int t) { return astar_zero(g->graph, s, t); }
+static PathResult* run_astar_euclidean(const BenchGraphs* g, int s, int t) { return astar_euclidean(g->graph, s, t); }
+static PathResult* run_astar_manhattan(const BenchGraphs* g, int s, int t) { return astar_manhattan(g->graph, s, t); }
+static PathResult* run_bellman_ford(const BenchGraphs* g, int s, int t) { return bellman_ford_find_path(g->graph, s, t); }
+static PathResult* run_compressed_bfs(const BenchGraphs* g, int s, int t) { return compressed_bfs_find_path(g->cgraph, s, t); }
+static PathResult* run_compressed_dijkstra(const BenchGraphs* g, int s, int t) { return compressed_dijkstra_find_path(g->cgraph, s, t); }
+static PathResult* run_float_dijkstra(const BenchGraphs* g, int s, int t) { return float_dijkstra_find_path(g->fgraph, s, t); }
+static PathResult* run_float_astar(const BenchGraphs* g, int s, int t) {
+    return float_astar_find_path(g->fgraph, s, t, FLOAT_HEURISTIC_EUCLIDEAN);
+}
+
+static const BenchAlgorithm ALGORITHMS[] = {
+    {"BFS", run_bfs, false},
+    {"DFS", run_dfs, false},
+    {"Dijkstra", run_dijkstra, false},
+    {"A* (Zero)", run_astar_zero, false},
+    {"A* (Euclidean)", run_astar_euclidean, true},
+    {"A* (Manhattan)", run_astar_manhattan, true},
+    {"Bellman-Ford", run_bellman_ford, false},
+    {"BFS (Compressed)", run_compressed_bfs, false},
+    {"Dijkstra (Compressed)", run_compressed_dijkstra, false},
+    {"Dijkstra (Float)", run_float_dijkstra, false},
+    {"A* (Float, Euclidean)", run_float_astar, true},
+};
+static const int NUM_ALGORITHMS = (int)(sizeof(ALGORITHMS) / sizeof(ALGORITHMS[0]));
+
+// Aggregated measurements of one algorithm on one graph
+typedef struct {
+    double p50_us;
+    double p90_us;
+    double p99_us;
+    double mean_us;
+    double throughput_qps;
+    double mean_settled;
+    double mean_relaxed;
+    double mean_bytes;
+    int found;
+} BenchSummary;
+
+static uint64_t next_random(uint64_t* state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static int compare_ll(const void* a, const void* b) {
+    long long x = *(const long long*)a;
+    long long y = *(const long long*)b;
+    return (x > y) - (x < y);
+}
+
+// Nearest-rank percentile of a sorted sample
+static double percentile_us(const long long* sorted, int count, double fraction) {
+    int rank = (int)(fraction * count + 0.999999);
+    if (rank < 1) rank = 1;
+    if (rank > count) rank = count;
+    return sorted[rank - 1] / 1000.0;
+}
+
+static bool run_algorithm(const BenchAlgorithm* algorithm, const BenchGraphs* graphs,
+                          const int* queries, const BenchConfig* config, BenchSummary* summary) {
+    int samples = config->num_queries * config->repetitions;
+    long long* latencies = (long long*)malloc(samples * sizeof(long long));
+    if (!latencies) {
+        fprintf(stderr, "Error: Memory allocation failed for latency samples\n");
+        return false;
+    }
+
+    // Warm caches and the allocator on the first queries of the set
+    for (int i = 0; i < config->warmup; i++) {
+        int q = i % config->num_queries;
+        path_result_destroy(algorithm->run(graphs, queries[2 * q], queries[2 * q + 1]));
+    }
+
+    memset(summary, 0, sizeof(BenchSummary));
+    long long total_ns = 0;
+    int k = 0;
+    for (int rep = 0; rep < config->repetitions; rep++) {
+        for (int q = 0; q < config->num_queries; q++) {
+            long long begin = graph_clock_ns();
+            PathResult* result = algorithm->run(graphs, queries[2 * q], queries[2 * q + 1]);
+            long long elapsed = graph_clock_ns() - begin;
+            if (!result) {
+                free(latencies);
+                return false;
+            }
+
+            latencies[k++] = elapsed;
+            total_ns += elapsed;
+            if (rep == 0) {
+                summary->mean_settled += result->stats.vertices_settled;
+                summary->mean_relaxed += result->stats.edges_relaxed;
+                summary->mean_bytes += (double)result->stats.bytes_allocated;
+                summary->found += result->found ? 1 : 0;
+            }
+            path_result_destroy(result);
+        }
+    }
+
+    qsort(latencies, samples, sizeof(long long), compare_ll);
+    summary->p50_us = percentile_us(latencies, samples, 0.50);
+    summary->p90_us = percentile_us(latencies, samples, 0.90);
+    summary->p99_us = percentile_us(latencies, samples, 0.99);
+    summary->mean_us = total_ns / 1000.0 / samples;
+    summary->throughput_qps = total_ns > 0 ? samples * 1e9 / total_ns : 0.0;
+    summary->mean_settled /= config->num_queries;
+    summary->mean_relaxed /= config->num_queries;
+    summary->mean_bytes /= config->num_queries;
+
+    free(latencies);
+    return true;
+}
+
+// Generate one benchmark graph; name receives a description like "grid-256x256"
+static Graph* generate_graph(const char* family, BenchSize size, unsigned int seed,
+                             char* name, size_t name_size) {
+    static const int GRID_SIDES[] = {32, 100, 316, 1000};
+    static const int GEOMETRIC_SIZES[] = {1000, 10000, 100000, 1000000};
+    static const int RMAT_SCALES[] = {10, 13, 17, 20};
+
+    if (!strcmp(family, "grid")) {
+        int side = GRID_SIDES[size];
+        snprintf(name, name_size, "grid-%dx%d", side, side);
+        return graph_generate_grid(side, side, 10.0, seed);
+    }
+    if (!strcmp(family, "geometric")) {
+        int n = GEOMETRIC_SIZES[size];
+        snprintf(name, name_size, "geometric-%d", n);
+        return graph_generate_geometric(n, 8.0, seed);
+    }
+    if (!strcmp(family, "rmat")) {
+        int scale = RMAT_SCALES[size];
+        snprintf(name, name_size, "rmat-%d", scale);
+        return graph_generate_rmat(scale, 8, 0.57, 0.19, 0.19, seed);
+    }
+    if (!strcmp(family, "road")) {
+        int side = GRID_SIDES[size];
+        snprintf(name, name_size, "road-%dx%d", side, side);
+        return graph_generate_road(side, side, seed);
+    }
+    return NULL;
+}
+
+static bool bench_family(FILE* out, const char* family, const BenchConfig* config, bool first) {
+    char name[64];
+    long long build_begin = graph_clock_ns();
+    Graph* graph = generate_graph(family, config->size, config->seed, name, sizeof(name));
+    double build_ms = (graph_clock_ns() - build_begin) / 1e6;
+    if (!graph) {
+        fprintf(stderr, "Error: Failed to generate %s graph\n", family);
+        return false;
+    }
+
+    CompressedGraph* cgraph = compressed_graph_create(graph, COMPRESSED_WEIGHTS_EXACT);
+    FloatGraph* fgraph = float_graph_create(graph, FLOAT_WEIGHTS_F32);
+    int* queries = (int*)malloc(2 * config->num_queries * sizeof(int));
+    if (!cgraph || !fgraph || !queries) {
+        fprintf(stderr, "Error: Failed to prepare %s\n", name);
+        compressed_graph_destroy(cgraph);
+        float_graph_destroy(fgraph);
+        free(queries);
+        graph_destroy(graph);
+        return false;
+    }
+
+    // The same query set for every algorithm on this graph
+    uint64_t state = config->seed ^ 0x5DEECE66DULL;
+    for (int i = 0; i < 2 * config->num_queries; i++) {
+        queries[i] = (int)(next_random(&state) % (uint64_t)graph->num_vertices);
+    }
+
+    fprintf(stderr, "%s: %d vertices, %d edges (generated in %.1f ms)\n",
+            name, graph->num_vertices, graph->num_edges, build_ms);
+    fprintf(out, "%s    {\n", first ? "" : ",\n");
+    fprintf(out, "      \"family\": \"%s\",\n", family);
+    fprintf(out, "      \"name\": \"%s\",\n", name);
+    fprintf(out, "      \"vertices\": %d,\n", graph->num_vertices);
+    fprintf(out, "      \"edges\": %d,\n", graph->num_edges);
+    fprintf(out, "      \"generate_ms\": %.3f,\n", build_ms);
+    fprintf(out, "      \"memory_bytes\": {\"graph\": %zu, \"compressed\": %zu, \"float\": %zu},\n",
+            graph_memory_usage(graph), compressed_graph_memory_usage(cgraph),
+            float_graph_memory_usage(fgraph));
+    fprintf(out, "      \"algorithms\": [");
+
+    BenchGraphs graphs = {graph, cgraph, fgraph};
+    bool ok = true;
+    bool first_algorithm = true;
+    for (int a = 0; a < NUM_ALGORITHMS && ok; a++) {
+        const BenchAlgorithm* algorithm = &ALGORITHMS[a];
+        if (algorithm->needs_coordinates && !graph_has_coordinates(graph)) continue;
+
+        fprintf(out, "%s\n        {\"name\": \"%s\", ", first_algorithm ? "" : ",", algorithm->name);
+        first_algorithm = false;
+
+        // O(VE) per query: only worth measuring on small graphs
+        if (algorithm->run == run_bellman_ford && graph->num_vertices > BELLMAN_FORD_MAX_VERTICES) {
+            fprintf(out, "\"skipped\": \"more than %d vertices\"}", BELLMAN_FORD_MAX_VERTICES);
+            continue;
+        }
+
+        BenchSummary summary;
+        ok = run_algorithm(algorithm, &graphs, queries, config, &summary);
+        if (!ok) break;
+        fprintf(out, "\"p50_us\": %.3f, \"p90_us\": %.3f, \"p99_us\": %.3f, \"mean_us\": %.3f, "
+                "\"throughput_qps\": %.1f, \"mean_settled\": %.1f, \"mean_relaxed\": %.1f, "
+                "\"mean_search_bytes\": %.0f, \"found\": %d}",
+                summary.p50_us, summary.p90_us, summary.p99_us, summary.mean_us,
+                summary.throughput_qps, summary.mean_settled, summary.mean_relaxed,
+                summary.mean_bytes, summary.found);
+        fprintf(stderr, "  %-24s p50 %10.1f us  p99 %10.1f us  %10.1f q/s\n",
+                algorithm->name, summary.p50_us, summary.p99_us, summary.throughput_qps);
+    }
+    fprintf(out, "\n      ]\n    }");
+
+    free(queries);
+    compressed_graph_destroy(cgraph);
+    float_graph_destroy(fgraph);
+    graph_destroy(graph);
+    return ok;
+}
+
+static void print_usage(const char* program) {
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  --size tiny|small|medium|large  Graph sizes (default: small)\n"
+            "  --queries N     Queries per graph (default: 100)\n"
+            "  --reps N        Timed repetitions of the query set (default: 3)\n"
+            "  --warmup N      Untimed warmup queries (default: 10)\n"
+            "  --seed N        Seed for graphs and queries (default: 42)\n"
+            "  --family NAME   Only grid, geometric, rmat or road\n"
+            "  --output FILE   Write JSON to FILE instead of stdout\n",
+            program);
+}
+
+static bool parse_args(int argc, char* argv[], BenchConfig* config) {
+    static const char* SIZE_NAMES[] = {"tiny", "small", "medium", "large"};
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (!value) {
+            fprintf(stderr, "Error: Missing value for %s\n", arg);
+            return false;
+        }
+        i++;
+
+        if (!strcmp(arg, "--size")) {
+            int s = 0;
+            while (s < 4 && strcmp(value, SIZE_NAMES[s]) != 0) s++;
+            if (s == 4) {
+                fprintf(stderr, "Error: Unknown size %s\n", value);
+                return false;
+            }
+            config->size = (BenchSize)s;
+        } else if (!strcmp(arg, "--queries")) {
+            config->num_queries = atoi(value);
+        } else if (!strcmp(arg, "--reps")) {
+            config->repetitions = atoi(value);
+        } else if (!strcmp(arg, "--warmup")) {
+            config->warmup = atoi(value);
+        } else if (!strcmp(arg, "--seed")) {
+            config->seed = (unsigned int)strtoul(value, NULL, 10);
+        } else if (!strcmp(arg, "--family")) {
+            config->family = value;
+        } else if (!strcmp(arg, "--output")) {
+            config->output = value;
+        } else {
+            fprintf(stderr, "Error: Unknown option %s\n", arg);
+            return false;
+        }
+    }
+
+    if (config->num_queries <= 0 || config->repetitions <= 0 || config->warmup < 0) {
+        fprintf(stderr, "Error: Queries and repetitions must be positive\n");
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    static const char* FAMILIES[] = {"grid", "geometric", "rmat", "road"};
+    static const char* SIZE_NAMES[] = {"tiny", "small", "medium", "large"};
+
+    BenchConfig config = {SIZE_SMALL, 100, 3, 10, 42, NULL, NULL};
+    if (!parse_args(argc, argv, &config)) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    FILE* out = stdout;
+    if (config.output) {
+        out = fopen(config.output, "w");
+        if (!out) {
+            fprintf(stderr, "Error: Cannot open %s for writing\n", config.output);
+            return 1;
+        }
+    }
+
+    fprintf(out, "{\n");
+    fprintf(out, "  \"benchmark\": \"graphpath\",\n");
+    fprintf(out, "  \"size\": \"%s\",\n", SIZE_NAMES[config.size]);
+    fprintf(out, "  \"seed\": %u,\n", config.seed);
+    fprintf(out, "  \"queries\": %d,\n", config.num_queries);
+    fprintf(out, "  \"repetitions\": %d,\n", config.repetitions);
+    fprintf(out, "  \"warmup\": %d,\n", config.warmup);
+    fprintf(out, "  \"graphs\": [\n");
+
+    bool ok = true;
+    bool first = true;
+    for (int f = 0; f < 4 && ok; f++) {
+        if (config.family && strcmp(config.family, FAMILIES[f]) != 0) continue;
+        ok = bench_family(out, FAMILIES[f], &config, first);
+        first = false;
+    }
+    fprintf(out, "\n  ]\n}\n");
+
+    if (out != stdout) fclose(out);
+    if (first && ok) {
+        fprintf(stderr, "Error: Unknown family %s\n", config.family);
+        return 1;
+    }
+    return ok ? 0 : 1;
+}
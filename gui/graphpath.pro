@@ -26,7 +26,34 @@ SOURCES += src/main.cpp \
            ../src/dfs.c \
            ../src/dijkstra.c \
            ../src/astar.c \
-           ../src/bellman_ford.c
+           ../src/bellman_ford.c \
+           ../src/min_heap.c \
+           ../src/compressed_graph.c \
+           ../src/float_graph.c \
+           ../src/parallel.c \
+           ../src/graph_builder.c \
+           ../src/graph_parser.c \
+           ../src/graph_formats.c \
+           ../src/graph_generators.c \
+           ../src/search_workspace.c \
+           ../src/query_server.c \
+           ../src/graph_snapshot.c \
+           ../src/path_cache.c \
+           ../src/spt_cache.c \
+           ../src/distance_table.c \
+           ../src/jps.c \
+           ../src/graph_view.c \
+           ../src/grid_graph.c \
+           ../src/implicit_search.c \
+           ../src/reach_index.c \
+           ../src/union_find.c \
+           ../src/parallel_components.c \
+           ../src/hub_labels.c \
+           ../src/cch.c \
+           ../src/partition.c \
+           ../src/crp.c \
+           ../src/arc_flags.c \
+           ../src/dynamic_sssp.c
 
 # Header files
 HEADERS += include/MainWindow.h \
@@ -40,7 +67,34 @@ HEADERS += include/MainWindow.h \
            ../include/dfs.h \
            ../include/dijkstra.h \
            ../include/astar.h \
-           ../include/bellman_ford.h
+           ../include/bellman_ford.h \
+           ../include/min_heap.h \
+           ../include/compressed_graph.h \
+           ../include/float_graph.h \
+           ../include/parallel.h \
+           ../include/graph_builder.h \
+           ../include/graph_parser.h \
+           ../include/graph_formats.h \
+           ../include/graph_generators.h \
+           ../include/search_workspace.h \
+           ../include/query_server.h \
+           ../include/graph_snapshot.h \
+           ../include/path_cache.h \
+           ../include/spt_cache.h \
+           ../include/distance_table.h \
+           ../include/jps.h \
+           ../include/graph_view.h \
+           ../include/grid_graph.h \
+           ../include/implicit_search.h \
+           ../include/reach_index.h \
+           ../include/union_find.h \
+           ../include/parallel_components.h \
+           ../include/hub_labels.h \
+           ../include/cch.h \
+           ../include/partition.h \
+           ../include/crp.h \
+           ../include/arc_flags.h \
+           ../include/dynamic_sssp.h
 
 # Default rules for deployment
 qnx: target.path = /tmp/$${TARGET}/bin
@@ -50,8 +104,8 @@ else: unix:!android: target.path = /opt/$${TARGET}/bin
 # Compiler flags for C files
 QMAKE_CFLAGS += -std=c11 -Wall -Wextra
 
-# Link math library for C code
-LIBS += -lm
+# Link math and thread libraries for C code
+LIBS += -lm -lpthread
 
 # Enable debugging
 CONFIG += debug_and_release
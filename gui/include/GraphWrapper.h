@@ -13,6 +13,9 @@ extern "C" {
     #include "dijkstra.h"
     #include "astar.h"
     #include "bellman_ford.h"
+    #include "graph_parser.h"
+    #include "graph_formats.h"
+    #include "jps.h"
 }
 
 /**
@@ -36,7 +39,21 @@ struct PathResultData {
     double timeMs;
     bool found;
 
-    PathResultData() : totalWeight(0), timeMs(0), found(false) {}
+    // Search work counters (see SearchStats)
+    qint64 verticesSettled;
+    qint64 edgesRelaxed;
+    qint64 heapPushes;
+    qint64 heapPops;
+    qint64 peakQueueSize;
+    qint64 bytesAllocated;
+    double initUs;
+    double searchUs;
+    double reconstructUs;
+
+    PathResultData() : totalWeight(0), timeMs(0), found(false),
+                       verticesSettled(0), edgesRelaxed(0), heapPushes(0), heapPops(0),
+                       peakQueueSize(0), bytesAllocated(0),
+                       initUs(0), searchUs(0), reconstructUs(0) {}
 };
 
 /**
@@ -1,6 +1,7 @@
 #include "GraphWrapper.h"
 #include <QFile>
 #include <QTextStream>
+#include <QByteArray>
 #include <QDebug>
 
 GraphWrapper::GraphWrapper(QObject *parent)
@@ -251,88 +252,41 @@ QVector<PathResultData> GraphWrapper::findPaths(int start, int end)
         }
     }
 
+    // Uniform-cost grids also get Jump Point Search
+    GridMap* grid = grid_map_from_graph(m_graph);
+    if (grid) {
+        PathResult* jps_result = jps_grid_find_path(grid, start, end);
+        grid_map_destroy(grid);
+        if (jps_result) {
+            results.append(convertPathResult(jps_result));
+            path_result_destroy(jps_result);
+        }
+    }
+
     return results;
 }
 
 bool GraphWrapper::loadFromFile(const QString& filename)
 {
-    QFile file(filename);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        emit errorOccurred(QString("Cannot open file: %1").arg(filename));
-        return false;
-    }
-
-    QTextStream in(&file);
-
-    // Read graph properties (CLI format: 4 lines)
-    int numVertices, numEdges;
-    bool isWeighted, isDirected;
-
-    // Line 1: number of vertices
-    QString line = in.readLine();
-    if (line.isNull()) {
-        emit errorOccurred("Empty file");
-        return false;
-    }
-    numVertices = line.trimmed().toInt();
-
-    // Line 2: is weighted (y/n)
-    line = in.readLine();
-    if (line.isNull()) {
-        emit errorOccurred("Invalid file format: missing weighted flag");
-        return false;
-    }
-    QString weightedFlag = line.trimmed().toLower();
-    isWeighted = (weightedFlag == "y" || weightedFlag == "yes" || weightedFlag == "1");
-
-    // Line 3: is directed (y/n)
-    line = in.readLine();
-    if (line.isNull()) {
-        emit errorOccurred("Invalid file format: missing directed flag");
-        return false;
-    }
-    QString directedFlag = line.trimmed().toLower();
-    isDirected = (directedFlag == "y" || directedFlag == "yes" || directedFlag == "1");
-
-    // Line 4: number of edges
-    line = in.readLine();
-    if (line.isNull()) {
-        emit errorOccurred("Invalid file format: missing edge count");
-        return false;
-    }
-    numEdges = line.trimmed().toInt();
-
-    createGraph(numVertices, isWeighted, isDirected);
-
-    if (!m_graph) {
-        return false;
-    }
-
-    // Read edges
-    QStringList parts;
-    for (int i = 0; i < numEdges; i++) {
-        line = in.readLine();
-        if (line.isNull()) {
-            emit errorOccurred("Unexpected end of file");
-            return false;
-        }
-
-        parts = line.split(' ');
-        if (parts.size() < 2) {
-            emit errorOccurred(QString("Invalid edge format at line %1").arg(i + 2));
-            return false;
-        }
-
-        int src = parts[0].toInt();
-        int dest = parts[1].toInt();
-        double weight = (parts.size() >= 3) ? parts[2].toDouble() : 1.0;
-
-        if (!addEdge(src, dest, weight)) {
-            return false;
+    // Shared C loaders: GraphPath text, DIMACS (.gr with sibling .co), Matrix Market, METIS
+    QByteArray path = QFile::encodeName(filename);
+    GraphFileInfo info;
+    GraphParseError error;
+    Graph* graph = graph_load_file(path.constData(), nullptr, &info, &error);
+
+    if (!graph) {
+        if (error.line > 0) {
+            emit errorOccurred(QString("%1 (line %2): %3")
+                               .arg(filename).arg(error.line).arg(error.message));
+        } else {
+            emit errorOccurred(QString("%1: %2").arg(filename).arg(error.message));
         }
+        return false;
     }
 
-    file.close();
+    cleanup();
+    m_graph = graph;
+    emit graphChanged();
     return true;
 }
 
@@ -384,6 +338,16 @@ PathResultData GraphWrapper::convertPathResult(const PathResult* result) const
     data.timeMs = result->time_ms;
     data.found = result->found;
 
+    data.verticesSettled = result->stats.vertices_settled;
+    data.edgesRelaxed = result->stats.edges_relaxed;
+    data.heapPushes = result->stats.heap_pushes;
+    data.heapPops = result->stats.heap_pops;
+    data.peakQueueSize = result->stats.peak_queue_size;
+    data.bytesAllocated = static_cast<qint64>(result->stats.bytes_allocated);
+    data.initUs = result->stats.init_ns / 1000.0;
+    data.searchUs = result->stats.search_ns / 1000.0;
+    data.reconstructUs = result->stats.reconstruct_ns / 1000.0;
+
     if (result->found && result->path) {
         for (int i = 0; i < result->path_length; i++) {
             data.path.append(result->path[i]);
@@ -327,7 +327,9 @@ void MainWindow::onLoadGraph()
         this,
         "Load Graph",
         "../examples",
-        "Graph Files (*.txt);;All Files (*)"
+        "Graph Files (*.txt *.gr *.mtx *.graph *.metis);;"
+        "GraphPath Text (*.txt);;DIMACS Road Networks (*.gr);;"
+        "Matrix Market (*.mtx);;METIS (*.graph *.metis);;All Files (*)"
     );
 
     if (filename.isEmpty()) {
@@ -109,6 +109,17 @@ QString ResultsWidget::formatAlgorithmResult(const PathResultData& result, int i
     output += QString("[Result %1]\n").arg(index);
     output += QString("  Algorithm: %1\n").arg(result.algorithm);
     output += QString("  Time: %1 ms\n").arg(result.timeMs, 0, 'f', 3);
+    output += QString("  Work: %1 settled, %2 relaxed, %3 pushes, %4 pops, peak queue %5, %6 KB\n")
+              .arg(result.verticesSettled)
+              .arg(result.edgesRelaxed)
+              .arg(result.heapPushes)
+              .arg(result.heapPops)
+              .arg(result.peakQueueSize)
+              .arg(result.bytesAllocated / 1024.0, 0, 'f', 1);
+    output += QString("  Phases: init %1 us, search %2 us, reconstruct %3 us\n")
+              .arg(result.initUs, 0, 'f', 1)
+              .arg(result.searchUs, 0, 'f', 1)
+              .arg(result.reconstructUs, 0, 'f', 1);
 
     if (result.found) {
         output += QString("  Path: %1\n").arg(formatPath(result.path));
@@ -140,6 +151,19 @@ QString ResultsWidget::formatPerformanceComparison(const QVector<PathResultData>
               .arg(fastestAlgorithm)
               .arg(minTime, 0, 'f', 3);
 
+    // Find the algorithm that did the least work
+    const PathResultData* leastWork = &results[0];
+    for (const PathResultData& result : results) {
+        if (result.verticesSettled < leastWork->verticesSettled) {
+            leastWork = &result;
+        }
+    }
+
+    output += QString("Least work: %1 (%2 vertices settled, %3 edges relaxed)\n")
+              .arg(leastWork->algorithm)
+              .arg(leastWork->verticesSettled)
+              .arg(leastWork->edgesRelaxed);
+
     return output;
 }
 
@@ -0,0 +1,58 @@
+#ifndef ARC_FLAGS_H
+#define ARC_FLAGS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "graph.h"
+#include "search_workspace.h"
+
+// Arc flags: goal-directed pruning that needs no coordinates. Vertices are
+// split into regions, and every arc carries one bit per region telling whether
+// it starts some shortest path into that region. A query toward a target in
+// region r relaxes only arcs whose bit r is set, which on road-like graphs
+// leaves little more than a corridor around the shortest path. Flags are
+// exact: the search returns true shortest paths.
+//
+// Arcs are numbered in adjacency order (adj_list[0] front to back, then
+// adj_list[1], ...), and the bits of one region form a contiguous bit row, so
+// a query scans a single row. Flags describe the graph version they were built
+// for; any later change to the graph makes them stale.
+
+typedef struct ArcFlags ArcFlags;
+
+// Partition into about num_regions regions (the partitioner splits in halves,
+// so the count is rounded up to a power of two) and compute the flags with one
+// backward search per region boundary vertex, regions spread over
+// num_threads (<= 0 means one per CPU). Weights must be non-negative.
+// Returns NULL on invalid input or when memory runs out.
+ArcFlags* arc_flags_build(const Graph* graph, int num_regions, int num_threads);
+void arc_flags_destroy(ArcFlags* flags);
+
+// Dijkstra that skips arcs not flagged for the target's region. Fails (not
+// found) when graph is not the version the flags describe, and with status
+// SEARCH_OUT_OF_MEMORY when memory runs out. The workspace is grown to the
+// graph on first use; one per thread keeps a query's cost to the vertices it
+// touches.
+PathResult* arc_flags_find_path_with_workspace(const ArcFlags* flags, const Graph* graph,
+                                               SearchWorkspace* workspace, int start, int end);
+
+// Same with a temporary workspace, which costs O(n) per call
+PathResult* arc_flags_find_path(const ArcFlags* flags, const Graph* graph, int start, int end);
+
+// Regions actually used, and the region of a vertex (-1 if invalid)
+int arc_flags_num_regions(const ArcFlags* flags);
+int arc_flags_region(const ArcFlags* flags, int vertex);
+
+// Mean fraction of regions flagged per arc (1.0 means no pruning at all)
+double arc_flags_density(const ArcFlags* flags);
+
+// Write the flags together with the graph topology and a hash of its weights
+bool arc_flags_save(const ArcFlags* flags, const char* path);
+
+// Read flags written by arc_flags_save and attach them to graph, which must
+// have the same arcs in the same adjacency order with the same weights
+ArcFlags* arc_flags_load(const char* path, const Graph* graph);
+
+size_t arc_flags_memory_usage(const ArcFlags* flags);
+
+#endif // ARC_FLAGS_H
@@ -3,14 +3,56 @@
 
 #include "graph.h"
 
-// Heuristic function type
+// Heuristic function type. A heuristic is admissible when it never
+// overestimates the remaining distance; only then do the searches below
+// promise anything about path cost. Nothing here can check that, so a custom
+// heuristic's result has suboptimality_bound 0 unless the caller vouches for it.
 typedef double (*HeuristicFunc)(const Graph*, int, int);
 
 // Find shortest path using A* algorithm with custom heuristic
 PathResult* astar_find_path(const Graph* graph, int start, int end,
                            HeuristicFunc heuristic, const char* algorithm_name);
 
-// A* with Euclidean distance heuristic
+// A* that gives up at the limits' deadline or cancellation
+// (result->status tells why; limits may be NULL)
+PathResult* astar_find_path_limited(const Graph* graph, int start, int end,
+                                    HeuristicFunc heuristic, const char* algorithm_name,
+                                    const SearchLimits* limits);
+
+// Weighted A* (f = g + weight * h, weight >= 1). With a consistent heuristic
+// the path costs at most weight times the optimum; the result's
+// suboptimality_bound is set to weight when the caller declares the heuristic
+// admissible, and to 0 otherwise.
+PathResult* astar_weighted(const Graph* graph, int start, int end,
+                           HeuristicFunc heuristic, double weight, bool admissible);
+
+// Options for astar_anytime
+typedef struct {
+    double initial_weight;     // Weight of the first search (>= 1)
+    double weight_step;        // Weight decrease per improvement round (> 0)
+    double time_budget_ms;     // Stop searching after this long (<= 0: until optimal)
+    bool admissible;           // Caller vouches that h never overestimates (else bounds are 0)
+    // Optional: called with each improved solution (the result is still being filled in)
+    void (*on_solution)(const PathResult* result, void* context);
+    void* context;
+} AnytimeAStarOptions;
+
+// Defaults: weight 3 lowered by 0.5 per round, no time budget, heuristic not
+// known to be admissible
+void anytime_astar_options_init(AnytimeAStarOptions* options);
+
+// Anytime Repairing A* (ARA*): a quick weighted search, then repeated repairs
+// with smaller weights that reuse earlier work, until the weight reaches 1 (or
+// the path is proven optimal) or the time budget runs out. The budget covers
+// the first search too: if it runs out before any path is found, the result is
+// not found with status SEARCH_TIMED_OUT. Returns the best path with its
+// proven suboptimality_bound (0 unless options->admissible). options may be NULL.
+PathResult* astar_anytime(const Graph* graph, int start, int end, HeuristicFunc heuristic,
+                          const AnytimeAStarOptions* options);
+
+// A* with Euclidean distance heuristic. Admissible only when no edge is
+// shorter than the distance between its endpoints, which the graph does not
+// promise, so the result carries no bound.
 PathResult* astar_euclidean(const Graph* graph, int start, int end);
 
 // A* with Manhattan distance heuristic
@@ -7,4 +7,9 @@
 // Can handle negative weights and detect negative cycles
 PathResult* bellman_ford_find_path(const Graph* graph, int start, int end);
 
+// Bellman-Ford that gives up at the limits' deadline or cancellation
+// (result->status tells why; limits may be NULL)
+PathResult* bellman_ford_find_path_limited(const Graph* graph, int start, int end,
+                                           const SearchLimits* limits);
+
 #endif // BELLMAN_FORD_H
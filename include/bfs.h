@@ -6,4 +6,9 @@
 // Find path using Breadth-First Search
 PathResult* bfs_find_path(const Graph* graph, int start, int end);
 
+// BFS that gives up at the limits' deadline or cancellation
+// (result->status tells why; limits may be NULL)
+PathResult* bfs_find_path_limited(const Graph* graph, int start, int end,
+                                  const SearchLimits* limits);
+
 #endif // BFS_H
@@ -0,0 +1,49 @@
+#ifndef CCH_H
+#define CCH_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "graph.h"
+
+// Customizable contraction hierarchy. Preprocessing depends only on the
+// topology: a nested dissection order and the chordal supergraph that
+// contracting vertices in that order produces. Customization then applies a
+// weight vector to the shortcuts in seconds, working through the elimination
+// tree level by level in parallel, and queries walk the elimination tree
+// upward from both endpoints. When only weights change (graph_set_edge_weight
+// or an external weight array), re-run cch_customize; when the topology
+// changes, build a new index.
+
+typedef struct CchIndex CchIndex;
+
+// Metric-independent preprocessing. Directed graphs use the underlying
+// undirected topology with separate upward and downward weights.
+CchIndex* cch_create(const Graph* graph);
+void cch_destroy(CchIndex* cch);
+
+// Apply a metric. weights is NULL to take Edge.weight, or one weight per arc
+// in adjacency order (adj_list[0] front to back, then adj_list[1], ...; an
+// undirected edge appears once from each endpoint). graph must have the
+// topology the index was built from. Weights must be non-negative.
+// num_threads <= 0 means one per CPU. Not safe while queries are running.
+bool cch_customize(CchIndex* cch, const Graph* graph, const double* weights, int num_threads);
+
+// Shortest path on the customized hierarchy, with shortcuts unpacked into
+// original arcs. Safe for concurrent readers.
+PathResult* cch_find_path(const CchIndex* cch, int start, int end);
+
+// Distance only; DBL_MAX when unreachable or not customized
+double cch_distance(const CchIndex* cch, int start, int end);
+
+// Arcs of the chordal supergraph (original edges plus shortcuts)
+int cch_num_arcs(const CchIndex* cch);
+
+// Height of the elimination tree (customization runs this many parallel rounds)
+int cch_num_levels(const CchIndex* cch);
+
+// Contraction rank of a vertex (0 first); -1 if invalid
+int cch_rank(const CchIndex* cch, int vertex);
+
+size_t cch_memory_usage(const CchIndex* cch);
+
+#endif // CCH_H
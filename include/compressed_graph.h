@@ -0,0 +1,56 @@
+#ifndef COMPRESSED_GRAPH_H
+#define COMPRESSED_GRAPH_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "graph.h"
+
+// How edge weights are stored in a compressed graph
+typedef enum {
+    COMPRESSED_WEIGHTS_EXACT,      // Lossless: 16-bit dictionary codes, or doubles (see below)
+    COMPRESSED_WEIGHTS_QUANTIZED   // 16-bit codes: weight = weight_min + code * weight_scale
+} CompressedWeightMode;
+
+// Read-only adjacency with sorted, delta + varint encoded neighbour lists.
+// The first neighbour of vertex u is stored as zigzag(dest - u), the rest as
+// gaps to the previous neighbour, so local and dense lists take one byte per arc.
+// EXACT weights are dictionary encoded when the graph has at most 65536
+// distinct weights (integer and road-class weights usually do), so an arc
+// costs about 3 bytes against the ~32 of an adjacency-list edge. With more
+// distinct weights each arc keeps an 8-byte double and the saving drops to
+// about 3x; QUANTIZED mode keeps 2 bytes per arc at the cost of precision.
+typedef struct {
+    int num_vertices;       // Number of vertices
+    int num_edges;          // Number of edges (as counted by the source graph)
+    int num_arcs;           // Number of stored arcs (undirected edges appear twice)
+    int max_degree;         // Largest out-degree (sizes decode buffers)
+    bool is_weighted;       // Unweighted graphs store no weights at all
+    bool is_directed;
+    CompressedWeightMode weight_mode;
+    size_t* byte_offsets;   // Start of each vertex's encoded list in data (n + 1)
+    int* arc_offsets;       // Index of each vertex's first arc in the weight array (n + 1)
+    uint8_t* data;          // Varint stream, padded for wide loads
+    size_t data_size;       // Encoded bytes (excluding padding)
+    double* weights;        // EXACT mode without a dictionary: one double per arc
+    uint16_t* qweights;     // One code per arc: a weight_values index or a quantization step
+    double* weight_values;  // EXACT mode dictionary: the distinct weights, sorted
+    int num_weight_values;
+    double weight_min;      // QUANTIZED mode: value of code 0
+    double weight_scale;    // QUANTIZED mode: value of one code step
+} CompressedGraph;
+
+// Creation and destruction
+CompressedGraph* compressed_graph_create(const Graph* graph, CompressedWeightMode mode);
+void compressed_graph_destroy(CompressedGraph* cgraph);
+
+// Neighbour access: decode vertex's list into dests (and weights if non-NULL).
+// Both buffers must hold at least max_degree entries. Returns the degree.
+int compressed_graph_neighbors(const CompressedGraph* cgraph, int vertex,
+                               int* dests, double* weights);
+size_t compressed_graph_memory_usage(const CompressedGraph* cgraph);
+
+// Path finding directly on the compressed representation
+PathResult* compressed_bfs_find_path(const CompressedGraph* cgraph, int start, int end);
+PathResult* compressed_dijkstra_find_path(const CompressedGraph* cgraph, int start, int end);
+
+#endif // COMPRESSED_GRAPH_H
@@ -0,0 +1,59 @@
+#ifndef CRP_H
+#define CRP_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "graph.h"
+#include "partition.h"
+#include "search_workspace.h"
+
+// Multilevel overlay route planner (customizable route planning). The graph
+// is partitioned into nested cells once; customization then stores, for every
+// cell on every level, the distances between its boundary vertices (a clique),
+// computed bottom-up so each level searches only the cliques of the level
+// below. A query runs Dijkstra on original arcs inside the source and target
+// cells and on the coarsest cliques that avoid them everywhere else, then
+// unpacks clique arcs back into original arcs. Overlay storage is the cliques
+// plus one int per vertex and level, so it stays far below a full hierarchy.
+//
+// The engine keeps a copy of the arc weights it was customized with; a later
+// crp_customize compares against it and recomputes only the cells that hold
+// a changed arc. Queries read original arcs from the graph, so re-customize
+// after changing weights and before querying again.
+
+typedef struct CrpEngine CrpEngine;
+
+// Partition the graph (see partition_create for max_cell_sizes) and build the
+// overlay structure. No weights are applied until crp_customize.
+CrpEngine* crp_create(const Graph* graph, const int* max_cell_sizes, int num_levels);
+void crp_destroy(CrpEngine* crp);
+
+// Bring the cliques up to date with the graph's weights, recomputing in
+// parallel only the cells whose arcs changed since the last call (all cells
+// the first time). num_threads <= 0 means one per CPU. Returns the number of
+// cells recomputed, or -1 if the topology differs from the one the engine was
+// built for, a weight is negative or memory runs out (the engine then needs
+// a successful customization before queries). Not safe while queries are running.
+int crp_customize(CrpEngine* crp, const Graph* graph, int num_threads);
+
+// Shortest path over the overlay, unpacked into original arcs. graph must be
+// the one the engine was customized with. Safe for concurrent readers, each
+// with its own workspace, which is grown to the graph on first use; reusing
+// it keeps a query's cost to the vertices it touches. Ends not found with
+// status SEARCH_OUT_OF_MEMORY when the search or unpacking runs out of memory.
+PathResult* crp_find_path_with_workspace(const CrpEngine* crp, const Graph* graph,
+                                         SearchWorkspace* workspace, int start, int end);
+
+// Same with a temporary workspace, which costs O(n) per call
+PathResult* crp_find_path(const CrpEngine* crp, const Graph* graph, int start, int end);
+
+// The partition the overlay is built on
+const Partition* crp_partition(const CrpEngine* crp);
+
+// Boundary vertices of all cells on a level; -1 if the level is invalid
+int crp_num_boundary_vertices(const CrpEngine* crp, int level);
+
+// Bytes of overlay storage (partition, boundaries, cliques and weight copy)
+size_t crp_memory_usage(const CrpEngine* crp);
+
+#endif // CRP_H
@@ -6,4 +6,9 @@
 // Find path using Depth-First Search
 PathResult* dfs_find_path(const Graph* graph, int start, int end);
 
+// DFS that gives up at the limits' deadline or cancellation
+// (result->status tells why; limits may be NULL)
+PathResult* dfs_find_path_limited(const Graph* graph, int start, int end,
+                                  const SearchLimits* limits);
+
 #endif // DFS_H
@@ -6,4 +6,9 @@
 // Find shortest path using Dijkstra's algorithm
 PathResult* dijkstra_find_path(const Graph* graph, int start, int end);
 
+// Dijkstra that gives up at the limits' deadline or cancellation
+// (result->status tells why; limits may be NULL)
+PathResult* dijkstra_find_path_limited(const Graph* graph, int start, int end,
+                                       const SearchLimits* limits);
+
 #endif // DIJKSTRA_H
@@ -0,0 +1,35 @@
+#ifndef DISTANCE_TABLE_H
+#define DISTANCE_TABLE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "graph.h"
+
+// Options for distance_table_compute
+typedef struct {
+    int num_threads;        // Worker threads (<= 0: one per CPU)
+    int** paths;            // Optional, num_sources * num_targets entries (row-major):
+                            // each receives a malloc'ed start->end vertex sequence,
+                            // or NULL when unreachable
+    int* path_lengths;      // Required with paths: vertices in each path (0 if none)
+    long long* vertices_settled; // Optional: total search work across all sources
+} DistanceTableOptions;
+
+// Default options: one thread per CPU, distances only
+void distance_table_options_init(DistanceTableOptions* options);
+
+// Many-to-many shortest path distances. Runs one Dijkstra per source that
+// stops once every target is settled, with sources spread over a thread pool
+// and one reusable workspace per thread. distances is a caller-provided
+// row-major num_sources x num_targets buffer; unreachable pairs get DBL_MAX.
+// Weights must be non-negative. options may be NULL.
+bool distance_table_compute(const Graph* graph,
+                            const int* sources, int num_sources,
+                            const int* targets, int num_targets,
+                            double* distances, const DistanceTableOptions* options);
+
+// Free the paths returned through DistanceTableOptions (count is
+// num_sources * num_targets, which may exceed INT_MAX)
+void distance_table_free_paths(int** paths, size_t count);
+
+#endif // DISTANCE_TABLE_H
@@ -0,0 +1,67 @@
+#ifndef DYNAMIC_SSSP_H
+#define DYNAMIC_SSSP_H
+
+#include <stdbool.h>
+#include "graph.h"
+#include "min_heap.h"
+
+// Shortest-path tree from a fixed source that is repaired in place when edges
+// change, in the style of Ramalingam and Reps. After an edge becomes cheaper
+// or appears, improvements propagate Dijkstra-style from its head. After an
+// edge on the tree becomes more expensive or disappears, only the subtree
+// hanging below it is re-examined: its vertices are re-seeded from their
+// unaffected in-neighbours and settled with a Dijkstra restricted to the
+// subtree. Work is proportional to the vertices whose distance or parent
+// actually changes (plus their arcs), not to the graph. Weights must be
+// non-negative.
+//
+//   graph_set_edge_weight(graph, u, v, 12.0);
+//   dynamic_sssp_update_edge(tree, graph, u, v);
+//
+// Every change must be reported, but missed ones are detected from the
+// graph's change count: an update that finds more changes than the one it
+// reports (new vertices aside) recomputes the whole tree, and so does a
+// query that finds the graph changed since the last update.
+typedef struct {
+    int source;
+    int capacity;                    // Vertices the arrays can hold
+    unsigned long long graph_version; // Graph state the tree describes (0: recompute)
+    unsigned long long graph_changes; // graph->changes at that state
+    int num_vertices;                // graph->num_vertices at that state
+    double* dist;                    // DBL_MAX when unreachable
+    int* parent;                     // -1 at the source and unreachable vertices
+    int last_affected;               // Vertices re-examined by the last update
+
+    // Private: in-neighbours of directed graphs, repair scratch space
+    int** in_neighbors;
+    int* in_degree;
+    int* in_capacity;
+    unsigned int* mark;
+    unsigned int mark_generation;
+    int* stack;
+    MinHeap* heap;
+} DynamicSssp;
+
+// Build the tree with a full Dijkstra from source
+DynamicSssp* dynamic_sssp_create(const Graph* graph, int source);
+void dynamic_sssp_destroy(DynamicSssp* tree);
+
+// Repair after the arcs between src and dest were added, removed or
+// reweighted (both directions on undirected graphs). Call once per changed
+// vertex pair, right after changing the graph. New vertices are picked up
+// automatically; any other change since the previous update (including a
+// removed vertex) makes this a full recompute. Returns false on invalid
+// input or a negative weight.
+bool dynamic_sssp_update_edge(DynamicSssp* tree, const Graph* graph, int src, int dest);
+
+// Throw the tree away and run Dijkstra again
+bool dynamic_sssp_recompute(DynamicSssp* tree, const Graph* graph);
+
+// Distance to a vertex (DBL_MAX when unreachable or invalid)
+double dynamic_sssp_distance(const DynamicSssp* tree, int vertex);
+
+// Path from the source to target; recomputes first if the graph changed
+// without the tree being told
+PathResult* dynamic_sssp_find_path(DynamicSssp* tree, const Graph* graph, int target);
+
+#endif // DYNAMIC_SSSP_H
@@ -0,0 +1,70 @@
+#ifndef FLOAT_GRAPH_H
+#define FLOAT_GRAPH_H
+
+#include <stdint.h>
+#include "graph.h"
+
+// Reduced-precision weight storage
+typedef enum {
+    FLOAT_WEIGHTS_F32,     // Weights stored as float
+    FLOAT_WEIGHTS_U16      // Weights stored as uint16 codes: weight = code * weight_scale
+} FloatWeightStorage;
+
+// Heuristics available to float A* (computed from float coordinates)
+typedef enum {
+    FLOAT_HEURISTIC_ZERO,
+    FLOAT_HEURISTIC_EUCLIDEAN,
+    FLOAT_HEURISTIC_MANHATTAN
+} FloatHeuristic;
+
+// Flat (CSR) snapshot of a graph with single-precision or quantized weights.
+// Searches over it keep float distance arrays, halving hot-loop memory traffic.
+typedef struct {
+    int num_vertices;
+    int num_arcs;
+    bool is_weighted;
+    bool is_directed;
+    FloatWeightStorage storage;
+    int* offsets;          // First arc of each vertex (n + 1)
+    int* targets;          // Arc destinations
+    float* weights;        // F32 storage
+    uint16_t* qweights;    // U16 storage
+    float weight_scale;    // U16 storage: value of one code step (1.0 for small integers)
+    float* coord_x;        // Copied coordinates (NULL if the graph has none)
+    float* coord_y;
+    // Largest factors c with c * distance(u, v) <= stored weight on every arc,
+    // capped at 1: scaling the heuristics by them keeps A* consistent with the
+    // stored (rounded or quantized) weights
+    float euclidean_scale;
+    float manhattan_scale;
+} FloatGraph;
+
+// Comparison of the reduced-precision path against the double path
+typedef struct {
+    int num_queries;          // Queries compared
+    int found_mismatches;     // Queries where reachability disagreed
+    int path_mismatches;      // Queries that returned a different vertex sequence
+    double max_abs_error;     // Largest |float - double| total weight
+    double max_rel_error;     // Largest relative error of total weight
+    double mean_rel_error;    // Mean relative error over reachable queries
+    double double_time_ms;    // Total time of the double Dijkstra runs
+    double float_time_ms;     // Total time of the float Dijkstra runs
+} WeightAccuracyReport;
+
+// Creation and destruction
+FloatGraph* float_graph_create(const Graph* graph, FloatWeightStorage storage);
+void float_graph_destroy(FloatGraph* fgraph);
+size_t float_graph_memory_usage(const FloatGraph* fgraph);
+
+// Path finding with float distance arrays
+PathResult* float_dijkstra_find_path(const FloatGraph* fgraph, int start, int end);
+PathResult* float_astar_find_path(const FloatGraph* fgraph, int start, int end,
+                                  FloatHeuristic heuristic);
+
+// Accuracy report over num_queries random (start, end) pairs drawn from seed
+bool float_graph_accuracy_report(const Graph* graph, const FloatGraph* fgraph,
+                                 int num_queries, unsigned int seed,
+                                 WeightAccuracyReport* report);
+void weight_accuracy_report_print(const WeightAccuracyReport* report);
+
+#endif // FLOAT_GRAPH_H
@@ -2,6 +2,7 @@
 #define GRAPH_H
 
 #include <stdbool.h>
+#include <stddef.h>
 
 // Edge structure for adjacency list
 typedef struct Edge {
@@ -16,6 +17,9 @@ typedef struct {
     double y;
 } Coordinates;
 
+struct ReachIndex;
+struct GraphComponents;
+
 // Graph structure
 typedef struct {
     int num_vertices;      // Number of vertices
@@ -24,16 +28,46 @@ typedef struct {
     bool is_directed;      // Is graph directed?
     Edge** adj_list;       // Array of adjacency lists
     Coordinates* coords;   // Coordinates for each vertex (optional, for A*)
+    Edge* edge_pool;       // Contiguous edge storage from a bulk build (NULL otherwise)
+    size_t edge_pool_size; // Number of edges in edge_pool
+    unsigned long long version; // Changes on every modification; never shared by two graphs
+    unsigned long long changes; // Modifications so far (one per graph_touch)
+    struct ReachIndex* reach_index; // Optional reachability index (see reach_index.h)
+    struct GraphComponents* components; // Connected components, undirected only (see union_find.h)
 } Graph;
 
+// Per-query search counters, filled in by every algorithm
+typedef struct {
+    long long vertices_settled;  // Vertices taken off the frontier and expanded
+    long long edges_relaxed;     // Edges examined during expansion
+    long long heap_pushes;       // Frontier insertions (queue/stack for BFS/DFS)
+    long long heap_pops;         // Frontier removals, including stale entries
+    long long peak_queue_size;   // Largest frontier size seen
+    size_t bytes_allocated;      // Working memory allocated by the search
+    long long init_ns;           // Allocation and initialisation
+    long long search_ns;         // Main search loop
+    long long reconstruct_ns;    // Path reconstruction and weight summing
+} SearchStats;
+
+// How a search ended
+typedef enum {
+    SEARCH_COMPLETED = 0,  // Ran to the end; found tells whether a path exists
+    SEARCH_TIMED_OUT,      // Stopped at the SearchLimits deadline
+    SEARCH_CANCELLED,      // Stopped by the SearchLimits cancel token
+    SEARCH_OUT_OF_MEMORY   // Working memory could not be allocated
+} SearchStatus;
+
 // Path result structure
 typedef struct {
     int* path;             // Array of vertices in path
     int path_length;       // Number of vertices in path
     double total_weight;   // Total weight of path
-    double time_ms;        // Execution time in milliseconds
+    double time_ms;        // Wall time in milliseconds (sum of the stats phases)
     const char* algorithm; // Algorithm name
     bool found;            // Was path found?
+    SearchStatus status;   // Interrupted searches report found = false
+    double suboptimality_bound; // Path cost is at most this times the optimum (0: no guarantee)
+    SearchStats stats;     // Work counters and phase timings
 } PathResult;
 
 // Graph creation and destruction
@@ -43,10 +77,22 @@ void graph_destroy(Graph* graph);
 // Graph operations
 bool graph_add_edge(Graph* graph, int src, int dest, double weight);
 bool graph_remove_edge(Graph* graph, int src, int dest);
+// Change the weight of the src -> dest edge (both directions when undirected);
+// false if there is no such edge. Parallel edges all get the new weight.
+bool graph_set_edge_weight(Graph* graph, int src, int dest, double weight);
 bool graph_add_vertex(Graph* graph);
 bool graph_remove_vertex(Graph* graph, int vertex);
 void graph_print(const Graph* graph);
 bool graph_is_valid_vertex(const Graph* graph, int vertex);
+size_t graph_memory_usage(const Graph* graph);
+
+// Give the graph a new version after modifying edges or coordinates in place
+// (the graph_* mutators above do this themselves)
+void graph_touch(Graph* graph);
+
+// True when an attached index proves end unreachable from start. Searches
+// call this first, so such queries are rejected without exploring anything.
+bool graph_path_ruled_out(const Graph* graph, int start, int end);
 
 // Coordinate operations
 bool graph_set_coordinates(Graph* graph, int vertex, double x, double y);
@@ -58,5 +104,37 @@ double graph_manhattan_distance(const Graph* graph, int v1, int v2);
 PathResult* path_result_create(void);
 void path_result_destroy(PathResult* result);
 void path_result_print(const PathResult* result);
+PathResult* path_result_clone(const PathResult* result);
+
+// Monotonic wall clock in nanoseconds, for search phase timing
+long long graph_clock_ns(void);
+
+// Flag shared between a search and whoever may cancel it (any thread)
+typedef struct CancelToken CancelToken;
+
+CancelToken* cancel_token_create(void);
+void cancel_token_destroy(CancelToken* token);
+void cancel_token_cancel(CancelToken* token);
+void cancel_token_reset(CancelToken* token);
+bool cancel_token_is_cancelled(const CancelToken* token);
+
+// Interruption limits for the *_limited searches. Main loops check them every
+// SEARCH_LIMITS_CHECK_INTERVAL iterations, so a check costs one clock read.
+typedef struct {
+    long long deadline_ns;     // graph_clock_ns() value to stop at (0: none)
+    const CancelToken* cancel; // Optional
+} SearchLimits;
+
+#define SEARCH_LIMITS_CHECK_INTERVAL 1024
+
+// No deadline and no token
+void search_limits_init(SearchLimits* limits);
+// Deadline budget_ms from now
+void search_limits_set_budget(SearchLimits* limits, double budget_ms);
+// SEARCH_COMPLETED while the search may go on (limits may be NULL)
+SearchStatus search_limits_check(const SearchLimits* limits);
+
+// Build a start->end vertex sequence from a parent array (-1 marks the root)
+int* path_reconstruct(const int* parent, int start, int end, int* path_length);
 
 #endif // GRAPH_H
@@ -0,0 +1,34 @@
+#ifndef GRAPH_BUILDER_H
+#define GRAPH_BUILDER_H
+
+#include <stddef.h>
+#include "graph.h"
+
+// One input edge for bulk construction
+typedef struct {
+    int src;
+    int dest;
+    double weight;
+} EdgeInput;
+
+// Bulk construction options
+typedef struct {
+    int num_threads;       // Worker threads (<= 0: one per CPU)
+    bool sort_neighbors;   // Order each adjacency list by (dest, weight)
+    bool deduplicate;      // Keep one arc per (src, dest), the lightest (implies sorting)
+} GraphBuildOptions;
+
+// Default options: all CPUs, insertion order kept, duplicates kept
+void graph_build_options_init(GraphBuildOptions* options);
+
+// Build a graph from an edge array in parallel. Degrees are counted with
+// atomics, turned into offsets with a prefix sum, and edges are scattered
+// into one contiguous edge pool; undirected graphs get the reverse arcs.
+// Without sorting, each adjacency list follows the input order of its edges
+// regardless of the thread count.
+// options may be NULL for defaults. Returns NULL on invalid input.
+Graph* graph_build_from_edges(int num_vertices, bool is_weighted, bool is_directed,
+                              const EdgeInput* edges, size_t num_edges,
+                              const GraphBuildOptions* options);
+
+#endif // GRAPH_BUILDER_H
@@ -0,0 +1,49 @@
+#ifndef GRAPH_FORMATS_H
+#define GRAPH_FORMATS_H
+
+#include <stddef.h>
+#include "graph.h"
+#include "graph_parser.h"
+
+// Supported graph file formats
+typedef enum {
+    GRAPH_FORMAT_TEXT,           // GraphPath text format (examples/*.txt)
+    GRAPH_FORMAT_DIMACS,         // 9th DIMACS Challenge .gr (+ optional .co coordinates)
+    GRAPH_FORMAT_MATRIX_MARKET,  // Matrix Market coordinate format (.mtx)
+    GRAPH_FORMAT_METIS           // METIS/Chaco adjacency format (.graph, .metis)
+} GraphFormat;
+
+// Pick a format from the file extension, falling back to the first bytes
+// of the content (data may be NULL when only the path is known)
+GraphFormat graph_format_detect(const char* path, const char* data, size_t size);
+
+// Human-readable format name
+const char* graph_format_name(GraphFormat format);
+
+// DIMACS shortest-path graph: "c" comments, "p sp n m", then "a u v w" arcs.
+// Vertices are 1-based in the file and shifted to 0-based. Always directed and weighted.
+Graph* graph_parse_dimacs(const char* data, size_t size, const GraphParseOptions* options,
+                          GraphParseError* error);
+
+// DIMACS coordinates: "c" comments, "p aux sp co n", then "v id x y" lines
+bool graph_parse_dimacs_coordinates(Graph* graph, const char* data, size_t size,
+                                    GraphParseError* error);
+
+// Matrix Market "matrix coordinate" file with real, integer or pattern entries.
+// Symmetric and hermitian matrices become undirected graphs, general ones directed;
+// skew-symmetric matrices become directed graphs with negated mirror arcs.
+Graph* graph_parse_matrix_market(const char* data, size_t size, const GraphParseOptions* options,
+                                 GraphParseError* error);
+
+// METIS graph: header "n m [fmt [ncon]]", then one adjacency line per vertex
+// (1-based neighbours, optional vertex sizes/weights and edge weights). Undirected.
+Graph* graph_parse_metis(const char* data, size_t size, const GraphParseOptions* options,
+                         GraphParseError* error);
+
+// Load any supported format. A DIMACS .gr file picks up its sibling .co file
+// (same name, .co extension) for coordinates when one exists.
+// options, info and error may be NULL. Returns NULL on failure.
+Graph* graph_load_file(const char* path, const GraphParseOptions* options,
+                       GraphFileInfo* info, GraphParseError* error);
+
+#endif // GRAPH_FORMATS_H
@@ -0,0 +1,32 @@
+#ifndef GRAPH_GENERATORS_H
+#define GRAPH_GENERATORS_H
+
+#include "graph.h"
+
+// Synthetic graphs for tests and benchmarks. Every generator is deterministic
+// for a given seed and builds its graph with graph_build_from_edges.
+
+// width x height 4-connected grid, undirected. Vertex y * width + x sits at
+// coordinates (x, y); weights are uniform in [1, max_weight], so Euclidean and
+// Manhattan A* stay admissible.
+Graph* graph_generate_grid(int width, int height, double max_weight, unsigned int seed);
+
+// Random geometric graph: points uniform in a 1000 x 1000 square, joined when
+// closer than the radius that gives about avg_degree neighbours on average.
+// Undirected, weight = Euclidean distance.
+Graph* graph_generate_geometric(int num_vertices, double avg_degree, unsigned int seed);
+
+// R-MAT power-law graph: 2^scale vertices and edge_factor * 2^scale directed
+// arcs drawn with quadrant probabilities a, b, c and 1 - a - b - c. Duplicate
+// arcs are merged. Integer weights in [1, 100]. No coordinates.
+Graph* graph_generate_rmat(int scale, int edge_factor, double a, double b, double c,
+                           unsigned int seed);
+
+// Road-like network: a jittered width x height lattice where a random spanning
+// tree is kept and about a quarter of the other local streets are dropped.
+// Every 16th row and column is an arterial that is never dropped. Undirected and
+// connected; weight = distance x slowness (1 on arterials, 1.5-3 on local
+// streets), so Euclidean A* stays admissible.
+Graph* graph_generate_road(int width, int height, unsigned int seed);
+
+#endif // GRAPH_GENERATORS_H
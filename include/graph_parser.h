@@ -0,0 +1,67 @@
+#ifndef GRAPH_PARSER_H
+#define GRAPH_PARSER_H
+
+#include <stddef.h>
+#include "graph.h"
+
+// Parser options
+typedef struct {
+    int num_threads;        // Threads for the edge section (<= 0: one per CPU)
+    bool sort_neighbors;    // Forwarded to the bulk builder
+    bool deduplicate;       // Forwarded to the bulk builder
+} GraphParseOptions;
+
+// Extra content found in a graph file besides the graph itself
+typedef struct {
+    bool has_coordinates;   // Coordinates section was present and applied
+    bool has_query;         // Start and end vertices were present
+    int start;
+    int end;
+} GraphFileInfo;
+
+// Parse failure description (line is 1-based, 0 when not tied to a line)
+typedef struct {
+    int line;
+    char message[160];
+} GraphParseError;
+
+// Default options: all CPUs, insertion order kept, duplicates kept
+void graph_parse_options_init(GraphParseOptions* options);
+
+// Parse the examples/*.txt format:
+//   vertices, weighted (y/n), directed (y/n), edge count,
+//   the edges as "src dest weight" ("src dest" when unweighted), then
+//   optionally a coordinates flag with "x y" per vertex, and optionally
+//   start and end vertices. An edge may not span lines. A weighted line holds
+//   one or more triples. An unweighted line holds "src dest" pairs, or one
+//   "src dest weight" whose weight is ignored; a line of 6, 12, ... values
+//   could be read either way and is rejected. '#' starts a comment anywhere,
+//   blank lines are skipped.
+// options, info and error may be NULL. Returns NULL on failure.
+Graph* graph_parse_buffer(const char* data, size_t size, const GraphParseOptions* options,
+                          GraphFileInfo* info, GraphParseError* error);
+
+// Read-only view of a whole file, memory-mapped when possible
+typedef struct {
+    const char* data;
+    size_t size;
+    void* mapping;          // mmap base, or NULL when the file was read into buffer
+    char* buffer;
+} GraphFileView;
+
+// Open a file view shared by the loaders. Returns false (with error set) on failure.
+bool graph_file_view_open(const char* path, GraphFileView* view, GraphParseError* error);
+void graph_file_view_close(GraphFileView* view);
+
+// Parse a file (memory-mapped when possible)
+Graph* graph_parse_file(const char* path, const GraphParseOptions* options,
+                        GraphFileInfo* info, GraphParseError* error);
+
+// Number scanners shared with the other loaders. Each skips leading blanks
+// (spaces, tabs, carriage returns but not newlines), parses one number that
+// must end at whitespace or a '#' comment, and returns the position after
+// it, or NULL if no valid number starts there.
+const char* graph_scan_int(const char* p, const char* end, long long* value);
+const char* graph_scan_double(const char* p, const char* end, double* value);
+
+#endif // GRAPH_PARSER_H
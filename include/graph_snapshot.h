@@ -0,0 +1,55 @@
+#ifndef GRAPH_SNAPSHOT_H
+#define GRAPH_SNAPSHOT_H
+
+#include <stdbool.h>
+#include "graph.h"
+#include "graph_parser.h"
+
+// Epoch-based snapshot management for a graph that is replaced while being
+// queried. Readers pin the current version with two atomic stores and never
+// block; a writer publishes a new version with one atomic swap, and old
+// versions are freed once every reader that could still see them has left.
+//
+//   int reader = graph_snapshot_reader_register(manager);   // once per thread
+//   const Graph* graph = graph_snapshot_acquire(manager, reader, &version);
+//   ... query graph ...
+//   graph_snapshot_release(manager, reader);
+
+typedef struct GraphSnapshotManager GraphSnapshotManager;
+
+// Take ownership of the initial graph (version 1). max_readers bounds the
+// number of concurrently registered reader threads.
+GraphSnapshotManager* graph_snapshot_manager_create(Graph* initial, int max_readers);
+
+// Free the manager and every version. No reader may be active.
+void graph_snapshot_manager_destroy(GraphSnapshotManager* manager);
+
+// Claim a reader slot for the calling thread; returns -1 when all are taken
+int graph_snapshot_reader_register(GraphSnapshotManager* manager);
+void graph_snapshot_reader_unregister(GraphSnapshotManager* manager, int reader);
+
+// Pin and return the current graph (version may be NULL). The graph stays
+// valid until the matching release; guards do not nest.
+const Graph* graph_snapshot_acquire(GraphSnapshotManager* manager, int reader,
+                                    unsigned long long* version);
+void graph_snapshot_release(GraphSnapshotManager* manager, int reader);
+
+// Make graph the current version (takes ownership) and retire the previous
+// one. Returns the new version number. Never waits for readers.
+unsigned long long graph_snapshot_publish(GraphSnapshotManager* manager, Graph* graph);
+
+// Load a file (any format graph_load_file accepts) and publish it.
+// Returns the new version, or 0 with error filled when loading fails.
+unsigned long long graph_snapshot_reload_file(GraphSnapshotManager* manager, const char* path,
+                                              GraphParseError* error);
+
+// Free retired versions no reader can still see; returns how many remain
+int graph_snapshot_reclaim(GraphSnapshotManager* manager);
+
+// Wait until every retired version has been freed
+void graph_snapshot_synchronize(GraphSnapshotManager* manager);
+
+// Current version number
+unsigned long long graph_snapshot_version(GraphSnapshotManager* manager);
+
+#endif // GRAPH_SNAPSHOT_H
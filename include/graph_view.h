@@ -0,0 +1,73 @@
+#ifndef GRAPH_VIEW_H
+#define GRAPH_VIEW_H
+
+#include <stdbool.h>
+#include "graph.h"
+#include "search_workspace.h"
+
+// Neighbour generator: writes up to capacity neighbours of vertex into dests
+// and weights and returns the full degree. When the degree exceeds capacity
+// the caller grows its buffers and asks again.
+typedef int (*GraphViewNeighbors)(const void* data, int vertex, int* dests, double* weights,
+                                  int capacity);
+
+// Estimate of the distance between two vertices
+typedef double (*GraphViewHeuristic)(const void* data, int from, int to);
+
+// Read-only graph seen through callbacks, so searches can run on
+// representations without adjacency lists (e.g. implicit grids)
+typedef struct {
+    const void* data;               // Passed to the callbacks
+    int num_vertices;
+    GraphViewNeighbors neighbors;
+    GraphViewHeuristic heuristic;   // NULL: A* degrades to Dijkstra
+    bool heuristic_admissible;      // heuristic never overestimates, so A* is exact
+} GraphView;
+
+// View of an adjacency-list graph (Euclidean heuristic when it has coordinates).
+// The heuristic is not marked admissible: edge weights need not be at least
+// the straight-line distance.
+GraphView graph_view_from_graph(const Graph* graph);
+
+// Searches over a view; results match the adjacency-list versions. A* claims
+// a suboptimality_bound of 1 only for views with an admissible heuristic.
+PathResult* graph_view_bfs(const GraphView* view, int start, int end);
+PathResult* graph_view_dijkstra(const GraphView* view, int start, int end);
+PathResult* graph_view_astar(const GraphView* view, int start, int end);
+
+// Search kernels shared by the view searches, the adjacency-list ones in
+// bfs.c, dijkstra.c and astar.c, and search_workspace.c. Adjacency-list views are walked directly,
+// without the callback. The caller validates start and end and names the
+// result; the kernels fill in the path, weight, status and stats. Running
+// out of memory, including while fetching neighbours, ends the search with
+// SEARCH_OUT_OF_MEMORY.
+typedef struct {
+    GraphViewHeuristic heuristic;   // NULL: Dijkstra order
+    const void* heuristic_data;     // First argument of heuristic
+    double heuristic_weight;        // Keys are g + heuristic_weight * h
+    const SearchLimits* limits;     // May be NULL
+} GraphViewSearchOptions;
+
+// Defaults: no heuristic, weight 1, no limits
+void graph_view_search_options_init(GraphViewSearchOptions* options);
+
+// Best-first search: Dijkstra, A* or weighted A* by the options
+void graph_view_best_first(const GraphView* view, int start, int end,
+                           const GraphViewSearchOptions* options, PathResult* result);
+
+// Fewest-edges search; total_weight sums the weights along the path found
+void graph_view_breadth_first(const GraphView* view, int start, int end,
+                              const SearchLimits* limits, PathResult* result);
+
+// The same kernels on a caller's workspace, begun by the caller and sized for
+// the view. Best-first uses dist, parent, seen, closed and heap; breadth-first
+// uses dist, parent, seen and queue. Counters and the outcome land in
+// workspace->stats and workspace->status. Returns true when end was reached,
+// with its distance in workspace->dist[end] and the path in workspace->parent.
+bool graph_view_best_first_workspace(const GraphView* view, int start, int end,
+                                     const GraphViewSearchOptions* options,
+                                     SearchWorkspace* workspace);
+bool graph_view_breadth_first_workspace(const GraphView* view, int start, int end,
+                                        const SearchLimits* limits, SearchWorkspace* workspace);
+
+#endif // GRAPH_VIEW_H
@@ -0,0 +1,41 @@
+#ifndef GRID_GRAPH_H
+#define GRID_GRAPH_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "graph_view.h"
+
+// Implicit occupancy grid: cell (x, y) is vertex y * width + x and neighbours
+// are generated on the fly instead of stored as edges. Obstacles take one bit
+// per cell. Moving into a cell costs that cell's cost (1.0 unless set), times
+// sqrt(2) for diagonal moves; diagonals may not cut corners.
+typedef struct {
+    int width;
+    int height;
+    bool diagonal;          // 8-connected instead of 4-connected
+    uint64_t* blocked;      // Bitmap, one bit per cell
+    float* costs;           // Per-cell entry costs, allocated on first grid_graph_set_cost
+    double min_cost;        // Lower bound on every cell cost (keeps A* admissible)
+} GridGraph;
+
+// Creation and destruction (all cells start open with cost 1.0)
+GridGraph* grid_graph_create(int width, int height, bool diagonal);
+void grid_graph_destroy(GridGraph* grid);
+
+// Cell access; out-of-range cells count as blocked
+bool grid_graph_set_blocked(GridGraph* grid, int x, int y, bool blocked);
+bool grid_graph_is_open(const GridGraph* grid, int x, int y);
+
+// Cost of entering a cell (must be positive)
+bool grid_graph_set_cost(GridGraph* grid, int x, int y, double cost);
+double grid_graph_get_cost(const GridGraph* grid, int x, int y);
+
+// Bytes held by the grid
+size_t grid_graph_memory_usage(const GridGraph* grid);
+
+// View for the graph_view_* searches, with an octile (or Manhattan) heuristic.
+// The grid must outlive the view.
+GraphView grid_graph_view(const GridGraph* grid);
+
+#endif // GRID_GRAPH_H
@@ -0,0 +1,53 @@
+#ifndef HUB_LABELS_H
+#define HUB_LABELS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "graph.h"
+
+// Hub labelling distance oracle (pruned landmark labelling). Every vertex
+// stores the hubs it reaches (forward label) and the hubs that reach it
+// (backward label) with exact distances; the distance from s to t is the
+// best sum over the hubs s's forward and t's backward label share. Labels
+// are built with one pruned Dijkstra per vertex in importance order and
+// describe the graph as it was when they were built.
+//
+// Each label is a segment of hub ranks sorted ascending and terminated by
+// padding sentinels, so a query is a branch-light merge of two arrays. All
+// arrays are 64-byte aligned in one block, which hub_labels_save writes as is
+// and hub_labels_load maps straight back into memory.
+
+typedef struct HubLabels HubLabels;
+
+// Build labels for a graph with non-negative weights. order lists every vertex
+// once, most important first; NULL orders by total degree. Returns NULL on
+// invalid input.
+HubLabels* hub_labels_build(const Graph* graph, const int* order);
+
+// Free labels (unmapping a loaded file)
+void hub_labels_destroy(HubLabels* labels);
+
+// Exact shortest path distance; DBL_MAX when end is unreachable or a vertex is invalid
+double hub_labels_distance(const HubLabels* labels, int start, int end);
+
+// Distance query that also unpacks the vertex sequence through the parent
+// pointers stored with every label entry
+PathResult* hub_labels_find_path(const HubLabels* labels, int start, int end);
+
+// Write the labels to a file (native byte order)
+bool hub_labels_save(const HubLabels* labels, const char* path);
+
+// Memory-map a file written by hub_labels_save; the labels stay backed by the
+// file. Returns NULL if the header or the label offsets are inconsistent.
+HubLabels* hub_labels_load(const char* path);
+
+// Vertices covered by the labels
+int hub_labels_num_vertices(const HubLabels* labels);
+
+// Mean number of hubs per label (forward and backward labels counted separately)
+double hub_labels_average_size(const HubLabels* labels);
+
+// Bytes of label storage
+size_t hub_labels_memory_usage(const HubLabels* labels);
+
+#endif // HUB_LABELS_H
@@ -0,0 +1,61 @@
+#ifndef IMPLICIT_SEARCH_H
+#define IMPLICIT_SEARCH_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "graph.h"
+
+// Receives one successor of the state being expanded; the state is copied
+typedef void (*ImplicitEmitFunc)(void* sink, const void* state, double cost);
+
+// A state space described by callbacks. States are fixed-size blobs of
+// state_size bytes that the search copies into its own node arena.
+typedef struct {
+    size_t state_size;
+    // Calls emit(sink, successor, cost) for every successor of state (cost >= 0)
+    void (*successors)(const void* state, ImplicitEmitFunc emit, void* sink, void* context);
+    bool (*is_goal)(const void* state, void* context);
+    // Optional: NULL hashes/compares the raw bytes (states must have no padding)
+    uint64_t (*hash)(const void* state, void* context);
+    bool (*equals)(const void* a, const void* b, void* context);
+    // Optional admissible estimate of the remaining cost (NULL: zero)
+    double (*heuristic)(const void* state, void* context);
+    void* context;          // Passed to every callback
+} ImplicitProblem;
+
+// Limits for implicit searches
+typedef struct {
+    size_t memory_limit;    // Bytes for nodes, hash table and frontier (0: unlimited)
+    double weight;          // Heuristic weight for implicit_weighted_astar (>= 1)
+} ImplicitSearchOptions;
+
+// Result of an implicit search
+typedef struct {
+    bool found;
+    bool memory_exhausted;  // Stopped at ImplicitSearchOptions.memory_limit
+    void* states;           // path_length states of state_size bytes, start first
+    int path_length;
+    double total_weight;    // Path cost (edge count for BFS)
+    double time_ms;
+    const char* algorithm;
+    SearchStats stats;      // vertices_settled counts expanded states
+    long long states_generated; // Distinct states stored
+} ImplicitResult;
+
+// Default options: no memory limit, weight 1
+void implicit_search_options_init(ImplicitSearchOptions* options);
+
+// Searches from start until a goal state is expanded. options may be NULL.
+ImplicitResult* implicit_bfs(const ImplicitProblem* problem, const void* start,
+                             const ImplicitSearchOptions* options);
+ImplicitResult* implicit_astar(const ImplicitProblem* problem, const void* start,
+                               const ImplicitSearchOptions* options);
+// f = g + weight * h; the path costs at most weight times the optimum when
+// the heuristic is consistent
+ImplicitResult* implicit_weighted_astar(const ImplicitProblem* problem, const void* start,
+                                        const ImplicitSearchOptions* options);
+
+void implicit_result_destroy(ImplicitResult* result);
+
+#endif // IMPLICIT_SEARCH_H
@@ -0,0 +1,43 @@
+#ifndef JPS_H
+#define JPS_H
+
+#include <stdbool.h>
+#include "graph.h"
+
+// Uniform-cost grid: cell (x, y) is vertex y * width + x. Straight moves cost
+// `cost`; with diagonal moves enabled they cost cost * sqrt(2) and may not cut
+// corners (both adjacent straight cells must be open).
+typedef struct {
+    int width;
+    int height;
+    bool diagonal;             // 8-connected instead of 4-connected
+    double cost;               // Cost of a straight move
+    unsigned char* blocked;    // width * height, nonzero for obstacles
+} GridMap;
+
+// Creation and destruction (all cells start open)
+GridMap* grid_map_create(int width, int height, bool diagonal, double cost);
+void grid_map_destroy(GridMap* grid);
+
+// Cell access; out-of-range cells count as blocked
+bool grid_map_set_blocked(GridMap* grid, int x, int y, bool blocked);
+bool grid_map_is_open(const GridMap* grid, int x, int y);
+
+// Recognise a graph that is exactly such a grid in row-major vertex order:
+// undirected, every edge between neighbouring cells, one weight for straight
+// edges (and sqrt(2) times it for diagonals), and every permitted move present.
+// Vertices without edges become obstacles. Returns NULL for any other graph.
+GridMap* grid_map_from_graph(const Graph* graph);
+
+// Explicit graph for a grid (with cell coordinates), e.g. to compare searches
+Graph* grid_map_to_graph(const GridMap* grid);
+
+// Jump Point Search between two cells. Only jump points are expanded, but the
+// returned path lists every cell. Stats count expanded jump points.
+PathResult* jps_grid_find_path(const GridMap* grid, int start, int end);
+
+// Jump Point Search on a graph recognised by grid_map_from_graph (not found
+// with an error message for other graphs)
+PathResult* jps_find_path(const Graph* graph, int start, int end);
+
+#endif // JPS_H
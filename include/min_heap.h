@@ -0,0 +1,29 @@
+#ifndef MIN_HEAP_H
+#define MIN_HEAP_H
+
+#include <stdbool.h>
+
+// Heap entry: a vertex keyed by its tentative distance
+typedef struct {
+    int vertex;
+    double key;
+} HeapNode;
+
+// Binary min-heap with lazy deletion (stale entries are skipped by callers)
+typedef struct {
+    HeapNode* nodes;
+    int size;
+    int capacity;
+} MinHeap;
+
+// Heap creation and destruction
+MinHeap* min_heap_create(int capacity);
+void min_heap_destroy(MinHeap* heap);
+
+// Heap operations
+bool min_heap_push(MinHeap* heap, int vertex, double key);
+HeapNode min_heap_pop(MinHeap* heap);
+bool min_heap_is_empty(const MinHeap* heap);
+void min_heap_clear(MinHeap* heap);
+
+#endif // MIN_HEAP_H
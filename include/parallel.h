@@ -0,0 +1,33 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <stddef.h>
+
+// Loop body: processes indices [begin, end) on worker thread_id
+typedef void (*ParallelBody)(size_t begin, size_t end, int thread_id, void* context);
+
+// Number of online CPUs (at least 1)
+int parallel_default_threads(void);
+
+// Resolve a requested thread count: <= 0 means one per CPU
+int parallel_resolve_threads(int requested);
+
+// Split [0, count) into one contiguous block per thread and run body on each.
+// Blocks run on pthreads; the calling thread executes block 0. Returns the
+// number of threads actually used.
+int parallel_for(int num_threads, size_t count, ParallelBody body, void* context);
+
+// Worker threads kept alive across loops, for algorithms that run many short
+// parallel loops in a row (e.g. one per BFS level) where creating and joining
+// threads each time would dominate. Loops on one pool must not overlap.
+typedef struct ParallelPool ParallelPool;
+
+// Start num_threads - 1 workers (<= 0: one per CPU); the calling thread of
+// each loop is the last. Returns NULL on allocation failure.
+ParallelPool* parallel_pool_create(int num_threads);
+void parallel_pool_destroy(ParallelPool* pool);
+
+// parallel_for on the pool's threads: the same blocks, body runs once per block
+int parallel_pool_for(ParallelPool* pool, size_t count, ParallelBody body, void* context);
+
+#endif // PARALLEL_H
@@ -0,0 +1,32 @@
+#ifndef PARALLEL_COMPONENTS_H
+#define PARALLEL_COMPONENTS_H
+
+#include "graph.h"
+
+// Per-vertex component labels computed with a thread pool
+typedef struct {
+    int* labels;            // Component of each vertex, 0..num_components-1
+    int* sizes;             // Vertices in each component
+    int num_vertices;
+    int num_components;
+    int largest;            // Label of the largest component (-1 if none)
+    int threads_used;
+    double time_ms;
+    const char* algorithm;
+} ComponentResult;
+
+// Connected components (Afforest: sampled neighbour linking, then the
+// remaining edges of vertices outside the dominant component, with lock-free
+// hooking and pointer jumping). Directed graphs get weakly connected
+// components. num_threads <= 0 means one per CPU.
+ComponentResult* parallel_connected_components(const Graph* graph, int num_threads);
+
+// Strongly connected components (parallel trimming of vertices without
+// in- or out-edges, then forward-backward reachability from one pivot per
+// open subproblem, all subproblems advancing together). Undirected graphs
+// give their connected components.
+ComponentResult* parallel_strong_components(const Graph* graph, int num_threads);
+
+void component_result_destroy(ComponentResult* result);
+
+#endif // PARALLEL_COMPONENTS_H
@@ -0,0 +1,31 @@
+#ifndef PARTITION_H
+#define PARTITION_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "graph.h"
+
+// Nested multilevel partition of a graph's vertices into cells. Level 0 is
+// the finest; every cell of level l + 1 is a union of level l cells.
+// Built by recursive bisection: each piece is split at the middle of a BFS
+// order grown from a pseudo-peripheral vertex (component by component), so
+// cells are compact on road-like graphs and sizes stay balanced.
+typedef struct {
+    int num_vertices;
+    int num_levels;
+    int* cells;             // cells[level * num_vertices + v]
+    int* num_cells;         // Cells on each level
+} Partition;
+
+// max_cell_sizes has num_levels strictly increasing entries: no cell on
+// level l has more than max_cell_sizes[l] vertices (edge direction is ignored)
+Partition* partition_create(const Graph* graph, const int* max_cell_sizes, int num_levels);
+void partition_destroy(Partition* partition);
+
+// Cell of a vertex on a level
+int partition_cell(const Partition* partition, int level, int vertex);
+
+// Arcs whose endpoints lie in different cells of a level
+int partition_cut_arcs(const Partition* partition, const Graph* graph, int level);
+
+#endif // PARTITION_H
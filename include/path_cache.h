@@ -0,0 +1,48 @@
+#ifndef PATH_CACHE_H
+#define PATH_CACHE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "graph.h"
+
+// Any point-to-point search with the dijkstra_find_path signature
+typedef PathResult* (*PathFinderFunc)(const Graph* graph, int start, int end);
+
+// Bounded cache of search results keyed by (start, end, finder). Entries
+// remember the graph version they were computed on and are dropped when the
+// graph has changed since. Eviction is CLOCK (approximate LRU). The cache is
+// split into independently locked shards, so concurrent lookups rarely contend.
+typedef struct PathCache PathCache;
+
+typedef struct {
+    long long hits;
+    long long misses;          // Includes stale entries
+    long long stale;           // Entries found but computed on an older graph
+    long long evictions;
+    long long entries;         // Currently cached
+} PathCacheStats;
+
+// Creation and destruction
+PathCache* path_cache_create(size_t capacity);
+void path_cache_destroy(PathCache* cache);
+
+// Cached copy of the result (caller destroys it), or NULL on a miss.
+// Copies have zeroed search stats; time_ms is the lookup time.
+PathResult* path_cache_lookup(PathCache* cache, const Graph* graph, int start, int end,
+                              PathFinderFunc finder);
+
+// Store a copy of result for the graph's current version
+bool path_cache_insert(PathCache* cache, const Graph* graph, int start, int end,
+                       PathFinderFunc finder, const PathResult* result);
+
+// Lookup, or run finder and cache its result on a miss
+PathResult* path_cache_find_path(PathCache* cache, const Graph* graph, int start, int end,
+                                 PathFinderFunc finder);
+
+// Drop every entry (counters are kept)
+void path_cache_clear(PathCache* cache);
+
+// Counters summed over all shards
+void path_cache_get_stats(PathCache* cache, PathCacheStats* stats);
+
+#endif // PATH_CACHE_H
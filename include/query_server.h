@@ -0,0 +1,113 @@
+#ifndef QUERY_SERVER_H
+#define QUERY_SERVER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "graph.h"
+#include "graph_snapshot.h"
+
+// Binary protocol over a Unix domain socket. Both ends are on the same host,
+// so fields use host byte order. Clients may pipeline any number of requests;
+// responses carry the request id and can arrive out of order. The server never
+// blocks on a client: responses it cannot send yet are queued, and a client
+// that stops reading them only stops its own requests from being read.
+
+// Request operations
+typedef enum {
+    QUERY_OP_PATH = 1,       // Distance and vertex sequence
+    QUERY_OP_DISTANCE = 2,   // Distance only (path_length is 0)
+    QUERY_OP_PING = 3,       // Empty OK response
+    QUERY_OP_SHUTDOWN = 4,   // Stop the server (if allowed), answered with OK first
+    QUERY_OP_RELOAD = 5      // Reload the graph file in the background (if configured)
+} QueryOp;
+
+// Algorithms a request can ask for
+typedef enum {
+    QUERY_ALGO_DIJKSTRA = 0,
+    QUERY_ALGO_ASTAR = 1,    // Euclidean heuristic when the graph has coordinates
+    QUERY_ALGO_BFS = 2       // Fewest edges
+} QueryAlgorithm;
+
+// Response status codes
+typedef enum {
+    QUERY_STATUS_OK = 0,
+    QUERY_STATUS_NOT_FOUND = 1,     // No path from start to end
+    QUERY_STATUS_BAD_REQUEST = 2,   // Unknown op/algorithm or invalid vertex
+    QUERY_STATUS_REFUSED = 3,       // e.g. remote shutdown not allowed
+    QUERY_STATUS_TIMED_OUT = 4,     // Search exceeded the server's query timeout
+    QUERY_STATUS_ERROR = 5          // Server-side failure, e.g. out of memory
+} QueryStatus;
+
+// 16-byte request
+typedef struct {
+    uint32_t id;            // Echoed in the response
+    uint8_t op;             // QueryOp
+    uint8_t algorithm;      // QueryAlgorithm
+    uint16_t flags;         // Reserved, must be 0
+    int32_t start;
+    int32_t end;
+} QueryRequest;
+
+// 32-byte response header, followed by path_length int32 vertices
+typedef struct {
+    uint32_t id;
+    uint32_t path_length;
+    uint8_t status;         // QueryStatus
+    uint8_t reserved[7];
+    uint64_t version;       // Graph snapshot that answered
+    double distance;
+} QueryResponseHeader;
+
+// Server configuration
+typedef struct {
+    const char* socket_path;
+    int num_threads;             // Worker threads (<= 0: one per CPU)
+    int max_pending;             // Queued requests before reads pause (<= 0: 4096)
+    bool allow_remote_shutdown;  // Honour QUERY_OP_SHUTDOWN
+    const char* graph_path;      // Source for reloads (NULL: reloads refused)
+    double query_timeout_ms;     // Per-search time budget (<= 0: unlimited)
+} QueryServerConfig;
+
+// Counters reported after shutdown
+typedef struct {
+    long long connections;
+    long long requests;
+    long long errors;            // Bad requests and failed writes
+    long long reloads;           // Snapshots published by reloads
+    long long timeouts;          // Searches stopped by query_timeout_ms
+} QueryServerStats;
+
+typedef struct QueryServer QueryServer;
+
+// Default configuration for socket_path
+void query_server_config_init(QueryServerConfig* config, const char* socket_path);
+
+// Bind and listen on the socket (an existing socket file is replaced).
+// Queries run against the current snapshot of graphs, which must outlive the
+// server and have a free reader slot per worker thread. Reloads publish new
+// snapshots while queries continue on the old one.
+QueryServer* query_server_create(GraphSnapshotManager* graphs, const QueryServerConfig* config);
+
+// Serve until stopped. Pending requests are answered before it returns.
+bool query_server_run(QueryServer* server);
+
+// Ask a running server to stop. Async-signal-safe; callable from any thread.
+void query_server_stop(QueryServer* server);
+
+// Reload config->graph_path in the background. Async-signal-safe (SIGHUP).
+void query_server_reload(QueryServer* server);
+
+// Counters so far
+void query_server_get_stats(QueryServer* server, QueryServerStats* stats);
+
+// Close the socket, remove the socket file and free the server
+void query_server_destroy(QueryServer* server);
+
+// Client helpers (blocking). connect returns a socket fd or -1.
+int query_client_connect(const char* socket_path);
+bool query_client_send(int fd, const QueryRequest* request);
+// Read one response; up to path_capacity vertices are stored in path (may be NULL),
+// the rest are discarded.
+bool query_client_receive(int fd, QueryResponseHeader* header, int32_t* path, int path_capacity);
+
+#endif // QUERY_SERVER_H
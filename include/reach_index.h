@@ -0,0 +1,45 @@
+#ifndef REACH_INDEX_H
+#define REACH_INDEX_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "graph.h"
+
+// Reachability index: the graph is condensed into strongly connected
+// components (iterative Tarjan) and the condensation DAG gets GRAIL interval
+// labels from several randomised DFS traversals. A query is answered in
+// O(traversals): same component means reachable, a label that does not
+// contain the other means unreachable, and anything else is undecided.
+
+// Answer of the constant-time check
+typedef enum {
+    REACH_NO = 0,      // end is certainly unreachable from start
+    REACH_YES,         // Same strongly connected component
+    REACH_MAYBE        // Labels cannot decide (or no index is attached)
+} ReachAnswer;
+
+#define REACH_INDEX_DEFAULT_TRAVERSALS 3
+
+// Attach an index to the graph; it is built on the first query and rebuilt
+// lazily after the graph changes. Searches then reject ruled-out queries.
+bool reach_index_attach(Graph* graph, int num_traversals);
+
+// Remove and free the graph's index (graph_destroy does this)
+void reach_index_detach(Graph* graph);
+
+// Constant-time check. Safe for concurrent readers as long as nobody
+// modifies the graph at the same time.
+ReachAnswer reach_index_query(const Graph* graph, int start, int end);
+
+// Exact answer: resolves REACH_MAYBE with a DFS over the condensation DAG
+// that the labels prune
+bool reach_index_reachable(const Graph* graph, int start, int end);
+
+// Strongly connected components of the current graph (-1 without an index)
+int reach_index_num_components(const Graph* graph);
+int reach_index_component(const Graph* graph, int vertex);
+
+// Bytes held by the index
+size_t reach_index_memory_usage(const Graph* graph);
+
+#endif // REACH_INDEX_H
@@ -0,0 +1,57 @@
+#ifndef SEARCH_WORKSPACE_H
+#define SEARCH_WORKSPACE_H
+
+#include <stdbool.h>
+#include "graph.h"
+#include "min_heap.h"
+
+// Searches a workspace can run
+typedef enum {
+    WORKSPACE_DIJKSTRA,
+    WORKSPACE_ASTAR,       // Euclidean heuristic (plain Dijkstra without coordinates)
+    WORKSPACE_BFS          // Fewest edges; distance is the summed weight of that path
+} WorkspaceAlgorithm;
+
+// Reusable per-thread search state. Arrays are sized once and invalidated in
+// O(1) per query with generation stamps, so repeated queries neither allocate
+// nor touch all n entries.
+typedef struct {
+    int capacity;            // Vertices the arrays can hold
+    double* dist;            // Valid where seen[v] == generation
+    int* parent;             // Valid where seen[v] == generation
+    unsigned int* seen;      // Generation in which dist/parent were written
+    unsigned int* closed;    // Generation in which the vertex was settled
+    unsigned int generation;
+    MinHeap* heap;
+    int* queue;              // BFS frontier
+    int* path;               // Last path found (start first)
+    int path_length;
+    SearchStats stats;       // Counters of the last query
+    SearchStatus status;     // How the last query ended
+} SearchWorkspace;
+
+// Creation and destruction
+SearchWorkspace* search_workspace_create(int num_vertices);
+void search_workspace_destroy(SearchWorkspace* workspace);
+
+// Grow the arrays to hold num_vertices (e.g. after the graph gained vertices)
+bool search_workspace_reserve(SearchWorkspace* workspace, int num_vertices);
+
+// Start a new query: invalidates all per-vertex state in O(1)
+void search_workspace_begin(SearchWorkspace* workspace);
+
+// Point-to-point search. On success returns true with *distance set and the
+// path in workspace->path / path_length; returns false when end is unreachable
+// or the query is invalid.
+bool search_workspace_find_path(SearchWorkspace* workspace, const Graph* graph,
+                                int start, int end, WorkspaceAlgorithm algorithm,
+                                double* distance);
+
+// find_path that gives up at the limits' deadline or cancellation, or when
+// memory runs out, returning false with workspace->status telling why
+// (limits may be NULL)
+bool search_workspace_find_path_limited(SearchWorkspace* workspace, const Graph* graph,
+                                        int start, int end, WorkspaceAlgorithm algorithm,
+                                        const SearchLimits* limits, double* distance);
+
+#endif // SEARCH_WORKSPACE_H
@@ -0,0 +1,62 @@
+#ifndef SPT_CACHE_H
+#define SPT_CACHE_H
+
+#include <stdbool.h>
+#include "graph.h"
+#include "min_heap.h"
+
+// Resumable single-source Dijkstra. The tree keeps its distances, parents and
+// frontier between queries: a target that is already settled costs only a
+// path reconstruction, and an unsettled one resumes expansion from where the
+// previous query stopped. Weights must be non-negative.
+typedef struct {
+    int source;
+    int capacity;                    // Vertices the arrays can hold
+    unsigned long long graph_version; // Graph state the tree was grown on (0: restart)
+    double* dist;                    // DBL_MAX until reached
+    int* parent;
+    bool* settled;
+    MinHeap* frontier;
+    int num_settled;
+    SearchStats stats;               // Cumulative work since the tree was (re)started
+} ShortestPathTree;
+
+// Creation and destruction
+ShortestPathTree* spt_create(const Graph* graph, int source);
+void spt_destroy(ShortestPathTree* tree);
+
+// Restart the tree from source (also done automatically when the graph changed)
+bool spt_reset(ShortestPathTree* tree, const Graph* graph, int source);
+
+// Expand until target is settled or the frontier is empty; true if reachable
+bool spt_settle(ShortestPathTree* tree, const Graph* graph, int target);
+
+// Path from the source to target. Stats cover only the work of this call.
+PathResult* spt_find_path(ShortestPathTree* tree, const Graph* graph, int target);
+
+// Small LRU of resumable trees keyed by source. Not thread-safe: use one
+// cache per thread.
+typedef struct SptCache SptCache;
+
+typedef struct {
+    long long tree_hits;             // Queries served by an existing tree
+    long long tree_misses;           // Queries that started or restarted a tree
+    long long settled_hits;          // Hits whose target was already settled
+    long long evictions;
+} SptCacheStats;
+
+SptCache* spt_cache_create(int max_trees);
+void spt_cache_destroy(SptCache* cache);
+
+// One-to-one query through the cache
+PathResult* spt_cache_find_path(SptCache* cache, const Graph* graph, int start, int end);
+
+// One-to-many: distances[i] is the distance to targets[i] (DBL_MAX when
+// unreachable). The tree grows only as far as the farthest target needs.
+// Returns false if the tree could not be grown (out of memory).
+bool spt_cache_distances(SptCache* cache, const Graph* graph, int source,
+                         const int* targets, int num_targets, double* distances);
+
+void spt_cache_get_stats(const SptCache* cache, SptCacheStats* stats);
+
+#endif // SPT_CACHE_H
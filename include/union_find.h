@@ -0,0 +1,73 @@
+#ifndef UNION_FIND_H
+#define UNION_FIND_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "graph.h"
+
+// Disjoint-set forest with union by rank and path compression
+typedef struct {
+    int* parent;
+    int* rank;
+    int* size;             // Set size, valid at roots
+    int count;             // Elements
+    int num_sets;
+} UnionFind;
+
+UnionFind* union_find_create(int count);
+void union_find_destroy(UnionFind* uf);
+
+// Add singleton sets until there are count elements
+bool union_find_grow(UnionFind* uf, int count);
+
+// Make every element its own set again
+void union_find_reset(UnionFind* uf);
+
+// Root of x's set, compressing the path
+int union_find_find(UnionFind* uf, int x);
+
+// Root of x's set without writing anything (safe for concurrent readers);
+// union by rank keeps this O(log n)
+int union_find_root(const UnionFind* uf, int x);
+
+// Merge the sets of a and b; false if they were already one set
+bool union_find_unite(UnionFind* uf, int a, int b);
+
+// Connected components of undirected graphs. Every undirected Graph carries
+// a union-find that graph_add_edge, graph_add_vertex, graph_set_edge_weight
+// and graph_set_coordinates keep up to date, and that bulk builds and
+// snapshot publication build up front; only removals make it stale, and it is
+// then rebuilt on the next query. Searches use it to reject start/end pairs in
+// different components at once. The functions below return -1 / false for
+// directed graphs.
+
+typedef struct GraphComponents GraphComponents;
+
+// Internal: lifetime and incremental updates, called from graph.c. The note
+// functions take the graph version before the change.
+GraphComponents* graph_components_create(int num_vertices, unsigned long long version);
+void graph_components_destroy(GraphComponents* components);
+void graph_components_note_edge(Graph* graph, int src, int dest, unsigned long long previous_version);
+void graph_components_note_vertex(Graph* graph, unsigned long long previous_version);
+void graph_components_note_unchanged(Graph* graph, unsigned long long previous_version);
+
+// Internal: rebuild stale sets now rather than on the first query, so that
+// readers of a freshly built or published graph never wait on a rebuild.
+// False if memory ran out (the sets then stay stale).
+bool graph_components_warm(const Graph* graph);
+
+// Internal: whether the sets describe the graph as it is (no rebuild pending)
+bool graph_components_current(const Graph* graph);
+
+// Internal: 1 when u and v share a component, 0 when they do not, -1 when
+// that is unknown (directed graph, invalid vertex, or no memory to rebuild
+// stale sets). Only 0 may be used to reject a query.
+int graph_components_connected(const Graph* graph, int u, int v);
+
+// Queries (concurrent readers are fine while nobody modifies the graph)
+int graph_num_components(const Graph* graph);
+int graph_component_size(const Graph* graph, int vertex);
+int graph_component_id(const Graph* graph, int vertex);  // Representative vertex
+bool graph_same_component(const Graph* graph, int u, int v);
+
+#endif // UNION_FIND_H
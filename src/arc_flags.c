@@ -0,0 +1,540 @@
+#include "arc_flags.h"
+#include "parallel.h"
+#include "partition.h"
+#include "search_workspace.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <float.h>
+
+#define ARC_FLAGS_MAGIC "GPARCFL1"
+#define ARC_FLAGS_FORMAT_VERSION 1
+
+// File layout: header, region of every vertex (int32), arc heads (int32) and
+// the bit rows (uint64), all in native byte order
+typedef struct {
+    char magic[8];
+    uint32_t format_version;
+    uint32_t num_regions;
+    int64_t num_vertices;
+    int64_t num_arcs;
+    uint64_t weight_hash;       // FNV-1a over the arc weights in adjacency order
+} ArcFlagsHeader;
+
+struct ArcFlags {
+    int num_vertices;
+    int num_regions;
+    int num_arcs;
+    int32_t* region;            // Vertex -> region
+    int* arc_offsets;           // n + 1: id of each vertex's first arc
+    int32_t* arc_heads;         // Topology the flags were computed for
+    uint64_t* rows;             // num_regions rows of words_per_row words
+    size_t words_per_row;
+    uint64_t weight_hash;
+    unsigned long long version; // Graph version the flags describe
+};
+
+static bool flag_set(const uint64_t* row, int arc) {
+    return (row[arc >> 6] >> (arc & 63)) & 1;
+}
+
+static uint64_t weight_hash(const Graph* graph) {
+    uint64_t hash = 14695981039346656037ull;
+    for (int u = 0; u < graph->num_vertices; u++) {
+        for (Edge* edge = graph->adj_list[u]; edge; edge = edge->next) {
+            const unsigned char* bytes = (const unsigned char*)&edge->weight;
+            for (size_t i = 0; i < sizeof(double); i++) {
+                hash = (hash ^ bytes[i]) * 1099511628211ull;
+            }
+        }
+    }
+    return hash;
+}
+
+static ArcFlags* arc_flags_alloc(int n, int num_arcs, int num_regions) {
+    ArcFlags* flags = (ArcFlags*)calloc(1, sizeof(ArcFlags));
+    if (!flags) return NULL;
+    flags->num_vertices = n;
+    flags->num_arcs = num_arcs;
+    flags->num_regions = num_regions;
+    flags->words_per_row = ((size_t)num_arcs + 63) / 64;
+    size_t words = flags->words_per_row * num_regions;
+    flags->region = (int32_t*)malloc(n * sizeof(int32_t));
+    flags->arc_offsets = (int*)malloc((n + 1) * sizeof(int));
+    flags->arc_heads = (int32_t*)malloc((num_arcs > 0 ? num_arcs : 1) * sizeof(int32_t));
+    flags->rows = (uint64_t*)calloc(words > 0 ? words : 1, sizeof(uint64_t));
+    if (!flags->region || !flags->arc_offsets || !flags->arc_heads || !flags->rows) {
+        arc_flags_destroy(flags);
+        return NULL;
+    }
+    return flags;
+}
+
+static int count_arcs(const Graph* graph) {
+    int arcs = 0;
+    for (int u = 0; u < graph->num_vertices; u++) {
+        for (Edge* edge = graph->adj_list[u]; edge; edge = edge->next) arcs++;
+    }
+    return arcs;
+}
+
+// ---------------------------------------------------------------------------
+// Construction
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    ArcFlags* flags;
+    const double* weights;       // Per arc
+    const int* rev_offsets;      // n + 1: arcs entering each vertex
+    const int* rev_arcs;
+    const int* arc_tails;
+    const int* boundary_offsets; // num_regions + 1
+    const int* boundary;         // Entry vertices grouped by region
+    atomic_int next_region;      // Regions are handed out one at a time
+    atomic_bool failed;
+} BuildContext;
+
+// Backward Dijkstra to b, then flag every arc that is tight (lies on a
+// shortest path to b) in the region's row. False if memory ran out, since a
+// lost heap entry would leave flags unset.
+static bool flag_boundary_vertex(BuildContext* ctx, SearchWorkspace* workspace, int* settled,
+                                 int b, uint64_t* row) {
+    const ArcFlags* flags = ctx->flags;
+    search_workspace_begin(workspace);
+    unsigned int generation = workspace->generation;
+    workspace->dist[b] = 0.0;
+    workspace->seen[b] = generation;
+    if (!min_heap_push(workspace->heap, b, 0.0)) return false;
+    int count = 0;
+
+    while (!min_heap_is_empty(workspace->heap)) {
+        int w = min_heap_pop(workspace->heap).vertex;
+        if (workspace->closed[w] == generation) continue;
+        workspace->closed[w] = generation;
+        settled[count++] = w;
+        double d = workspace->dist[w];
+        for (int i = ctx->rev_offsets[w]; i < ctx->rev_offsets[w + 1]; i++) {
+            int arc = ctx->rev_arcs[i];
+            int u = ctx->arc_tails[arc];
+            double candidate = d + ctx->weights[arc];
+            if (workspace->closed[u] == generation) continue;
+            if (workspace->seen[u] != generation || candidate < workspace->dist[u]) {
+                workspace->seen[u] = generation;
+                workspace->dist[u] = candidate;
+                if (!min_heap_push(workspace->heap, u, candidate)) return false;
+            }
+        }
+    }
+
+    for (int i = 0; i < count; i++) {
+        int u = settled[i];
+        for (int arc = flags->arc_offsets[u]; arc < flags->arc_offsets[u + 1]; arc++) {
+            int w = flags->arc_heads[arc];
+            if (workspace->closed[w] == generation &&
+                workspace->dist[w] + ctx->weights[arc] == workspace->dist[u]) {
+                row[arc >> 6] |= 1ull << (arc & 63);
+            }
+        }
+    }
+    return true;
+}
+
+// One block per thread; regions are claimed dynamically and each owns its
+// row, so threads never write the same word
+static void build_worker(size_t begin, size_t end, int thread_id, void* context) {
+    (void)begin;
+    (void)end;
+    (void)thread_id;
+    BuildContext* ctx = (BuildContext*)context;
+    ArcFlags* flags = ctx->flags;
+
+    SearchWorkspace* workspace = search_workspace_create(flags->num_vertices);
+    int* settled = (int*)malloc(flags->num_vertices * sizeof(int));
+    if (!workspace || !settled) {
+        atomic_store(&ctx->failed, true);
+    } else {
+        int r;
+        while (!atomic_load_explicit(&ctx->failed, memory_order_relaxed) &&
+               (r = atomic_fetch_add(&ctx->next_region, 1)) < flags->num_regions) {
+            uint64_t* row = flags->rows + (size_t)r * flags->words_per_row;
+            for (int i = ctx->boundary_offsets[r]; i < ctx->boundary_offsets[r + 1]; i++) {
+                if (!flag_boundary_vertex(ctx, workspace, settled, ctx->boundary[i], row)) {
+                    atomic_store(&ctx->failed, true);
+                    break;
+                }
+            }
+        }
+    }
+    search_workspace_destroy(workspace);
+    free(settled);
+}
+
+ArcFlags* arc_flags_build(const Graph* graph, int num_regions, int num_threads) {
+    if (!graph || num_regions < 1) {
+        fprintf(stderr, "Error: Invalid arc flag parameters\n");
+        return NULL;
+    }
+    int n = graph->num_vertices;
+    int num_arcs = count_arcs(graph);
+    for (int u = 0; u < n; u++) {
+        for (Edge* edge = graph->adj_list[u]; edge; edge = edge->next) {
+            if (edge->weight < 0) {
+                fprintf(stderr, "Error: Arc flags require non-negative edge weights\n");
+                return NULL;
+            }
+        }
+    }
+
+    int max_region_size = (int)(((long long)n + num_regions - 1) / num_regions);
+    Partition* partition = partition_create(graph, &max_region_size, 1);
+    if (!partition) return NULL;
+
+    ArcFlags* flags = arc_flags_alloc(n, num_arcs, partition->num_cells[0]);
+    int arcs = num_arcs > 0 ? num_arcs : 1;
+    double* weights = (double*)malloc(arcs * sizeof(double));
+    int* arc_tails = (int*)malloc(arcs * sizeof(int));
+    int* rev_offsets = (int*)calloc(n + 1, sizeof(int));
+    int* rev_arcs = (int*)malloc(arcs * sizeof(int));
+    int* boundary_offsets = flags ? (int*)calloc(flags->num_regions + 1, sizeof(int)) : NULL;
+    int* boundary = (int*)malloc(n * sizeof(int));
+    bool* entry = (bool*)calloc(n, sizeof(bool));
+    bool ok = flags && weights && arc_tails && rev_offsets && rev_arcs && boundary_offsets &&
+              boundary && entry;
+
+    if (ok) {
+        memcpy(flags->region, partition->cells, n * sizeof(int32_t));
+        const int32_t* region = flags->region;
+        uint64_t* rows = flags->rows;
+        int arc = 0;
+        for (int u = 0; u < n; u++) {
+            flags->arc_offsets[u] = arc;
+            for (Edge* edge = graph->adj_list[u]; edge; edge = edge->next, arc++) {
+                int w = edge->dest;
+                flags->arc_heads[arc] = w;
+                weights[arc] = edge->weight;
+                arc_tails[arc] = u;
+                rev_offsets[w + 1]++;
+                // Arcs inside a region serve every path that ends there
+                if (region[u] == region[w]) {
+                    rows[(size_t)region[w] * flags->words_per_row + (arc >> 6)] |= 1ull << (arc & 63);
+                } else {
+                    entry[w] = true;
+                }
+            }
+        }
+        flags->arc_offsets[n] = arc;
+        flags->weight_hash = weight_hash(graph);
+        flags->version = graph->version;
+
+        for (int v = 0; v < n; v++) rev_offsets[v + 1] += rev_offsets[v];
+        int* fill = boundary;  // Borrowed as a cursor before the boundary is built
+        memcpy(fill, rev_offsets, n * sizeof(int));
+        for (arc = 0; arc < num_arcs; arc++) {
+            rev_arcs[fill[flags->arc_heads[arc]]++] = arc;
+        }
+
+        for (int v = 0; v < n; v++) {
+            if (entry[v]) boundary_offsets[region[v] + 1]++;
+        }
+        for (int r = 0; r < flags->num_regions; r++) {
+            boundary_offsets[r + 1] += boundary_offsets[r];
+        }
+        int* cursor = (int*)malloc((flags->num_regions > 0 ? flags->num_regions : 1) * sizeof(int));
+        ok = cursor != NULL;
+        if (ok) {
+            memcpy(cursor, boundary_offsets, flags->num_regions * sizeof(int));
+            for (int v = 0; v < n; v++) {
+                if (entry[v]) boundary[cursor[region[v]]++] = v;
+            }
+            free(cursor);
+        }
+    }
+
+    if (ok) {
+        BuildContext ctx = {
+            .flags = flags,
+            .weights = weights,
+            .rev_offsets = rev_offsets,
+            .rev_arcs = rev_arcs,
+            .arc_tails = arc_tails,
+            .boundary_offsets = boundary_offsets,
+            .boundary = boundary,
+        };
+        atomic_init(&ctx.next_region, 0);
+        atomic_init(&ctx.failed, false);
+        int threads = parallel_resolve_threads(num_threads);
+        if (threads > flags->num_regions) threads = flags->num_regions;
+        parallel_for(threads, (size_t)threads, build_worker, &ctx);
+        ok = !atomic_load(&ctx.failed);
+    }
+
+    partition_destroy(partition);
+    free(weights);
+    free(arc_tails);
+    free(rev_offsets);
+    free(rev_arcs);
+    free(boundary_offsets);
+    free(boundary);
+    free(entry);
+    if (!ok) {
+        fprintf(stderr, "Error: Memory allocation failed for arc flags\n");
+        arc_flags_destroy(flags);
+        return NULL;
+    }
+    return flags;
+}
+
+void arc_flags_destroy(ArcFlags* flags) {
+    if (!flags) return;
+    free(flags->region);
+    free(flags->arc_offsets);
+    free(flags->arc_heads);
+    free(flags->rows);
+    free(flags);
+}
+
+// ---------------------------------------------------------------------------
+// Queries
+// ---------------------------------------------------------------------------
+
+PathResult* arc_flags_find_path(const ArcFlags* flags, const Graph* graph, int start, int end) {
+    SearchWorkspace* workspace = search_workspace_create(flags ? flags->num_vertices : 0);
+    if (!workspace) {
+        PathResult* result = path_result_create();
+        if (result) result->status = SEARCH_OUT_OF_MEMORY;
+        return result;
+    }
+    PathResult* result = arc_flags_find_path_with_workspace(flags, graph, workspace, start, end);
+    if (result) {
+        result->stats.bytes_allocated = (size_t)workspace->capacity * (sizeof(double) + 5 * sizeof(int));
+    }
+    search_workspace_destroy(workspace);
+    return result;
+}
+
+PathResult* arc_flags_find_path_with_workspace(const ArcFlags* flags, const Graph* graph,
+                                               SearchWorkspace* workspace, int start, int end) {
+    PathResult* result = path_result_create();
+    if (!result) return NULL;
+
+    result->algorithm = "Arc Flags";
+    result->suboptimality_bound = 1.0;
+
+    if (!flags || !graph || !workspace || graph->num_vertices != flags->num_vertices ||
+        start < 0 || start >= flags->num_vertices || end < 0 || end >= flags->num_vertices) {
+        fprintf(stderr, "Error: Invalid start or end vertex\n");
+        return result;
+    }
+    if (graph->version != flags->version) {
+        fprintf(stderr, "Error: Arc flags are stale; the graph changed since they were built\n");
+        return result;
+    }
+
+    SearchStats* stats = &result->stats;
+    long long start_ns = graph_clock_ns();
+    if (!search_workspace_reserve(workspace, flags->num_vertices)) {
+        result->status = SEARCH_OUT_OF_MEMORY;
+        return result;
+    }
+    search_workspace_begin(workspace);
+
+    long long search_ns = graph_clock_ns();
+    stats->init_ns = search_ns - start_ns;
+    const uint64_t* row = flags->rows + (size_t)flags->region[end] * flags->words_per_row;
+    unsigned int generation = workspace->generation;
+    MinHeap* heap = workspace->heap;
+    workspace->dist[start] = 0.0;
+    workspace->parent[start] = -1;
+    workspace->seen[start] = generation;
+    bool found = false;
+    if (min_heap_push(heap, start, 0.0)) {
+        stats->heap_pushes++;
+    } else {
+        result->status = SEARCH_OUT_OF_MEMORY;
+    }
+
+    while (!min_heap_is_empty(heap) && result->status == SEARCH_COMPLETED) {
+        if (heap->size > stats->peak_queue_size) stats->peak_queue_size = heap->size;
+        int u = min_heap_pop(heap).vertex;
+        stats->heap_pops++;
+        if (workspace->closed[u] == generation) continue;
+        workspace->closed[u] = generation;
+        stats->vertices_settled++;
+        if (u == end) {
+            found = true;
+            break;
+        }
+
+        double d = workspace->dist[u];
+        int arc = flags->arc_offsets[u];
+        for (Edge* edge = graph->adj_list[u]; edge; edge = edge->next, arc++) {
+            if (!flag_set(row, arc)) continue;
+            int w = edge->dest;
+            stats->edges_relaxed++;
+            if (workspace->closed[w] == generation) continue;
+            double candidate = d + edge->weight;
+            if (workspace->seen[w] != generation || candidate < workspace->dist[w]) {
+                workspace->seen[w] = generation;
+                workspace->dist[w] = candidate;
+                workspace->parent[w] = u;
+                if (!min_heap_push(heap, w, candidate)) {
+                    result->status = SEARCH_OUT_OF_MEMORY;  // A lost entry could hide the path
+                    break;
+                }
+                stats->heap_pushes++;
+            }
+        }
+    }
+
+    long long reconstruct_ns = graph_clock_ns();
+    stats->search_ns = reconstruct_ns - search_ns;
+
+    if (found) {
+        int count = 0;
+        for (int v = end; v != -1; v = workspace->parent[v]) count++;
+        result->path = (int*)malloc(count * sizeof(int));
+        if (result->path) {
+            int index = count;
+            for (int v = end; v != -1; v = workspace->parent[v]) result->path[--index] = v;
+            result->path_length = count;
+            result->total_weight = workspace->dist[end];
+            result->found = true;
+        } else {
+            result->status = SEARCH_OUT_OF_MEMORY;
+        }
+    }
+
+    long long end_ns = graph_clock_ns();
+    stats->reconstruct_ns = end_ns - reconstruct_ns;
+    result->time_ms = (end_ns - start_ns) / 1e6;
+    return result;
+}
+
+int arc_flags_num_regions(const ArcFlags* flags) {
+    return flags ? flags->num_regions : 0;
+}
+
+int arc_flags_region(const ArcFlags* flags, int vertex) {
+    if (!flags || vertex < 0 || vertex >= flags->num_vertices) return -1;
+    return flags->region[vertex];
+}
+
+double arc_flags_density(const ArcFlags* flags) {
+    if (!flags || flags->num_arcs == 0) return 0.0;
+    size_t words = flags->words_per_row * flags->num_regions;
+    long long set = 0;
+    for (size_t i = 0; i < words; i++) {
+        for (uint64_t word = flags->rows[i]; word; word &= word - 1) set++;
+    }
+    return (double)set / ((double)flags->num_arcs * flags->num_regions);
+}
+
+// ---------------------------------------------------------------------------
+// Serialization
+// ---------------------------------------------------------------------------
+
+bool arc_flags_save(const ArcFlags* flags, const char* path) {
+    if (!flags || !path) return false;
+
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        fprintf(stderr, "Error: Cannot open %s for writing\n", path);
+        return false;
+    }
+    ArcFlagsHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, ARC_FLAGS_MAGIC, sizeof(header.magic));
+    header.format_version = ARC_FLAGS_FORMAT_VERSION;
+    header.num_regions = (uint32_t)flags->num_regions;
+    header.num_vertices = flags->num_vertices;
+    header.num_arcs = flags->num_arcs;
+    header.weight_hash = flags->weight_hash;
+
+    size_t words = flags->words_per_row * flags->num_regions;
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+              fwrite(flags->region, sizeof(int32_t), flags->num_vertices, file) ==
+                  (size_t)flags->num_vertices &&
+              fwrite(flags->arc_heads, sizeof(int32_t), flags->num_arcs, file) ==
+                  (size_t)flags->num_arcs &&
+              fwrite(flags->rows, sizeof(uint64_t), words, file) == words;
+    ok = (fclose(file) == 0) && ok;
+    if (!ok) {
+        fprintf(stderr, "Error: Failed to write arc flags to %s\n", path);
+    }
+    return ok;
+}
+
+ArcFlags* arc_flags_load(const char* path, const Graph* graph) {
+    if (!path || !graph) return NULL;
+
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        fprintf(stderr, "Error: Cannot open arc flag file %s\n", path);
+        return NULL;
+    }
+    ArcFlagsHeader header;
+    bool valid = fread(&header, sizeof(header), 1, file) == 1 &&
+                 memcmp(header.magic, ARC_FLAGS_MAGIC, sizeof(header.magic)) == 0 &&
+                 header.format_version == ARC_FLAGS_FORMAT_VERSION && header.num_regions > 0;
+    if (!valid) {
+        fclose(file);
+        fprintf(stderr, "Error: %s is not an arc flag file\n", path);
+        return NULL;
+    }
+    int num_arcs = count_arcs(graph);
+    if (header.num_vertices != graph->num_vertices || header.num_arcs != num_arcs ||
+        header.num_regions > (uint32_t)graph->num_vertices) {
+        fclose(file);
+        fprintf(stderr, "Error: Arc flags in %s belong to a different graph\n", path);
+        return NULL;
+    }
+
+    int n = graph->num_vertices;
+    ArcFlags* flags = arc_flags_alloc(n, num_arcs, (int)header.num_regions);
+    if (!flags) {
+        fclose(file);
+        fprintf(stderr, "Error: Memory allocation failed for arc flags\n");
+        return NULL;
+    }
+    size_t words = flags->words_per_row * flags->num_regions;
+    bool read_ok = fread(flags->region, sizeof(int32_t), n, file) == (size_t)n &&
+                   fread(flags->arc_heads, sizeof(int32_t), num_arcs, file) == (size_t)num_arcs &&
+                   fread(flags->rows, sizeof(uint64_t), words, file) == words;
+    fclose(file);
+
+    // Regions must be in range and the arcs must match the graph one for one
+    bool same_graph = read_ok && header.weight_hash == weight_hash(graph);
+    for (int v = 0; v < n && same_graph; v++) {
+        same_graph = flags->region[v] >= 0 && flags->region[v] < flags->num_regions;
+    }
+    int arc = 0;
+    for (int u = 0; u < n && same_graph; u++) {
+        flags->arc_offsets[u] = arc;
+        for (Edge* edge = graph->adj_list[u]; edge; edge = edge->next, arc++) {
+            if (flags->arc_heads[arc] != edge->dest) {
+                same_graph = false;
+                break;
+            }
+        }
+    }
+    flags->arc_offsets[n] = arc;
+    if (!same_graph) {
+        fprintf(stderr, "Error: Arc flags in %s belong to a different graph\n", path);
+        arc_flags_destroy(flags);
+        return NULL;
+    }
+    flags->weight_hash = header.weight_hash;
+    flags->version = graph->version;
+    return flags;
+}
+
+size_t arc_flags_memory_usage(const ArcFlags* flags) {
+    if (!flags) return 0;
+    return sizeof(ArcFlags) +
+           (size_t)flags->num_vertices * sizeof(int32_t) +
+           ((size_t)flags->num_vertices + 1) * sizeof(int) +
+           (size_t)flags->num_arcs * sizeof(int32_t) +
+           flags->words_per_row * flags->num_regions * sizeof(uint64_t);
+}
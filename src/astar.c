@@ -1,246 +1,335 @@
 #include "astar.h"
+#include "min_heap.h"
+#include "graph_view.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <limits.h>
 #include <float.h>
-#include <time.h>
 
-// Priority queue node for A*
-typedef struct AStarNode {
-    int vertex;
-    double g_score;  // Cost from start to current vertex
-    double f_score;  // g_score + heuristic (estimated total cost)
-} AStarNode;
-
-// Priority queue for A* (min-heap based on f_score)
+// Graph heuristic seen through the view kernel's callback type
 typedef struct {
-    AStarNode* nodes;
-    int size;
-    int capacity;
-} AStarPQ;
-
-static AStarPQ* astar_pq_create(int capacity) {
-    AStarPQ* pq = (AStarPQ*)malloc(sizeof(AStarPQ));
-    if (!pq) return NULL;
-
-    pq->nodes = (AStarNode*)malloc(capacity * sizeof(AStarNode));
-    if (!pq->nodes) {
-        free(pq);
-        return NULL;
-    }
+    const Graph* graph;
+    HeuristicFunc heuristic;
+} GraphHeuristic;
 
-    pq->size = 0;
-    pq->capacity = capacity;
-    return pq;
+static double graph_heuristic(const void* data, int from, int to) {
+    const GraphHeuristic* adapter = (const GraphHeuristic*)data;
+    return adapter->heuristic(adapter->graph, from, to);
 }
 
-static void astar_pq_destroy(AStarPQ* pq) {
-    if (!pq) return;
-    free(pq->nodes);
-    free(pq);
+// Zero heuristic (always returns 0)
+static double zero_heuristic(const Graph* graph, int v1, int v2) {
+    (void)graph;  // Unused
+    (void)v1;     // Unused
+    (void)v2;     // Unused
+    return 0.0;
 }
 
-static void astar_pq_swap(AStarNode* a, AStarNode* b) {
-    AStarNode temp = *a;
-    *a = *b;
-    *b = temp;
-}
+// A* ordered by f = g + heuristic_weight * h. Closed vertices are never reopened, so with
+// a consistent heuristic the path costs at most heuristic_weight times the optimum;
+// the bound is only reported for heuristics known to be admissible.
+static PathResult* astar_search(const Graph* graph, int start, int end, HeuristicFunc heuristic,
+                                double heuristic_weight, bool admissible,
+                                const char* algorithm_name, const SearchLimits* limits) {
+    PathResult* result = path_result_create();
+    if (!result) return NULL;
 
-static void astar_pq_heapify_up(AStarPQ* pq, int index) {
-    while (index > 0) {
-        int parent = (index - 1) / 2;
-        if (pq->nodes[index].f_score >= pq->nodes[parent].f_score) {
-            break;
-        }
-        astar_pq_swap(&pq->nodes[index], &pq->nodes[parent]);
-        index = parent;
-    }
-}
+    result->algorithm = algorithm_name;
+    result->suboptimality_bound = admissible ? heuristic_weight : 0.0;
 
-static void astar_pq_heapify_down(AStarPQ* pq, int index) {
-    while (true) {
-        int smallest = index;
-        int left = 2 * index + 1;
-        int right = 2 * index + 2;
+    if (!graph_is_valid_vertex(graph, start) || !graph_is_valid_vertex(graph, end)) {
+        fprintf(stderr, "Error: Invalid start or end vertex\n");
+        return result;
+    }
+    if (graph_path_ruled_out(graph, start, end)) {
+        return result;  // Proven unreachable by the graph's index
+    }
 
-        if (left < pq->size && pq->nodes[left].f_score < pq->nodes[smallest].f_score) {
-            smallest = left;
-        }
-        if (right < pq->size && pq->nodes[right].f_score < pq->nodes[smallest].f_score) {
-            smallest = right;
-        }
+    GraphHeuristic adapter = {graph, heuristic};
+    GraphView view = graph_view_from_graph(graph);
+    GraphViewSearchOptions options;
+    graph_view_search_options_init(&options);
+    options.heuristic = graph_heuristic;
+    options.heuristic_data = &adapter;
+    options.heuristic_weight = heuristic_weight;
+    options.limits = limits;
+    graph_view_best_first(&view, start, end, &options, result);
+    return result;
+}
 
-        if (smallest == index) {
-            break;
-        }
+// A* algorithm implementation with custom heuristic
+PathResult* astar_find_path(const Graph* graph, int start, int end,
+                           HeuristicFunc heuristic, const char* algorithm_name) {
+    return astar_search(graph, start, end, heuristic, 1.0, heuristic == zero_heuristic,
+                        algorithm_name, NULL);
+}
 
-        astar_pq_swap(&pq->nodes[index], &pq->nodes[smallest]);
-        index = smallest;
-    }
+PathResult* astar_find_path_limited(const Graph* graph, int start, int end,
+                                    HeuristicFunc heuristic, const char* algorithm_name,
+                                    const SearchLimits* limits) {
+    return astar_search(graph, start, end, heuristic, 1.0, heuristic == zero_heuristic,
+                        algorithm_name, limits);
 }
 
-static void astar_pq_push(AStarPQ* pq, int vertex, double g_score, double f_score) {
-    // Check if PQ needs to grow
-    if (pq->size >= pq->capacity) {
-        int new_capacity = pq->capacity * 2;
-        AStarNode* new_nodes = (AStarNode*)realloc(pq->nodes, new_capacity * sizeof(AStarNode));
-        if (new_nodes) {
-            pq->nodes = new_nodes;
-            pq->capacity = new_capacity;
-        } else {
-            fprintf(stderr, "Warning: Failed to grow A* priority queue\n");
-            return;  // Skip this push if we can't grow
-        }
+// Weighted A*
+PathResult* astar_weighted(const Graph* graph, int start, int end,
+                           HeuristicFunc heuristic, double weight, bool admissible) {
+    if (weight < 1.0) {
+        fprintf(stderr, "Error: Heuristic weight must be at least 1\n");
+        PathResult* result = path_result_create();
+        if (result) result->algorithm = "Weighted A*";
+        return result;
     }
+    return astar_search(graph, start, end, heuristic, weight, admissible, "Weighted A*", NULL);
+}
 
-    pq->nodes[pq->size].vertex = vertex;
-    pq->nodes[pq->size].g_score = g_score;
-    pq->nodes[pq->size].f_score = f_score;
-    astar_pq_heapify_up(pq, pq->size);
-    pq->size++;
+void anytime_astar_options_init(AnytimeAStarOptions* options) {
+    if (!options) return;
+    options->initial_weight = 3.0;
+    options->weight_step = 0.5;
+    options->time_budget_ms = 0.0;
+    options->admissible = false;
+    options->on_solution = NULL;
+    options->context = NULL;
 }
 
-static AStarNode astar_pq_pop(AStarPQ* pq) {
-    AStarNode min = pq->nodes[0];
-    pq->nodes[0] = pq->nodes[--pq->size];
-    astar_pq_heapify_down(pq, 0);
-    return min;
+// ARA* search state; vertices are OPEN, CLOSED or INCONS (closed but improved)
+typedef struct {
+    const Graph* graph;
+    int end;
+    HeuristicFunc heuristic;
+    double weight;
+    double* g_score;
+    double* h_score;       // Cached heuristic, negative until computed
+    int* parent;
+    bool* in_open;
+    bool* closed;
+    bool* incons;
+    MinHeap* open_set;     // Keyed by f = g + weight * h
+    bool failed;           // A push could not grow the heap
+    SearchStats* stats;
+} AnytimeSearch;
+
+static double anytime_h(AnytimeSearch* search, int v) {
+    if (search->h_score[v] < 0.0) {
+        search->h_score[v] = search->heuristic(search->graph, v, search->end);
+    }
+    return search->h_score[v];
 }
 
-static bool astar_pq_is_empty(const AStarPQ* pq) {
-    return pq->size == 0;
+static double anytime_f(AnytimeSearch* search, int v) {
+    return search->g_score[v] + search->weight * anytime_h(search, v);
 }
 
-// Reconstruct path from parent array
-static int* reconstruct_path(int* parent, int start, int end, int* path_length) {
-    if (parent[end] == -1 && start != end) {
-        *path_length = 0;
-        return NULL;
+static void anytime_push(AnytimeSearch* search, int v) {
+    search->in_open[v] = true;
+    if (!min_heap_push(search->open_set, v, anytime_f(search, v))) {
+        search->failed = true;
+        return;
+    }
+    search->stats->heap_pushes++;
+    if (search->open_set->size > search->stats->peak_queue_size) {
+        search->stats->peak_queue_size = search->open_set->size;
     }
+}
 
-    // Count path length
-    int count = 0;
-    for (int v = end; v != -1; v = parent[v]) {
-        count++;
+// Drop entries whose vertex was expanded or improved since they were pushed
+// (the heap is rebuilt whenever the weight changes, so f identifies the push)
+static bool anytime_top(AnytimeSearch* search, HeapNode* top) {
+    while (!min_heap_is_empty(search->open_set)) {
+        HeapNode node = search->open_set->nodes[0];
+        if (search->in_open[node.vertex] && node.key == anytime_f(search, node.vertex)) {
+            *top = node;
+            return true;
+        }
+        min_heap_pop(search->open_set);
+        search->stats->heap_pops++;
     }
+    return false;
+}
+
+// Expand until no OPEN vertex can improve the goal under the current weight.
+// Returns false when the deadline passes first or the heap cannot grow.
+static bool anytime_improve_path(AnytimeSearch* search, long long deadline_ns) {
+    const Graph* graph = search->graph;
+    HeapNode top;
+
+    while (anytime_top(search, &top)) {
+        if (search->failed) return false;
+        double goal_f = search->g_score[search->end];
+        if (goal_f != DBL_MAX && top.key >= goal_f) break;
+        if (deadline_ns > 0 && (search->stats->vertices_settled & 255) == 0 &&
+            graph_clock_ns() > deadline_ns) {
+            return false;
+        }
 
-    int* path = (int*)malloc(count * sizeof(int));
-    if (!path) return NULL;
+        min_heap_pop(search->open_set);
+        search->stats->heap_pops++;
+        int u = top.vertex;
+        search->in_open[u] = false;
+        search->closed[u] = true;
+        search->stats->vertices_settled++;
 
-    // Fill path in reverse
-    int index = count - 1;
-    for (int v = end; v != -1; v = parent[v]) {
-        path[index--] = v;
+        for (Edge* edge = graph->adj_list[u]; edge; edge = edge->next) {
+            int v = edge->dest;
+            search->stats->edges_relaxed++;
+            double tentative = search->g_score[u] + edge->weight;
+            if (tentative >= search->g_score[v]) continue;
+
+            search->g_score[v] = tentative;
+            search->parent[v] = u;
+            if (search->closed[v]) {
+                search->incons[v] = true;
+            } else {
+                anytime_push(search, v);
+            }
+        }
     }
+    return !search->failed;
+}
 
-    *path_length = count;
-    return path;
+// Proven bound for the current goal cost: g(goal) / min over OPEN and INCONS of g + h
+static double anytime_bound(AnytimeSearch* search) {
+    double lower = search->g_score[search->end];
+    for (int v = 0; v < search->graph->num_vertices; v++) {
+        if (!search->in_open[v] && !search->incons[v]) continue;
+        double f = search->g_score[v] + anytime_h(search, v);
+        if (f < lower) lower = f;
+    }
+    double goal = search->g_score[search->end];
+    if (lower <= 0.0) return goal <= 0.0 ? 1.0 : search->weight;
+    double bound = goal / lower;
+    if (bound < 1.0) bound = 1.0;
+    return bound < search->weight ? bound : search->weight;
 }
 
-// A* algorithm implementation with custom heuristic
-PathResult* astar_find_path(const Graph* graph, int start, int end,
-                           HeuristicFunc heuristic, const char* algorithm_name) {
+// Anytime Repairing A* (Likhachev et al.)
+PathResult* astar_anytime(const Graph* graph, int start, int end, HeuristicFunc heuristic,
+                          const AnytimeAStarOptions* options) {
     PathResult* result = path_result_create();
     if (!result) return NULL;
 
-    result->algorithm = algorithm_name;
+    result->algorithm = "ARA* (Anytime A*)";
+
+    AnytimeAStarOptions defaults;
+    anytime_astar_options_init(&defaults);
+    if (!options) options = &defaults;
 
     if (!graph_is_valid_vertex(graph, start) || !graph_is_valid_vertex(graph, end)) {
         fprintf(stderr, "Error: Invalid start or end vertex\n");
         return result;
     }
+    if (options->initial_weight < 1.0 || options->weight_step <= 0.0) {
+        fprintf(stderr, "Error: ARA* needs an initial weight >= 1 and a positive weight step\n");
+        return result;
+    }
+    if (graph_path_ruled_out(graph, start, end)) {
+        return result;  // Proven unreachable by the graph's index
+    }
 
-    clock_t start_time = clock();
+    SearchStats* stats = &result->stats;
+    long long start_ns = graph_clock_ns();
+    long long deadline_ns = options->time_budget_ms > 0.0
+                                ? start_ns + (long long)(options->time_budget_ms * 1e6) : 0;
 
     int n = graph->num_vertices;
-    double* g_score = (double*)malloc(n * sizeof(double));
-    double* f_score = (double*)malloc(n * sizeof(double));
-    int* parent = (int*)malloc(n * sizeof(int));
-    bool* in_closed_set = (bool*)calloc(n, sizeof(bool));
-    // Start with reasonable initial capacity, will grow dynamically if needed
-    AStarPQ* open_set = astar_pq_create(n > 1000 ? n : 1000);
-
-    if (!g_score || !f_score || !parent || !in_closed_set || !open_set) {
-        free(g_score);
-        free(f_score);
-        free(parent);
-        free(in_closed_set);
-        astar_pq_destroy(open_set);
+    AnytimeSearch search;
+    search.graph = graph;
+    search.end = end;
+    search.heuristic = heuristic;
+    search.weight = options->initial_weight;
+    search.g_score = (double*)malloc(n * sizeof(double));
+    search.h_score = (double*)malloc(n * sizeof(double));
+    search.parent = (int*)malloc(n * sizeof(int));
+    search.in_open = (bool*)calloc(n, sizeof(bool));
+    search.closed = (bool*)calloc(n, sizeof(bool));
+    search.incons = (bool*)calloc(n, sizeof(bool));
+    search.open_set = min_heap_create(n > 1000 ? n : 1000);
+    search.failed = false;
+    search.stats = stats;
+
+    if (!search.g_score || !search.h_score || !search.parent || !search.in_open ||
+        !search.closed || !search.incons || !search.open_set) {
+        fprintf(stderr, "Error: Memory allocation failed for ARA*\n");
+        free(search.g_score);
+        free(search.h_score);
+        free(search.parent);
+        free(search.in_open);
+        free(search.closed);
+        free(search.incons);
+        min_heap_destroy(search.open_set);
+        result->status = SEARCH_OUT_OF_MEMORY;
         return result;
     }
 
-    // Initialize scores
     for (int i = 0; i < n; i++) {
-        g_score[i] = DBL_MAX;
-        f_score[i] = DBL_MAX;
-        parent[i] = -1;
+        search.g_score[i] = DBL_MAX;
+        search.h_score[i] = -1.0;
+        search.parent[i] = -1;
     }
-
-    g_score[start] = 0.0;
-    f_score[start] = heuristic(graph, start, end);
-    astar_pq_push(open_set, start, g_score[start], f_score[start]);
-
-    // A* main loop
-    while (!astar_pq_is_empty(open_set)) {
-        AStarNode current = astar_pq_pop(open_set);
-        int u = current.vertex;
-
-        if (in_closed_set[u]) continue;
-        in_closed_set[u] = true;
-
-        // Found the goal
-        if (u == end) break;
-
-        // Explore neighbors
-        Edge* edge = graph->adj_list[u];
-        while (edge) {
-            int v = edge->dest;
-            double weight = edge->weight;
-
-            if (in_closed_set[v]) {
-                edge = edge->next;
-                continue;
-            }
-
-            double tentative_g_score = g_score[u] + weight;
-
-            if (tentative_g_score < g_score[v]) {
-                parent[v] = u;
-                g_score[v] = tentative_g_score;
-                f_score[v] = g_score[v] + heuristic(graph, v, end);
-                astar_pq_push(open_set, v, g_score[v], f_score[v]);
+    search.g_score[start] = 0.0;
+    anytime_push(&search, start);
+
+    long long search_ns = graph_clock_ns();
+    stats->init_ns = search_ns - start_ns;
+
+    // The budget covers the first search as well as the refinements
+    bool completed = anytime_improve_path(&search, deadline_ns);
+    while (completed && search.g_score[end] != DBL_MAX) {
+        // The proven bound assumes h never overestimates
+        double bound = options->admissible ? anytime_bound(&search) : 0.0;
+        int* path = path_reconstruct(search.parent, start, end, &result->path_length);
+        if (!path) {
+            search.failed = true;
+            break;
+        }
+        free(result->path);
+        result->path = path;
+        result->found = true;
+        result->total_weight = search.g_score[end];
+        result->suboptimality_bound = bound;
+        if (options->on_solution) options->on_solution(result, options->context);
+
+        if ((options->admissible && bound <= 1.0) || search.weight <= 1.0) break;
+        if (deadline_ns > 0 && graph_clock_ns() > deadline_ns) break;
+
+        // Lower the weight and restart from OPEN plus the inconsistent vertices
+        search.weight -= options->weight_step;
+        if (search.weight < 1.0) search.weight = 1.0;
+        min_heap_clear(search.open_set);
+        for (int v = 0; v < n; v++) {
+            if (search.in_open[v] || search.incons[v]) {
+                search.incons[v] = false;
+                anytime_push(&search, v);
             }
-
-            edge = edge->next;
+            search.closed[v] = false;
         }
+        completed = anytime_improve_path(&search, deadline_ns);
+    }
+    if (search.failed) {
+        result->status = SEARCH_OUT_OF_MEMORY;
+    } else if (!completed && !result->found) {
+        result->status = SEARCH_TIMED_OUT;
     }
 
-    // Reconstruct path
-    result->path = reconstruct_path(parent, start, end, &result->path_length);
-    result->found = (result->path != NULL);
-    result->total_weight = (result->found) ? g_score[end] : 0.0;
-
-    clock_t end_time = clock();
-    result->time_ms = ((double)(end_time - start_time) / CLOCKS_PER_SEC) * 1000.0;
+    long long end_ns = graph_clock_ns();
+    stats->search_ns = end_ns - search_ns;
+    stats->bytes_allocated = n * (2 * sizeof(double) + sizeof(int) + 3 * sizeof(bool)) +
+                             sizeof(MinHeap) + search.open_set->capacity * sizeof(HeapNode);
+    result->time_ms = (end_ns - start_ns) / 1e6;
 
-    free(g_score);
-    free(f_score);
-    free(parent);
-    free(in_closed_set);
-    astar_pq_destroy(open_set);
+    free(search.g_score);
+    free(search.h_score);
+    free(search.parent);
+    free(search.in_open);
+    free(search.closed);
+    free(search.incons);
+    min_heap_destroy(search.open_set);
 
     return result;
 }
 
-// Zero heuristic (always returns 0)
-static double zero_heuristic(const Graph* graph, int v1, int v2) {
-    (void)graph;  // Unused
-    (void)v1;     // Unused
-    (void)v2;     // Unused
-    return 0.0;
-}
-
 // A* with Euclidean distance heuristic
 PathResult* astar_euclidean(const Graph* graph, int start, int end) {
     if (!graph_has_coordinates(graph)) {
@@ -256,6 +345,8 @@ PathResult* astar_manhattan(const Graph* graph, int start, int end) {
         fprintf(stderr, "Warning: Graph has no coordinates, using zero heuristic\n");
         return astar_find_path(graph, start, end, zero_heuristic, "A* (Manhattan-fallback)");
     }
+    // Manhattan distance overestimates diagonal and Euclidean-length edges, so
+    // the path carries no optimality guarantee
     return astar_find_path(graph, start, end, graph_manhattan_distance, "A* (Manhattan)");
 }
 
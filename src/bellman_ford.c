@@ -4,7 +4,6 @@
 #include <string.h>
 #include <limits.h>
 #include <float.h>
-#include <time.h>
 
 // Edge list structure for Bellman-Ford
 typedef struct EdgeList {
@@ -13,45 +12,25 @@ typedef struct EdgeList {
     double weight;
 } EdgeList;
 
-// Reconstruct path from parent array
-static int* reconstruct_path(int* parent, int start, int end, int* path_length) {
-    if (parent[end] == -1 && start != end) {
-        *path_length = 0;
-        return NULL;
-    }
-
-    // Count path length
-    int count = 0;
-    for (int v = end; v != -1; v = parent[v]) {
-        count++;
-    }
-
-    int* path = (int*)malloc(count * sizeof(int));
-    if (!path) return NULL;
-
-    // Fill path in reverse
-    int index = count - 1;
-    for (int v = end; v != -1; v = parent[v]) {
-        path[index--] = v;
-    }
-
-    *path_length = count;
-    return path;
-}
-
 // Bellman-Ford algorithm implementation
-PathResult* bellman_ford_find_path(const Graph* graph, int start, int end) {
+PathResult* bellman_ford_find_path_limited(const Graph* graph, int start, int end,
+                                           const SearchLimits* limits) {
     PathResult* result = path_result_create();
     if (!result) return NULL;
 
     result->algorithm = "Bellman-Ford";
+    result->suboptimality_bound = 1.0;
 
     if (!graph_is_valid_vertex(graph, start) || !graph_is_valid_vertex(graph, end)) {
         fprintf(stderr, "Error: Invalid start or end vertex\n");
         return result;
     }
+    if (graph_path_ruled_out(graph, start, end)) {
+        return result;  // Proven unreachable by the graph's index
+    }
 
-    clock_t start_time = clock();
+    SearchStats* stats = &result->stats;
+    long long start_ns = graph_clock_ns();
 
     int n = graph->num_vertices;
 
@@ -100,10 +79,17 @@ PathResult* bellman_ford_find_path(const Graph* graph, int start, int end) {
     }
     dist[start] = 0.0;
 
-    // Relax edges (n-1) times
-    for (int i = 0; i < n - 1; i++) {
+    long long search_ns = graph_clock_ns();
+    stats->init_ns = search_ns - start_ns;
+
+    // Relax edges (n-1) times; a round can be long, so limits are checked inside it
+    for (int i = 0; i < n - 1 && result->status == SEARCH_COMPLETED; i++) {
         bool updated = false;
         for (int j = 0; j < edge_count; j++) {
+            if ((j & (SEARCH_LIMITS_CHECK_INTERVAL - 1)) == 0 &&
+                (result->status = search_limits_check(limits)) != SEARCH_COMPLETED) {
+                break;
+            }
             int u = edges[j].src;
             int v = edges[j].dest;
             double weight = edges[j].weight;
@@ -114,14 +100,25 @@ PathResult* bellman_ford_find_path(const Graph* graph, int start, int end) {
                 updated = true;
             }
         }
+        stats->edges_relaxed += edge_count;  // Approximate for an interrupted round
         // Early termination if no updates
         if (!updated) break;
     }
 
-    // Reconstruct the path first
-    result->path = reconstruct_path(parent, start, end, &result->path_length);
-    result->found = (result->path != NULL);
-    result->total_weight = (result->found) ? dist[end] : 0.0;
+    // Bellman-Ford has no frontier; count the vertices it reached
+    for (int i = 0; i < n; i++) {
+        if (dist[i] != DBL_MAX) stats->vertices_settled++;
+    }
+
+    long long reconstruct_ns = graph_clock_ns();
+    stats->search_ns = reconstruct_ns - search_ns;
+
+    // Reconstruct the path first (not for an interrupted search)
+    if (result->status == SEARCH_COMPLETED) {
+        result->path = path_reconstruct(parent, start, end, &result->path_length);
+        result->found = (result->path != NULL);
+        result->total_weight = (result->found) ? dist[end] : 0.0;
+    }
 
     // Check if there's a negative cycle that affects the shortest path
     // We only care about negative cycles that can improve the distance to vertices on our path
@@ -157,8 +154,10 @@ PathResult* bellman_ford_find_path(const Graph* graph, int start, int end) {
         }
     }
 
-    clock_t end_time = clock();
-    result->time_ms = ((double)(end_time - start_time) / CLOCKS_PER_SEC) * 1000.0;
+    long long end_ns = graph_clock_ns();
+    stats->reconstruct_ns = end_ns - reconstruct_ns;
+    stats->bytes_allocated = edge_count * sizeof(EdgeList) + n * (sizeof(double) + sizeof(int));
+    result->time_ms = (end_ns - start_ns) / 1e6;
 
     free(edges);
     free(dist);
@@ -166,3 +165,7 @@ PathResult* bellman_ford_find_path(const Graph* graph, int start, int end) {
 
     return result;
 }
+
+PathResult* bellman_ford_find_path(const Graph* graph, int start, int end) {
+    return bellman_ford_find_path_limited(graph, start, end, NULL);
+}
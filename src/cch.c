@@ -0,0 +1,852 @@
+#include "cch.h"
+#include "parallel.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+
+// Cells this small are ordered as they are instead of being dissected further
+#define CCH_LEAF_SIZE 16
+
+// Elimination tree levels with fewer vertices are customized on one thread
+#define CCH_PARALLEL_LEVEL 256
+
+struct CchIndex {
+    int num_vertices;
+    int* rank;                   // Vertex -> contraction rank
+    int* order;                  // Rank -> vertex
+
+    // Chordal supergraph in rank space: arcs (v, w) with v < w, sorted by w
+    int* up_offsets;             // n + 1
+    int* up_heads;
+    int num_arcs;
+
+    // The same arcs seen from the higher end: lower vertex and arc id
+    int* down_offsets;           // n + 1
+    int* down_tails;
+    int* down_arcs;
+
+    // Vertices grouped by height in the elimination tree
+    int* level_offsets;          // num_levels + 1
+    int* level_vertices;
+    int num_levels;
+
+    // Graph arcs in adjacency order -> 2 * arc + (0: upward, 1: downward); -1 for self-loops
+    int* input_arcs;
+    int num_input_arcs;
+
+    // Metric
+    double* up_weight;           // Lower -> higher endpoint
+    double* down_weight;         // Higher -> lower endpoint
+    int* up_mid;                 // Lower triangle vertex behind the weight (-1: original arc)
+    int* down_mid;
+    bool customized;
+};
+
+// Growable int array
+typedef struct {
+    int* items;
+    int size;
+    int capacity;
+} IntVector;
+
+static bool int_vector_push(IntVector* vector, int value) {
+    if (vector->size == vector->capacity) {
+        int capacity = vector->capacity ? vector->capacity * 2 : 4;
+        int* items = (int*)realloc(vector->items, capacity * sizeof(int));
+        if (!items) return false;
+        vector->items = items;
+        vector->capacity = capacity;
+    }
+    vector->items[vector->size++] = value;
+    return true;
+}
+
+static int compare_ints(const void* a, const void* b) {
+    int x = *(const int*)a;
+    int y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+// ---------------------------------------------------------------------------
+// Nested dissection order
+// ---------------------------------------------------------------------------
+
+// Symmetric adjacency without self-loops
+typedef struct {
+    int* offsets;                // n + 1
+    int* adj;
+} Neighbors;
+
+static bool neighbors_build(const Graph* graph, Neighbors* neighbors) {
+    int n = graph->num_vertices;
+    neighbors->adj = NULL;
+    neighbors->offsets = (int*)calloc(n + 1, sizeof(int));
+    if (!neighbors->offsets) return false;
+    for (int u = 0; u < n; u++) {
+        for (Edge* edge = graph->adj_list[u]; edge; edge = edge->next) {
+            if (edge->dest == u) continue;
+            neighbors->offsets[u + 1]++;
+            neighbors->offsets[edge->dest + 1]++;
+        }
+    }
+    for (int v = 0; v < n; v++) {
+        neighbors->offsets[v + 1] += neighbors->offsets[v];
+    }
+
+    int total = neighbors->offsets[n];
+    neighbors->adj = (int*)malloc((total > 0 ? total : 1) * sizeof(int));
+    int* fill = (int*)malloc(n * sizeof(int));
+    if (!neighbors->adj || !fill) {
+        free(fill);
+        return false;
+    }
+    memcpy(fill, neighbors->offsets, n * sizeof(int));
+    for (int u = 0; u < n; u++) {
+        for (Edge* edge = graph->adj_list[u]; edge; edge = edge->next) {
+            if (edge->dest == u) continue;
+            neighbors->adj[fill[u]++] = edge->dest;
+            neighbors->adj[fill[edge->dest]++] = u;
+        }
+    }
+    free(fill);
+    return true;
+}
+
+typedef struct {
+    const Neighbors* neighbors;
+    int* mark;                   // Cell id of each vertex
+    int* level;                  // BFS level, -1 when not reached
+    int* queue;
+    int* scratch;
+    int* level_count;
+    int* rank;
+    int next_mark;
+} Dissection;
+
+// BFS inside cell m; the reached vertices are queue[0..return value)
+static int cell_bfs(Dissection* d, int source, int m) {
+    const Neighbors* neighbors = d->neighbors;
+    int head = 0;
+    int tail = 0;
+    d->queue[tail++] = source;
+    d->level[source] = 0;
+    while (head < tail) {
+        int u = d->queue[head++];
+        for (int i = neighbors->offsets[u]; i < neighbors->offsets[u + 1]; i++) {
+            int w = neighbors->adj[i];
+            if (d->mark[w] == m && d->level[w] < 0) {
+                d->level[w] = d->level[u] + 1;
+                d->queue[tail++] = w;
+            }
+        }
+    }
+    return tail;
+}
+
+static void clear_levels(Dissection* d, const int* vertices, int count) {
+    for (int i = 0; i < count; i++) {
+        d->level[vertices[i]] = -1;
+    }
+}
+
+// Which side of the separator level a vertex goes to: 0 before it, 1 after
+// it, 2 separator. Separator-level vertices without a neighbour after it do
+// not separate anything and join the first side.
+static int dissection_side(const Dissection* d, int v, int m, int separator_level) {
+    if (d->level[v] < separator_level) return 0;
+    if (d->level[v] > separator_level) return 1;
+    const Neighbors* neighbors = d->neighbors;
+    for (int i = neighbors->offsets[v]; i < neighbors->offsets[v + 1]; i++) {
+        int w = neighbors->adj[i];
+        if (d->mark[w] == m && d->level[w] > separator_level) return 2;
+    }
+    return 0;
+}
+
+static bool dissect(Dissection* d, int* vertices, int count, int first_rank);
+
+// Order each connected component of a cell on its own
+static bool dissect_components(Dissection* d, int* vertices, int count, int first_rank, int m) {
+    int* starts = (int*)malloc((count + 1) * sizeof(int));
+    if (!starts) return false;
+
+    int filled = 0;
+    int components = 0;
+    for (int i = 0; i < count; i++) {
+        if (d->level[vertices[i]] >= 0) continue;
+        int reached = cell_bfs(d, vertices[i], m);
+        starts[components++] = filled;
+        memcpy(d->scratch + filled, d->queue, reached * sizeof(int));
+        filled += reached;
+    }
+    starts[components] = filled;
+    clear_levels(d, vertices, count);
+    memcpy(vertices, d->scratch, count * sizeof(int));
+
+    bool ok = true;
+    for (int c = 0; c < components && ok; c++) {
+        ok = dissect(d, vertices + starts[c], starts[c + 1] - starts[c], first_rank + starts[c]);
+    }
+    free(starts);
+    return ok;
+}
+
+// Give the vertices of a cell the ranks [first_rank, first_rank + count):
+// both halves of a BFS level separator recursively, the separator last
+static bool dissect(Dissection* d, int* vertices, int count, int first_rank) {
+    if (count <= CCH_LEAF_SIZE) {
+        for (int i = 0; i < count; i++) {
+            d->rank[vertices[i]] = first_rank + i;
+        }
+        return true;
+    }
+
+    int m = d->next_mark++;
+    for (int i = 0; i < count; i++) {
+        d->mark[vertices[i]] = m;
+    }
+
+    int reached = cell_bfs(d, vertices[0], m);
+    if (reached < count) {
+        clear_levels(d, vertices, count);
+        return dissect_components(d, vertices, count, first_rank, m);
+    }
+
+    // Levels from a pseudo-peripheral vertex: the last one a BFS reaches
+    int far = d->queue[count - 1];
+    clear_levels(d, vertices, count);
+    cell_bfs(d, far, m);
+    int max_level = d->level[d->queue[count - 1]];
+    if (max_level < 2) {
+        // Every vertex is next to the start: nothing worth separating
+        clear_levels(d, vertices, count);
+        for (int i = 0; i < count; i++) {
+            d->rank[vertices[i]] = first_rank + i;
+        }
+        return true;
+    }
+
+    // Smallest level leaving at least a fifth on each side, else the most balanced one
+    for (int l = 0; l <= max_level; l++) {
+        d->level_count[l] = 0;
+    }
+    for (int i = 0; i < count; i++) {
+        d->level_count[d->level[vertices[i]]]++;
+    }
+    int balanced = -1;
+    int most_even = -1;
+    int most_even_side = -1;
+    int before = d->level_count[0];
+    for (int l = 1; l < max_level; l++) {
+        int after = count - before - d->level_count[l];
+        int smaller = before < after ? before : after;
+        if (smaller >= count / 5 && (balanced < 0 || d->level_count[l] < d->level_count[balanced])) {
+            balanced = l;
+        }
+        if (smaller > most_even_side) {
+            most_even_side = smaller;
+            most_even = l;
+        }
+        before += d->level_count[l];
+    }
+    int separator_level = balanced >= 0 ? balanced : most_even;
+
+    int sizes[3] = {0, 0, 0};
+    for (int i = 0; i < count; i++) {
+        sizes[dissection_side(d, vertices[i], m, separator_level)]++;
+    }
+    int positions[3] = {0, sizes[0], sizes[0] + sizes[1]};
+    for (int i = 0; i < count; i++) {
+        int side = dissection_side(d, vertices[i], m, separator_level);
+        d->scratch[positions[side]++] = vertices[i];
+    }
+    clear_levels(d, vertices, count);
+    memcpy(vertices, d->scratch, count * sizeof(int));
+
+    int separator_start = sizes[0] + sizes[1];
+    for (int i = separator_start; i < count; i++) {
+        d->rank[vertices[i]] = first_rank + i;
+    }
+    return dissect(d, vertices, sizes[0], first_rank) &&
+           dissect(d, vertices + sizes[0], sizes[1], first_rank + sizes[0]);
+}
+
+static bool nested_dissection(const Neighbors* neighbors, int n, int* rank) {
+    Dissection d;
+    d.neighbors = neighbors;
+    d.rank = rank;
+    d.next_mark = 0;
+    d.mark = (int*)malloc(n * sizeof(int));
+    d.level = (int*)malloc(n * sizeof(int));
+    d.queue = (int*)malloc(n * sizeof(int));
+    d.scratch = (int*)malloc(n * sizeof(int));
+    d.level_count = (int*)malloc((n + 1) * sizeof(int));
+    int* vertices = (int*)malloc(n * sizeof(int));
+
+    bool ok = d.mark && d.level && d.queue && d.scratch && d.level_count && vertices;
+    if (ok) {
+        for (int v = 0; v < n; v++) {
+            d.mark[v] = -1;
+            d.level[v] = -1;
+            vertices[v] = v;
+        }
+        ok = dissect(&d, vertices, n, 0);
+    }
+
+    free(d.mark);
+    free(d.level);
+    free(d.queue);
+    free(d.scratch);
+    free(d.level_count);
+    free(vertices);
+    return ok;
+}
+
+// ---------------------------------------------------------------------------
+// Chordal supergraph
+// ---------------------------------------------------------------------------
+
+// Contract vertices in rank order. The fill of contracting v is a clique on
+// its higher neighbours; handing them to the lowest of them (v's parent in
+// the elimination tree) is enough, because that vertex passes them on when
+// it is contracted in turn.
+static bool build_chordal_graph(CchIndex* cch, const Neighbors* neighbors) {
+    int n = cch->num_vertices;
+    IntVector* up = (IntVector*)calloc(n, sizeof(IntVector));
+    if (!up) return false;
+
+    bool ok = true;
+    for (int u = 0; u < n && ok; u++) {
+        for (int i = neighbors->offsets[u]; i < neighbors->offsets[u + 1] && ok; i++) {
+            int ru = cch->rank[u];
+            int rw = cch->rank[neighbors->adj[i]];
+            if (ru < rw) ok = int_vector_push(&up[ru], rw);
+        }
+    }
+
+    long long total = 0;
+    for (int v = 0; v < n && ok; v++) {
+        IntVector* set = &up[v];
+        if (set->size > 1) qsort(set->items, set->size, sizeof(int), compare_ints);
+        int unique = 0;
+        for (int i = 0; i < set->size; i++) {
+            if (unique == 0 || set->items[unique - 1] != set->items[i]) {
+                set->items[unique++] = set->items[i];
+            }
+        }
+        set->size = unique;
+        total += unique;
+        for (int i = 1; i < unique && ok; i++) {
+            ok = int_vector_push(&up[set->items[0]], set->items[i]);
+        }
+    }
+    if (ok && total > 0x7fffffff) {
+        fprintf(stderr, "Error: CCH has too many shortcuts\n");
+        ok = false;
+    }
+
+    if (ok) {
+        cch->num_arcs = (int)total;
+        cch->up_offsets = (int*)malloc((n + 1) * sizeof(int));
+        cch->up_heads = (int*)malloc((total > 0 ? total : 1) * sizeof(int));
+        ok = cch->up_offsets && cch->up_heads;
+    }
+    if (ok) {
+        int pos = 0;
+        for (int v = 0; v < n; v++) {
+            cch->up_offsets[v] = pos;
+            if (up[v].size > 0) memcpy(cch->up_heads + pos, up[v].items, up[v].size * sizeof(int));
+            pos += up[v].size;
+        }
+        cch->up_offsets[n] = pos;
+    }
+
+    for (int v = 0; v < n; v++) {
+        free(up[v].items);
+    }
+    free(up);
+    return ok;
+}
+
+// Downward view of the arcs and the elimination tree levels
+static bool build_down_and_levels(CchIndex* cch) {
+    int n = cch->num_vertices;
+    int arcs = cch->num_arcs > 0 ? cch->num_arcs : 1;
+    cch->down_offsets = (int*)calloc(n + 1, sizeof(int));
+    cch->down_tails = (int*)malloc(arcs * sizeof(int));
+    cch->down_arcs = (int*)malloc(arcs * sizeof(int));
+    int* fill = (int*)malloc(n * sizeof(int));
+    int* height = (int*)malloc(n * sizeof(int));
+    bool ok = cch->down_offsets && cch->down_tails && cch->down_arcs && fill && height;
+
+    if (ok) {
+        for (int a = 0; a < cch->num_arcs; a++) {
+            cch->down_offsets[cch->up_heads[a] + 1]++;
+        }
+        for (int v = 0; v < n; v++) {
+            cch->down_offsets[v + 1] += cch->down_offsets[v];
+        }
+        memcpy(fill, cch->down_offsets, n * sizeof(int));
+        for (int v = 0; v < n; v++) {
+            for (int a = cch->up_offsets[v]; a < cch->up_offsets[v + 1]; a++) {
+                int pos = fill[cch->up_heads[a]]++;
+                cch->down_tails[pos] = v;
+                cch->down_arcs[pos] = a;
+            }
+        }
+
+        // Every lower neighbour is a descendant, so heights follow rank order
+        cch->num_levels = n > 0 ? 1 : 0;
+        for (int v = 0; v < n; v++) {
+            height[v] = 0;
+            for (int i = cch->down_offsets[v]; i < cch->down_offsets[v + 1]; i++) {
+                int below = height[cch->down_tails[i]] + 1;
+                if (below > height[v]) height[v] = below;
+            }
+            if (height[v] + 1 > cch->num_levels) cch->num_levels = height[v] + 1;
+        }
+
+        cch->level_offsets = (int*)calloc(cch->num_levels + 1, sizeof(int));
+        cch->level_vertices = (int*)malloc(n * sizeof(int));
+        ok = cch->level_offsets && cch->level_vertices;
+    }
+    if (ok) {
+        for (int v = 0; v < n; v++) {
+            cch->level_offsets[height[v] + 1]++;
+        }
+        for (int l = 0; l < cch->num_levels; l++) {
+            cch->level_offsets[l + 1] += cch->level_offsets[l];
+        }
+        memcpy(fill, cch->level_offsets, cch->num_levels * sizeof(int));
+        for (int v = 0; v < n; v++) {
+            cch->level_vertices[fill[height[v]]++] = v;
+        }
+    }
+
+    free(fill);
+    free(height);
+    return ok;
+}
+
+// Arc (low, high) of the chordal graph, or -1
+static int find_arc(const CchIndex* cch, int low, int high) {
+    int begin = cch->up_offsets[low];
+    int end = cch->up_offsets[low + 1];
+    while (begin < end) {
+        int mid = begin + (end - begin) / 2;
+        if (cch->up_heads[mid] < high) {
+            begin = mid + 1;
+        } else {
+            end = mid;
+        }
+    }
+    return (begin < cch->up_offsets[low + 1] && cch->up_heads[begin] == high) ? begin : -1;
+}
+
+static bool map_input_arcs(CchIndex* cch, const Graph* graph) {
+    int count = 0;
+    for (int u = 0; u < graph->num_vertices; u++) {
+        for (Edge* edge = graph->adj_list[u]; edge; edge = edge->next) {
+            count++;
+        }
+    }
+    cch->num_input_arcs = count;
+    cch->input_arcs = (int*)malloc((count > 0 ? count : 1) * sizeof(int));
+    if (!cch->input_arcs) return false;
+
+    int i = 0;
+    for (int u = 0; u < graph->num_vertices; u++) {
+        for (Edge* edge = graph->adj_list[u]; edge; edge = edge->next, i++) {
+            int ru = cch->rank[u];
+            int rw = cch->rank[edge->dest];
+            if (ru == rw) {
+                cch->input_arcs[i] = -1;
+            } else if (ru < rw) {
+                cch->input_arcs[i] = 2 * find_arc(cch, ru, rw);
+            } else {
+                cch->input_arcs[i] = 2 * find_arc(cch, rw, ru) + 1;
+            }
+        }
+    }
+    return true;
+}
+
+CchIndex* cch_create(const Graph* graph) {
+    if (!graph) {
+        fprintf(stderr, "Error: Graph is NULL\n");
+        return NULL;
+    }
+
+    int n = graph->num_vertices;
+    CchIndex* cch = (CchIndex*)calloc(1, sizeof(CchIndex));
+    Neighbors neighbors = {NULL, NULL};
+    bool ok = cch != NULL;
+    if (ok) {
+        cch->num_vertices = n;
+        cch->rank = (int*)malloc(n * sizeof(int));
+        cch->order = (int*)malloc(n * sizeof(int));
+        ok = cch->rank && cch->order && neighbors_build(graph, &neighbors) &&
+             nested_dissection(&neighbors, n, cch->rank);
+    }
+    if (ok) {
+        for (int v = 0; v < n; v++) {
+            cch->order[cch->rank[v]] = v;
+        }
+        ok = build_chordal_graph(cch, &neighbors) && build_down_and_levels(cch) &&
+             map_input_arcs(cch, graph);
+    }
+    if (ok) {
+        int arcs = cch->num_arcs > 0 ? cch->num_arcs : 1;
+        cch->up_weight = (double*)malloc(arcs * sizeof(double));
+        cch->down_weight = (double*)malloc(arcs * sizeof(double));
+        cch->up_mid = (int*)malloc(arcs * sizeof(int));
+        cch->down_mid = (int*)malloc(arcs * sizeof(int));
+        ok = cch->up_weight && cch->down_weight && cch->up_mid && cch->down_mid;
+    }
+    free(neighbors.offsets);
+    free(neighbors.adj);
+
+    if (!ok) {
+        fprintf(stderr, "Error: Memory allocation failed for CCH\n");
+        cch_destroy(cch);
+        return NULL;
+    }
+    return cch;
+}
+
+void cch_destroy(CchIndex* cch) {
+    if (!cch) return;
+    free(cch->rank);
+    free(cch->order);
+    free(cch->up_offsets);
+    free(cch->up_heads);
+    free(cch->down_offsets);
+    free(cch->down_tails);
+    free(cch->down_arcs);
+    free(cch->level_offsets);
+    free(cch->level_vertices);
+    free(cch->input_arcs);
+    free(cch->up_weight);
+    free(cch->down_weight);
+    free(cch->up_mid);
+    free(cch->down_mid);
+    free(cch);
+}
+
+// ---------------------------------------------------------------------------
+// Customization
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    CchIndex* cch;
+    const int* vertices;         // Current level
+} CustomizeContext;
+
+// Finish the upward arcs of v from its lower triangles (u, v, w): the arcs of
+// u are final because u sits on a lower level, and only v's arcs are written,
+// so all vertices of one level can run at once
+static void customize_vertex(CchIndex* cch, int v) {
+    const int* heads = cch->up_heads;
+    double* up = cch->up_weight;
+    double* down = cch->down_weight;
+    int v_end = cch->up_offsets[v + 1];
+
+    for (int i = cch->down_offsets[v]; i < cch->down_offsets[v + 1]; i++) {
+        int u = cch->down_tails[i];
+        int uv = cch->down_arcs[i];
+        int vw = cch->up_offsets[v];
+        for (int uw = uv + 1; uw < cch->up_offsets[u + 1]; uw++) {
+            int w = heads[uw];
+            while (vw < v_end && heads[vw] != w) vw++;  // Present: the graph is chordal
+            if (vw == v_end) break;
+
+            double via = down[uv] + up[uw];            // v -> u -> w
+            if (via < up[vw]) {
+                up[vw] = via;
+                cch->up_mid[vw] = u;
+            }
+            via = down[uw] + up[uv];                   // w -> u -> v
+            if (via < down[vw]) {
+                down[vw] = via;
+                cch->down_mid[vw] = u;
+            }
+        }
+    }
+}
+
+static void customize_range(size_t begin, size_t end, int thread_id, void* arg) {
+    (void)thread_id;
+    CustomizeContext* ctx = (CustomizeContext*)arg;
+    for (size_t i = begin; i < end; i++) {
+        customize_vertex(ctx->cch, ctx->vertices[i]);
+    }
+}
+
+bool cch_customize(CchIndex* cch, const Graph* graph, const double* weights, int num_threads) {
+    if (!cch || !graph) return false;
+
+    int count = 0;
+    bool same_topology = graph->num_vertices == cch->num_vertices;
+    for (int u = 0; u < graph->num_vertices && same_topology; u++) {
+        for (Edge* edge = graph->adj_list[u]; edge && same_topology; edge = edge->next, count++) {
+            if (count >= cch->num_input_arcs) {
+                same_topology = false;
+                break;
+            }
+            // The mapped arc must still end at this edge's endpoints
+            int code = cch->input_arcs[count];
+            int ru = cch->rank[u];
+            int rw = cch->rank[edge->dest];
+            if (code < 0) {
+                same_topology = ru == rw;
+            } else {
+                int head = cch->up_heads[code >> 1];
+                same_topology = (code & 1) ? head == ru : head == rw;
+            }
+        }
+    }
+    if (!same_topology || count != cch->num_input_arcs) {
+        fprintf(stderr, "Error: Graph topology differs from the one the CCH was built for\n");
+        return false;
+    }
+
+    for (int a = 0; a < cch->num_arcs; a++) {
+        cch->up_weight[a] = DBL_MAX;
+        cch->down_weight[a] = DBL_MAX;
+        cch->up_mid[a] = -1;
+        cch->down_mid[a] = -1;
+    }
+    int i = 0;
+    for (int u = 0; u < graph->num_vertices; u++) {
+        for (Edge* edge = graph->adj_list[u]; edge; edge = edge->next, i++) {
+            double weight = weights ? weights[i] : edge->weight;
+            if (weight < 0) {
+                fprintf(stderr, "Error: CCH requires non-negative edge weights\n");
+                cch->customized = false;
+                return false;
+            }
+            int code = cch->input_arcs[i];
+            if (code < 0) continue;
+            double* slot = (code & 1) ? &cch->down_weight[code >> 1] : &cch->up_weight[code >> 1];
+            if (weight < *slot) *slot = weight;
+        }
+    }
+
+    CustomizeContext ctx = {cch, NULL};
+    for (int l = 0; l < cch->num_levels; l++) {
+        int begin = cch->level_offsets[l];
+        int size = cch->level_offsets[l + 1] - begin;
+        ctx.vertices = cch->level_vertices + begin;
+        parallel_for(size >= CCH_PARALLEL_LEVEL ? num_threads : 1, size, customize_range, &ctx);
+    }
+    cch->customized = true;
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Queries
+// ---------------------------------------------------------------------------
+
+static int tree_parent(const CchIndex* cch, int v) {
+    return cch->up_offsets[v] < cch->up_offsets[v + 1] ? cch->up_heads[cch->up_offsets[v]] : -1;
+}
+
+// Relax the upward (or downward) arcs along the elimination tree path from
+// source to the root. Every arc leads to an ancestor, so one pass in rank
+// order settles the path.
+static void tree_search(const CchIndex* cch, int source, const double* weight,
+                        double* dist, int* pred) {
+    for (int v = source; v >= 0; v = tree_parent(cch, v)) {
+        dist[v] = DBL_MAX;
+    }
+    dist[source] = 0.0;
+    pred[source] = -1;
+    for (int v = source; v >= 0; v = tree_parent(cch, v)) {
+        if (dist[v] == DBL_MAX) continue;
+        for (int a = cch->up_offsets[v]; a < cch->up_offsets[v + 1]; a++) {
+            if (weight[a] == DBL_MAX) continue;
+            int w = cch->up_heads[a];
+            double candidate = dist[v] + weight[a];
+            if (candidate < dist[w]) {
+                dist[w] = candidate;
+                pred[w] = v;
+            }
+        }
+    }
+}
+
+// Distance between ranks s and t; *meeting gets the best common ancestor (-1: none)
+static double tree_query(const CchIndex* cch, int s, int t, double* forward, double* backward,
+                         int* forward_pred, int* backward_pred, int* meeting) {
+    tree_search(cch, s, cch->up_weight, forward, forward_pred);
+    tree_search(cch, t, cch->down_weight, backward, backward_pred);
+
+    double best = DBL_MAX;
+    *meeting = -1;
+    int a = s;
+    int b = t;
+    while (a >= 0 && b >= 0) {
+        if (a == b) {
+            if (forward[a] != DBL_MAX && backward[a] != DBL_MAX && forward[a] + backward[a] < best) {
+                best = forward[a] + backward[a];
+                *meeting = a;
+            }
+            a = tree_parent(cch, a);
+            b = tree_parent(cch, b);
+        } else if (a < b) {
+            a = tree_parent(cch, a);
+        } else {
+            b = tree_parent(cch, b);
+        }
+    }
+    return best;
+}
+
+static bool query_valid(const CchIndex* cch, int start, int end) {
+    return cch && start >= 0 && start < cch->num_vertices && end >= 0 && end < cch->num_vertices;
+}
+
+double cch_distance(const CchIndex* cch, int start, int end) {
+    if (!query_valid(cch, start, end) || !cch->customized) return DBL_MAX;
+
+    int n = cch->num_vertices;
+    double* dist = (double*)malloc(2 * n * sizeof(double));
+    int* pred = (int*)malloc(2 * n * sizeof(int));
+    double best = DBL_MAX;
+    int meeting;
+    if (dist && pred) {
+        best = tree_query(cch, cch->rank[start], cch->rank[end], dist, dist + n, pred, pred + n,
+                          &meeting);
+    }
+    free(dist);
+    free(pred);
+    return best;
+}
+
+// Append the original vertices after from on the arc from -> to (ranks),
+// replacing each shortcut by its two halves through the triangle vertex
+static bool unpack_arc(const CchIndex* cch, int from, int to, IntVector* stack, IntVector* out) {
+    stack->size = 0;
+    if (!int_vector_push(stack, from) || !int_vector_push(stack, to)) return false;
+    while (stack->size > 0) {
+        int y = stack->items[--stack->size];
+        int x = stack->items[--stack->size];
+        int arc = x < y ? find_arc(cch, x, y) : find_arc(cch, y, x);
+        int mid = x < y ? cch->up_mid[arc] : cch->down_mid[arc];
+        if (mid < 0) {
+            if (!int_vector_push(out, cch->order[y])) return false;
+        } else if (!int_vector_push(stack, mid) || !int_vector_push(stack, y) ||
+                   !int_vector_push(stack, x) || !int_vector_push(stack, mid)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+PathResult* cch_find_path(const CchIndex* cch, int start, int end) {
+    PathResult* result = path_result_create();
+    if (!result) return NULL;
+
+    result->algorithm = "CCH";
+    result->suboptimality_bound = 1.0;
+
+    if (!query_valid(cch, start, end)) {
+        fprintf(stderr, "Error: Invalid start or end vertex\n");
+        return result;
+    }
+    if (!cch->customized) {
+        fprintf(stderr, "Error: CCH has not been customized\n");
+        return result;
+    }
+
+    SearchStats* stats = &result->stats;
+    long long start_ns = graph_clock_ns();
+    int n = cch->num_vertices;
+    double* dist = (double*)malloc(2 * n * sizeof(double));
+    int* pred = (int*)malloc(2 * n * sizeof(int));
+    if (!dist || !pred) {
+        free(dist);
+        free(pred);
+        return result;
+    }
+    stats->bytes_allocated = 2 * (size_t)n * (sizeof(double) + sizeof(int));
+    double* forward = dist;
+    double* backward = dist + n;
+    int* forward_pred = pred;
+    int* backward_pred = pred + n;
+
+    long long search_ns = graph_clock_ns();
+    stats->init_ns = search_ns - start_ns;
+    int s = cch->rank[start];
+    int t = cch->rank[end];
+    int meeting;
+    double distance = tree_query(cch, s, t, forward, backward, forward_pred, backward_pred, &meeting);
+    for (int v = s; v >= 0; v = tree_parent(cch, v)) stats->vertices_settled++;
+    for (int v = t; v >= 0; v = tree_parent(cch, v)) stats->vertices_settled++;
+
+    long long reconstruct_ns = graph_clock_ns();
+    stats->search_ns = reconstruct_ns - search_ns;
+
+    if (meeting >= 0) {
+        // Ranks from s up to the meeting vertex, then down to t
+        IntVector ranks = {NULL, 0, 0};
+        IntVector stack = {NULL, 0, 0};
+        IntVector path = {NULL, 0, 0};
+        bool ok = true;
+        for (int v = meeting; v >= 0 && ok; v = forward_pred[v]) {
+            ok = int_vector_push(&ranks, v);
+        }
+        ok = ok && int_vector_push(&path, start);
+        for (int i = ranks.size - 1; i > 0 && ok; i--) {
+            ok = unpack_arc(cch, ranks.items[i], ranks.items[i - 1], &stack, &path);
+        }
+        for (int v = meeting; v != t && ok; v = backward_pred[v]) {
+            ok = unpack_arc(cch, v, backward_pred[v], &stack, &path);
+        }
+
+        if (ok) {
+            result->path = path.items;
+            result->path_length = path.size;
+            result->total_weight = distance;
+            result->found = true;
+        } else {
+            free(path.items);
+        }
+        free(ranks.items);
+        free(stack.items);
+    }
+
+    free(dist);
+    free(pred);
+    long long end_ns = graph_clock_ns();
+    stats->reconstruct_ns = end_ns - reconstruct_ns;
+    result->time_ms = (end_ns - start_ns) / 1e6;
+    return result;
+}
+
+int cch_num_arcs(const CchIndex* cch) {
+    return cch ? cch->num_arcs : 0;
+}
+
+int cch_num_levels(const CchIndex* cch) {
+    return cch ? cch->num_levels : 0;
+}
+
+int cch_rank(const CchIndex* cch, int vertex) {
+    if (!cch || vertex < 0 || vertex >= cch->num_vertices) return -1;
+    return cch->rank[vertex];
+}
+
+size_t cch_memory_usage(const CchIndex* cch) {
+    if (!cch) return 0;
+    size_t n = cch->num_vertices;
+    size_t arcs = cch->num_arcs;
+    return sizeof(CchIndex) +
+           n * 2 * sizeof(int) +                                   // rank, order
+           (n + 1) * 2 * sizeof(int) +                             // up/down offsets
+           arcs * 3 * sizeof(int) +                                // heads, down tails and arcs
+           (cch->num_levels + 1 + n) * sizeof(int) +               // levels
+           cch->num_input_arcs * sizeof(int) +
+           arcs * 2 * (sizeof(double) + sizeof(int));              // metric
+}
@@ -0,0 +1,569 @@
+#include "compressed_graph.h"
+#include "min_heap.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include <math.h>
+
+#if defined(__SSE2__) && defined(__GNUC__)
+#include <emmintrin.h>
+#define COMPRESSED_USE_SSE2 1
+#endif
+
+// Bytes of zero padding after the varint stream so the decoder may load 16 bytes at a time
+#define VARINT_PADDING 16
+
+// Most distinct weights an EXACT graph stores as 16-bit dictionary codes
+#define MAX_WEIGHT_VALUES 65536
+
+// Arc used while sorting a neighbour list
+typedef struct {
+    int dest;
+    double weight;
+} SortArc;
+
+static int compare_arcs(const void* a, const void* b) {
+    const SortArc* x = (const SortArc*)a;
+    const SortArc* y = (const SortArc*)b;
+    if (x->dest != y->dest) return (x->dest < y->dest) ? -1 : 1;
+    if (x->weight != y->weight) return (x->weight < y->weight) ? -1 : 1;
+    return 0;
+}
+
+static int compare_doubles(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x < y) ? -1 : (x > y) ? 1 : 0;
+}
+
+// Sorted distinct weights of graph when there are at most MAX_WEIGHT_VALUES
+// of them; *count is 0 (and NULL is returned) when there are more. Sets
+// *failed on allocation failure.
+static double* weight_dictionary(const Graph* graph, int num_arcs, int* count, bool* failed) {
+    *count = 0;
+    *failed = false;
+    double* values = (double*)malloc((num_arcs > 0 ? num_arcs : 1) * sizeof(double));
+    if (!values) {
+        *failed = true;
+        return NULL;
+    }
+    int arc = 0;
+    for (int i = 0; i < graph->num_vertices; i++) {
+        for (Edge* edge = graph->adj_list[i]; edge; edge = edge->next) {
+            values[arc++] = edge->weight;
+        }
+    }
+    qsort(values, num_arcs, sizeof(double), compare_doubles);
+
+    int distinct = 0;
+    for (int k = 0; k < num_arcs; k++) {
+        if (distinct > 0 && values[k] == values[distinct - 1]) continue;
+        if (distinct == MAX_WEIGHT_VALUES) {
+            free(values);
+            return NULL;
+        }
+        values[distinct++] = values[k];
+    }
+    double* trimmed = (double*)realloc(values, (distinct > 0 ? distinct : 1) * sizeof(double));
+    *count = distinct;
+    return trimmed ? trimmed : values;
+}
+
+// Index of weight in the sorted dictionary (it is always present)
+static uint16_t weight_code(const CompressedGraph* cgraph, double weight) {
+    int lo = 0;
+    int hi = cgraph->num_weight_values - 1;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (cgraph->weight_values[mid] < weight) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return (uint16_t)lo;
+}
+
+static uint32_t zigzag_encode(int32_t value) {
+    return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+static int32_t zigzag_decode(uint32_t value) {
+    return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+}
+
+static size_t varint_encode(uint32_t value, uint8_t* out) {
+    size_t n = 0;
+    while (value >= 0x80) {
+        out[n++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    out[n++] = (uint8_t)value;
+    return n;
+}
+
+static const uint8_t* varint_decode_one(const uint8_t* p, uint32_t* out) {
+    uint32_t value = *p & 0x7F;
+    int shift = 7;
+    while (*p++ & 0x80) {
+        value |= (uint32_t)(*p & 0x7F) << shift;
+        shift += 7;
+    }
+    *out = value;
+    return p;
+}
+
+// Decode count varints into out. Runs of single-byte values (the common case
+// for sorted gaps) are widened 16 at a time with SSE2, or 8 at a time otherwise.
+static const uint8_t* varint_decode_run(const uint8_t* p, int count, uint32_t* out) {
+    int i = 0;
+
+#ifdef COMPRESSED_USE_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    while (count - i >= 16) {
+        __m128i chunk = _mm_loadu_si128((const __m128i*)p);
+        unsigned mask = (unsigned)_mm_movemask_epi8(chunk);
+        if (mask == 0) {
+            __m128i lo = _mm_unpacklo_epi8(chunk, zero);
+            __m128i hi = _mm_unpackhi_epi8(chunk, zero);
+            _mm_storeu_si128((__m128i*)(out + i), _mm_unpacklo_epi16(lo, zero));
+            _mm_storeu_si128((__m128i*)(out + i + 4), _mm_unpackhi_epi16(lo, zero));
+            _mm_storeu_si128((__m128i*)(out + i + 8), _mm_unpacklo_epi16(hi, zero));
+            _mm_storeu_si128((__m128i*)(out + i + 12), _mm_unpackhi_epi16(hi, zero));
+            p += 16;
+            i += 16;
+            continue;
+        }
+
+        // Copy the single-byte prefix, then decode one multi-byte value
+        int run = __builtin_ctz(mask);
+        for (int k = 0; k < run; k++) {
+            out[i + k] = p[k];
+        }
+        p += run;
+        i += run;
+        p = varint_decode_one(p, &out[i++]);
+    }
+#else
+    while (count - i >= 8) {
+        uint64_t word;
+        memcpy(&word, p, sizeof(word));
+        if ((word & 0x8080808080808080ULL) == 0) {
+            for (int k = 0; k < 8; k++) {
+                out[i + k] = p[k];
+            }
+            p += 8;
+            i += 8;
+            continue;
+        }
+        p = varint_decode_one(p, &out[i++]);
+    }
+#endif
+
+    while (i < count) {
+        p = varint_decode_one(p, &out[i++]);
+    }
+    return p;
+}
+
+static double arc_weight(const CompressedGraph* cgraph, int arc) {
+    if (!cgraph->is_weighted) return 1.0;
+    if (cgraph->weight_values) return cgraph->weight_values[cgraph->qweights[arc]];
+    if (cgraph->weight_mode == COMPRESSED_WEIGHTS_QUANTIZED) {
+        return cgraph->weight_min + cgraph->qweights[arc] * cgraph->weight_scale;
+    }
+    return cgraph->weights[arc];
+}
+
+// Create a compressed copy of graph
+CompressedGraph* compressed_graph_create(const Graph* graph, CompressedWeightMode mode) {
+    if (!graph) {
+        fprintf(stderr, "Error: Graph is NULL\n");
+        return NULL;
+    }
+
+    CompressedGraph* cgraph = (CompressedGraph*)calloc(1, sizeof(CompressedGraph));
+    if (!cgraph) {
+        fprintf(stderr, "Error: Memory allocation failed for compressed graph\n");
+        return NULL;
+    }
+
+    int n = graph->num_vertices;
+    cgraph->num_vertices = n;
+    cgraph->num_edges = graph->num_edges;
+    cgraph->is_weighted = graph->is_weighted;
+    cgraph->is_directed = graph->is_directed;
+    cgraph->weight_mode = mode;
+
+    // Count arcs and find the largest list
+    int num_arcs = 0;
+    int max_degree = 0;
+    double weight_min = DBL_MAX;
+    double weight_max = -DBL_MAX;
+    for (int i = 0; i < n; i++) {
+        int degree = 0;
+        for (Edge* edge = graph->adj_list[i]; edge; edge = edge->next) {
+            degree++;
+            if (edge->weight < weight_min) weight_min = edge->weight;
+            if (edge->weight > weight_max) weight_max = edge->weight;
+        }
+        num_arcs += degree;
+        if (degree > max_degree) max_degree = degree;
+    }
+    cgraph->num_arcs = num_arcs;
+    cgraph->max_degree = max_degree;
+
+    // Worst case: 5 bytes per arc
+    size_t capacity = (size_t)num_arcs * 5 + VARINT_PADDING;
+    cgraph->byte_offsets = (size_t*)malloc((n + 1) * sizeof(size_t));
+    cgraph->arc_offsets = (int*)malloc((n + 1) * sizeof(int));
+    cgraph->data = (uint8_t*)malloc(capacity);
+    SortArc* scratch = (SortArc*)malloc((max_degree > 0 ? max_degree : 1) * sizeof(SortArc));
+
+    bool weights_ok = true;
+    if (cgraph->is_weighted && num_arcs > 0 && mode == COMPRESSED_WEIGHTS_EXACT) {
+        bool failed;
+        cgraph->weight_values = weight_dictionary(graph, num_arcs, &cgraph->num_weight_values, &failed);
+        weights_ok = !failed;
+    }
+    if (cgraph->is_weighted && num_arcs > 0 && weights_ok) {
+        if (mode == COMPRESSED_WEIGHTS_QUANTIZED || cgraph->weight_values) {
+            cgraph->qweights = (uint16_t*)malloc(num_arcs * sizeof(uint16_t));
+            weights_ok = cgraph->qweights != NULL;
+        } else {
+            cgraph->weights = (double*)malloc(num_arcs * sizeof(double));
+            weights_ok = cgraph->weights != NULL;
+        }
+    }
+
+    if (!cgraph->byte_offsets || !cgraph->arc_offsets || !cgraph->data || !scratch || !weights_ok) {
+        fprintf(stderr, "Error: Memory allocation failed for compressed graph\n");
+        free(scratch);
+        compressed_graph_destroy(cgraph);
+        return NULL;
+    }
+
+    if (mode == COMPRESSED_WEIGHTS_QUANTIZED && num_arcs > 0) {
+        cgraph->weight_min = weight_min;
+        cgraph->weight_scale = (weight_max > weight_min) ? (weight_max - weight_min) / 65535.0 : 0.0;
+    }
+
+    // Sort and encode each neighbour list
+    size_t pos = 0;
+    int arc = 0;
+    for (int i = 0; i < n; i++) {
+        cgraph->byte_offsets[i] = pos;
+        cgraph->arc_offsets[i] = arc;
+
+        int degree = 0;
+        for (Edge* edge = graph->adj_list[i]; edge; edge = edge->next) {
+            scratch[degree].dest = edge->dest;
+            scratch[degree].weight = edge->weight;
+            degree++;
+        }
+        qsort(scratch, degree, sizeof(SortArc), compare_arcs);
+
+        for (int k = 0; k < degree; k++) {
+            uint32_t code = (k == 0) ? zigzag_encode(scratch[0].dest - i)
+                                     : (uint32_t)(scratch[k].dest - scratch[k - 1].dest);
+            pos += varint_encode(code, cgraph->data + pos);
+
+            if (cgraph->weights) {
+                cgraph->weights[arc] = scratch[k].weight;
+            } else if (cgraph->weight_values) {
+                cgraph->qweights[arc] = weight_code(cgraph, scratch[k].weight);
+            } else if (cgraph->qweights) {
+                double steps = (cgraph->weight_scale > 0.0)
+                             ? (scratch[k].weight - weight_min) / cgraph->weight_scale : 0.0;
+                cgraph->qweights[arc] = (uint16_t)lround(steps);
+            }
+            arc++;
+        }
+    }
+    cgraph->byte_offsets[n] = pos;
+    cgraph->arc_offsets[n] = arc;
+    cgraph->data_size = pos;
+    free(scratch);
+
+    // Trim the stream to its final size (keeping the decoder padding)
+    uint8_t* trimmed = (uint8_t*)realloc(cgraph->data, pos + VARINT_PADDING);
+    if (trimmed) {
+        cgraph->data = trimmed;
+    }
+    memset(cgraph->data + pos, 0, VARINT_PADDING);
+
+    return cgraph;
+}
+
+void compressed_graph_destroy(CompressedGraph* cgraph) {
+    if (!cgraph) return;
+    free(cgraph->byte_offsets);
+    free(cgraph->arc_offsets);
+    free(cgraph->data);
+    free(cgraph->weights);
+    free(cgraph->qweights);
+    free(cgraph->weight_values);
+    free(cgraph);
+}
+
+int compressed_graph_neighbors(const CompressedGraph* cgraph, int vertex,
+                               int* dests, double* weights) {
+    int first = cgraph->arc_offsets[vertex];
+    int degree = cgraph->arc_offsets[vertex + 1] - first;
+    if (degree == 0) return 0;
+
+    uint32_t* codes = (uint32_t*)dests;
+    varint_decode_run(cgraph->data + cgraph->byte_offsets[vertex], degree, codes);
+
+    // Undo the delta encoding in place
+    int prev = vertex + zigzag_decode(codes[0]);
+    dests[0] = prev;
+    for (int k = 1; k < degree; k++) {
+        prev += (int)codes[k];
+        dests[k] = prev;
+    }
+
+    if (weights) {
+        for (int k = 0; k < degree; k++) {
+            weights[k] = arc_weight(cgraph, first + k);
+        }
+    }
+    return degree;
+}
+
+size_t compressed_graph_memory_usage(const CompressedGraph* cgraph) {
+    if (!cgraph) return 0;
+
+    size_t n = (size_t)cgraph->num_vertices + 1;
+    size_t bytes = sizeof(CompressedGraph) + n * sizeof(size_t) + n * sizeof(int);
+    bytes += cgraph->data_size + VARINT_PADDING;
+    if (cgraph->weights) bytes += (size_t)cgraph->num_arcs * sizeof(double);
+    if (cgraph->qweights) bytes += (size_t)cgraph->num_arcs * sizeof(uint16_t);
+    if (cgraph->weight_values) bytes += (size_t)cgraph->num_weight_values * sizeof(double);
+    return bytes;
+}
+
+static bool compressed_is_valid_vertex(const CompressedGraph* cgraph, int vertex) {
+    return cgraph && vertex >= 0 && vertex < cgraph->num_vertices;
+}
+
+// BFS over the compressed adjacency
+PathResult* compressed_bfs_find_path(const CompressedGraph* cgraph, int start, int end) {
+    PathResult* result = path_result_create();
+    if (!result) return NULL;
+
+    result->algorithm = "BFS (Compressed)";
+    // Fewest edges, which is only the shortest path when edges are unweighted
+    if (cgraph && !cgraph->is_weighted) result->suboptimality_bound = 1.0;
+
+    if (!compressed_is_valid_vertex(cgraph, start) || !compressed_is_valid_vertex(cgraph, end)) {
+        fprintf(stderr, "Error: Invalid start or end vertex\n");
+        return result;
+    }
+
+    SearchStats* stats = &result->stats;
+    long long start_ns = graph_clock_ns();
+
+    int n = cgraph->num_vertices;
+    int scratch_size = cgraph->max_degree > 0 ? cgraph->max_degree : 1;
+    bool* visited = (bool*)calloc(n, sizeof(bool));
+    int* parent = (int*)malloc(n * sizeof(int));
+    int* queue = (int*)malloc(n * sizeof(int));
+    int* dests = (int*)malloc(scratch_size * sizeof(int));
+    double* weights = (double*)malloc(scratch_size * sizeof(double));
+
+    if (!visited || !parent || !queue || !dests || !weights) {
+        fprintf(stderr, "Error: Memory allocation failed for %s\n", result->algorithm);
+        result->status = SEARCH_OUT_OF_MEMORY;
+        free(visited);
+        free(parent);
+        free(queue);
+        free(dests);
+        free(weights);
+        return result;
+    }
+
+    for (int i = 0; i < n; i++) {
+        parent[i] = -1;
+    }
+
+    // Every vertex is enqueued at most once, so a flat array suffices
+    int front = 0;
+    int rear = 0;
+    visited[start] = true;
+    queue[rear++] = start;
+    stats->heap_pushes = 1;
+    stats->peak_queue_size = 1;
+
+    long long search_ns = graph_clock_ns();
+    stats->init_ns = search_ns - start_ns;
+
+    while (front < rear) {
+        int current = queue[front++];
+        stats->heap_pops++;
+        stats->vertices_settled++;
+        if (current == end) break;
+
+        int degree = compressed_graph_neighbors(cgraph, current, dests, NULL);
+        stats->edges_relaxed += degree;
+        for (int k = 0; k < degree; k++) {
+            int v = dests[k];
+            if (!visited[v]) {
+                visited[v] = true;
+                parent[v] = current;
+                queue[rear++] = v;
+                stats->heap_pushes++;
+            }
+        }
+        if (rear - front > stats->peak_queue_size) stats->peak_queue_size = rear - front;
+    }
+
+    long long reconstruct_ns = graph_clock_ns();
+    stats->search_ns = reconstruct_ns - search_ns;
+
+    if (visited[end]) {
+        result->path = path_reconstruct(parent, start, end, &result->path_length);
+        result->found = (result->path != NULL);
+        if (!result->found) result->status = SEARCH_OUT_OF_MEMORY;
+    }
+
+    // Sum the cheapest arc between each consecutive pair
+    if (result->found) {
+        for (int i = 0; i < result->path_length - 1; i++) {
+            int degree = compressed_graph_neighbors(cgraph, result->path[i], dests, weights);
+            double best = DBL_MAX;
+            for (int k = 0; k < degree; k++) {
+                if (dests[k] == result->path[i + 1] && weights[k] < best) {
+                    best = weights[k];
+                }
+            }
+            result->total_weight += best;
+        }
+    }
+
+    long long end_ns = graph_clock_ns();
+    stats->reconstruct_ns = end_ns - reconstruct_ns;
+    stats->bytes_allocated = n * (sizeof(bool) + 2 * sizeof(int)) +
+                             scratch_size * (sizeof(int) + sizeof(double));
+    result->time_ms = (end_ns - start_ns) / 1e6;
+
+    free(visited);
+    free(parent);
+    free(queue);
+    free(dests);
+    free(weights);
+
+    return result;
+}
+
+// Dijkstra over the compressed adjacency
+PathResult* compressed_dijkstra_find_path(const CompressedGraph* cgraph, int start, int end) {
+    PathResult* result = path_result_create();
+    if (!result) return NULL;
+
+    result->algorithm = (cgraph && cgraph->weight_mode == COMPRESSED_WEIGHTS_QUANTIZED)
+                      ? "Dijkstra (Compressed, quantized)" : "Dijkstra (Compressed)";
+    // Quantized weights only approximate the original ones
+    if (cgraph && cgraph->weight_mode == COMPRESSED_WEIGHTS_EXACT) result->suboptimality_bound = 1.0;
+
+    if (!compressed_is_valid_vertex(cgraph, start) || !compressed_is_valid_vertex(cgraph, end)) {
+        fprintf(stderr, "Error: Invalid start or end vertex\n");
+        return result;
+    }
+
+    SearchStats* stats = &result->stats;
+    long long start_ns = graph_clock_ns();
+
+    int n = cgraph->num_vertices;
+    int scratch_size = cgraph->max_degree > 0 ? cgraph->max_degree : 1;
+    double* dist = (double*)malloc(n * sizeof(double));
+    int* parent = (int*)malloc(n * sizeof(int));
+    bool* visited = (bool*)calloc(n, sizeof(bool));
+    int* dests = (int*)malloc(scratch_size * sizeof(int));
+    double* weights = (double*)malloc(scratch_size * sizeof(double));
+    MinHeap* heap = min_heap_create(n > 1000 ? 1000 : n);
+
+    if (!dist || !parent || !visited || !dests || !weights || !heap) {
+        fprintf(stderr, "Error: Memory allocation failed for %s\n", result->algorithm);
+        result->status = SEARCH_OUT_OF_MEMORY;
+        free(dist);
+        free(parent);
+        free(visited);
+        free(dests);
+        free(weights);
+        min_heap_destroy(heap);
+        return result;
+    }
+
+    for (int i = 0; i < n; i++) {
+        dist[i] = DBL_MAX;
+        parent[i] = -1;
+    }
+
+    dist[start] = 0.0;
+    if (!min_heap_push(heap, start, 0.0)) {
+        result->status = SEARCH_OUT_OF_MEMORY;
+    }
+    stats->heap_pushes = 1;
+    stats->peak_queue_size = 1;
+
+    long long search_ns = graph_clock_ns();
+    stats->init_ns = search_ns - start_ns;
+
+    while (!min_heap_is_empty(heap) && result->status == SEARCH_COMPLETED) {
+        HeapNode current = min_heap_pop(heap);
+        int u = current.vertex;
+        stats->heap_pops++;
+
+        if (visited[u]) continue;
+        visited[u] = true;
+        stats->vertices_settled++;
+
+        if (u == end) break;
+
+        int degree = compressed_graph_neighbors(cgraph, u, dests, weights);
+        stats->edges_relaxed += degree;
+        for (int k = 0; k < degree; k++) {
+            int v = dests[k];
+            double candidate = dist[u] + weights[k];
+            if (!visited[v] && candidate < dist[v]) {
+                dist[v] = candidate;
+                parent[v] = u;
+                if (!min_heap_push(heap, v, candidate)) {
+                    result->status = SEARCH_OUT_OF_MEMORY;  // A dropped entry could hide the shortest path
+                    break;
+                }
+                stats->heap_pushes++;
+            }
+        }
+        if (heap->size > stats->peak_queue_size) stats->peak_queue_size = heap->size;
+    }
+
+    long long reconstruct_ns = graph_clock_ns();
+    stats->search_ns = reconstruct_ns - search_ns;
+
+    // An interrupted search may hold a tentative path
+    if (result->status == SEARCH_COMPLETED && visited[end]) {
+        result->path = path_reconstruct(parent, start, end, &result->path_length);
+        result->found = (result->path != NULL);
+        result->total_weight = (result->found) ? dist[end] : 0.0;
+        if (!result->found) result->status = SEARCH_OUT_OF_MEMORY;
+    }
+
+    long long end_ns = graph_clock_ns();
+    stats->reconstruct_ns = end_ns - reconstruct_ns;
+    stats->bytes_allocated = n * (sizeof(double) + sizeof(int) + sizeof(bool)) +
+                             scratch_size * (sizeof(int) + sizeof(double)) +
+                             sizeof(MinHeap) + heap->capacity * sizeof(HeapNode);
+    result->time_ms = (end_ns - start_ns) / 1e6;
+
+    free(dist);
+    free(parent);
+    free(visited);
+    free(dests);
+    free(weights);
+    min_heap_destroy(heap);
+
+    return result;
+}
@@ -0,0 +1,591 @@
+#include "crp.h"
+#include "parallel.h"
+#include "search_workspace.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include <stdatomic.h>
+
+// Overlay of one partition level
+typedef struct {
+    const int* cells;            // Row of the partition
+    int num_cells;
+    int* boundary_index;         // Vertex -> position in its cell's boundary list (-1: inner)
+    int* boundary_offsets;       // num_cells + 1
+    int* boundary;               // Boundary vertices grouped by cell
+    size_t* clique_offsets;      // num_cells + 1
+    double* clique;              // k x k distances per cell, row = from
+    bool* dirty;                 // Cell needs its clique recomputed
+} CrpLevel;
+
+struct CrpEngine {
+    int num_vertices;
+    int num_levels;
+    Partition* partition;
+    CrpLevel* levels;
+
+    // Arcs in adjacency order as of the last customization
+    int num_arcs;
+    int* arc_heads;
+    double* arc_weights;
+    bool customized;
+};
+
+// Growable int array
+typedef struct {
+    int* items;
+    int size;
+    int capacity;
+} IntVector;
+
+static bool int_vector_push(IntVector* vector, int value) {
+    if (vector->size == vector->capacity) {
+        int capacity = vector->capacity ? vector->capacity * 2 : 16;
+        int* items = (int*)realloc(vector->items, capacity * sizeof(int));
+        if (!items) return false;
+        vector->items = items;
+        vector->capacity = capacity;
+    }
+    vector->items[vector->size++] = value;
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Construction
+// ---------------------------------------------------------------------------
+
+static bool build_level(CrpLevel* level, const Graph* graph) {
+    int n = graph->num_vertices;
+    const int* cells = level->cells;
+    int num_cells = level->num_cells;
+    level->boundary_index = (int*)malloc(n * sizeof(int));
+    level->boundary_offsets = (int*)calloc(num_cells + 1, sizeof(int));
+    level->clique_offsets = (size_t*)malloc((num_cells + 1) * sizeof(size_t));
+    level->dirty = (bool*)malloc(num_cells * sizeof(bool));
+    if (!level->boundary_index || !level->boundary_offsets || !level->clique_offsets ||
+        !level->dirty) {
+        return false;
+    }
+
+    // A vertex is on the boundary when an arc in either direction leaves its cell
+    for (int v = 0; v < n; v++) level->boundary_index[v] = -1;
+    for (int u = 0; u < n; u++) {
+        for (Edge* edge = graph->adj_list[u]; edge; edge = edge->next) {
+            if (cells[u] != cells[edge->dest]) {
+                level->boundary_index[u] = 0;
+                level->boundary_index[edge->dest] = 0;
+            }
+        }
+    }
+    for (int v = 0; v < n; v++) {
+        if (level->boundary_index[v] == 0) level->boundary_offsets[cells[v] + 1]++;
+    }
+    level->clique_offsets[0] = 0;
+    for (int c = 0; c < num_cells; c++) {
+        size_t k = level->boundary_offsets[c + 1];
+        level->clique_offsets[c + 1] = level->clique_offsets[c] + k * k;
+        level->boundary_offsets[c + 1] += level->boundary_offsets[c];
+        level->dirty[c] = true;
+    }
+
+    int total = level->boundary_offsets[num_cells];
+    size_t clique_size = level->clique_offsets[num_cells];
+    level->boundary = (int*)malloc((total > 0 ? total : 1) * sizeof(int));
+    level->clique = (double*)malloc((clique_size > 0 ? clique_size : 1) * sizeof(double));
+    if (!level->boundary || !level->clique) return false;
+    for (int v = 0; v < n; v++) {
+        if (level->boundary_index[v] < 0) continue;
+        int c = cells[v];
+        int slot = level->boundary_offsets[c]++;
+        level->boundary[slot] = v;
+    }
+    for (int c = num_cells; c > 0; c--) {
+        level->boundary_offsets[c] = level->boundary_offsets[c - 1];
+    }
+    level->boundary_offsets[0] = 0;
+    for (int c = 0; c < num_cells; c++) {
+        for (int i = level->boundary_offsets[c]; i < level->boundary_offsets[c + 1]; i++) {
+            level->boundary_index[level->boundary[i]] = i - level->boundary_offsets[c];
+        }
+    }
+    return true;
+}
+
+CrpEngine* crp_create(const Graph* graph, const int* max_cell_sizes, int num_levels) {
+    if (!graph) {
+        fprintf(stderr, "Error: Invalid graph for overlay\n");
+        return NULL;
+    }
+    Partition* partition = partition_create(graph, max_cell_sizes, num_levels);
+    if (!partition) return NULL;
+
+    int n = graph->num_vertices;
+    CrpEngine* crp = (CrpEngine*)calloc(1, sizeof(CrpEngine));
+    if (!crp) {
+        partition_destroy(partition);
+        fprintf(stderr, "Error: Memory allocation failed for overlay\n");
+        return NULL;
+    }
+    crp->num_vertices = n;
+    crp->num_levels = num_levels;
+    crp->partition = partition;
+    crp->levels = (CrpLevel*)calloc(num_levels, sizeof(CrpLevel));
+    bool ok = crp->levels != NULL;
+    for (int l = 0; l < num_levels && ok; l++) {
+        crp->levels[l].cells = partition->cells + (size_t)l * n;
+        crp->levels[l].num_cells = partition->num_cells[l];
+        ok = build_level(&crp->levels[l], graph);
+    }
+
+    for (int u = 0; u < n; u++) {
+        for (Edge* edge = graph->adj_list[u]; edge; edge = edge->next) crp->num_arcs++;
+    }
+    if (ok) {
+        int arcs = crp->num_arcs > 0 ? crp->num_arcs : 1;
+        crp->arc_heads = (int*)malloc(arcs * sizeof(int));
+        crp->arc_weights = (double*)malloc(arcs * sizeof(double));
+        ok = crp->arc_heads && crp->arc_weights;
+    }
+    if (!ok) {
+        fprintf(stderr, "Error: Memory allocation failed for overlay\n");
+        crp_destroy(crp);
+        return NULL;
+    }
+    int i = 0;
+    for (int u = 0; u < n; u++) {
+        for (Edge* edge = graph->adj_list[u]; edge; edge = edge->next, i++) {
+            crp->arc_heads[i] = edge->dest;
+            crp->arc_weights[i] = edge->weight;
+        }
+    }
+    return crp;
+}
+
+void crp_destroy(CrpEngine* crp) {
+    if (!crp) return;
+    if (crp->levels) {
+        for (int l = 0; l < crp->num_levels; l++) {
+            CrpLevel* level = &crp->levels[l];
+            free(level->boundary_index);
+            free(level->boundary_offsets);
+            free(level->boundary);
+            free(level->clique_offsets);
+            free(level->clique);
+            free(level->dirty);
+        }
+        free(crp->levels);
+    }
+    partition_destroy(crp->partition);
+    free(crp->arc_heads);
+    free(crp->arc_weights);
+    free(crp);
+}
+
+// ---------------------------------------------------------------------------
+// Searches inside one cell
+// ---------------------------------------------------------------------------
+
+// A failed push loses the entry, so the search ends as SEARCH_OUT_OF_MEMORY
+static void relax(SearchWorkspace* search, int u, int w, double d) {
+    unsigned int generation = search->generation;
+    if (search->closed[w] == generation) return;
+    if (search->seen[w] != generation || d < search->dist[w]) {
+        search->seen[w] = generation;
+        search->dist[w] = d;
+        search->parent[w] = u;
+        if (!min_heap_push(search->heap, w, d)) {
+            search->status = SEARCH_OUT_OF_MEMORY;
+            return;
+        }
+        search->stats.heap_pushes++;
+    }
+}
+
+// Relax the clique arcs of u's cell on a level; false if u is not on its boundary
+static bool relax_clique(const CrpEngine* crp, SearchWorkspace* search, int level, int u, double d) {
+    const CrpLevel* overlay = &crp->levels[level];
+    int index = overlay->boundary_index[u];
+    if (index < 0) return false;
+    int c = overlay->cells[u];
+    int first = overlay->boundary_offsets[c];
+    int k = overlay->boundary_offsets[c + 1] - first;
+    const double* row = overlay->clique + overlay->clique_offsets[c] + (size_t)index * k;
+    for (int j = 0; j < k; j++) {
+        if (j == index || row[j] == DBL_MAX) continue;
+        relax(search, u, overlay->boundary[first + j], d + row[j]);
+        search->stats.edges_relaxed++;
+    }
+    return true;
+}
+
+// Dijkstra from source restricted to cell c of a level, stopping once target
+// is settled (target < 0 settles the whole cell). Level 0 walks original arcs;
+// higher levels walk the boundary vertices of the subcells, using subcell
+// cliques inside a subcell and original arcs between subcells. False when
+// target was not reached or memory ran out.
+static bool cell_search(const CrpEngine* crp, const Graph* graph, SearchWorkspace* search,
+                        int level, int c, int source, int target) {
+    search_workspace_begin(search);
+    const int* cells = crp->levels[level].cells;
+    const int* subcells = level > 0 ? crp->levels[level - 1].cells : NULL;
+    relax(search, -1, source, 0.0);
+
+    while (!min_heap_is_empty(search->heap) && search->status == SEARCH_COMPLETED) {
+        int u = min_heap_pop(search->heap).vertex;
+        if (search->closed[u] == search->generation) continue;
+        search->closed[u] = search->generation;
+        if (u == target) return true;
+
+        double d = search->dist[u];
+        if (subcells) relax_clique(crp, search, level - 1, u, d);
+        for (Edge* edge = graph->adj_list[u]; edge; edge = edge->next) {
+            int w = edge->dest;
+            if (cells[w] != c || (subcells && subcells[w] == subcells[u])) continue;
+            relax(search, u, w, d + edge->weight);
+        }
+    }
+    return target < 0 && search->status == SEARCH_COMPLETED;
+}
+
+// ---------------------------------------------------------------------------
+// Customization
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    CrpEngine* crp;
+    const Graph* graph;
+    SearchWorkspace** workspaces;  // One per thread
+    int level;
+    const int* cells;            // Dirty cells of the level
+    atomic_bool failed;          // A search ran out of memory
+} CustomizeContext;
+
+static void customize_cell(CustomizeContext* ctx, SearchWorkspace* search, int c) {
+    CrpLevel* overlay = &ctx->crp->levels[ctx->level];
+    int first = overlay->boundary_offsets[c];
+    int k = overlay->boundary_offsets[c + 1] - first;
+    double* clique = overlay->clique + overlay->clique_offsets[c];
+
+    for (int i = 0; i < k; i++) {
+        if (!cell_search(ctx->crp, ctx->graph, search, ctx->level, c, overlay->boundary[first + i], -1)) {
+            atomic_store(&ctx->failed, true);
+            return;
+        }
+        double* row = clique + (size_t)i * k;
+        for (int j = 0; j < k; j++) {
+            int b = overlay->boundary[first + j];
+            row[j] = search->closed[b] == search->generation ? search->dist[b] : DBL_MAX;
+        }
+    }
+}
+
+static void customize_range(size_t begin, size_t end, int thread_id, void* arg) {
+    CustomizeContext* ctx = (CustomizeContext*)arg;
+    for (size_t i = begin; i < end; i++) {
+        customize_cell(ctx, ctx->workspaces[thread_id], ctx->cells[i]);
+    }
+}
+
+// Mark the cells holding arc u -> w on every level where it does not cross
+static void mark_arc(CrpEngine* crp, int u, int w) {
+    for (int l = 0; l < crp->num_levels; l++) {
+        const CrpLevel* level = &crp->levels[l];
+        if (level->cells[u] == level->cells[w]) level->dirty[level->cells[u]] = true;
+    }
+}
+
+int crp_customize(CrpEngine* crp, const Graph* graph, int num_threads) {
+    if (!crp || !graph) return -1;
+
+    int count = 0;
+    bool same_topology = graph->num_vertices == crp->num_vertices;
+    for (int u = 0; u < graph->num_vertices && same_topology; u++) {
+        for (Edge* edge = graph->adj_list[u]; edge; edge = edge->next, count++) {
+            if (count >= crp->num_arcs || crp->arc_heads[count] != edge->dest) {
+                same_topology = false;
+                break;
+            }
+            if (edge->weight < 0) {
+                fprintf(stderr, "Error: Overlay requires non-negative edge weights\n");
+                return -1;
+            }
+        }
+    }
+    if (!same_topology || count != crp->num_arcs) {
+        fprintf(stderr, "Error: Graph topology differs from the one the overlay was built for\n");
+        return -1;
+    }
+
+    int i = 0;
+    for (int u = 0; u < graph->num_vertices; u++) {
+        for (Edge* edge = graph->adj_list[u]; edge; edge = edge->next, i++) {
+            if (edge->weight != crp->arc_weights[i]) {
+                crp->arc_weights[i] = edge->weight;
+                mark_arc(crp, u, edge->dest);
+            }
+        }
+    }
+
+    // Collect dirty cells; one workspace per thread that can get work
+    int most_dirty = 0;
+    for (int l = 0; l < crp->num_levels; l++) {
+        int dirty = 0;
+        for (int c = 0; c < crp->levels[l].num_cells; c++) dirty += crp->levels[l].dirty[c];
+        if (dirty > most_dirty) most_dirty = dirty;
+    }
+    if (most_dirty == 0) {
+        crp->customized = true;
+        return 0;
+    }
+    int threads = parallel_resolve_threads(num_threads);
+    if (threads > most_dirty) threads = most_dirty;
+    int* cells = (int*)malloc(most_dirty * sizeof(int));
+    SearchWorkspace** workspaces = (SearchWorkspace**)calloc(threads, sizeof(SearchWorkspace*));
+    bool ok = cells && workspaces;
+    for (int t = 0; t < threads && ok; t++) {
+        workspaces[t] = search_workspace_create(crp->num_vertices);
+        ok = workspaces[t] != NULL;
+    }
+
+    int recomputed = 0;
+    if (ok) {
+        // Bottom-up: a level's searches read the finished cliques below it.
+        // Cells stay dirty until their clique is complete.
+        CustomizeContext ctx = {crp, graph, workspaces, 0, cells, false};
+        for (int l = 0; l < crp->num_levels && ok; l++) {
+            CrpLevel* level = &crp->levels[l];
+            int dirty = 0;
+            for (int c = 0; c < level->num_cells; c++) {
+                if (level->dirty[c]) cells[dirty++] = c;
+            }
+            ctx.level = l;
+            parallel_for(threads, dirty, customize_range, &ctx);
+            ok = !atomic_load(&ctx.failed);
+            if (!ok) break;
+            for (int d = 0; d < dirty; d++) level->dirty[cells[d]] = false;
+            recomputed += dirty;
+        }
+        crp->customized = ok;
+    }
+    if (!ok) {
+        fprintf(stderr, "Error: Memory allocation failed for overlay customization\n");
+        recomputed = -1;
+    }
+
+    if (workspaces) {
+        for (int t = 0; t < threads; t++) search_workspace_destroy(workspaces[t]);
+    }
+    free(workspaces);
+    free(cells);
+    return recomputed;
+}
+
+// ---------------------------------------------------------------------------
+// Queries
+// ---------------------------------------------------------------------------
+
+// Highest level on which v shares a cell with neither endpoint (-1: none)
+static int query_level(const CrpEngine* crp, int v, int s, int t) {
+    for (int l = crp->num_levels - 1; l >= 0; l--) {
+        const int* cells = crp->levels[l].cells;
+        if (cells[v] != cells[s] && cells[v] != cells[t]) return l;
+    }
+    return -1;
+}
+
+// Clique level of the arc a -> b the search took (-1: original arc). An
+// original arc that accounts for the distance exactly is as good as the clique
+// arc, so it is used whenever there is one.
+static int arc_via(const Graph* graph, const SearchWorkspace* search, int a, int b, int clique_level) {
+    for (Edge* edge = graph->adj_list[a]; edge; edge = edge->next) {
+        if (edge->dest == b && search->dist[a] + edge->weight == search->dist[b]) return -1;
+    }
+    return clique_level;
+}
+
+// Copy the parent chain ending at end out of the workspace, start first, with
+// the level of the arc into each vertex. clique_level is the level of the
+// cliques a cell search used (-1: none); a query (query set) picks the level
+// per vertex from its start and end.
+static bool extract_chain(const CrpEngine* crp, const Graph* graph, const SearchWorkspace* search,
+                          bool query, int start, int end, int clique_level,
+                          IntVector* vertices, IntVector* vias) {
+    vertices->size = 0;
+    vias->size = 0;
+    for (int v = end; v >= 0; v = search->parent[v]) {
+        if (!int_vector_push(vertices, v)) return false;
+    }
+    for (int i = 0, j = vertices->size - 1; i < j; i++, j--) {
+        int vertex = vertices->items[i];
+        vertices->items[i] = vertices->items[j];
+        vertices->items[j] = vertex;
+    }
+    if (!int_vector_push(vias, -1)) return false;
+    for (int i = 1; i < vertices->size; i++) {
+        int a = vertices->items[i - 1];
+        int level = query ? query_level(crp, a, start, end) : clique_level;
+        if (!int_vector_push(vias, arc_via(graph, search, a, vertices->items[i], level))) return false;
+    }
+    return true;
+}
+
+// Append the original vertices after a on the path a -> b; via is the level
+// of the clique arc between them (-1: original arc)
+static bool unpack_arc(const CrpEngine* crp, const Graph* graph, SearchWorkspace* search,
+                       int a, int b, int via, IntVector* out) {
+    if (via < 0) return int_vector_push(out, b);
+    int c = crp->levels[via].cells[a];
+    if (!cell_search(crp, graph, search, via, c, a, b)) return false;
+
+    IntVector vertices = {NULL, 0, 0};
+    IntVector vias = {NULL, 0, 0};
+    bool ok = extract_chain(crp, graph, search, false, a, b, via - 1, &vertices, &vias);
+    for (int i = 1; i < vertices.size && ok; i++) {
+        ok = unpack_arc(crp, graph, search, vertices.items[i - 1], vertices.items[i],
+                        vias.items[i], out);
+    }
+    free(vertices.items);
+    free(vias.items);
+    return ok;
+}
+
+PathResult* crp_find_path(const CrpEngine* crp, const Graph* graph, int start, int end) {
+    SearchWorkspace* workspace = search_workspace_create(crp ? crp->num_vertices : 0);
+    if (!workspace) {
+        PathResult* result = path_result_create();
+        if (result) result->status = SEARCH_OUT_OF_MEMORY;
+        return result;
+    }
+    PathResult* result = crp_find_path_with_workspace(crp, graph, workspace, start, end);
+    if (result) {
+        result->stats.bytes_allocated = (size_t)workspace->capacity * (sizeof(double) + 5 * sizeof(int));
+    }
+    search_workspace_destroy(workspace);
+    return result;
+}
+
+PathResult* crp_find_path_with_workspace(const CrpEngine* crp, const Graph* graph,
+                                         SearchWorkspace* workspace, int start, int end) {
+    PathResult* result = path_result_create();
+    if (!result) return NULL;
+
+    result->algorithm = "CRP";
+    result->suboptimality_bound = 1.0;
+
+    if (!crp || !graph || !workspace || graph->num_vertices != crp->num_vertices ||
+        start < 0 || start >= crp->num_vertices || end < 0 || end >= crp->num_vertices) {
+        fprintf(stderr, "Error: Invalid start or end vertex\n");
+        return result;
+    }
+    if (!crp->customized) {
+        fprintf(stderr, "Error: Overlay has not been customized\n");
+        return result;
+    }
+
+    SearchStats* stats = &result->stats;
+    long long start_ns = graph_clock_ns();
+    SearchWorkspace* search = workspace;
+    if (!search_workspace_reserve(search, crp->num_vertices)) {
+        result->status = SEARCH_OUT_OF_MEMORY;
+        return result;
+    }
+    search_workspace_begin(search);
+
+    long long search_ns = graph_clock_ns();
+    stats->init_ns = search_ns - start_ns;
+    relax(search, -1, start, 0.0);
+    bool found = false;
+    while (!min_heap_is_empty(search->heap) && search->status == SEARCH_COMPLETED) {
+        int u = min_heap_pop(search->heap).vertex;
+        search->stats.heap_pops++;
+        if (search->closed[u] == search->generation) continue;
+        search->closed[u] = search->generation;
+        search->stats.vertices_settled++;
+        if (u == end) {
+            found = true;
+            break;
+        }
+
+        double d = search->dist[u];
+        int level = query_level(crp, u, start, end);
+        if (level >= 0 && relax_clique(crp, search, level, u, d)) {
+            // Inside a far cell only the arcs leaving it matter
+            const int* cells = crp->levels[level].cells;
+            for (Edge* edge = graph->adj_list[u]; edge; edge = edge->next) {
+                if (cells[edge->dest] == cells[u]) continue;
+                relax(search, u, edge->dest, d + edge->weight);
+                search->stats.edges_relaxed++;
+            }
+        } else {
+            for (Edge* edge = graph->adj_list[u]; edge; edge = edge->next) {
+                relax(search, u, edge->dest, d + edge->weight);
+                search->stats.edges_relaxed++;
+            }
+        }
+    }
+    stats->vertices_settled = search->stats.vertices_settled;
+    stats->edges_relaxed = search->stats.edges_relaxed;
+    stats->heap_pushes = search->stats.heap_pushes;
+    stats->heap_pops = search->stats.heap_pops;
+    result->status = search->status;
+
+    long long reconstruct_ns = graph_clock_ns();
+    stats->search_ns = reconstruct_ns - search_ns;
+
+    if (found) {
+        double distance = search->dist[end];
+        IntVector vertices = {NULL, 0, 0};
+        IntVector vias = {NULL, 0, 0};
+        IntVector path = {NULL, 0, 0};
+        bool ok = extract_chain(crp, graph, search, true, start, end, -1, &vertices, &vias) &&
+                  int_vector_push(&path, start);
+        for (int i = 1; i < vertices.size && ok; i++) {
+            ok = unpack_arc(crp, graph, search, vertices.items[i - 1], vertices.items[i],
+                            vias.items[i], &path);
+        }
+        if (ok) {
+            result->path = path.items;
+            result->path_length = path.size;
+            result->total_weight = distance;
+            result->found = true;
+        } else {
+            // Unpacking only fails when memory runs out
+            free(path.items);
+            result->status = SEARCH_OUT_OF_MEMORY;
+        }
+        free(vertices.items);
+        free(vias.items);
+    }
+
+    long long end_ns = graph_clock_ns();
+    stats->reconstruct_ns = end_ns - reconstruct_ns;
+    result->time_ms = (end_ns - start_ns) / 1e6;
+    return result;
+}
+
+const Partition* crp_partition(const CrpEngine* crp) {
+    return crp ? crp->partition : NULL;
+}
+
+int crp_num_boundary_vertices(const CrpEngine* crp, int level) {
+    if (!crp || level < 0 || level >= crp->num_levels) return -1;
+    return crp->levels[level].boundary_offsets[crp->levels[level].num_cells];
+}
+
+size_t crp_memory_usage(const CrpEngine* crp) {
+    if (!crp) return 0;
+    size_t n = crp->num_vertices;
+    size_t bytes = sizeof(CrpEngine) + crp->num_levels * sizeof(CrpLevel) +
+                   crp->num_levels * (n + 1) * sizeof(int) +               // partition
+                   (size_t)crp->num_arcs * (sizeof(int) + sizeof(double)); // weight copy
+    for (int l = 0; l < crp->num_levels; l++) {
+        const CrpLevel* level = &crp->levels[l];
+        size_t cells = level->num_cells;
+        bytes += n * sizeof(int) +                                          // boundary index
+                 (cells + 1) * (sizeof(int) + sizeof(size_t)) + cells * sizeof(bool) +
+                 level->boundary_offsets[cells] * sizeof(int) +
+                 level->clique_offsets[cells] * sizeof(double);
+    }
+    return bytes;
+}
@@ -2,7 +2,6 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <time.h>
 
 // Stack for iterative DFS
 typedef struct {
@@ -56,45 +55,25 @@ static int stack_pop(Stack* stack) {
     return stack->data[stack->top--];
 }
 
-// Reconstruct path from parent array
-static int* reconstruct_path(int* parent, int start, int end, int* path_length) {
-    if (parent[end] == -1 && start != end) {
-        *path_length = 0;
-        return NULL;
-    }
-
-    // Count path length
-    int count = 0;
-    for (int v = end; v != -1; v = parent[v]) {
-        count++;
-    }
-
-    int* path = (int*)malloc(count * sizeof(int));
-    if (!path) return NULL;
-
-    // Fill path in reverse
-    int index = count - 1;
-    for (int v = end; v != -1; v = parent[v]) {
-        path[index--] = v;
-    }
-
-    *path_length = count;
-    return path;
-}
-
 // DFS algorithm implementation (iterative)
-PathResult* dfs_find_path(const Graph* graph, int start, int end) {
+PathResult* dfs_find_path_limited(const Graph* graph, int start, int end,
+                                  const SearchLimits* limits) {
     PathResult* result = path_result_create();
     if (!result) return NULL;
 
     result->algorithm = "DFS (Depth-First Search)";
+    result->suboptimality_bound = 0.0;  // Any path, not the shortest
 
     if (!graph_is_valid_vertex(graph, start) || !graph_is_valid_vertex(graph, end)) {
         fprintf(stderr, "Error: Invalid start or end vertex\n");
         return result;
     }
+    if (graph_path_ruled_out(graph, start, end)) {
+        return result;  // Proven unreachable by the graph's index
+    }
 
-    clock_t start_time = clock();
+    SearchStats* stats = &result->stats;
+    long long start_ns = graph_clock_ns();
 
     int n = graph->num_vertices;
     bool* visited = (bool*)calloc(n, sizeof(bool));
@@ -114,13 +93,24 @@ PathResult* dfs_find_path(const Graph* graph, int start, int end) {
     }
 
     stack_push(stack, start);
+    stats->heap_pushes = 1;
+    stats->peak_queue_size = 1;
+
+    long long search_ns = graph_clock_ns();
+    stats->init_ns = search_ns - start_ns;
 
     // DFS traversal
     while (!stack_is_empty(stack)) {
         int current = stack_pop(stack);
+        stats->heap_pops++;
+        if ((stats->heap_pops & (SEARCH_LIMITS_CHECK_INTERVAL - 1)) == 0 &&
+            (result->status = search_limits_check(limits)) != SEARCH_COMPLETED) {
+            break;
+        }
 
         if (!visited[current]) {
             visited[current] = true;
+            stats->vertices_settled++;
 
             if (current == end) {
                 break;
@@ -128,20 +118,30 @@ PathResult* dfs_find_path(const Graph* graph, int start, int end) {
 
             Edge* edge = graph->adj_list[current];
             while (edge) {
+                stats->edges_relaxed++;
                 if (!visited[edge->dest]) {
                     if (parent[edge->dest] == -1 && edge->dest != start) {
                         parent[edge->dest] = current;
                     }
                     stack_push(stack, edge->dest);
+                    stats->heap_pushes++;
+                    if (stack->top + 1 > stats->peak_queue_size) {
+                        stats->peak_queue_size = stack->top + 1;
+                    }
                 }
                 edge = edge->next;
             }
         }
     }
 
-    // Reconstruct path
-    result->path = reconstruct_path(parent, start, end, &result->path_length);
-    result->found = (result->path != NULL);
+    long long reconstruct_ns = graph_clock_ns();
+    stats->search_ns = reconstruct_ns - search_ns;
+
+    // Reconstruct path (an interrupted search may hold a partial one)
+    if (result->status == SEARCH_COMPLETED) {
+        result->path = path_reconstruct(parent, start, end, &result->path_length);
+        result->found = (result->path != NULL);
+    }
 
     // Calculate total weight
     if (result->found) {
@@ -160,8 +160,11 @@ PathResult* dfs_find_path(const Graph* graph, int start, int end) {
         }
     }
 
-    clock_t end_time = clock();
-    result->time_ms = ((double)(end_time - start_time) / CLOCKS_PER_SEC) * 1000.0;
+    long long end_ns = graph_clock_ns();
+    stats->reconstruct_ns = end_ns - reconstruct_ns;
+    stats->bytes_allocated = n * (sizeof(bool) + sizeof(int)) +
+                             sizeof(Stack) + stack->capacity * sizeof(int);
+    result->time_ms = (end_ns - start_ns) / 1e6;
 
     free(visited);
     free(parent);
@@ -169,3 +172,7 @@ PathResult* dfs_find_path(const Graph* graph, int start, int end) {
 
     return result;
 }
+
+PathResult* dfs_find_path(const Graph* graph, int start, int end) {
+    return dfs_find_path_limited(graph, start, end, NULL);
+}
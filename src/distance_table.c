@@ -0,0 +1,256 @@
+#include "distance_table.h"
+#include "parallel.h"
+#include "search_workspace.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include <stdatomic.h>
+
+// Flat copy of the adjacency lists. Every row scans most of the graph, so one
+// O(E) copy up front pays for itself in sequential, pointer-free scans.
+typedef struct {
+    int* offsets;                // n + 1
+    int* dests;
+    double* weights;
+} FlatAdjacency;
+
+// Shared, read-only description of the query plus the work queue
+typedef struct {
+    const Graph* graph;
+    FlatAdjacency adjacency;
+    const int* sources;
+    int num_sources;
+    const int* targets;
+    int num_targets;
+    int num_unique_targets;
+    const int* first_target;     // Per vertex: first index in targets, or -1
+    double* distances;
+    int** paths;
+    int* path_lengths;
+    atomic_int next_source;      // Sources are handed out one at a time
+    atomic_bool failed;
+    atomic_llong vertices_settled;
+} DistanceTableContext;
+
+void distance_table_options_init(DistanceTableOptions* options) {
+    if (!options) return;
+    memset(options, 0, sizeof(DistanceTableOptions));
+}
+
+// Multi-target Dijkstra from one source, stopping once all targets are settled
+static void table_row(DistanceTableContext* ctx, SearchWorkspace* workspace, int row) {
+    const FlatAdjacency* adjacency = &ctx->adjacency;
+    int source = ctx->sources[row];
+
+    search_workspace_begin(workspace);
+    unsigned int generation = workspace->generation;
+    MinHeap* heap = workspace->heap;
+    int remaining = ctx->num_unique_targets;
+    long long settled = 0;
+
+    workspace->seen[source] = generation;
+    workspace->dist[source] = 0.0;
+    workspace->parent[source] = -1;
+    min_heap_push(heap, source, 0.0);
+
+    while (remaining > 0 && !min_heap_is_empty(heap)) {
+        int u = min_heap_pop(heap).vertex;
+        if (workspace->closed[u] == generation) continue;
+        workspace->closed[u] = generation;
+        settled++;
+        if (ctx->first_target[u] >= 0 && --remaining == 0) break;
+
+        double dist_u = workspace->dist[u];
+        int arc_end = adjacency->offsets[u + 1];
+        for (int arc = adjacency->offsets[u]; arc < arc_end; arc++) {
+            int v = adjacency->dests[arc];
+            if (workspace->closed[v] == generation) continue;
+            double candidate = dist_u + adjacency->weights[arc];
+            if (workspace->seen[v] != generation || candidate < workspace->dist[v]) {
+                workspace->seen[v] = generation;
+                workspace->dist[v] = candidate;
+                workspace->parent[v] = u;
+                if (!min_heap_push(heap, v, candidate)) {
+                    atomic_store(&ctx->failed, true);
+                    return;
+                }
+            }
+        }
+    }
+    atomic_fetch_add_explicit(&ctx->vertices_settled, settled, memory_order_relaxed);
+
+    size_t base = (size_t)row * ctx->num_targets;
+    for (int j = 0; j < ctx->num_targets; j++) {
+        int target = ctx->targets[j];
+        bool reached = (workspace->closed[target] == generation);
+        ctx->distances[base + j] = reached ? workspace->dist[target] : DBL_MAX;
+        if (!ctx->paths) continue;
+
+        ctx->paths[base + j] = NULL;
+        ctx->path_lengths[base + j] = 0;
+        if (!reached) continue;
+
+        int count = 0;
+        for (int v = target; v != -1; v = workspace->parent[v]) {
+            count++;
+        }
+        int* path = (int*)malloc(count * sizeof(int));
+        if (!path) {
+            atomic_store(&ctx->failed, true);
+            continue;
+        }
+        int index = count;
+        for (int v = target; v != -1; v = workspace->parent[v]) {
+            path[--index] = v;
+        }
+        ctx->paths[base + j] = path;
+        ctx->path_lengths[base + j] = count;
+    }
+}
+
+// One block per thread; rows are claimed dynamically so uneven searches balance
+static void table_worker(size_t begin, size_t end, int thread_id, void* context) {
+    (void)begin;
+    (void)end;
+    (void)thread_id;
+    DistanceTableContext* ctx = (DistanceTableContext*)context;
+
+    SearchWorkspace* workspace = search_workspace_create(ctx->graph->num_vertices);
+    if (!workspace) {
+        atomic_store(&ctx->failed, true);
+        return;
+    }
+    int row;
+    while (!atomic_load_explicit(&ctx->failed, memory_order_relaxed) &&
+           (row = atomic_fetch_add(&ctx->next_source, 1)) < ctx->num_sources) {
+        table_row(ctx, workspace, row);
+    }
+    search_workspace_destroy(workspace);
+}
+
+static bool flat_adjacency_build(const Graph* graph, FlatAdjacency* adjacency) {
+    int n = graph->num_vertices;
+    size_t arcs = 0;
+    for (int u = 0; u < n; u++) {
+        for (Edge* edge = graph->adj_list[u]; edge; edge = edge->next) {
+            arcs++;
+        }
+    }
+
+    adjacency->offsets = (int*)malloc((n + 1) * sizeof(int));
+    adjacency->dests = (int*)malloc((arcs > 0 ? arcs : 1) * sizeof(int));
+    adjacency->weights = (double*)malloc((arcs > 0 ? arcs : 1) * sizeof(double));
+    if (!adjacency->offsets || !adjacency->dests || !adjacency->weights) {
+        return false;
+    }
+
+    int arc = 0;
+    for (int u = 0; u < n; u++) {
+        adjacency->offsets[u] = arc;
+        for (Edge* edge = graph->adj_list[u]; edge; edge = edge->next) {
+            adjacency->dests[arc] = edge->dest;
+            adjacency->weights[arc] = edge->weight;
+            arc++;
+        }
+    }
+    adjacency->offsets[n] = arc;
+    return true;
+}
+
+static void flat_adjacency_free(FlatAdjacency* adjacency) {
+    free(adjacency->offsets);
+    free(adjacency->dests);
+    free(adjacency->weights);
+}
+
+bool distance_table_compute(const Graph* graph,
+                            const int* sources, int num_sources,
+                            const int* targets, int num_targets,
+                            double* distances, const DistanceTableOptions* options) {
+    DistanceTableOptions defaults;
+    distance_table_options_init(&defaults);
+    if (!options) options = &defaults;
+
+    if (!graph || !sources || !targets || !distances || num_sources < 0 || num_targets < 0 ||
+        (options->paths && !options->path_lengths)) {
+        fprintf(stderr, "Error: Invalid distance table arguments\n");
+        return false;
+    }
+    for (int i = 0; i < num_sources; i++) {
+        if (!graph_is_valid_vertex(graph, sources[i])) {
+            fprintf(stderr, "Error: Invalid source vertex %d\n", sources[i]);
+            return false;
+        }
+    }
+    for (int j = 0; j < num_targets; j++) {
+        if (!graph_is_valid_vertex(graph, targets[j])) {
+            fprintf(stderr, "Error: Invalid target vertex %d\n", targets[j]);
+            return false;
+        }
+    }
+    if (options->paths) {
+        memset(options->paths, 0, (size_t)num_sources * num_targets * sizeof(int*));
+    }
+    if (num_sources == 0 || num_targets == 0) return true;
+
+    FlatAdjacency adjacency = {NULL, NULL, NULL};
+    int* first_target = (int*)malloc(graph->num_vertices * sizeof(int));
+    if (!first_target || !flat_adjacency_build(graph, &adjacency)) {
+        fprintf(stderr, "Error: Memory allocation failed for distance table\n");
+        free(first_target);
+        flat_adjacency_free(&adjacency);
+        return false;
+    }
+    memset(first_target, -1, graph->num_vertices * sizeof(int));
+    int num_unique = 0;
+    for (int j = 0; j < num_targets; j++) {
+        if (first_target[targets[j]] < 0) {
+            first_target[targets[j]] = j;
+            num_unique++;
+        }
+    }
+
+    DistanceTableContext ctx = {
+        .graph = graph,
+        .adjacency = adjacency,
+        .sources = sources,
+        .num_sources = num_sources,
+        .targets = targets,
+        .num_targets = num_targets,
+        .num_unique_targets = num_unique,
+        .first_target = first_target,
+        .distances = distances,
+        .paths = options->paths,
+        .path_lengths = options->path_lengths,
+    };
+    atomic_init(&ctx.next_source, 0);
+    atomic_init(&ctx.failed, false);
+    atomic_init(&ctx.vertices_settled, 0);
+
+    int num_threads = parallel_resolve_threads(options->num_threads);
+    if (num_threads > num_sources) num_threads = num_sources;
+    parallel_for(num_threads, (size_t)num_threads, table_worker, &ctx);
+    free(first_target);
+    flat_adjacency_free(&adjacency);
+
+    if (options->vertices_settled) {
+        *options->vertices_settled = atomic_load(&ctx.vertices_settled);
+    }
+    if (atomic_load(&ctx.failed)) {
+        fprintf(stderr, "Error: Memory allocation failed for distance table\n");
+        if (options->paths) {
+            distance_table_free_paths(options->paths, (size_t)num_sources * num_targets);
+        }
+        return false;
+    }
+    return true;
+}
+
+void distance_table_free_paths(int** paths, size_t count) {
+    if (!paths) return;
+    for (size_t i = 0; i < count; i++) {
+        free(paths[i]);
+        paths[i] = NULL;
+    }
+}
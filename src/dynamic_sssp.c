@@ -0,0 +1,339 @@
+#include "dynamic_sssp.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <float.h>
+
+static bool dynamic_sssp_reserve(DynamicSssp* tree, int num_vertices) {
+    if (num_vertices <= tree->capacity) return true;
+
+    double* dist = (double*)realloc(tree->dist, num_vertices * sizeof(double));
+    if (dist) tree->dist = dist;
+    int* parent = (int*)realloc(tree->parent, num_vertices * sizeof(int));
+    if (parent) tree->parent = parent;
+    int** in_neighbors = (int**)realloc(tree->in_neighbors, num_vertices * sizeof(int*));
+    if (in_neighbors) tree->in_neighbors = in_neighbors;
+    int* in_degree = (int*)realloc(tree->in_degree, num_vertices * sizeof(int));
+    if (in_degree) tree->in_degree = in_degree;
+    int* in_capacity = (int*)realloc(tree->in_capacity, num_vertices * sizeof(int));
+    if (in_capacity) tree->in_capacity = in_capacity;
+    unsigned int* mark = (unsigned int*)realloc(tree->mark, num_vertices * sizeof(unsigned int));
+    if (mark) tree->mark = mark;
+    int* stack = (int*)realloc(tree->stack, num_vertices * sizeof(int));
+    if (stack) tree->stack = stack;
+
+    if (!dist || !parent || !in_neighbors || !in_degree || !in_capacity || !mark || !stack) {
+        fprintf(stderr, "Error: Memory allocation failed for dynamic shortest path tree\n");
+        return false;
+    }
+    for (int v = tree->capacity; v < num_vertices; v++) {
+        tree->dist[v] = DBL_MAX;
+        tree->parent[v] = -1;
+        tree->in_neighbors[v] = NULL;
+        tree->in_degree[v] = 0;
+        tree->in_capacity[v] = 0;
+        tree->mark[v] = 0;
+    }
+    tree->capacity = num_vertices;
+    return true;
+}
+
+// Cheapest arc from u to v; DBL_MAX when there is none
+static double arc_weight(const Graph* graph, int u, int v) {
+    double best = DBL_MAX;
+    for (Edge* edge = graph->adj_list[u]; edge; edge = edge->next) {
+        if (edge->dest == v && edge->weight < best) best = edge->weight;
+    }
+    return best;
+}
+
+static int in_find(const DynamicSssp* tree, int v, int u) {
+    for (int i = 0; i < tree->in_degree[v]; i++) {
+        if (tree->in_neighbors[v][i] == u) return i;
+    }
+    return -1;
+}
+
+static bool in_add(DynamicSssp* tree, int v, int u) {
+    if (tree->in_degree[v] == tree->in_capacity[v]) {
+        int capacity = tree->in_capacity[v] ? tree->in_capacity[v] * 2 : 4;
+        int* items = (int*)realloc(tree->in_neighbors[v], capacity * sizeof(int));
+        if (!items) {
+            fprintf(stderr, "Error: Memory allocation failed for dynamic shortest path tree\n");
+            return false;
+        }
+        tree->in_neighbors[v] = items;
+        tree->in_capacity[v] = capacity;
+    }
+    tree->in_neighbors[v][tree->in_degree[v]++] = u;
+    return true;
+}
+
+// Start a new affected set: invalidates all marks in O(1)
+static void next_mark(DynamicSssp* tree) {
+    if (tree->mark_generation == UINT_MAX) {
+        memset(tree->mark, 0, tree->capacity * sizeof(unsigned int));
+        tree->mark_generation = 0;
+    }
+    tree->mark_generation++;
+}
+
+// Settle the heap, relaxing arcs into vertices that may still improve
+// (everything, or only marked vertices when restricted)
+static void propagate(DynamicSssp* tree, const Graph* graph, bool restricted) {
+    while (!min_heap_is_empty(tree->heap)) {
+        HeapNode node = min_heap_pop(tree->heap);
+        int u = node.vertex;
+        if (node.key > tree->dist[u]) continue;  // Stale entry
+        if (!restricted) tree->last_affected++;
+
+        for (Edge* edge = graph->adj_list[u]; edge; edge = edge->next) {
+            int v = edge->dest;
+            if (restricted && tree->mark[v] != tree->mark_generation) continue;
+            double candidate = node.key + edge->weight;
+            if (candidate < tree->dist[v]) {
+                tree->dist[v] = candidate;
+                tree->parent[v] = u;
+                min_heap_push(tree->heap, v, candidate);
+            }
+        }
+    }
+}
+
+// Remember the graph state the tree now describes
+static void dynamic_sssp_sync(DynamicSssp* tree, const Graph* graph) {
+    tree->graph_version = graph->version;
+    tree->graph_changes = graph->changes;
+    tree->num_vertices = graph->num_vertices;
+}
+
+bool dynamic_sssp_recompute(DynamicSssp* tree, const Graph* graph) {
+    if (!tree || !graph) return false;
+    int n = graph->num_vertices;
+    if (tree->source >= n) {
+        fprintf(stderr, "Error: Invalid source vertex\n");
+        return false;
+    }
+    if (!dynamic_sssp_reserve(tree, n)) return false;
+
+    for (int u = 0; u < n; u++) {
+        for (Edge* edge = graph->adj_list[u]; edge; edge = edge->next) {
+            if (edge->weight < 0) {
+                fprintf(stderr, "Error: Dynamic shortest path tree requires non-negative edge weights\n");
+                return false;
+            }
+        }
+    }
+
+    // In-neighbours are needed to re-seed affected vertices of directed graphs.
+    // Arcs of u are added together, so a duplicate tail is always the last entry.
+    for (int v = 0; v < tree->capacity; v++) {
+        tree->dist[v] = DBL_MAX;
+        tree->parent[v] = -1;
+        tree->in_degree[v] = 0;
+    }
+    if (graph->is_directed) {
+        for (int u = 0; u < n; u++) {
+            for (Edge* edge = graph->adj_list[u]; edge; edge = edge->next) {
+                int v = edge->dest;
+                if (tree->in_degree[v] > 0 && tree->in_neighbors[v][tree->in_degree[v] - 1] == u) continue;
+                if (!in_add(tree, v, u)) return false;
+            }
+        }
+    }
+
+    min_heap_clear(tree->heap);
+    tree->last_affected = 0;
+    tree->dist[tree->source] = 0.0;
+    min_heap_push(tree->heap, tree->source, 0.0);
+    propagate(tree, graph, false);
+    dynamic_sssp_sync(tree, graph);
+    return true;
+}
+
+DynamicSssp* dynamic_sssp_create(const Graph* graph, int source) {
+    if (!graph_is_valid_vertex(graph, source)) {
+        fprintf(stderr, "Error: Invalid source vertex\n");
+        return NULL;
+    }
+    DynamicSssp* tree = (DynamicSssp*)calloc(1, sizeof(DynamicSssp));
+    if (!tree) {
+        fprintf(stderr, "Error: Memory allocation failed for dynamic shortest path tree\n");
+        return NULL;
+    }
+    tree->source = source;
+    tree->heap = min_heap_create(1024);
+    if (!tree->heap || !dynamic_sssp_recompute(tree, graph)) {
+        dynamic_sssp_destroy(tree);
+        return NULL;
+    }
+    return tree;
+}
+
+void dynamic_sssp_destroy(DynamicSssp* tree) {
+    if (!tree) return;
+    if (tree->in_neighbors) {
+        for (int v = 0; v < tree->capacity; v++) free(tree->in_neighbors[v]);
+    }
+    free(tree->in_neighbors);
+    free(tree->in_degree);
+    free(tree->in_capacity);
+    free(tree->dist);
+    free(tree->parent);
+    free(tree->mark);
+    free(tree->stack);
+    min_heap_destroy(tree->heap);
+    free(tree);
+}
+
+// The tree arc into v got longer or vanished: re-examine the subtree below v
+static void repair_subtree(DynamicSssp* tree, const Graph* graph, int v) {
+    next_mark(tree);
+    unsigned int generation = tree->mark_generation;
+    int* affected = tree->stack;
+    int count = 0;
+    affected[count++] = v;
+    tree->mark[v] = generation;
+    for (int i = 0; i < count; i++) {
+        int u = affected[i];
+        for (Edge* edge = graph->adj_list[u]; edge; edge = edge->next) {
+            int w = edge->dest;
+            if (tree->parent[w] == u && tree->mark[w] != generation) {
+                tree->mark[w] = generation;
+                affected[count++] = w;
+            }
+        }
+    }
+    tree->last_affected += count;
+
+    // Best entry into each affected vertex from outside the subtree, whose
+    // distances the change cannot have touched
+    min_heap_clear(tree->heap);
+    for (int i = 0; i < count; i++) {
+        int x = affected[i];
+        double best = DBL_MAX;
+        int best_parent = -1;
+        if (graph->is_directed) {
+            for (int j = 0; j < tree->in_degree[x]; j++) {
+                int z = tree->in_neighbors[x][j];
+                if (tree->mark[z] == generation || tree->dist[z] == DBL_MAX) continue;
+                double candidate = tree->dist[z] + arc_weight(graph, z, x);
+                if (candidate < best) {
+                    best = candidate;
+                    best_parent = z;
+                }
+            }
+        } else {
+            for (Edge* edge = graph->adj_list[x]; edge; edge = edge->next) {
+                int z = edge->dest;
+                if (tree->mark[z] == generation || tree->dist[z] == DBL_MAX) continue;
+                double candidate = tree->dist[z] + edge->weight;
+                if (candidate < best) {
+                    best = candidate;
+                    best_parent = z;
+                }
+            }
+        }
+        tree->dist[x] = best;
+        tree->parent[x] = best_parent;
+        if (best < DBL_MAX) min_heap_push(tree->heap, x, best);
+    }
+    propagate(tree, graph, true);
+}
+
+// Restore the invariant for the arcs u -> v given that it holds everywhere else
+static void repair_arc(DynamicSssp* tree, const Graph* graph, int u, int v) {
+    double weight = arc_weight(graph, u, v);
+    if (weight != DBL_MAX && tree->dist[u] != DBL_MAX && tree->dist[u] + weight < tree->dist[v]) {
+        tree->dist[v] = tree->dist[u] + weight;
+        tree->parent[v] = u;
+        min_heap_clear(tree->heap);
+        min_heap_push(tree->heap, v, tree->dist[v]);
+        propagate(tree, graph, false);
+    } else if (tree->parent[v] == u && (weight == DBL_MAX || tree->dist[u] + weight > tree->dist[v])) {
+        repair_subtree(tree, graph, v);
+    }
+}
+
+bool dynamic_sssp_update_edge(DynamicSssp* tree, const Graph* graph, int src, int dest) {
+    if (!tree || !graph_is_valid_vertex(graph, src) || !graph_is_valid_vertex(graph, dest)) {
+        fprintf(stderr, "Error: Invalid vertex (src: %d, dest: %d)\n", src, dest);
+        return false;
+    }
+    if (!dynamic_sssp_reserve(tree, graph->num_vertices)) return false;
+
+    // Repairs assume this pair is the only change besides added vertices
+    unsigned long long added = (graph->num_vertices >= tree->num_vertices)
+                             ? (unsigned long long)(graph->num_vertices - tree->num_vertices) : 0;
+    if (tree->graph_version == 0 || graph->num_vertices < tree->num_vertices ||
+        graph->changes - tree->graph_changes > added + 1) {
+        return dynamic_sssp_recompute(tree, graph);
+    }
+
+    double weight = arc_weight(graph, src, dest);
+    if (weight < 0) {
+        fprintf(stderr, "Error: Dynamic shortest path tree requires non-negative edge weights\n");
+        tree->graph_version = 0;  // Force a recompute before the next query
+        return false;
+    }
+    if (graph->is_directed) {
+        int index = in_find(tree, dest, src);
+        if (weight != DBL_MAX && index < 0) {
+            if (!in_add(tree, dest, src)) return false;
+        } else if (weight == DBL_MAX && index >= 0) {
+            tree->in_neighbors[dest][index] = tree->in_neighbors[dest][--tree->in_degree[dest]];
+        }
+    }
+
+    tree->last_affected = 0;
+    repair_arc(tree, graph, src, dest);
+    if (!graph->is_directed && src != dest) {
+        repair_arc(tree, graph, dest, src);
+    }
+    dynamic_sssp_sync(tree, graph);
+    return true;
+}
+
+double dynamic_sssp_distance(const DynamicSssp* tree, int vertex) {
+    if (!tree || vertex < 0 || vertex >= tree->capacity) return DBL_MAX;
+    return tree->dist[vertex];
+}
+
+PathResult* dynamic_sssp_find_path(DynamicSssp* tree, const Graph* graph, int target) {
+    PathResult* result = path_result_create();
+    if (!result) return NULL;
+
+    result->algorithm = "Dynamic SSSP";
+    result->suboptimality_bound = 1.0;
+
+    if (!tree || !graph_is_valid_vertex(graph, target)) {
+        fprintf(stderr, "Error: Invalid target vertex %d\n", target);
+        return result;
+    }
+
+    long long start_ns = graph_clock_ns();
+    if (graph->version != tree->graph_version && !dynamic_sssp_recompute(tree, graph)) {
+        return result;
+    }
+    long long reconstruct_ns = graph_clock_ns();
+    result->stats.search_ns = reconstruct_ns - start_ns;
+
+    if (tree->dist[target] != DBL_MAX) {
+        int count = 0;
+        for (int v = target; v != -1; v = tree->parent[v]) count++;
+        result->path = (int*)malloc(count * sizeof(int));
+        if (result->path) {
+            int index = count;
+            for (int v = target; v != -1; v = tree->parent[v]) result->path[--index] = v;
+            result->path_length = count;
+            result->total_weight = tree->dist[target];
+            result->found = true;
+        }
+    }
+
+    long long end_ns = graph_clock_ns();
+    result->stats.reconstruct_ns = end_ns - reconstruct_ns;
+    result->time_ms = (end_ns - start_ns) / 1e6;
+    return result;
+}
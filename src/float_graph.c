@@ -0,0 +1,434 @@
+#include "float_graph.h"
+#include "dijkstra.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include <math.h>
+
+// Priority queue node with a single-precision key (8 bytes instead of 16)
+typedef struct {
+    int vertex;
+    float key;
+} FloatPQNode;
+
+typedef struct {
+    FloatPQNode* nodes;
+    int size;
+    int capacity;
+} FloatPQ;
+
+static FloatPQ* float_pq_create(int capacity) {
+    FloatPQ* pq = (FloatPQ*)malloc(sizeof(FloatPQ));
+    if (!pq) return NULL;
+
+    pq->nodes = (FloatPQNode*)malloc(capacity * sizeof(FloatPQNode));
+    if (!pq->nodes) {
+        free(pq);
+        return NULL;
+    }
+
+    pq->size = 0;
+    pq->capacity = capacity;
+    return pq;
+}
+
+static void float_pq_destroy(FloatPQ* pq) {
+    if (!pq) return;
+    free(pq->nodes);
+    free(pq);
+}
+
+// Returns false, leaving the queue unchanged, when it cannot grow
+static bool float_pq_push(FloatPQ* pq, int vertex, float key) {
+    // Check if PQ needs to grow
+    if (pq->size >= pq->capacity) {
+        int new_capacity = pq->capacity * 2;
+        FloatPQNode* new_nodes = (FloatPQNode*)realloc(pq->nodes, new_capacity * sizeof(FloatPQNode));
+        if (!new_nodes) {
+            return false;
+        }
+        pq->nodes = new_nodes;
+        pq->capacity = new_capacity;
+    }
+
+    int index = pq->size++;
+    while (index > 0) {
+        int parent = (index - 1) / 2;
+        if (pq->nodes[parent].key <= key) break;
+        pq->nodes[index] = pq->nodes[parent];
+        index = parent;
+    }
+    pq->nodes[index].vertex = vertex;
+    pq->nodes[index].key = key;
+    return true;
+}
+
+static FloatPQNode float_pq_pop(FloatPQ* pq) {
+    FloatPQNode min = pq->nodes[0];
+    FloatPQNode last = pq->nodes[--pq->size];
+
+    int index = 0;
+    while (true) {
+        int child = 2 * index + 1;
+        if (child >= pq->size) break;
+        if (child + 1 < pq->size && pq->nodes[child + 1].key < pq->nodes[child].key) {
+            child++;
+        }
+        if (last.key <= pq->nodes[child].key) break;
+        pq->nodes[index] = pq->nodes[child];
+        index = child;
+    }
+    if (pq->size > 0) {
+        pq->nodes[index] = last;
+    }
+    return min;
+}
+
+static float arc_weight(const FloatGraph* fgraph, int arc) {
+    if (fgraph->storage == FLOAT_WEIGHTS_U16) {
+        return fgraph->qweights[arc] * fgraph->weight_scale;
+    }
+    return fgraph->weights[arc];
+}
+
+// Fit the heuristic scales to the stored weights. The small margin absorbs
+// float rounding in the heuristic itself.
+static void heuristic_scales(FloatGraph* fgraph) {
+    double euclidean = 1.0;
+    double manhattan = 1.0;
+    for (int u = 0; u < fgraph->num_vertices; u++) {
+        for (int arc = fgraph->offsets[u]; arc < fgraph->offsets[u + 1]; arc++) {
+            int v = fgraph->targets[arc];
+            double dx = fabs((double)fgraph->coord_x[v] - fgraph->coord_x[u]);
+            double dy = fabs((double)fgraph->coord_y[v] - fgraph->coord_y[u]);
+            double weight = arc_weight(fgraph, arc);
+            double length = sqrt(dx * dx + dy * dy);
+            if (length > 0.0 && weight < euclidean * length) euclidean = weight / length;
+            if (dx + dy > 0.0 && weight < manhattan * (dx + dy)) manhattan = weight / (dx + dy);
+        }
+    }
+    fgraph->euclidean_scale = euclidean > 0.0 ? (float)(euclidean * (1.0 - 1e-6)) : 0.0f;
+    fgraph->manhattan_scale = manhattan > 0.0 ? (float)(manhattan * (1.0 - 1e-6)) : 0.0f;
+}
+
+// Create a reduced-precision copy of graph
+FloatGraph* float_graph_create(const Graph* graph, FloatWeightStorage storage) {
+    if (!graph) {
+        fprintf(stderr, "Error: Graph is NULL\n");
+        return NULL;
+    }
+
+    int n = graph->num_vertices;
+    int num_arcs = 0;
+    double max_weight = 0.0;
+    bool small_integers = true;
+    for (int i = 0; i < n; i++) {
+        for (Edge* edge = graph->adj_list[i]; edge; edge = edge->next) {
+            if (storage == FLOAT_WEIGHTS_U16 && edge->weight < 0.0) {
+                fprintf(stderr, "Error: uint16 weight storage requires non-negative weights\n");
+                return NULL;
+            }
+            if (edge->weight > max_weight) max_weight = edge->weight;
+            if (edge->weight != floor(edge->weight)) small_integers = false;
+            num_arcs++;
+        }
+    }
+    if (max_weight > 65535.0) small_integers = false;
+
+    FloatGraph* fgraph = (FloatGraph*)calloc(1, sizeof(FloatGraph));
+    if (!fgraph) {
+        fprintf(stderr, "Error: Memory allocation failed for float graph\n");
+        return NULL;
+    }
+
+    fgraph->num_vertices = n;
+    fgraph->num_arcs = num_arcs;
+    fgraph->is_weighted = graph->is_weighted;
+    fgraph->is_directed = graph->is_directed;
+    fgraph->storage = storage;
+    fgraph->offsets = (int*)malloc((n + 1) * sizeof(int));
+    fgraph->targets = (int*)malloc((num_arcs > 0 ? num_arcs : 1) * sizeof(int));
+    if (storage == FLOAT_WEIGHTS_U16) {
+        fgraph->qweights = (uint16_t*)malloc((num_arcs > 0 ? num_arcs : 1) * sizeof(uint16_t));
+        // Integer weights that fit are stored exactly; others share a uniform step
+        fgraph->weight_scale = small_integers ? 1.0f : (float)(max_weight / 65535.0);
+    } else {
+        fgraph->weights = (float*)malloc((num_arcs > 0 ? num_arcs : 1) * sizeof(float));
+    }
+
+    if (!fgraph->offsets || !fgraph->targets || (!fgraph->weights && !fgraph->qweights)) {
+        fprintf(stderr, "Error: Memory allocation failed for float graph\n");
+        float_graph_destroy(fgraph);
+        return NULL;
+    }
+
+    int arc = 0;
+    for (int i = 0; i < n; i++) {
+        fgraph->offsets[i] = arc;
+        for (Edge* edge = graph->adj_list[i]; edge; edge = edge->next) {
+            fgraph->targets[arc] = edge->dest;
+            if (fgraph->qweights) {
+                double code = (fgraph->weight_scale > 0.0f) ? edge->weight / fgraph->weight_scale : 0.0;
+                fgraph->qweights[arc] = (uint16_t)(code > 65535.0 ? 65535 : lround(code));
+            } else {
+                fgraph->weights[arc] = (float)edge->weight;
+            }
+            arc++;
+        }
+    }
+    fgraph->offsets[n] = arc;
+
+    if (graph_has_coordinates(graph)) {
+        fgraph->coord_x = (float*)malloc(n * sizeof(float));
+        fgraph->coord_y = (float*)malloc(n * sizeof(float));
+        if (!fgraph->coord_x || !fgraph->coord_y) {
+            fprintf(stderr, "Error: Memory allocation failed for float coordinates\n");
+            float_graph_destroy(fgraph);
+            return NULL;
+        }
+        for (int i = 0; i < n; i++) {
+            fgraph->coord_x[i] = (float)graph->coords[i].x;
+            fgraph->coord_y[i] = (float)graph->coords[i].y;
+        }
+        heuristic_scales(fgraph);
+    }
+
+    return fgraph;
+}
+
+void float_graph_destroy(FloatGraph* fgraph) {
+    if (!fgraph) return;
+    free(fgraph->offsets);
+    free(fgraph->targets);
+    free(fgraph->weights);
+    free(fgraph->qweights);
+    free(fgraph->coord_x);
+    free(fgraph->coord_y);
+    free(fgraph);
+}
+
+size_t float_graph_memory_usage(const FloatGraph* fgraph) {
+    if (!fgraph) return 0;
+
+    size_t bytes = sizeof(FloatGraph) + ((size_t)fgraph->num_vertices + 1) * sizeof(int);
+    bytes += (size_t)fgraph->num_arcs * sizeof(int);
+    bytes += (size_t)fgraph->num_arcs * (fgraph->qweights ? sizeof(uint16_t) : sizeof(float));
+    if (fgraph->coord_x) {
+        bytes += (size_t)fgraph->num_vertices * 2 * sizeof(float);
+    }
+    return bytes;
+}
+
+static float float_heuristic(const FloatGraph* fgraph, FloatHeuristic heuristic, int v, int goal) {
+    if (heuristic == FLOAT_HEURISTIC_ZERO || !fgraph->coord_x) {
+        return 0.0f;
+    }
+
+    float dx = fgraph->coord_x[goal] - fgraph->coord_x[v];
+    float dy = fgraph->coord_y[goal] - fgraph->coord_y[v];
+    if (heuristic == FLOAT_HEURISTIC_EUCLIDEAN) {
+        return fgraph->euclidean_scale * sqrtf(dx * dx + dy * dy);
+    }
+    return fgraph->manhattan_scale * (fabsf(dx) + fabsf(dy));
+}
+
+// Shared float search: Dijkstra when heuristic is FLOAT_HEURISTIC_ZERO, A* otherwise
+static PathResult* float_search(const FloatGraph* fgraph, int start, int end,
+                                FloatHeuristic heuristic, const char* algorithm_name) {
+    PathResult* result = path_result_create();
+    if (!result) return NULL;
+
+    result->algorithm = algorithm_name;
+
+    if (!fgraph || start < 0 || start >= fgraph->num_vertices ||
+        end < 0 || end >= fgraph->num_vertices) {
+        fprintf(stderr, "Error: Invalid start or end vertex\n");
+        return result;
+    }
+
+    SearchStats* stats = &result->stats;
+    long long start_ns = graph_clock_ns();
+
+    int n = fgraph->num_vertices;
+    float* dist = (float*)malloc(n * sizeof(float));
+    int* parent = (int*)malloc(n * sizeof(int));
+    bool* closed = (bool*)calloc(n, sizeof(bool));
+    FloatPQ* pq = float_pq_create(n > 1000 ? 1000 : n);
+
+    if (!dist || !parent || !closed || !pq) {
+        fprintf(stderr, "Error: Memory allocation failed for %s\n", algorithm_name);
+        result->status = SEARCH_OUT_OF_MEMORY;
+        free(dist);
+        free(parent);
+        free(closed);
+        float_pq_destroy(pq);
+        return result;
+    }
+
+    for (int i = 0; i < n; i++) {
+        dist[i] = FLT_MAX;
+        parent[i] = -1;
+    }
+
+    dist[start] = 0.0f;
+    if (!float_pq_push(pq, start, float_heuristic(fgraph, heuristic, start, end))) {
+        result->status = SEARCH_OUT_OF_MEMORY;
+    }
+    stats->heap_pushes = 1;
+    stats->peak_queue_size = 1;
+
+    long long search_ns = graph_clock_ns();
+    stats->init_ns = search_ns - start_ns;
+
+    while (pq->size > 0 && result->status == SEARCH_COMPLETED) {
+        int u = float_pq_pop(pq).vertex;
+        stats->heap_pops++;
+
+        if (closed[u]) continue;
+        closed[u] = true;
+        stats->vertices_settled++;
+
+        if (u == end) break;
+
+        stats->edges_relaxed += fgraph->offsets[u + 1] - fgraph->offsets[u];
+        for (int arc = fgraph->offsets[u]; arc < fgraph->offsets[u + 1]; arc++) {
+            int v = fgraph->targets[arc];
+            if (closed[v]) continue;
+
+            float candidate = dist[u] + arc_weight(fgraph, arc);
+            if (candidate < dist[v]) {
+                dist[v] = candidate;
+                parent[v] = u;
+                if (!float_pq_push(pq, v, candidate + float_heuristic(fgraph, heuristic, v, end))) {
+                    result->status = SEARCH_OUT_OF_MEMORY;  // A dropped entry could hide the shortest path
+                    break;
+                }
+                stats->heap_pushes++;
+            }
+        }
+        if (pq->size > stats->peak_queue_size) stats->peak_queue_size = pq->size;
+    }
+
+    long long reconstruct_ns = graph_clock_ns();
+    stats->search_ns = reconstruct_ns - search_ns;
+
+    if (result->status == SEARCH_COMPLETED && closed[end]) {
+        result->path = path_reconstruct(parent, start, end, &result->path_length);
+        result->found = (result->path != NULL);
+        result->total_weight = (result->found) ? (double)dist[end] : 0.0;
+        if (!result->found) result->status = SEARCH_OUT_OF_MEMORY;
+    }
+
+    long long end_ns = graph_clock_ns();
+    stats->reconstruct_ns = end_ns - reconstruct_ns;
+    stats->bytes_allocated = n * (sizeof(float) + sizeof(int) + sizeof(bool)) +
+                             sizeof(FloatPQ) + pq->capacity * sizeof(FloatPQNode);
+    result->time_ms = (end_ns - start_ns) / 1e6;
+
+    free(dist);
+    free(parent);
+    free(closed);
+    float_pq_destroy(pq);
+
+    return result;
+}
+
+PathResult* float_dijkstra_find_path(const FloatGraph* fgraph, int start, int end) {
+    const char* name = (fgraph && fgraph->storage == FLOAT_WEIGHTS_U16)
+                     ? "Dijkstra (uint16 weights)" : "Dijkstra (float32)";
+    return float_search(fgraph, start, end, FLOAT_HEURISTIC_ZERO, name);
+}
+
+PathResult* float_astar_find_path(const FloatGraph* fgraph, int start, int end,
+                                  FloatHeuristic heuristic) {
+    bool quantized = fgraph && fgraph->storage == FLOAT_WEIGHTS_U16;
+    const char* name = quantized ? "A* (uint16 weights, Zero)" : "A* (float32, Zero)";
+    if (heuristic == FLOAT_HEURISTIC_EUCLIDEAN) {
+        name = quantized ? "A* (uint16 weights, Euclidean)" : "A* (float32, Euclidean)";
+    } else if (heuristic == FLOAT_HEURISTIC_MANHATTAN) {
+        name = quantized ? "A* (uint16 weights, Manhattan)" : "A* (float32, Manhattan)";
+    }
+    return float_search(fgraph, start, end, heuristic, name);
+}
+
+// Small deterministic generator so reports are reproducible across platforms
+static unsigned int next_random(unsigned int* state) {
+    unsigned int x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+bool float_graph_accuracy_report(const Graph* graph, const FloatGraph* fgraph,
+                                 int num_queries, unsigned int seed,
+                                 WeightAccuracyReport* report) {
+    if (!graph || !fgraph || !report || num_queries <= 0 ||
+        graph->num_vertices != fgraph->num_vertices) {
+        fprintf(stderr, "Error: Invalid arguments for accuracy report\n");
+        return false;
+    }
+
+    memset(report, 0, sizeof(WeightAccuracyReport));
+    unsigned int state = seed ? seed : 0x9E3779B9u;
+    int reachable = 0;
+    double rel_sum = 0.0;
+
+    for (int q = 0; q < num_queries; q++) {
+        int start = (int)(next_random(&state) % (unsigned int)graph->num_vertices);
+        int end = (int)(next_random(&state) % (unsigned int)graph->num_vertices);
+
+        PathResult* exact = dijkstra_find_path(graph, start, end);
+        PathResult* approx = float_dijkstra_find_path(fgraph, start, end);
+        if (!exact || !approx) {
+            path_result_destroy(exact);
+            path_result_destroy(approx);
+            return false;
+        }
+
+        report->num_queries++;
+        report->double_time_ms += exact->time_ms;
+        report->float_time_ms += approx->time_ms;
+
+        if (exact->found != approx->found) {
+            report->found_mismatches++;
+        } else if (exact->found) {
+            reachable++;
+
+            bool same_path = exact->path_length == approx->path_length;
+            for (int i = 0; same_path && i < exact->path_length; i++) {
+                same_path = exact->path[i] == approx->path[i];
+            }
+            if (!same_path) report->path_mismatches++;
+
+            double abs_error = fabs(approx->total_weight - exact->total_weight);
+            double rel_error = (exact->total_weight != 0.0) ? abs_error / fabs(exact->total_weight) : 0.0;
+            if (abs_error > report->max_abs_error) report->max_abs_error = abs_error;
+            if (rel_error > report->max_rel_error) report->max_rel_error = rel_error;
+            rel_sum += rel_error;
+        }
+
+        path_result_destroy(exact);
+        path_result_destroy(approx);
+    }
+
+    report->mean_rel_error = (reachable > 0) ? rel_sum / reachable : 0.0;
+    return true;
+}
+
+void weight_accuracy_report_print(const WeightAccuracyReport* report) {
+    if (!report) return;
+
+    printf("\n=== Reduced-Precision Accuracy ===\n");
+    printf("Queries: %d\n", report->num_queries);
+    printf("Reachability mismatches: %d\n", report->found_mismatches);
+    printf("Different paths: %d\n", report->path_mismatches);
+    printf("Max absolute error: %.6g\n", report->max_abs_error);
+    printf("Max relative error: %.6g\n", report->max_rel_error);
+    printf("Mean relative error: %.6g\n", report->mean_rel_error);
+    printf("Time (double): %.3f ms\n", report->double_time_ms);
+    printf("Time (reduced): %.3f ms\n", report->float_time_ms);
+    printf("==================================\n\n");
+}
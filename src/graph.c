@@ -1,8 +1,34 @@
+#define _POSIX_C_SOURCE 200809L
 #include "graph.h"
+#include "reach_index.h"
+#include "union_find.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <time.h>
+
+// Source of graph versions: process-wide, so a version identifies one graph state
+static atomic_ullong next_graph_version = 1;
+
+void graph_touch(Graph* graph) {
+    if (graph) {
+        graph->version = atomic_fetch_add_explicit(&next_graph_version, 1, memory_order_relaxed);
+        graph->changes++;
+    }
+}
+
+// Free an edge unless it lives in the bulk-built edge pool
+static void edge_free(Graph* graph, Edge* edge) {
+    uintptr_t addr = (uintptr_t)edge;
+    uintptr_t pool = (uintptr_t)graph->edge_pool;
+    if (pool && addr >= pool && addr < pool + graph->edge_pool_size * sizeof(Edge)) {
+        return;  // Released with the whole pool in graph_destroy
+    }
+    free(edge);
+}
 
 // Create a new graph
 Graph* graph_create(int num_vertices, bool is_weighted, bool is_directed) {
@@ -33,6 +59,24 @@ Graph* graph_create(int num_vertices, bool is_weighted, bool is_directed) {
     // Initialize coordinates to NULL (optional feature)
     graph->coords = NULL;
 
+    // Edges are individually allocated until a bulk build provides a pool
+    graph->edge_pool = NULL;
+    graph->edge_pool_size = 0;
+    graph->reach_index = NULL;
+    graph->components = NULL;
+    graph->changes = 0;
+    graph_touch(graph);
+
+    // Undirected graphs keep their connected components up to date
+    if (!is_directed) {
+        graph->components = graph_components_create(num_vertices, graph->version);
+        if (!graph->components) {
+            free(graph->adj_list);
+            free(graph);
+            return NULL;
+        }
+    }
+
     return graph;
 }
 
@@ -40,21 +84,30 @@ Graph* graph_create(int num_vertices, bool is_weighted, bool is_directed) {
 void graph_destroy(Graph* graph) {
     if (!graph) return;
 
-    // Free all edges in adjacency lists
+    // Free all individually allocated edges in adjacency lists
     for (int i = 0; i < graph->num_vertices; i++) {
         Edge* current = graph->adj_list[i];
         while (current) {
             Edge* temp = current;
             current = current->next;
-            free(temp);
+            edge_free(graph, temp);
         }
     }
 
     free(graph->adj_list);
+    free(graph->edge_pool);
     free(graph->coords);  // Free coordinates if allocated
+    reach_index_detach(graph);
+    graph_components_destroy(graph->components);
     free(graph);
 }
 
+bool graph_path_ruled_out(const Graph* graph, int start, int end) {
+    if (!graph) return false;
+    if (graph->components && graph_components_connected(graph, start, end) == 0) return true;
+    return graph->reach_index && reach_index_query(graph, start, end) == REACH_NO;
+}
+
 // Check if vertex is valid
 bool graph_is_valid_vertex(const Graph* graph, int vertex) {
     return graph && vertex >= 0 && vertex < graph->num_vertices;
@@ -92,7 +145,10 @@ bool graph_add_vertex(Graph* graph) {
         graph->coords[graph->num_vertices].y = 0.0;
     }
 
+    unsigned long long before = graph->version;
     graph->num_vertices = new_count;
+    graph_touch(graph);
+    graph_components_note_vertex(graph, before);
 
     return true;
 }
@@ -117,7 +173,7 @@ bool graph_remove_vertex(Graph* graph, int vertex) {
             // but we need to remove both directions
         }
 
-        free(temp);
+        edge_free(graph, temp);
     }
     graph->adj_list[vertex] = NULL;
 
@@ -130,7 +186,7 @@ bool graph_remove_vertex(Graph* graph, int vertex) {
             if ((*edge_ptr)->dest == vertex) {
                 Edge* to_remove = *edge_ptr;
                 *edge_ptr = (*edge_ptr)->next;
-                free(to_remove);
+                edge_free(graph, to_remove);
 
                 if (graph->is_directed) {
                     graph->num_edges--;
@@ -158,6 +214,7 @@ bool graph_remove_vertex(Graph* graph, int vertex) {
     }
 
     graph->num_vertices--;
+    graph_touch(graph);
 
     // Optionally shrink the adjacency list array
     if (graph->num_vertices > 0) {
@@ -208,7 +265,10 @@ bool graph_add_edge(Graph* graph, int src, int dest, double weight) {
         graph->adj_list[dest] = reverse_edge;
     }
 
+    unsigned long long before = graph->version;
     graph->num_edges++;
+    graph_touch(graph);
+    graph_components_note_edge(graph, src, dest, before);
     return true;
 }
 
@@ -227,7 +287,7 @@ bool graph_remove_edge(Graph* graph, int src, int dest) {
         if ((*edge_ptr)->dest == dest) {
             Edge* to_remove = *edge_ptr;
             *edge_ptr = (*edge_ptr)->next;
-            free(to_remove);
+            edge_free(graph, to_remove);
             found = true;
             break;
         }
@@ -241,7 +301,7 @@ bool graph_remove_edge(Graph* graph, int src, int dest) {
             if ((*edge_ptr)->dest == src) {
                 Edge* to_remove = *edge_ptr;
                 *edge_ptr = (*edge_ptr)->next;
-                free(to_remove);
+                edge_free(graph, to_remove);
                 break;
             }
             edge_ptr = &(*edge_ptr)->next;
@@ -250,8 +310,45 @@ bool graph_remove_edge(Graph* graph, int src, int dest) {
 
     if (found) {
         graph->num_edges--;
+        graph_touch(graph);
+    }
+
+    return found;
+}
+
+// Set the weight of an existing edge; the topology stays the same
+bool graph_set_edge_weight(Graph* graph, int src, int dest, double weight) {
+    if (!graph_is_valid_vertex(graph, src) || !graph_is_valid_vertex(graph, dest)) {
+        fprintf(stderr, "Error: Invalid vertex (src: %d, dest: %d)\n", src, dest);
+        return false;
     }
 
+    // For unweighted graphs, weight is always 1.0
+    if (!graph->is_weighted) {
+        weight = 1.0;
+    }
+
+    bool found = false;
+    for (Edge* edge = graph->adj_list[src]; edge; edge = edge->next) {
+        if (edge->dest == dest) {
+            edge->weight = weight;
+            found = true;
+        }
+    }
+    if (found && !graph->is_directed && src != dest) {
+        for (Edge* edge = graph->adj_list[dest]; edge; edge = edge->next) {
+            if (edge->dest == src) {
+                edge->weight = weight;
+            }
+        }
+    }
+
+    if (found) {
+        // Connectivity is unchanged, so the components stay valid
+        unsigned long long before = graph->version;
+        graph_touch(graph);
+        graph_components_note_edge(graph, src, dest, before);
+    }
     return found;
 }
 
@@ -283,6 +380,22 @@ void graph_print(const Graph* graph) {
     printf("=======================\n\n");
 }
 
+// Approximate heap footprint of the graph (adjacency nodes, list heads, coordinates)
+size_t graph_memory_usage(const Graph* graph) {
+    if (!graph) return 0;
+
+    size_t bytes = sizeof(Graph) + (size_t)graph->num_vertices * sizeof(Edge*);
+    for (int i = 0; i < graph->num_vertices; i++) {
+        for (Edge* edge = graph->adj_list[i]; edge; edge = edge->next) {
+            bytes += sizeof(Edge);
+        }
+    }
+    if (graph->coords) {
+        bytes += (size_t)graph->num_vertices * sizeof(Coordinates);
+    }
+    return bytes;
+}
+
 // Create a new path result
 PathResult* path_result_create(void) {
     PathResult* result = (PathResult*)malloc(sizeof(PathResult));
@@ -297,6 +410,9 @@ PathResult* path_result_create(void) {
     result->time_ms = 0.0;
     result->algorithm = NULL;
     result->found = false;
+    result->suboptimality_bound = 0.0;
+    result->status = SEARCH_COMPLETED;
+    memset(&result->stats, 0, sizeof(SearchStats));
 
     return result;
 }
@@ -308,12 +424,39 @@ void path_result_destroy(PathResult* result) {
     free(result);
 }
 
+// Deep copy of a path result
+PathResult* path_result_clone(const PathResult* result) {
+    if (!result) return NULL;
+    PathResult* copy = path_result_create();
+    if (!copy) return NULL;
+
+    *copy = *result;
+    copy->path = NULL;
+    if (result->path && result->path_length > 0) {
+        copy->path = (int*)malloc(result->path_length * sizeof(int));
+        if (!copy->path) {
+            fprintf(stderr, "Error: Memory allocation failed for path\n");
+            free(copy);
+            return NULL;
+        }
+        memcpy(copy->path, result->path, result->path_length * sizeof(int));
+    }
+    return copy;
+}
+
 // Print path result
 void path_result_print(const PathResult* result) {
     if (!result) return;
 
     printf("  Algorithm: %s\n", result->algorithm ? result->algorithm : "Unknown");
     printf("  Time: %.3f ms\n", result->time_ms);
+    printf("  Work: %lld settled, %lld relaxed, %lld pushes, %lld pops, peak queue %lld, %.1f KB\n",
+           result->stats.vertices_settled, result->stats.edges_relaxed,
+           result->stats.heap_pushes, result->stats.heap_pops,
+           result->stats.peak_queue_size, result->stats.bytes_allocated / 1024.0);
+    printf("  Phases: init %.1f us, search %.1f us, reconstruct %.1f us\n",
+           result->stats.init_ns / 1000.0, result->stats.search_ns / 1000.0,
+           result->stats.reconstruct_ns / 1000.0);
 
     if (result->found) {
         printf("  Path: ");
@@ -328,6 +471,87 @@ void path_result_print(const PathResult* result) {
     }
 }
 
+// Monotonic wall clock in nanoseconds
+long long graph_clock_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+struct CancelToken {
+    atomic_bool cancelled;
+};
+
+CancelToken* cancel_token_create(void) {
+    CancelToken* token = (CancelToken*)malloc(sizeof(CancelToken));
+    if (!token) {
+        fprintf(stderr, "Error: Memory allocation failed for cancel token\n");
+        return NULL;
+    }
+    atomic_init(&token->cancelled, false);
+    return token;
+}
+
+void cancel_token_destroy(CancelToken* token) {
+    free(token);
+}
+
+void cancel_token_cancel(CancelToken* token) {
+    if (token) atomic_store_explicit(&token->cancelled, true, memory_order_relaxed);
+}
+
+void cancel_token_reset(CancelToken* token) {
+    if (token) atomic_store_explicit(&token->cancelled, false, memory_order_relaxed);
+}
+
+bool cancel_token_is_cancelled(const CancelToken* token) {
+    return token && atomic_load_explicit(&token->cancelled, memory_order_relaxed);
+}
+
+void search_limits_init(SearchLimits* limits) {
+    if (!limits) return;
+    limits->deadline_ns = 0;
+    limits->cancel = NULL;
+}
+
+void search_limits_set_budget(SearchLimits* limits, double budget_ms) {
+    if (!limits) return;
+    limits->deadline_ns = graph_clock_ns() + (long long)(budget_ms * 1e6);
+}
+
+SearchStatus search_limits_check(const SearchLimits* limits) {
+    if (!limits) return SEARCH_COMPLETED;
+    if (cancel_token_is_cancelled(limits->cancel)) return SEARCH_CANCELLED;
+    if (limits->deadline_ns > 0 && graph_clock_ns() >= limits->deadline_ns) return SEARCH_TIMED_OUT;
+    return SEARCH_COMPLETED;
+}
+
+// Reconstruct path from parent array
+int* path_reconstruct(const int* parent, int start, int end, int* path_length) {
+    *path_length = 0;
+    if (parent[end] == -1 && start != end) {
+        return NULL;
+    }
+
+    // Count path length
+    int count = 0;
+    for (int v = end; v != -1; v = parent[v]) {
+        count++;
+    }
+
+    int* path = (int*)malloc(count * sizeof(int));
+    if (!path) return NULL;
+
+    // Fill path in reverse
+    int index = count - 1;
+    for (int v = end; v != -1; v = parent[v]) {
+        path[index--] = v;
+    }
+
+    *path_length = count;
+    return path;
+}
+
 // Set coordinates for a vertex
 bool graph_set_coordinates(Graph* graph, int vertex, double x, double y) {
     if (!graph_is_valid_vertex(graph, vertex)) {
@@ -346,6 +570,10 @@ bool graph_set_coordinates(Graph* graph, int vertex, double x, double y) {
 
     graph->coords[vertex].x = x;
     graph->coords[vertex].y = y;
+    // Connectivity is unchanged, so the components stay valid
+    unsigned long long before = graph->version;
+    graph_touch(graph);
+    graph_components_note_unchanged(graph, before);
     return true;
 }
 
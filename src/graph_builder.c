@@ -0,0 +1,284 @@
+#include "graph_builder.h"
+#include "parallel.h"
+#include "union_find.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <stdatomic.h>
+
+// Scattered arc tagged with the input edge it came from; the tag restores
+// insertion order after a multi-threaded scatter
+typedef struct {
+    int index;
+    int dest;
+    double weight;
+} TaggedArc;
+
+// Shared state for the build phases
+typedef struct {
+    int num_vertices;
+    bool is_weighted;
+    bool is_directed;
+    bool sort_neighbors;
+    bool deduplicate;
+    const EdgeInput* edges;
+    atomic_int* counts;       // Degrees, then reused as per-vertex fill cursors
+    size_t* offsets;          // First pool slot of each vertex (n + 1)
+    size_t* block_sums;       // Per-thread partial sums for the prefix scan
+    size_t* kept;             // Per-thread count of edges kept after finalize
+    Edge* pool;
+    TaggedArc* tagged;        // Scatter target when insertion order must be restored
+    Edge** adj_list;
+    atomic_bool invalid;
+} BuildContext;
+
+void graph_build_options_init(GraphBuildOptions* options) {
+    if (!options) return;
+    options->num_threads = 0;
+    options->sort_neighbors = false;
+    options->deduplicate = false;
+}
+
+static int compare_tagged(const void* a, const void* b) {
+    int x = ((const TaggedArc*)a)->index;
+    int y = ((const TaggedArc*)b)->index;
+    return (x > y) - (x < y);
+}
+
+static int compare_edges(const void* a, const void* b) {
+    const Edge* x = (const Edge*)a;
+    const Edge* y = (const Edge*)b;
+    if (x->dest != y->dest) return (x->dest < y->dest) ? -1 : 1;
+    if (x->weight != y->weight) return (x->weight < y->weight) ? -1 : 1;
+    return 0;
+}
+
+// Phase 1: count out-degrees (and in-degrees for undirected graphs)
+static void count_degrees(size_t begin, size_t end, int thread_id, void* arg) {
+    (void)thread_id;
+    BuildContext* ctx = (BuildContext*)arg;
+    int n = ctx->num_vertices;
+
+    for (size_t i = begin; i < end; i++) {
+        int src = ctx->edges[i].src;
+        int dest = ctx->edges[i].dest;
+        if (src < 0 || src >= n || dest < 0 || dest >= n) {
+            atomic_store_explicit(&ctx->invalid, true, memory_order_relaxed);
+            continue;
+        }
+        atomic_fetch_add_explicit(&ctx->counts[src], 1, memory_order_relaxed);
+        if (!ctx->is_directed && src != dest) {
+            atomic_fetch_add_explicit(&ctx->counts[dest], 1, memory_order_relaxed);
+        }
+    }
+}
+
+// Phase 2a: sum the degrees of each thread's vertex block
+static void sum_blocks(size_t begin, size_t end, int thread_id, void* arg) {
+    BuildContext* ctx = (BuildContext*)arg;
+    size_t sum = 0;
+    for (size_t v = begin; v < end; v++) {
+        sum += (size_t)atomic_load_explicit(&ctx->counts[v], memory_order_relaxed);
+    }
+    ctx->block_sums[thread_id] = sum;
+}
+
+// Phase 2b: write offsets from the scanned block sums and reset the cursors
+static void write_offsets(size_t begin, size_t end, int thread_id, void* arg) {
+    BuildContext* ctx = (BuildContext*)arg;
+    size_t running = ctx->block_sums[thread_id];
+    for (size_t v = begin; v < end; v++) {
+        ctx->offsets[v] = running;
+        running += (size_t)atomic_load_explicit(&ctx->counts[v], memory_order_relaxed);
+        atomic_store_explicit(&ctx->counts[v], 0, memory_order_relaxed);
+    }
+}
+
+static void place_arc(BuildContext* ctx, size_t slot, int index, int dest, double weight) {
+    if (ctx->tagged) {
+        ctx->tagged[slot].index = index;
+        ctx->tagged[slot].dest = dest;
+        ctx->tagged[slot].weight = weight;
+    } else {
+        ctx->pool[slot].dest = dest;
+        ctx->pool[slot].weight = weight;
+    }
+}
+
+// Phase 3: scatter each edge (and its reverse) into its vertex's slice. Slots
+// are claimed atomically, so with several threads the order within a slice
+// depends on timing until finalize restores it.
+static void scatter_edges(size_t begin, size_t end, int thread_id, void* arg) {
+    (void)thread_id;
+    BuildContext* ctx = (BuildContext*)arg;
+
+    for (size_t i = begin; i < end; i++) {
+        int src = ctx->edges[i].src;
+        int dest = ctx->edges[i].dest;
+        double weight = ctx->is_weighted ? ctx->edges[i].weight : 1.0;
+
+        size_t slot = ctx->offsets[src] +
+                      (size_t)atomic_fetch_add_explicit(&ctx->counts[src], 1, memory_order_relaxed);
+        place_arc(ctx, slot, (int)i, dest, weight);
+
+        if (!ctx->is_directed && src != dest) {
+            slot = ctx->offsets[dest] +
+                   (size_t)atomic_fetch_add_explicit(&ctx->counts[dest], 1, memory_order_relaxed);
+            place_arc(ctx, slot, (int)i, src, weight);
+        }
+    }
+}
+
+// Phase 4: sort/deduplicate each slice and link it into an adjacency list
+static void finalize_lists(size_t begin, size_t end, int thread_id, void* arg) {
+    BuildContext* ctx = (BuildContext*)arg;
+    size_t kept_edges = 0;
+
+    for (size_t v = begin; v < end; v++) {
+        Edge* slice = ctx->pool + ctx->offsets[v];
+        size_t degree = ctx->offsets[v + 1] - ctx->offsets[v];
+
+        if (ctx->tagged) {
+            // Back to input order: each input edge adds at most one arc per vertex
+            TaggedArc* tagged = ctx->tagged + ctx->offsets[v];
+            if (degree > 1) qsort(tagged, degree, sizeof(TaggedArc), compare_tagged);
+            for (size_t k = 0; k < degree; k++) {
+                slice[k].dest = tagged[k].dest;
+                slice[k].weight = tagged[k].weight;
+            }
+        }
+
+        if (degree > 1 && (ctx->sort_neighbors || ctx->deduplicate)) {
+            qsort(slice, degree, sizeof(Edge), compare_edges);
+        }
+        if (degree > 1 && ctx->deduplicate) {
+            // Sorted by (dest, weight): the first of each run is the lightest
+            size_t unique = 1;
+            for (size_t k = 1; k < degree; k++) {
+                if (slice[k].dest != slice[unique - 1].dest) {
+                    slice[unique++] = slice[k];
+                }
+            }
+            degree = unique;
+        }
+
+        for (size_t k = 0; k < degree; k++) {
+            slice[k].next = (k + 1 < degree) ? &slice[k + 1] : NULL;
+            // Undirected edges are stored twice; count each at its lower endpoint
+            if (ctx->is_directed || slice[k].dest >= (int)v) {
+                kept_edges++;
+            }
+        }
+        ctx->adj_list[v] = (degree > 0) ? slice : NULL;
+    }
+
+    ctx->kept[thread_id] += kept_edges;
+}
+
+Graph* graph_build_from_edges(int num_vertices, bool is_weighted, bool is_directed,
+                              const EdgeInput* edges, size_t num_edges,
+                              const GraphBuildOptions* options) {
+    if (num_edges > 0 && !edges) {
+        fprintf(stderr, "Error: Edge array is NULL\n");
+        return NULL;
+    }
+    if (num_edges > INT_MAX) {
+        fprintf(stderr, "Error: Too many edges (%zu)\n", num_edges);
+        return NULL;
+    }
+
+    GraphBuildOptions defaults;
+    graph_build_options_init(&defaults);
+    if (!options) options = &defaults;
+
+    Graph* graph = graph_create(num_vertices, is_weighted, is_directed);
+    if (!graph) return NULL;
+
+    int num_threads = parallel_resolve_threads(options->num_threads);
+    int n = num_vertices;
+
+    BuildContext ctx;
+    ctx.num_vertices = n;
+    ctx.is_weighted = is_weighted;
+    ctx.is_directed = is_directed;
+    ctx.sort_neighbors = options->sort_neighbors;
+    ctx.deduplicate = options->deduplicate;
+    ctx.edges = edges;
+    ctx.counts = (atomic_int*)malloc(n * sizeof(atomic_int));
+    ctx.offsets = (size_t*)malloc((n + 1) * sizeof(size_t));
+    ctx.block_sums = (size_t*)calloc(num_threads, sizeof(size_t));
+    ctx.kept = (size_t*)calloc(num_threads, sizeof(size_t));
+    ctx.pool = NULL;
+    ctx.tagged = NULL;
+    ctx.adj_list = graph->adj_list;
+    atomic_init(&ctx.invalid, false);
+
+    if (!ctx.counts || !ctx.offsets || !ctx.block_sums || !ctx.kept) {
+        fprintf(stderr, "Error: Memory allocation failed for graph build\n");
+        goto fail;
+    }
+    for (int v = 0; v < n; v++) {
+        atomic_init(&ctx.counts[v], 0);
+    }
+
+    parallel_for(num_threads, num_edges, count_degrees, &ctx);
+    if (atomic_load(&ctx.invalid)) {
+        fprintf(stderr, "Error: Edge list references a vertex outside [0, %d)\n", n);
+        goto fail;
+    }
+
+    // Exclusive scan over per-thread block sums
+    int blocks = parallel_for(num_threads, (size_t)n, sum_blocks, &ctx);
+    size_t total = 0;
+    for (int t = 0; t < blocks; t++) {
+        size_t block = ctx.block_sums[t];
+        ctx.block_sums[t] = total;
+        total += block;
+    }
+    parallel_for(num_threads, (size_t)n, write_offsets, &ctx);
+    ctx.offsets[n] = total;
+
+    ctx.pool = (Edge*)malloc((total > 0 ? total : 1) * sizeof(Edge));
+    if (!ctx.pool) {
+        fprintf(stderr, "Error: Memory allocation failed for edge pool\n");
+        goto fail;
+    }
+    graph->edge_pool = ctx.pool;
+    graph->edge_pool_size = total;
+    if (num_threads > 1 && !ctx.sort_neighbors && !ctx.deduplicate) {
+        ctx.tagged = (TaggedArc*)malloc((total > 0 ? total : 1) * sizeof(TaggedArc));
+        if (!ctx.tagged) {
+            fprintf(stderr, "Error: Memory allocation failed for edge pool\n");
+            goto fail;
+        }
+    }
+
+    parallel_for(num_threads, num_edges, scatter_edges, &ctx);
+    parallel_for(num_threads, (size_t)n, finalize_lists, &ctx);
+
+    size_t kept = 0;
+    for (int t = 0; t < num_threads; t++) {
+        kept += ctx.kept[t];
+    }
+    graph->num_edges = (int)kept;
+    graph_touch(graph);
+    // Components now, so the first query on a loaded graph does not pay for them
+    graph_components_warm(graph);
+
+    free(ctx.tagged);
+    free(ctx.counts);
+    free(ctx.offsets);
+    free(ctx.block_sums);
+    free(ctx.kept);
+    return graph;
+
+fail:
+    free(ctx.tagged);
+    free(ctx.counts);
+    free(ctx.offsets);
+    free(ctx.block_sums);
+    free(ctx.kept);
+    graph_destroy(graph);
+    return NULL;
+}
@@ -0,0 +1,594 @@
+#define _POSIX_C_SOURCE 200809L
+#include "graph_formats.h"
+#include "graph_builder.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <ctype.h>
+#include <unistd.h>
+
+// Line-by-line walk over a buffer
+typedef struct {
+    const char* p;
+    const char* end;
+    int line;                 // 1-based number of the line last returned
+} LineReader;
+
+// Growable edge array (exact capacity is known up front for every format)
+typedef struct {
+    EdgeInput* edges;
+    size_t count;
+    size_t capacity;
+} EdgeBuffer;
+
+static void set_error(GraphParseError* error, int line, const char* format, ...) {
+    if (!error) return;
+    error->line = line;
+    va_list args;
+    va_start(args, format);
+    vsnprintf(error->message, sizeof(error->message), format, args);
+    va_end(args);
+}
+
+static void clear_error(GraphParseError* error) {
+    if (!error) return;
+    error->line = 0;
+    error->message[0] = '\0';
+}
+
+// Return the next line as [begin, end) without its newline; false at the end
+static bool next_line(LineReader* reader, const char** begin, const char** end) {
+    if (reader->p >= reader->end) return false;
+    const char* start = reader->p;
+    const char* newline = (const char*)memchr(start, '\n', (size_t)(reader->end - start));
+    const char* stop = newline ? newline : reader->end;
+    reader->p = newline ? newline + 1 : reader->end;
+    reader->line++;
+    *begin = start;
+    *end = stop;
+    return true;
+}
+
+static const char* skip_blanks(const char* p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) p++;
+    return p;
+}
+
+// Match a case-insensitive keyword followed by a blank or the line end
+static const char* scan_word(const char* p, const char* end, const char* word) {
+    p = skip_blanks(p, end);
+    size_t length = strlen(word);
+    if ((size_t)(end - p) < length) return NULL;
+    for (size_t i = 0; i < length; i++) {
+        if (tolower((unsigned char)p[i]) != word[i]) return NULL;
+    }
+    p += length;
+    if (p < end && *p != ' ' && *p != '\t' && *p != '\r') return NULL;
+    return p;
+}
+
+// Read a 1-based vertex id and convert it to 0-based
+static const char* scan_vertex(const char* p, const char* end, long long n, int* vertex) {
+    long long value;
+    p = graph_scan_int(p, end, &value);
+    if (!p || value < 1 || value > n) return NULL;
+    *vertex = (int)(value - 1);
+    return p;
+}
+
+static bool edge_buffer_init(EdgeBuffer* buffer, size_t capacity) {
+    buffer->count = 0;
+    buffer->capacity = capacity;
+    buffer->edges = (EdgeInput*)malloc((capacity > 0 ? capacity : 1) * sizeof(EdgeInput));
+    return buffer->edges != NULL;
+}
+
+static Graph* build_graph(long long num_vertices, bool is_weighted, bool is_directed,
+                          EdgeBuffer* buffer, const GraphParseOptions* options,
+                          GraphParseError* error) {
+    GraphParseOptions default_options;
+    graph_parse_options_init(&default_options);
+    if (!options) options = &default_options;
+
+    GraphBuildOptions build_options;
+    graph_build_options_init(&build_options);
+    build_options.num_threads = options->num_threads;
+    build_options.sort_neighbors = options->sort_neighbors;
+    build_options.deduplicate = options->deduplicate;
+
+    Graph* graph = graph_build_from_edges((int)num_vertices, is_weighted, is_directed,
+                                          buffer->edges, buffer->count, &build_options);
+    free(buffer->edges);
+    buffer->edges = NULL;
+    if (!graph) {
+        set_error(error, 0, "failed to build graph");
+    }
+    return graph;
+}
+
+GraphFormat graph_format_detect(const char* path, const char* data, size_t size) {
+    const char* dot = path ? strrchr(path, '.') : NULL;
+    const char* slash = path ? strrchr(path, '/') : NULL;
+    if (dot && (!slash || dot > slash)) {
+        char extension[8];
+        size_t length = 0;
+        for (const char* c = dot + 1; *c && length + 1 < sizeof(extension); c++) {
+            extension[length++] = (char)tolower((unsigned char)*c);
+        }
+        extension[length] = '\0';
+
+        if (!strcmp(extension, "gr")) return GRAPH_FORMAT_DIMACS;
+        if (!strcmp(extension, "mtx")) return GRAPH_FORMAT_MATRIX_MARKET;
+        if (!strcmp(extension, "graph") || !strcmp(extension, "metis")) return GRAPH_FORMAT_METIS;
+        if (!strcmp(extension, "txt")) return GRAPH_FORMAT_TEXT;
+    }
+
+    // Unknown extension: look at the content
+    if (data) {
+        const char* end = data + size;
+        const char* p = data;
+        while (p < end && isspace((unsigned char)*p)) p++;
+        if ((size_t)(end - p) >= 14 && !strncmp(p, "%%MatrixMarket", 14)) {
+            return GRAPH_FORMAT_MATRIX_MARKET;
+        }
+        if (p < end && (*p == 'c' || *p == 'p') && p + 1 < end &&
+            (p[1] == ' ' || p[1] == '\t' || p[1] == '\n' || p[1] == '\r')) {
+            return GRAPH_FORMAT_DIMACS;
+        }
+    }
+    return GRAPH_FORMAT_TEXT;
+}
+
+const char* graph_format_name(GraphFormat format) {
+    switch (format) {
+        case GRAPH_FORMAT_TEXT:           return "GraphPath text";
+        case GRAPH_FORMAT_DIMACS:         return "DIMACS";
+        case GRAPH_FORMAT_MATRIX_MARKET:  return "Matrix Market";
+        case GRAPH_FORMAT_METIS:          return "METIS";
+    }
+    return "unknown";
+}
+
+Graph* graph_parse_dimacs(const char* data, size_t size, const GraphParseOptions* options,
+                          GraphParseError* error) {
+    clear_error(error);
+    LineReader reader = {data, data + size, 0};
+    const char* p;
+    const char* end;
+    long long n = -1, m = 0;
+    EdgeBuffer buffer = {NULL, 0, 0};
+
+    while (next_line(&reader, &p, &end)) {
+        p = skip_blanks(p, end);
+        if (p == end || *p == 'c') continue;
+
+        if (*p == 'p') {
+            if (n >= 0) {
+                set_error(error, reader.line, "duplicate problem line");
+                goto fail;
+            }
+            const char* q = scan_word(p + 1, end, "sp");
+            if (q) q = graph_scan_int(q, end, &n);
+            if (q) q = graph_scan_int(q, end, &m);
+            if (!q || n <= 0 || n > INT32_MAX || m < 0 || m > INT32_MAX ||
+                skip_blanks(q, end) != end) {
+                set_error(error, reader.line, "expected problem line \"p sp <vertices> <arcs>\"");
+                goto fail;
+            }
+            if (!edge_buffer_init(&buffer, (size_t)m)) {
+                set_error(error, 0, "out of memory");
+                goto fail;
+            }
+        } else if (*p == 'a') {
+            if (n < 0) {
+                set_error(error, reader.line, "arc before problem line");
+                goto fail;
+            }
+            if (buffer.count >= buffer.capacity) {
+                set_error(error, reader.line, "more arcs than the %lld declared", m);
+                goto fail;
+            }
+            EdgeInput* edge = &buffer.edges[buffer.count];
+            const char* q = scan_vertex(p + 1, end, n, &edge->src);
+            if (q) q = scan_vertex(q, end, n, &edge->dest);
+            if (!q) {
+                set_error(error, reader.line, "expected arc \"a <u> <v> <weight>\" with vertices in [1, %lld]", n);
+                goto fail;
+            }
+            q = graph_scan_double(q, end, &edge->weight);
+            if (!q || skip_blanks(q, end) != end) {
+                set_error(error, reader.line, "invalid arc weight");
+                goto fail;
+            }
+            buffer.count++;
+        } else {
+            set_error(error, reader.line, "unknown line type '%c'", *p);
+            goto fail;
+        }
+    }
+
+    if (n < 0) {
+        set_error(error, 0, "missing problem line \"p sp <vertices> <arcs>\"");
+        goto fail;
+    }
+    if (buffer.count != (size_t)m) {
+        set_error(error, reader.line, "expected %lld arcs, found %zu", m, buffer.count);
+        goto fail;
+    }
+    return build_graph(n, true, true, &buffer, options, error);
+
+fail:
+    free(buffer.edges);
+    return NULL;
+}
+
+bool graph_parse_dimacs_coordinates(Graph* graph, const char* data, size_t size,
+                                    GraphParseError* error) {
+    clear_error(error);
+    if (!graph) {
+        set_error(error, 0, "no graph for coordinates");
+        return false;
+    }
+
+    LineReader reader = {data, data + size, 0};
+    const char* p;
+    const char* end;
+    bool have_problem = false;
+
+    while (next_line(&reader, &p, &end)) {
+        p = skip_blanks(p, end);
+        if (p == end || *p == 'c') continue;
+
+        if (*p == 'p') {
+            long long n;
+            const char* q = scan_word(p + 1, end, "aux");
+            if (q) q = scan_word(q, end, "sp");
+            if (q) q = scan_word(q, end, "co");
+            if (q) q = graph_scan_int(q, end, &n);
+            if (!q || skip_blanks(q, end) != end) {
+                set_error(error, reader.line, "expected problem line \"p aux sp co <vertices>\"");
+                return false;
+            }
+            if (n != graph->num_vertices) {
+                set_error(error, reader.line, "coordinates are for %lld vertices, graph has %d",
+                          n, graph->num_vertices);
+                return false;
+            }
+            have_problem = true;
+        } else if (*p == 'v') {
+            if (!have_problem) {
+                set_error(error, reader.line, "coordinate before problem line");
+                return false;
+            }
+            int vertex;
+            double x, y;
+            const char* q = scan_vertex(p + 1, end, graph->num_vertices, &vertex);
+            if (q) q = graph_scan_double(q, end, &x);
+            if (q) q = graph_scan_double(q, end, &y);
+            if (!q || skip_blanks(q, end) != end) {
+                set_error(error, reader.line, "expected \"v <id> <x> <y>\" with id in [1, %d]",
+                          graph->num_vertices);
+                return false;
+            }
+            if (!graph_set_coordinates(graph, vertex, x, y)) {
+                set_error(error, reader.line, "failed to set coordinates");
+                return false;
+            }
+        } else {
+            set_error(error, reader.line, "unknown line type '%c'", *p);
+            return false;
+        }
+    }
+
+    if (!have_problem) {
+        set_error(error, 0, "missing problem line \"p aux sp co <vertices>\"");
+        return false;
+    }
+    return true;
+}
+
+Graph* graph_parse_matrix_market(const char* data, size_t size, const GraphParseOptions* options,
+                                 GraphParseError* error) {
+    clear_error(error);
+    LineReader reader = {data, data + size, 0};
+    const char* p;
+    const char* end;
+    EdgeBuffer buffer = {NULL, 0, 0};
+
+    // Banner: %%MatrixMarket matrix coordinate <field> <symmetry>
+    if (!next_line(&reader, &p, &end) || (size_t)(end - p) < 14 ||
+        strncmp(p, "%%MatrixMarket", 14) != 0) {
+        set_error(error, 1, "missing %%%%MatrixMarket banner");
+        return NULL;
+    }
+    const char* q = scan_word(p + 14, end, "matrix");
+    if (!q) {
+        set_error(error, 1, "only \"matrix\" objects are supported");
+        return NULL;
+    }
+    if (scan_word(q, end, "array")) {
+        set_error(error, 1, "dense \"array\" matrices are not supported, use \"coordinate\"");
+        return NULL;
+    }
+    q = scan_word(q, end, "coordinate");
+    if (!q) {
+        set_error(error, 1, "expected \"coordinate\" format");
+        return NULL;
+    }
+
+    bool is_weighted;
+    const char* r;
+    if ((r = scan_word(q, end, "real")) || (r = scan_word(q, end, "double")) ||
+        (r = scan_word(q, end, "integer"))) {
+        is_weighted = true;
+    } else if ((r = scan_word(q, end, "pattern"))) {
+        is_weighted = false;
+    } else {
+        set_error(error, 1, "unsupported field type (expected real, integer or pattern)");
+        return NULL;
+    }
+
+    bool is_directed, is_skew = false;
+    if ((q = scan_word(r, end, "general"))) {
+        is_directed = true;
+    } else if ((q = scan_word(r, end, "symmetric")) || (q = scan_word(r, end, "hermitian"))) {
+        is_directed = false;
+    } else if ((q = scan_word(r, end, "skew-symmetric"))) {
+        is_directed = true;
+        is_skew = true;
+    } else {
+        set_error(error, 1, "unsupported symmetry (expected general, symmetric or skew-symmetric)");
+        return NULL;
+    }
+
+    // Size line after '%' comments: rows cols entries
+    long long rows = 0, cols = 0, entries = 0;
+    bool have_size = false;
+    while (next_line(&reader, &p, &end)) {
+        p = skip_blanks(p, end);
+        if (p == end || *p == '%') continue;
+        q = graph_scan_int(p, end, &rows);
+        if (q) q = graph_scan_int(q, end, &cols);
+        if (q) q = graph_scan_int(q, end, &entries);
+        if (!q || skip_blanks(q, end) != end || rows <= 0 || cols <= 0 ||
+            rows > INT32_MAX || cols > INT32_MAX || entries < 0 || entries > INT32_MAX / 2) {
+            set_error(error, reader.line, "expected size line \"<rows> <cols> <entries>\"");
+            return NULL;
+        }
+        have_size = true;
+        break;
+    }
+    if (!have_size) {
+        set_error(error, 0, "missing size line");
+        return NULL;
+    }
+
+    // Non-square matrices become graphs over max(rows, cols) vertices
+    long long n = rows > cols ? rows : cols;
+    if (!edge_buffer_init(&buffer, (size_t)entries * (is_skew ? 2 : 1))) {
+        set_error(error, 0, "out of memory");
+        return NULL;
+    }
+
+    long long found = 0;
+    while (next_line(&reader, &p, &end)) {
+        p = skip_blanks(p, end);
+        if (p == end || *p == '%') continue;
+        if (found >= entries) {
+            set_error(error, reader.line, "more entries than the %lld declared", entries);
+            goto fail;
+        }
+
+        int row, col;
+        double value = 1.0;
+        q = scan_vertex(p, end, rows, &row);
+        if (q) q = scan_vertex(q, end, cols, &col);
+        if (!q) {
+            set_error(error, reader.line, "expected entry \"<row> <col>%s\" within the matrix",
+                      is_weighted ? " <value>" : "");
+            goto fail;
+        }
+        if (is_weighted) {
+            q = graph_scan_double(q, end, &value);
+            if (!q) {
+                set_error(error, reader.line, "invalid entry value");
+                goto fail;
+            }
+        }
+        if (skip_blanks(q, end) != end) {
+            set_error(error, reader.line, "unexpected text after entry");
+            goto fail;
+        }
+
+        buffer.edges[buffer.count++] = (EdgeInput){row, col, value};
+        if (is_skew && row != col) {
+            buffer.edges[buffer.count++] = (EdgeInput){col, row, -value};
+        }
+        found++;
+    }
+
+    if (found != entries) {
+        set_error(error, reader.line, "expected %lld entries, found %lld", entries, found);
+        goto fail;
+    }
+    return build_graph(n, is_weighted, is_directed, &buffer, options, error);
+
+fail:
+    free(buffer.edges);
+    return NULL;
+}
+
+Graph* graph_parse_metis(const char* data, size_t size, const GraphParseOptions* options,
+                         GraphParseError* error) {
+    clear_error(error);
+    LineReader reader = {data, data + size, 0};
+    const char* p;
+    const char* end;
+    EdgeBuffer buffer = {NULL, 0, 0};
+
+    // Header after '%' comments: n m [fmt [ncon]]
+    long long n = 0, m = 0, fmt = 0, ncon = 0;
+    bool have_header = false;
+    while (next_line(&reader, &p, &end)) {
+        p = skip_blanks(p, end);
+        if (p == end || *p == '%') continue;
+        const char* q = graph_scan_int(p, end, &n);
+        if (q) q = graph_scan_int(q, end, &m);
+        if (q && skip_blanks(q, end) != end) {
+            q = graph_scan_int(q, end, &fmt);
+            if (q && skip_blanks(q, end) != end) q = graph_scan_int(q, end, &ncon);
+        }
+        if (!q || skip_blanks(q, end) != end || n <= 0 || n > INT32_MAX || m < 0 ||
+            m > INT32_MAX || fmt < 0 || fmt > 111 || ncon < 0) {
+            set_error(error, reader.line, "expected header \"<vertices> <edges> [fmt [ncon]]\"");
+            return NULL;
+        }
+        have_header = true;
+        break;
+    }
+    if (!have_header) {
+        set_error(error, 0, "missing header");
+        return NULL;
+    }
+
+    // fmt digits: vertex sizes, vertex weights, edge weights
+    bool has_sizes = (fmt / 100) % 10 == 1;
+    bool has_vertex_weights = (fmt / 10) % 10 == 1;
+    bool has_edge_weights = fmt % 10 == 1;
+    if (has_vertex_weights && ncon == 0) ncon = 1;
+    if (!has_vertex_weights) ncon = 0;
+
+    if (!edge_buffer_init(&buffer, (size_t)m)) {
+        set_error(error, 0, "out of memory");
+        return NULL;
+    }
+
+    // Line v lists the neighbours of vertex v; blank lines are isolated vertices.
+    // Each edge appears at both endpoints and is kept once, at its lower endpoint.
+    int vertex = 0;
+    size_t listed = 0, self_loops = 0;
+    while (vertex < n && next_line(&reader, &p, &end)) {
+        p = skip_blanks(p, end);
+        if (p < end && *p == '%') continue;
+
+        const char* q = p;
+        long long skipped;
+        for (long long k = 0; k < (has_sizes ? 1 : 0) + ncon; k++) {
+            q = graph_scan_int(q, end, &skipped);
+            if (!q) {
+                set_error(error, reader.line, "missing vertex size or weight for vertex %d", vertex + 1);
+                goto fail;
+            }
+        }
+
+        while (skip_blanks(q, end) != end) {
+            int neighbor;
+            double weight = 1.0;
+            q = scan_vertex(q, end, n, &neighbor);
+            if (!q) {
+                set_error(error, reader.line, "expected neighbour in [1, %lld]", n);
+                goto fail;
+            }
+            if (has_edge_weights) {
+                q = graph_scan_double(q, end, &weight);
+                if (!q) {
+                    set_error(error, reader.line, "missing edge weight");
+                    goto fail;
+                }
+            }
+            listed++;
+            if (neighbor < vertex) continue;
+            if (neighbor == vertex) self_loops++;
+            if (buffer.count >= buffer.capacity) {
+                set_error(error, reader.line,
+                          "more than the %lld declared edges (each edge must be listed at both endpoints)", m);
+                goto fail;
+            }
+            buffer.edges[buffer.count++] = (EdgeInput){vertex, neighbor, weight};
+        }
+        vertex++;
+    }
+
+    // Trailing empty adjacency lines are often trimmed; anything else is an error
+    while (next_line(&reader, &p, &end)) {
+        p = skip_blanks(p, end);
+        if (p != end && *p != '%') {
+            set_error(error, reader.line, "unexpected data after the last vertex");
+            goto fail;
+        }
+    }
+    if (buffer.count != (size_t)m || listed != 2 * buffer.count - self_loops) {
+        set_error(error, 0, "expected %lld edges, found %zu (each edge must be listed at both endpoints)",
+                  m, buffer.count);
+        goto fail;
+    }
+    return build_graph(n, has_edge_weights, false, &buffer, options, error);
+
+fail:
+    free(buffer.edges);
+    return NULL;
+}
+
+// Path of the DIMACS coordinates file next to a .gr file, or NULL if absent
+static char* dimacs_coordinates_path(const char* path) {
+    size_t length = strlen(path);
+    if (length < 3 || strcmp(path + length - 3, ".gr") != 0) return NULL;
+
+    char* co_path = (char*)malloc(length + 1);
+    if (!co_path) return NULL;
+    memcpy(co_path, path, length - 3);
+    strcpy(co_path + length - 3, ".co");
+    if (access(co_path, R_OK) != 0) {
+        free(co_path);
+        return NULL;
+    }
+    return co_path;
+}
+
+Graph* graph_load_file(const char* path, const GraphParseOptions* options,
+                       GraphFileInfo* info, GraphParseError* error) {
+    GraphFileInfo local_info;
+    if (!info) info = &local_info;
+    memset(info, 0, sizeof(GraphFileInfo));
+
+    GraphFileView view;
+    if (!graph_file_view_open(path, &view, error)) {
+        return NULL;
+    }
+
+    Graph* graph = NULL;
+    switch (graph_format_detect(path, view.data, view.size)) {
+        case GRAPH_FORMAT_TEXT:
+            graph = graph_parse_buffer(view.data, view.size, options, info, error);
+            break;
+        case GRAPH_FORMAT_DIMACS:
+            graph = graph_parse_dimacs(view.data, view.size, options, error);
+            break;
+        case GRAPH_FORMAT_MATRIX_MARKET:
+            graph = graph_parse_matrix_market(view.data, view.size, options, error);
+            break;
+        case GRAPH_FORMAT_METIS:
+            graph = graph_parse_metis(view.data, view.size, options, error);
+            break;
+    }
+    graph_file_view_close(&view);
+
+    char* co_path = graph ? dimacs_coordinates_path(path) : NULL;
+    if (co_path) {
+        GraphFileView co_view;
+        GraphParseError co_error;
+        if (!graph_file_view_open(co_path, &co_view, &co_error) ||
+            !graph_parse_dimacs_coordinates(graph, co_view.data, co_view.size, &co_error)) {
+            set_error(error, co_error.line, "%s: %s", co_path, co_error.message);
+            graph_destroy(graph);
+            graph = NULL;
+        } else {
+            info->has_coordinates = true;
+        }
+        graph_file_view_close(&co_view);
+        free(co_path);
+    }
+    return graph;
+}
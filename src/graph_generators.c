@@ -0,0 +1,329 @@
+#include "graph_generators.h"
+#include "graph_builder.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <math.h>
+
+#define GEOMETRIC_SIDE 1000.0
+#define GEOMETRIC_PI 3.14159265358979323846
+#define ROAD_ARTERIAL_SPACING 16
+
+// Growable edge list for generators whose edge count is not known up front
+typedef struct {
+    EdgeInput* edges;
+    size_t count;
+    size_t capacity;
+} GeneratedEdges;
+
+// splitmix64: small, fast and good enough for synthetic graphs
+static uint64_t next_random(uint64_t* state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Uniform double in [0, 1)
+static double next_unit(uint64_t* state) {
+    return (next_random(state) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static bool edge_list_push(GeneratedEdges* list, int src, int dest, double weight) {
+    if (list->count == list->capacity) {
+        size_t capacity = list->capacity ? list->capacity * 2 : 1024;
+        EdgeInput* edges = (EdgeInput*)realloc(list->edges, capacity * sizeof(EdgeInput));
+        if (!edges) {
+            fprintf(stderr, "Error: Memory allocation failed for generated edges\n");
+            return false;
+        }
+        list->edges = edges;
+        list->capacity = capacity;
+    }
+    list->edges[list->count].src = src;
+    list->edges[list->count].dest = dest;
+    list->edges[list->count].weight = weight;
+    list->count++;
+    return true;
+}
+
+static Graph* build_from_list(int num_vertices, bool is_directed, GeneratedEdges* list, bool deduplicate) {
+    GraphBuildOptions options;
+    graph_build_options_init(&options);
+    options.deduplicate = deduplicate;
+    Graph* graph = graph_build_from_edges(num_vertices, true, is_directed,
+                                          list->edges, list->count, &options);
+    free(list->edges);
+    list->edges = NULL;
+    return graph;
+}
+
+static bool set_all_coordinates(Graph* graph, const double* xs, const double* ys) {
+    for (int v = 0; v < graph->num_vertices; v++) {
+        if (!graph_set_coordinates(graph, v, xs[v], ys[v])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+Graph* graph_generate_grid(int width, int height, double max_weight, unsigned int seed) {
+    if (width <= 0 || height <= 0 || (long long)width * height > 0x7FFFFFFF || max_weight < 1.0) {
+        fprintf(stderr, "Error: Invalid grid size %dx%d or max weight %.2f\n", width, height, max_weight);
+        return NULL;
+    }
+
+    uint64_t state = seed;
+    int n = width * height;
+    GeneratedEdges list = {NULL, 0, 0};
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            int v = y * width + x;
+            if (x + 1 < width &&
+                !edge_list_push(&list, v, v + 1, 1.0 + next_unit(&state) * (max_weight - 1.0))) {
+                free(list.edges);
+                return NULL;
+            }
+            if (y + 1 < height &&
+                !edge_list_push(&list, v, v + width, 1.0 + next_unit(&state) * (max_weight - 1.0))) {
+                free(list.edges);
+                return NULL;
+            }
+        }
+    }
+
+    Graph* graph = build_from_list(n, false, &list, false);
+    if (!graph) return NULL;
+    for (int v = 0; v < n; v++) {
+        if (!graph_set_coordinates(graph, v, v % width, v / width)) {
+            graph_destroy(graph);
+            return NULL;
+        }
+    }
+    return graph;
+}
+
+Graph* graph_generate_geometric(int num_vertices, double avg_degree, unsigned int seed) {
+    if (num_vertices <= 0 || avg_degree <= 0.0) {
+        fprintf(stderr, "Error: Invalid geometric graph parameters\n");
+        return NULL;
+    }
+
+    uint64_t state = seed;
+    int n = num_vertices;
+    // Expected neighbours within radius r: n * pi * r^2 / side^2
+    double radius = GEOMETRIC_SIDE * sqrt(avg_degree / (GEOMETRIC_PI * n));
+    int cells = (int)(GEOMETRIC_SIDE / radius);
+    if (cells < 1) cells = 1;
+    if (cells > 4096) cells = 4096;
+    double cell_size = GEOMETRIC_SIDE / cells;
+
+    double* xs = (double*)malloc(n * sizeof(double));
+    double* ys = (double*)malloc(n * sizeof(double));
+    int* cell_start = (int*)calloc((size_t)cells * cells + 1, sizeof(int));
+    int* order = (int*)malloc(n * sizeof(int));
+    int* fill = (int*)malloc((size_t)cells * cells * sizeof(int));
+    GeneratedEdges list = {NULL, 0, 0};
+    Graph* graph = NULL;
+
+    if (!xs || !ys || !cell_start || !order || !fill) {
+        fprintf(stderr, "Error: Memory allocation failed for geometric graph\n");
+        goto done;
+    }
+
+    // Bucket points by cell with a counting sort so neighbour checks stay local
+    for (int v = 0; v < n; v++) {
+        xs[v] = next_unit(&state) * GEOMETRIC_SIDE;
+        ys[v] = next_unit(&state) * GEOMETRIC_SIDE;
+        int cx = (int)(xs[v] / cell_size);
+        int cy = (int)(ys[v] / cell_size);
+        cell_start[(cy < cells ? cy : cells - 1) * cells + (cx < cells ? cx : cells - 1) + 1]++;
+    }
+    for (int c = 0; c < cells * cells; c++) {
+        cell_start[c + 1] += cell_start[c];
+    }
+    for (int c = 0; c < cells * cells; c++) {
+        fill[c] = cell_start[c];
+    }
+    for (int v = 0; v < n; v++) {
+        int cx = (int)(xs[v] / cell_size);
+        int cy = (int)(ys[v] / cell_size);
+        int c = (cy < cells ? cy : cells - 1) * cells + (cx < cells ? cx : cells - 1);
+        order[fill[c]++] = v;
+    }
+
+    double radius_sq = radius * radius;
+    for (int cy = 0; cy < cells; cy++) {
+        for (int cx = 0; cx < cells; cx++) {
+            int c = cy * cells + cx;
+            for (int i = cell_start[c]; i < cell_start[c + 1]; i++) {
+                int u = order[i];
+                for (int ny = cy - 1; ny <= cy + 1; ny++) {
+                    for (int nx = cx - 1; nx <= cx + 1; nx++) {
+                        if (nx < 0 || ny < 0 || nx >= cells || ny >= cells) continue;
+                        int nc = ny * cells + nx;
+                        for (int j = cell_start[nc]; j < cell_start[nc + 1]; j++) {
+                            int v = order[j];
+                            if (v <= u) continue;  // Each pair once
+                            double dx = xs[u] - xs[v];
+                            double dy = ys[u] - ys[v];
+                            double dist_sq = dx * dx + dy * dy;
+                            if (dist_sq <= radius_sq && !edge_list_push(&list, u, v, sqrt(dist_sq))) {
+                                goto done;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    graph = build_from_list(n, false, &list, false);
+    if (graph && !set_all_coordinates(graph, xs, ys)) {
+        graph_destroy(graph);
+        graph = NULL;
+    }
+
+done:
+    free(list.edges);
+    free(xs);
+    free(ys);
+    free(cell_start);
+    free(order);
+    free(fill);
+    return graph;
+}
+
+Graph* graph_generate_rmat(int scale, int edge_factor, double a, double b, double c,
+                           unsigned int seed) {
+    if (scale <= 0 || scale > 30 || edge_factor <= 0 || a < 0.0 || b < 0.0 || c < 0.0 ||
+        a + b + c > 1.0 || ((long long)edge_factor << scale) > 0x7FFFFFFF) {
+        fprintf(stderr, "Error: Invalid R-MAT parameters\n");
+        return NULL;
+    }
+
+    uint64_t state = seed;
+    int n = 1 << scale;
+    size_t m = (size_t)edge_factor << scale;
+    GeneratedEdges list = {NULL, 0, 0};
+    list.edges = (EdgeInput*)malloc(m * sizeof(EdgeInput));
+    if (!list.edges) {
+        fprintf(stderr, "Error: Memory allocation failed for R-MAT edges\n");
+        return NULL;
+    }
+    list.capacity = m;
+
+    // Descend the adjacency matrix one quadrant per bit
+    for (size_t e = 0; e < m; e++) {
+        int src = 0, dest = 0;
+        for (int bit = scale - 1; bit >= 0; bit--) {
+            double r = next_unit(&state);
+            if (r < a) {
+                // Top-left: neither bit set
+            } else if (r < a + b) {
+                dest |= 1 << bit;
+            } else if (r < a + b + c) {
+                src |= 1 << bit;
+            } else {
+                src |= 1 << bit;
+                dest |= 1 << bit;
+            }
+        }
+        list.edges[e].src = src;
+        list.edges[e].dest = dest;
+        list.edges[e].weight = (double)(1 + next_random(&state) % 100);
+    }
+    list.count = m;
+
+    return build_from_list(n, true, &list, true);
+}
+
+// Union-find root with path halving (for the road generator's spanning tree)
+static int find_root(int* parent, int v) {
+    while (parent[v] != v) {
+        parent[v] = parent[parent[v]];
+        v = parent[v];
+    }
+    return v;
+}
+
+Graph* graph_generate_road(int width, int height, unsigned int seed) {
+    if (width <= 0 || height <= 0 || (long long)width * height > 0x7FFFFFFF) {
+        fprintf(stderr, "Error: Invalid road network size %dx%d\n", width, height);
+        return NULL;
+    }
+
+    uint64_t state = seed;
+    int n = width * height;
+    size_t max_edges = (size_t)(width - 1) * height + (size_t)width * (height - 1);
+    double* xs = (double*)malloc(n * sizeof(double));
+    double* ys = (double*)malloc(n * sizeof(double));
+    int* parent = (int*)malloc(n * sizeof(int));
+    EdgeInput* candidates = (EdgeInput*)malloc((max_edges > 0 ? max_edges : 1) * sizeof(EdgeInput));
+    GeneratedEdges list = {NULL, 0, 0};
+    Graph* graph = NULL;
+
+    if (!xs || !ys || !parent || !candidates) {
+        fprintf(stderr, "Error: Memory allocation failed for road network\n");
+        goto done;
+    }
+
+    // Jittered lattice: intersections move up to 0.3 blocks from their slot
+    for (int v = 0; v < n; v++) {
+        xs[v] = (v % width) + (next_unit(&state) - 0.5) * 0.6;
+        ys[v] = (v / width) + (next_unit(&state) - 0.5) * 0.6;
+        parent[v] = v;
+    }
+
+    size_t count = 0;
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            int v = y * width + x;
+            if (x + 1 < width) candidates[count++] = (EdgeInput){v, v + 1, 0.0};
+            if (y + 1 < height) candidates[count++] = (EdgeInput){v, v + width, 0.0};
+        }
+    }
+
+    // Shuffle, then keep a spanning tree (Kruskal over the random order) plus
+    // all arterials and three quarters of the remaining local streets
+    for (size_t i = count; i > 1; i--) {
+        size_t j = next_random(&state) % i;
+        EdgeInput tmp = candidates[i - 1];
+        candidates[i - 1] = candidates[j];
+        candidates[j] = tmp;
+    }
+    for (size_t i = 0; i < count; i++) {
+        int u = candidates[i].src;
+        int v = candidates[i].dest;
+        bool horizontal = (v == u + 1);
+        bool arterial = horizontal ? (u / width) % ROAD_ARTERIAL_SPACING == 0
+                                   : (u % width) % ROAD_ARTERIAL_SPACING == 0;
+        int ru = find_root(parent, u);
+        int rv = find_root(parent, v);
+        bool tree_edge = (ru != rv);
+        if (tree_edge) parent[ru] = rv;
+
+        if (tree_edge || arterial || next_unit(&state) < 0.75) {
+            double dx = xs[u] - xs[v];
+            double dy = ys[u] - ys[v];
+            double slowness = arterial ? 1.0 : 1.5 + 1.5 * next_unit(&state);
+            if (!edge_list_push(&list, u, v, sqrt(dx * dx + dy * dy) * slowness)) {
+                goto done;
+            }
+        }
+    }
+
+    graph = build_from_list(n, false, &list, false);
+    if (graph && !set_all_coordinates(graph, xs, ys)) {
+        graph_destroy(graph);
+        graph = NULL;
+    }
+
+done:
+    free(list.edges);
+    free(xs);
+    free(ys);
+    free(parent);
+    free(candidates);
+    return graph;
+}
@@ -0,0 +1,687 @@
+#define _POSIX_C_SOURCE 200809L
+#include "graph_parser.h"
+#include "graph_builder.h"
+#include "parallel.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Edge sections smaller than this are parsed on the calling thread
+#define PARALLEL_EDGE_THRESHOLD 100000
+
+// Exactly representable powers of ten for the fast double path
+static const double POW10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+// Position in the buffer with line tracking for the header and trailer
+typedef struct {
+    const char* p;
+    const char* end;
+    int line;
+} Cursor;
+
+// One slice of the text after the edge count, cut at line starts
+typedef struct {
+    const char* begin;        // First character of the slice's first line
+    const char* end;
+    int newlines;             // Line breaks in the slice (count pass)
+    long long num_edges;      // Edges on the slice's edge lines (count pass)
+    bool stopped;             // Count pass met a line that is not a list of edges
+    int first_line;           // Line number of begin
+    int first_edge;           // Index of the slice's first edge
+    int take;                 // Edges to parse from the slice
+    const char* stop;         // Line after the last edge taken (parse pass)
+    int stop_line;
+    int error_line;           // 0 when the slice parsed cleanly
+    char error_message[128];
+} EdgeChunk;
+
+typedef struct {
+    int num_vertices;
+    int num_edges;
+    bool is_weighted;
+    EdgeInput* edges;
+    EdgeChunk* chunks;
+} EdgeParseContext;
+
+void graph_parse_options_init(GraphParseOptions* options) {
+    if (!options) return;
+    options->num_threads = 0;
+    options->sort_neighbors = false;
+    options->deduplicate = false;
+}
+
+static void set_error(GraphParseError* error, int line, const char* format, ...) {
+    if (!error) return;
+    error->line = line;
+    va_list args;
+    va_start(args, format);
+    vsnprintf(error->message, sizeof(error->message), format, args);
+    va_end(args);
+}
+
+static bool is_blank(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+static bool is_space(char c) {
+    return is_blank(c) || c == '\n' || c == '\f' || c == '\v';
+}
+
+static const char* skip_blanks(const char* p, const char* end) {
+    while (p < end && is_blank(*p)) p++;
+    return p;
+}
+
+const char* graph_scan_int(const char* p, const char* end, long long* value) {
+    p = skip_blanks(p, end);
+
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = (*p == '-');
+        p++;
+    }
+
+    const char* digits = p;
+    unsigned long long result = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        if (p - digits >= 18) return NULL;  // Beyond any vertex id or count we accept
+        result = result * 10 + (unsigned long long)(*p - '0');
+        p++;
+    }
+    if (p == digits) return NULL;
+    if (p < end && !is_space(*p) && *p != '#') return NULL;
+
+    *value = negative ? -(long long)result : (long long)result;
+    return p;
+}
+
+const char* graph_scan_double(const char* p, const char* end, double* value) {
+    p = skip_blanks(p, end);
+    const char* token = p;
+
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = (*p == '-');
+        p++;
+    }
+
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    bool any_digit = false;
+    bool exact = true;
+
+    while (p < end && *p >= '0' && *p <= '9') {
+        any_digit = true;
+        if (digits < 19) {
+            if (mantissa || *p != '0') digits++;
+            mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+        } else {
+            exact = false;
+        }
+        p++;
+    }
+    if (p < end && *p == '.') {
+        p++;
+        while (p < end && *p >= '0' && *p <= '9') {
+            any_digit = true;
+            if (digits < 19) {
+                if (mantissa || *p != '0') digits++;
+                mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+                exponent--;
+            } else {
+                exact = false;
+            }
+            p++;
+        }
+    }
+    if (!any_digit) {
+        // Let strtod handle inf/nan spellings
+        exact = false;
+        while (p < end && !is_space(*p) && *p != '#') p++;
+    } else if (p < end && (*p == 'e' || *p == 'E')) {
+        p++;
+        bool exp_negative = false;
+        if (p < end && (*p == '-' || *p == '+')) {
+            exp_negative = (*p == '-');
+            p++;
+        }
+        int exp_value = 0;
+        const char* exp_digits = p;
+        while (p < end && *p >= '0' && *p <= '9') {
+            if (exp_value < 10000) exp_value = exp_value * 10 + (*p - '0');
+            p++;
+        }
+        if (p == exp_digits) return NULL;
+        exponent += exp_negative ? -exp_value : exp_value;
+    }
+    if (p < end && !is_space(*p) && *p != '#') return NULL;
+
+    // Clinger's fast path: both the mantissa and the power of ten are exact doubles
+    if (exact && mantissa <= (1ULL << 53) && exponent >= -22 && exponent <= 22) {
+        double result = (double)mantissa;
+        result = (exponent < 0) ? result / POW10[-exponent] : result * POW10[exponent];
+        *value = negative ? -result : result;
+        return p;
+    }
+
+    // Slow path for long mantissas, large exponents and special values
+    char buffer[128];
+    size_t length = (size_t)(p - token);
+    if (length == 0 || length >= sizeof(buffer)) return NULL;
+    memcpy(buffer, token, length);
+    buffer[length] = '\0';
+    char* parsed_end = NULL;
+    double result = strtod(buffer, &parsed_end);
+    if (parsed_end != buffer + length) return NULL;
+    *value = result;
+    return p;
+}
+
+// Skip whitespace and '#' comments including newlines, counting lines
+static void cursor_skip_space(Cursor* cursor) {
+    while (cursor->p < cursor->end) {
+        char c = *cursor->p;
+        if (c == '#') {
+            while (cursor->p < cursor->end && *cursor->p != '\n') cursor->p++;
+            continue;
+        }
+        if (!is_space(c)) break;
+        if (c == '\n') cursor->line++;
+        cursor->p++;
+    }
+}
+
+static bool cursor_at_end(Cursor* cursor) {
+    cursor_skip_space(cursor);
+    return cursor->p >= cursor->end;
+}
+
+static bool cursor_read_int(Cursor* cursor, long long* value) {
+    cursor_skip_space(cursor);
+    const char* next = graph_scan_int(cursor->p, cursor->end, value);
+    if (!next) return false;
+    cursor->p = next;
+    return true;
+}
+
+static bool cursor_read_double(Cursor* cursor, double* value) {
+    cursor_skip_space(cursor);
+    const char* next = graph_scan_double(cursor->p, cursor->end, value);
+    if (!next) return false;
+    cursor->p = next;
+    return true;
+}
+
+// Recognise y/yes/true and n/no/false (case-insensitive), plus 1/0 when
+// allow_digits is set, without consuming anything on failure
+static bool cursor_read_flag(Cursor* cursor, bool allow_digits, bool* flag) {
+    cursor_skip_space(cursor);
+    const char* p = cursor->p;
+    char token[8];
+    size_t length = 0;
+    while (p < cursor->end && !is_space(*p)) {
+        if (length + 1 >= sizeof(token)) return false;
+        char c = *p++;
+        token[length++] = (c >= 'A' && c <= 'Z') ? (char)(c - 'A' + 'a') : c;
+    }
+    token[length] = '\0';
+
+    if (!strcmp(token, "y") || !strcmp(token, "yes") || !strcmp(token, "true") ||
+        (allow_digits && !strcmp(token, "1"))) {
+        *flag = true;
+    } else if (!strcmp(token, "n") || !strcmp(token, "no") || !strcmp(token, "false") ||
+               (allow_digits && !strcmp(token, "0"))) {
+        *flag = false;
+    } else {
+        return false;
+    }
+    cursor->p = p;
+    return true;
+}
+
+static const char* next_line(const char* p, const char* end) {
+    const char* newline = (const char*)memchr(p, '\n', (size_t)(end - p));
+    return newline ? newline + 1 : end;
+}
+
+// Count the values on one line, ignoring a '#' comment. *line_end is set to
+// the line's newline, or to end on the last line.
+static int count_line_values(const char* p, const char* end, const char** line_end) {
+    int values = 0;
+    while (true) {
+        p = skip_blanks(p, end);
+        if (p >= end || *p == '\n') break;
+        if (*p == '#') {
+            const char* newline = (const char*)memchr(p, '\n', (size_t)(end - p));
+            p = newline ? newline : end;
+            break;
+        }
+        values++;
+        while (p < end && !is_space(*p) && *p != '#') p++;
+    }
+    *line_end = p;
+    return values;
+}
+
+// Edges held by a line of that many values: "src dest weight" triples in a
+// weighted graph, "src dest" pairs otherwise (a single "src dest weight" is
+// accepted and its weight ignored). An unweighted line of 6, 12, ... values
+// could be pairs or weighted triples, so it is rejected rather than guessed.
+// Returns -1 for any count not accepted.
+static int edges_on_line(int values, bool is_weighted) {
+    if (is_weighted) return (values % 3 == 0) ? values / 3 : -1;
+    if (values == 3) return 1;
+    if (values > 0 && values % 6 == 0) return -1;
+    return (values % 2 == 0) ? values / 2 : -1;
+}
+
+// Count pass: edges on each slice's leading edge lines, and its line breaks
+static void count_edge_chunk(size_t begin, size_t end, int thread_id, void* arg) {
+    (void)thread_id;
+    EdgeParseContext* ctx = (EdgeParseContext*)arg;
+
+    for (size_t c = begin; c < end; c++) {
+        EdgeChunk* chunk = &ctx->chunks[c];
+        const char* p = chunk->begin;
+
+        while (p < chunk->end && !chunk->stopped) {
+            const char* line_end;
+            int edges = edges_on_line(count_line_values(p, chunk->end, &line_end), ctx->is_weighted);
+            if (edges < 0) {
+                chunk->stopped = true;
+                break;
+            }
+            chunk->num_edges += edges;
+            if (line_end < chunk->end) chunk->newlines++;
+            p = (line_end < chunk->end) ? line_end + 1 : line_end;
+        }
+        while (p < chunk->end) {
+            const char* newline = (const char*)memchr(p, '\n', (size_t)(chunk->end - p));
+            if (!newline) break;
+            chunk->newlines++;
+            p = newline + 1;
+        }
+    }
+}
+
+static void chunk_error(EdgeChunk* chunk, int line, const char* format, ...) {
+    chunk->error_line = line;
+    va_list args;
+    va_start(args, format);
+    vsnprintf(chunk->error_message, sizeof(chunk->error_message), format, args);
+    va_end(args);
+}
+
+// Parse pass: read each slice's edges directly into their final slots
+static void parse_edge_chunk(size_t begin, size_t end, int thread_id, void* arg) {
+    (void)thread_id;
+    EdgeParseContext* ctx = (EdgeParseContext*)arg;
+
+    for (size_t c = begin; c < end; c++) {
+        EdgeChunk* chunk = &ctx->chunks[c];
+        const char* p = chunk->begin;
+        int line = chunk->first_line;
+        int parsed = 0;
+
+        while (parsed < chunk->take && !chunk->error_line) {
+            if (p >= chunk->end) {
+                chunk_error(chunk, line, "expected %d edges, found %d",
+                            ctx->num_edges, chunk->first_edge + parsed);
+                break;
+            }
+
+            const char* line_end;
+            int values = count_line_values(p, chunk->end, &line_end);
+            int edges = edges_on_line(values, ctx->is_weighted);
+            if (edges < 0) {
+                if (ctx->is_weighted && values % 3 == 2) {
+                    chunk_error(chunk, line, "missing weight for weighted graph");
+                } else if (!ctx->is_weighted && values % 6 == 0) {
+                    chunk_error(chunk, line, "%d values could be \"src dest\" pairs or "
+                                "\"src dest weight\" triples; use one edge per line", values);
+                } else {
+                    chunk_error(chunk, line, "expected %s per edge, found %d values",
+                                ctx->is_weighted ? "\"src dest weight\"" : "\"src dest\"", values);
+                }
+                break;
+            }
+            if (edges > chunk->take - parsed) {
+                chunk_error(chunk, line, "unexpected text after edge");
+                break;
+            }
+
+            const char* q = p;
+            for (int e = 0; e < edges; e++) {
+                long long src, dest;
+                double weight = 1.0;
+
+                q = graph_scan_int(q, line_end, &src);
+                if (!q) {
+                    chunk_error(chunk, line, "expected integer source vertex");
+                    break;
+                }
+                q = graph_scan_int(q, line_end, &dest);
+                if (!q) {
+                    chunk_error(chunk, line, "expected integer destination vertex");
+                    break;
+                }
+                if (src < 0 || src >= ctx->num_vertices || dest < 0 || dest >= ctx->num_vertices) {
+                    chunk_error(chunk, line, "edge %lld -> %lld references a vertex outside [0, %d)",
+                                src, dest, ctx->num_vertices);
+                    break;
+                }
+                if (ctx->is_weighted || values == 3) {
+                    q = graph_scan_double(q, line_end, &weight);
+                    if (!q) {
+                        chunk_error(chunk, line, "invalid edge weight");
+                        break;
+                    }
+                }
+
+                EdgeInput* edge = &ctx->edges[chunk->first_edge + parsed + e];
+                edge->src = (int)src;
+                edge->dest = (int)dest;
+                edge->weight = weight;
+            }
+            parsed += edges;
+
+            if (line_end < chunk->end) {
+                p = line_end + 1;
+                line++;
+            } else {
+                p = line_end;
+            }
+        }
+
+        chunk->stop = p;
+        chunk->stop_line = line;
+    }
+}
+
+// Read the optional coordinates section and query vertices after the edges
+static bool parse_trailer(Cursor* cursor, Graph* graph, GraphFileInfo* info, GraphParseError* error) {
+    if (cursor_at_end(cursor)) return true;
+
+    // A y/n flag introduces the coordinates section; a number starts the query
+    bool has_coordinates = false;
+    if (cursor_read_flag(cursor, false, &has_coordinates) && has_coordinates) {
+        for (int v = 0; v < graph->num_vertices; v++) {
+            double x, y;
+            if (!cursor_read_double(cursor, &x) || !cursor_read_double(cursor, &y)) {
+                set_error(error, cursor->line, "expected coordinates \"x y\" for vertex %d", v);
+                return false;
+            }
+            if (!graph_set_coordinates(graph, v, x, y)) {
+                set_error(error, cursor->line, "failed to store coordinates");
+                return false;
+            }
+        }
+        info->has_coordinates = true;
+    }
+
+    if (cursor_at_end(cursor)) return true;
+
+    long long start, end;
+    if (!cursor_read_int(cursor, &start)) {
+        set_error(error, cursor->line, "expected start vertex");
+        return false;
+    }
+    if (!cursor_read_int(cursor, &end)) {
+        set_error(error, cursor->line, "expected end vertex");
+        return false;
+    }
+    if (start < 0 || start >= graph->num_vertices || end < 0 || end >= graph->num_vertices) {
+        set_error(error, cursor->line, "query vertices %lld -> %lld out of range", start, end);
+        return false;
+    }
+    if (!cursor_at_end(cursor)) {
+        set_error(error, cursor->line, "unexpected content after query vertices");
+        return false;
+    }
+
+    info->has_query = true;
+    info->start = (int)start;
+    info->end = (int)end;
+    return true;
+}
+
+Graph* graph_parse_buffer(const char* data, size_t size, const GraphParseOptions* options,
+                          GraphFileInfo* info, GraphParseError* error) {
+    GraphParseOptions default_options;
+    graph_parse_options_init(&default_options);
+    if (!options) options = &default_options;
+
+    GraphFileInfo local_info;
+    if (!info) info = &local_info;
+    memset(info, 0, sizeof(GraphFileInfo));
+    if (error) {
+        error->line = 0;
+        error->message[0] = '\0';
+    }
+
+    Cursor cursor = {data, data + size, 1};
+    long long num_vertices, num_edges;
+    bool is_weighted, is_directed;
+
+    if (cursor_at_end(&cursor)) {
+        set_error(error, 0, "empty file");
+        return NULL;
+    }
+    if (!cursor_read_int(&cursor, &num_vertices) || num_vertices <= 0 || num_vertices > INT32_MAX) {
+        set_error(error, cursor.line, "expected a positive number of vertices");
+        return NULL;
+    }
+    if (!cursor_read_flag(&cursor, true, &is_weighted)) {
+        set_error(error, cursor.line, "expected weighted flag (y/n)");
+        return NULL;
+    }
+    if (!cursor_read_flag(&cursor, true, &is_directed)) {
+        set_error(error, cursor.line, "expected directed flag (y/n)");
+        return NULL;
+    }
+    if (!cursor_read_int(&cursor, &num_edges) || num_edges < 0 || num_edges > INT32_MAX) {
+        set_error(error, cursor.line, "expected a non-negative number of edges");
+        return NULL;
+    }
+
+    // Edges start on the first non-blank, non-comment line after the edge count
+    const char* p = skip_blanks(cursor.p, cursor.end);
+    if (p < cursor.end && *p != '\n' && *p != '#') {
+        set_error(error, cursor.line, "unexpected text after edge count");
+        return NULL;
+    }
+    cursor.p = p;
+    cursor_skip_space(&cursor);
+    while (cursor.p > data && cursor.p[-1] != '\n') cursor.p--;  // Back to the line start
+
+    int m = (int)num_edges;
+    int num_threads = parallel_resolve_threads(options->num_threads);
+    int num_chunks = (m >= PARALLEL_EDGE_THRESHOLD) ? num_threads : 1;
+
+    EdgeInput* edges = (EdgeInput*)malloc((m > 0 ? m : 1) * sizeof(EdgeInput));
+    EdgeChunk* chunks = (EdgeChunk*)calloc(num_chunks, sizeof(EdgeChunk));
+    if (!edges || !chunks) {
+        set_error(error, 0, "out of memory");
+        free(edges);
+        free(chunks);
+        return NULL;
+    }
+
+    // Cut the rest of the file into byte slices at line starts
+    const char* section = cursor.p;
+    size_t span = (size_t)(cursor.end - section);
+    for (int c = 0; c < num_chunks; c++) {
+        chunks[c].begin = (c == 0) ? section : chunks[c - 1].end;
+        const char* cut = section + span * (size_t)(c + 1) / (size_t)num_chunks;
+        if (c == num_chunks - 1) {
+            cut = cursor.end;
+        } else if (cut <= chunks[c].begin) {
+            cut = chunks[c].begin;
+        } else if (cut[-1] != '\n') {
+            cut = next_line(cut, cursor.end);
+        }
+        chunks[c].end = cut;
+    }
+
+    EdgeParseContext ctx;
+    ctx.num_vertices = (int)num_vertices;
+    ctx.num_edges = m;
+    ctx.is_weighted = is_weighted;
+    ctx.edges = edges;
+    ctx.chunks = chunks;
+
+    // Edge lines may hold several edges, so the first edge of each slice
+    // comes from a count pass. The trailer is counted too but never taken.
+    if (num_chunks > 1) {
+        parallel_for(num_threads, (size_t)num_chunks, count_edge_chunk, &ctx);
+    }
+    int remaining = m;
+    int line = cursor.line;
+    for (int c = 0; c < num_chunks; c++) {
+        chunks[c].first_line = line;
+        chunks[c].first_edge = m - remaining;
+        if (chunks[c].stopped || c == num_chunks - 1) {
+            // The parse pass reports the bad line or the missing edges
+            chunks[c].take = remaining;
+        } else {
+            chunks[c].take = (chunks[c].num_edges < remaining) ? (int)chunks[c].num_edges : remaining;
+        }
+        remaining -= chunks[c].take;
+        line += chunks[c].newlines;
+    }
+    parallel_for(num_threads, (size_t)num_chunks, parse_edge_chunk, &ctx);
+
+    // Report the earliest failing line; the trailer follows the last edge taken
+    const char* trailer = section;
+    int trailer_line = cursor.line;
+    for (int c = 0; c < num_chunks; c++) {
+        if (chunks[c].error_line) {
+            set_error(error, chunks[c].error_line, "%s", chunks[c].error_message);
+            free(edges);
+            free(chunks);
+            return NULL;
+        }
+        if (chunks[c].take > 0) {
+            trailer = chunks[c].stop;
+            trailer_line = chunks[c].stop_line;
+        }
+    }
+    free(chunks);
+
+    GraphBuildOptions build_options;
+    graph_build_options_init(&build_options);
+    build_options.num_threads = options->num_threads;
+    build_options.sort_neighbors = options->sort_neighbors;
+    build_options.deduplicate = options->deduplicate;
+    Graph* graph = graph_build_from_edges((int)num_vertices, is_weighted, is_directed,
+                                          edges, (size_t)m, &build_options);
+    free(edges);
+    if (!graph) {
+        set_error(error, 0, "failed to build graph");
+        return NULL;
+    }
+
+    cursor.p = trailer;
+    cursor.line = trailer_line;
+    if (!parse_trailer(&cursor, graph, info, error)) {
+        graph_destroy(graph);
+        return NULL;
+    }
+    return graph;
+}
+
+bool graph_file_view_open(const char* path, GraphFileView* view, GraphParseError* error) {
+    view->data = "";
+    view->size = 0;
+    view->mapping = NULL;
+    view->buffer = NULL;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        set_error(error, 0, "cannot open file: %s", path);
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        set_error(error, 0, "cannot stat file: %s", path);
+        return false;
+    }
+
+    size_t size = (size_t)st.st_size;
+    if (size > 0) {
+        void* mapped = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped != MAP_FAILED) {
+            posix_madvise(mapped, size, POSIX_MADV_SEQUENTIAL);
+            close(fd);
+            view->data = (const char*)mapped;
+            view->size = size;
+            view->mapping = mapped;
+            return true;
+        }
+    }
+
+    // Not mappable (e.g. a pipe): read it in large blocks instead
+    size_t capacity = size + 1;
+    char* buffer = (char*)malloc(capacity);
+    size_t length = 0;
+    while (buffer) {
+        ssize_t got = read(fd, buffer + length, capacity - length);
+        if (got <= 0) break;
+        length += (size_t)got;
+        if (length == capacity) {
+            char* grown = (char*)realloc(buffer, capacity * 2);
+            if (!grown) {
+                free(buffer);
+                buffer = NULL;
+                break;
+            }
+            buffer = grown;
+            capacity *= 2;
+        }
+    }
+    close(fd);
+
+    if (!buffer) {
+        set_error(error, 0, "out of memory reading %s", path);
+        return false;
+    }
+    view->data = buffer;
+    view->size = length;
+    view->buffer = buffer;
+    return true;
+}
+
+void graph_file_view_close(GraphFileView* view) {
+    if (!view) return;
+    if (view->mapping) {
+        munmap(view->mapping, view->size);
+    }
+    free(view->buffer);
+    view->data = "";
+    view->size = 0;
+    view->mapping = NULL;
+    view->buffer = NULL;
+}
+
+Graph* graph_parse_file(const char* path, const GraphParseOptions* options,
+                        GraphFileInfo* info, GraphParseError* error) {
+    GraphFileView view;
+    if (!graph_file_view_open(path, &view, error)) {
+        return NULL;
+    }
+    Graph* graph = graph_parse_buffer(view.data, view.size, options, info, error);
+    graph_file_view_close(&view);
+    return graph;
+}
@@ -0,0 +1,212 @@
+#define _POSIX_C_SOURCE 200809L
+#include "graph_snapshot.h"
+#include "graph_formats.h"
+#include "union_find.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <time.h>
+
+#define READER_IDLE 0ULL       // Epoch value of a reader outside any guard
+#define CACHE_LINE 64
+
+// One published version of the graph
+typedef struct GraphSnapshot {
+    Graph* graph;
+    unsigned long long version;
+    unsigned long long retire_epoch;   // Global epoch when it was replaced
+    struct GraphSnapshot* next;        // Retired list
+} GraphSnapshot;
+
+// Readers announce the epoch they entered in; padded so that readers on
+// different cores do not share a cache line
+typedef struct {
+    atomic_ullong epoch;
+    atomic_bool in_use;
+    char padding[CACHE_LINE - sizeof(atomic_ullong) - sizeof(atomic_bool)];
+} ReaderSlot;
+
+struct GraphSnapshotManager {
+    _Atomic(GraphSnapshot*) current;
+    atomic_ullong global_epoch;
+    ReaderSlot* readers;
+    int max_readers;
+
+    pthread_mutex_t writer_lock;       // Serializes publish and reclaim
+    GraphSnapshot* retired;            // Protected by writer_lock
+    unsigned long long next_version;   // Protected by writer_lock
+};
+
+static void snapshot_free(GraphSnapshot* snapshot) {
+    graph_destroy(snapshot->graph);
+    free(snapshot);
+}
+
+GraphSnapshotManager* graph_snapshot_manager_create(Graph* initial, int max_readers) {
+    if (!initial || max_readers <= 0) {
+        fprintf(stderr, "Error: Snapshot manager needs a graph and at least one reader\n");
+        return NULL;
+    }
+
+    GraphSnapshotManager* manager = (GraphSnapshotManager*)calloc(1, sizeof(GraphSnapshotManager));
+    GraphSnapshot* snapshot = (GraphSnapshot*)calloc(1, sizeof(GraphSnapshot));
+    ReaderSlot* readers = (ReaderSlot*)calloc(max_readers, sizeof(ReaderSlot));
+    if (!manager || !snapshot || !readers) {
+        fprintf(stderr, "Error: Memory allocation failed for snapshot manager\n");
+        free(manager);
+        free(snapshot);
+        free(readers);
+        return NULL;
+    }
+
+    for (int i = 0; i < max_readers; i++) {
+        atomic_init(&readers[i].epoch, READER_IDLE);
+        atomic_init(&readers[i].in_use, false);
+    }
+    snapshot->graph = initial;
+    snapshot->version = 1;
+    graph_components_warm(initial);
+    manager->readers = readers;
+    manager->max_readers = max_readers;
+    manager->next_version = 2;
+    atomic_init(&manager->current, snapshot);
+    atomic_init(&manager->global_epoch, 1ULL);
+    pthread_mutex_init(&manager->writer_lock, NULL);
+    return manager;
+}
+
+void graph_snapshot_manager_destroy(GraphSnapshotManager* manager) {
+    if (!manager) return;
+    while (manager->retired) {
+        GraphSnapshot* next = manager->retired->next;
+        snapshot_free(manager->retired);
+        manager->retired = next;
+    }
+    snapshot_free(atomic_load(&manager->current));
+    pthread_mutex_destroy(&manager->writer_lock);
+    free(manager->readers);
+    free(manager);
+}
+
+int graph_snapshot_reader_register(GraphSnapshotManager* manager) {
+    if (!manager) return -1;
+    for (int i = 0; i < manager->max_readers; i++) {
+        bool expected = false;
+        if (atomic_compare_exchange_strong(&manager->readers[i].in_use, &expected, true)) {
+            return i;
+        }
+    }
+    fprintf(stderr, "Error: All %d snapshot reader slots are in use\n", manager->max_readers);
+    return -1;
+}
+
+void graph_snapshot_reader_unregister(GraphSnapshotManager* manager, int reader) {
+    if (!manager || reader < 0 || reader >= manager->max_readers) return;
+    atomic_store(&manager->readers[reader].epoch, READER_IDLE);
+    atomic_store(&manager->readers[reader].in_use, false);
+}
+
+const Graph* graph_snapshot_acquire(GraphSnapshotManager* manager, int reader,
+                                    unsigned long long* version) {
+    ReaderSlot* slot = &manager->readers[reader];
+
+    // Announce before loading current (both sequentially consistent): a writer
+    // that misses the announcement swapped current before our load, so we
+    // cannot see the version it is about to free.
+    atomic_store(&slot->epoch, atomic_load(&manager->global_epoch));
+    GraphSnapshot* snapshot = atomic_load(&manager->current);
+    if (version) *version = snapshot->version;
+    return snapshot->graph;
+}
+
+void graph_snapshot_release(GraphSnapshotManager* manager, int reader) {
+    atomic_store_explicit(&manager->readers[reader].epoch, READER_IDLE, memory_order_release);
+}
+
+// Free retired versions older than every active reader; caller holds writer_lock
+static int reclaim_locked(GraphSnapshotManager* manager) {
+    unsigned long long oldest = atomic_load(&manager->global_epoch);
+    for (int i = 0; i < manager->max_readers; i++) {
+        unsigned long long epoch = atomic_load(&manager->readers[i].epoch);
+        if (epoch != READER_IDLE && epoch < oldest) {
+            oldest = epoch;
+        }
+    }
+
+    int remaining = 0;
+    GraphSnapshot** link = &manager->retired;
+    while (*link) {
+        GraphSnapshot* snapshot = *link;
+        // Readers that entered after the retirement epoch saw a newer version
+        if (snapshot->retire_epoch < oldest) {
+            *link = snapshot->next;
+            snapshot_free(snapshot);
+        } else {
+            link = &snapshot->next;
+            remaining++;
+        }
+    }
+    return remaining;
+}
+
+unsigned long long graph_snapshot_publish(GraphSnapshotManager* manager, Graph* graph) {
+    if (!manager || !graph) return 0;
+
+    GraphSnapshot* snapshot = (GraphSnapshot*)calloc(1, sizeof(GraphSnapshot));
+    if (!snapshot) {
+        fprintf(stderr, "Error: Memory allocation failed for graph snapshot\n");
+        graph_destroy(graph);
+        return 0;
+    }
+    snapshot->graph = graph;
+    // Lazy state is built before readers can see the graph, not on their queries
+    graph_components_warm(graph);
+
+    pthread_mutex_lock(&manager->writer_lock);
+    snapshot->version = manager->next_version++;
+    GraphSnapshot* old = atomic_exchange(&manager->current, snapshot);
+
+    // Readers still announcing an epoch <= retire_epoch may hold old
+    old->retire_epoch = atomic_fetch_add(&manager->global_epoch, 1ULL);
+    old->next = manager->retired;
+    manager->retired = old;
+    reclaim_locked(manager);
+
+    unsigned long long version = snapshot->version;
+    pthread_mutex_unlock(&manager->writer_lock);
+    return version;
+}
+
+unsigned long long graph_snapshot_reload_file(GraphSnapshotManager* manager, const char* path,
+                                              GraphParseError* error) {
+    if (!manager) return 0;
+
+    // Build outside the writer lock: readers and other writers are unaffected
+    Graph* graph = graph_load_file(path, NULL, NULL, error);
+    if (!graph) {
+        return 0;
+    }
+    return graph_snapshot_publish(manager, graph);
+}
+
+int graph_snapshot_reclaim(GraphSnapshotManager* manager) {
+    if (!manager) return 0;
+    pthread_mutex_lock(&manager->writer_lock);
+    int remaining = reclaim_locked(manager);
+    pthread_mutex_unlock(&manager->writer_lock);
+    return remaining;
+}
+
+void graph_snapshot_synchronize(GraphSnapshotManager* manager) {
+    // Guards are short (one query), so a brief sleep between scans suffices
+    struct timespec pause = {0, 100000};
+    while (graph_snapshot_reclaim(manager) > 0) {
+        nanosleep(&pause, NULL);
+    }
+}
+
+unsigned long long graph_snapshot_version(GraphSnapshotManager* manager) {
+    if (!manager) return 0;
+    return atomic_load(&manager->current)->version;
+}
@@ -0,0 +1,397 @@
+#include "graph_view.h"
+#include "min_heap.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define INITIAL_NEIGHBOR_CAPACITY 16
+
+static int adjacency_neighbors(const void* data, int vertex, int* dests, double* weights,
+                               int capacity) {
+    const Graph* graph = (const Graph*)data;
+    int degree = 0;
+    for (Edge* edge = graph->adj_list[vertex]; edge; edge = edge->next) {
+        if (degree < capacity) {
+            dests[degree] = edge->dest;
+            weights[degree] = edge->weight;
+        }
+        degree++;
+    }
+    return degree;
+}
+
+static double adjacency_heuristic(const void* data, int from, int to) {
+    return graph_euclidean_distance((const Graph*)data, from, to);
+}
+
+GraphView graph_view_from_graph(const Graph* graph) {
+    GraphView view;
+    view.data = graph;
+    view.num_vertices = graph ? graph->num_vertices : 0;
+    view.neighbors = adjacency_neighbors;
+    view.heuristic = graph_has_coordinates(graph) ? adjacency_heuristic : NULL;
+    // Straight-line distance only bounds arbitrary edge weights from below when
+    // no edge is shorter than its endpoints are apart, which nothing enforces
+    view.heuristic_admissible = false;
+    return view;
+}
+
+// Per-search neighbour buffers, grown when a vertex has more neighbours
+typedef struct {
+    int* dests;
+    double* weights;
+    int capacity;
+} NeighborBuffer;
+
+static bool neighbor_buffer_init(NeighborBuffer* buffer) {
+    buffer->capacity = INITIAL_NEIGHBOR_CAPACITY;
+    buffer->dests = (int*)malloc(buffer->capacity * sizeof(int));
+    buffer->weights = (double*)malloc(buffer->capacity * sizeof(double));
+    return buffer->dests && buffer->weights;
+}
+
+static void neighbor_buffer_free(NeighborBuffer* buffer) {
+    free(buffer->dests);
+    free(buffer->weights);
+}
+
+// Neighbours of vertex into buffer; returns the degree, or -1 on allocation failure
+static int view_neighbors(const GraphView* view, int vertex, NeighborBuffer* buffer) {
+    int degree = view->neighbors(view->data, vertex, buffer->dests, buffer->weights, buffer->capacity);
+    if (degree > buffer->capacity) {
+        int* dests = (int*)realloc(buffer->dests, degree * sizeof(int));
+        if (dests) buffer->dests = dests;
+        double* weights = (double*)realloc(buffer->weights, degree * sizeof(double));
+        if (weights) buffer->weights = weights;
+        if (!dests || !weights) return -1;
+        buffer->capacity = degree;
+        degree = view->neighbors(view->data, vertex, buffer->dests, buffer->weights, buffer->capacity);
+    }
+    return degree;
+}
+
+// Position in one vertex's neighbours. Adjacency-list views are walked in
+// place; other views are copied into the buffer through their callback.
+typedef struct {
+    const Edge* edge;
+    int index;
+    int degree;
+} NeighborCursor;
+
+// Graph behind an adjacency-list view, NULL for callback views
+static const Graph* view_adjacency(const GraphView* view) {
+    return (view->neighbors == adjacency_neighbors) ? (const Graph*)view->data : NULL;
+}
+
+// Start on the neighbours of vertex; false on allocation failure
+static bool neighbors_begin(const GraphView* view, const Graph* adjacency, int vertex,
+                            NeighborBuffer* buffer, NeighborCursor* cursor) {
+    cursor->index = 0;
+    if (adjacency) {
+        cursor->edge = adjacency->adj_list[vertex];
+        cursor->degree = 0;
+        return true;
+    }
+    cursor->edge = NULL;
+    cursor->degree = view_neighbors(view, vertex, buffer);
+    return cursor->degree >= 0;
+}
+
+static bool neighbors_next(const Graph* adjacency, const NeighborBuffer* buffer,
+                           NeighborCursor* cursor, int* dest, double* weight) {
+    if (adjacency) {
+        if (!cursor->edge) return false;
+        *dest = cursor->edge->dest;
+        *weight = cursor->edge->weight;
+        cursor->edge = cursor->edge->next;
+        return true;
+    }
+    if (cursor->index >= cursor->degree) return false;
+    *dest = buffer->dests[cursor->index];
+    *weight = buffer->weights[cursor->index++];
+    return true;
+}
+
+static bool view_valid_vertex(const GraphView* view, int vertex) {
+    return view && vertex >= 0 && vertex < view->num_vertices;
+}
+
+void graph_view_search_options_init(GraphViewSearchOptions* options) {
+    if (!options) return;
+    options->heuristic = NULL;
+    options->heuristic_data = NULL;
+    options->heuristic_weight = 1.0;
+    options->limits = NULL;
+}
+
+bool graph_view_breadth_first_workspace(const GraphView* view, int start, int end,
+                                        const SearchLimits* limits, SearchWorkspace* workspace) {
+    SearchStats* stats = &workspace->stats;
+    unsigned int generation = workspace->generation;
+    const Graph* adjacency = view_adjacency(view);
+    NeighborBuffer buffer = {NULL, NULL, 0};
+    if (!adjacency && !neighbor_buffer_init(&buffer)) {
+        neighbor_buffer_free(&buffer);
+        workspace->status = SEARCH_OUT_OF_MEMORY;
+        return false;
+    }
+
+    int front = 0;
+    int rear = 0;
+    workspace->seen[start] = generation;
+    workspace->parent[start] = -1;
+    workspace->dist[start] = 0.0;
+    workspace->queue[rear++] = start;
+    stats->heap_pushes = 1;
+    stats->peak_queue_size = 1;
+
+    // Vertices are marked on enqueue, so every dequeue settles one
+    while (front < rear) {
+        int u = workspace->queue[front++];
+        stats->heap_pops++;
+        if ((stats->heap_pops & (SEARCH_LIMITS_CHECK_INTERVAL - 1)) == 0 &&
+            (workspace->status = search_limits_check(limits)) != SEARCH_COMPLETED) {
+            break;
+        }
+        stats->vertices_settled++;
+        if (u == end) break;
+
+        NeighborCursor cursor;
+        if (!neighbors_begin(view, adjacency, u, &buffer, &cursor)) {
+            workspace->status = SEARCH_OUT_OF_MEMORY;
+            break;
+        }
+        int v;
+        double weight;
+        while (neighbors_next(adjacency, &buffer, &cursor, &v, &weight)) {
+            stats->edges_relaxed++;
+            if (workspace->seen[v] != generation) {
+                workspace->seen[v] = generation;
+                workspace->parent[v] = u;
+                workspace->dist[v] = workspace->dist[u] + weight;
+                workspace->queue[rear++] = v;
+                stats->heap_pushes++;
+            }
+        }
+        if (rear - front > stats->peak_queue_size) stats->peak_queue_size = rear - front;
+    }
+
+    stats->bytes_allocated += buffer.capacity * (sizeof(int) + sizeof(double));
+    neighbor_buffer_free(&buffer);
+    // An interrupted search may hold a partial path
+    return workspace->status == SEARCH_COMPLETED && workspace->seen[end] == generation;
+}
+
+bool graph_view_best_first_workspace(const GraphView* view, int start, int end,
+                                     const GraphViewSearchOptions* options,
+                                     SearchWorkspace* workspace) {
+    SearchStats* stats = &workspace->stats;
+    unsigned int generation = workspace->generation;
+    MinHeap* heap = workspace->heap;
+    const Graph* adjacency = view_adjacency(view);
+    GraphViewHeuristic heuristic = options->heuristic;
+    const void* heuristic_data = options->heuristic_data;
+    double heuristic_weight = options->heuristic_weight;
+    NeighborBuffer buffer = {NULL, NULL, 0};
+    if (!adjacency && !neighbor_buffer_init(&buffer)) {
+        neighbor_buffer_free(&buffer);
+        workspace->status = SEARCH_OUT_OF_MEMORY;
+        return false;
+    }
+
+    workspace->seen[start] = generation;
+    workspace->parent[start] = -1;
+    workspace->dist[start] = 0.0;
+    double start_key = heuristic ? heuristic_weight * heuristic(heuristic_data, start, end) : 0.0;
+    if (!min_heap_push(heap, start, start_key)) {
+        workspace->status = SEARCH_OUT_OF_MEMORY;
+    }
+    stats->heap_pushes = 1;
+    stats->peak_queue_size = 1;
+
+    // Closed vertices are never reopened, so with a consistent heuristic the
+    // path costs at most heuristic_weight times the optimum
+    while (!min_heap_is_empty(heap) && workspace->status == SEARCH_COMPLETED) {
+        int u = min_heap_pop(heap).vertex;
+        stats->heap_pops++;
+        if ((stats->heap_pops & (SEARCH_LIMITS_CHECK_INTERVAL - 1)) == 0 &&
+            (workspace->status = search_limits_check(options->limits)) != SEARCH_COMPLETED) {
+            break;
+        }
+        if (workspace->closed[u] == generation) continue;
+        workspace->closed[u] = generation;
+        stats->vertices_settled++;
+        if (u == end) break;
+
+        NeighborCursor cursor;
+        if (!neighbors_begin(view, adjacency, u, &buffer, &cursor)) {
+            workspace->status = SEARCH_OUT_OF_MEMORY;
+            break;
+        }
+        double dist_u = workspace->dist[u];
+        int v;
+        double weight;
+        while (neighbors_next(adjacency, &buffer, &cursor, &v, &weight)) {
+            stats->edges_relaxed++;
+            if (workspace->closed[v] == generation) continue;
+
+            double candidate = dist_u + weight;
+            if (workspace->seen[v] != generation || candidate < workspace->dist[v]) {
+                workspace->seen[v] = generation;
+                workspace->dist[v] = candidate;
+                workspace->parent[v] = u;
+                double key = candidate;
+                if (heuristic) key += heuristic_weight * heuristic(heuristic_data, v, end);
+                if (!min_heap_push(heap, v, key)) {
+                    workspace->status = SEARCH_OUT_OF_MEMORY;  // A dropped entry could hide the shortest path
+                    break;
+                }
+                stats->heap_pushes++;
+            }
+        }
+        if (heap->size > stats->peak_queue_size) stats->peak_queue_size = heap->size;
+    }
+
+    stats->bytes_allocated += buffer.capacity * (sizeof(int) + sizeof(double));
+    neighbor_buffer_free(&buffer);
+    // An interrupted search may hold a tentative path
+    return workspace->status == SEARCH_COMPLETED && workspace->closed[end] == generation;
+}
+
+// One-shot workspace holding only the arrays a kernel reads: queue for
+// breadth-first, closed stamps and a heap for best-first
+static bool scratch_workspace_init(SearchWorkspace* workspace, int n, bool breadth_first) {
+    memset(workspace, 0, sizeof(SearchWorkspace));
+    workspace->capacity = n;
+    workspace->generation = 1;
+    workspace->status = SEARCH_COMPLETED;
+    workspace->dist = (double*)malloc(n * sizeof(double));
+    workspace->parent = (int*)malloc(n * sizeof(int));
+    workspace->seen = (unsigned int*)calloc(n, sizeof(unsigned int));
+    if (breadth_first) {
+        workspace->queue = (int*)malloc(n * sizeof(int));
+        return workspace->dist && workspace->parent && workspace->seen && workspace->queue;
+    }
+    workspace->closed = (unsigned int*)calloc(n, sizeof(unsigned int));
+    workspace->heap = min_heap_create(1024);
+    return workspace->dist && workspace->parent && workspace->seen && workspace->closed &&
+           workspace->heap;
+}
+
+static size_t scratch_workspace_bytes(const SearchWorkspace* workspace) {
+    size_t per_vertex = sizeof(double) + sizeof(int) + sizeof(unsigned int);
+    per_vertex += workspace->queue ? sizeof(int) : sizeof(unsigned int);
+    size_t bytes = workspace->capacity * per_vertex;
+    if (workspace->heap) bytes += sizeof(MinHeap) + workspace->heap->capacity * sizeof(HeapNode);
+    return bytes;
+}
+
+static void scratch_workspace_free(SearchWorkspace* workspace) {
+    free(workspace->dist);
+    free(workspace->parent);
+    free(workspace->seen);
+    free(workspace->closed);
+    free(workspace->queue);
+    min_heap_destroy(workspace->heap);
+}
+
+// Run a kernel on a one-shot workspace and copy its outcome into result
+static void scratch_search(const GraphView* view, int start, int end, bool breadth_first,
+                           const GraphViewSearchOptions* options, PathResult* result) {
+    long long start_ns = graph_clock_ns();
+    SearchWorkspace workspace;
+    if (!scratch_workspace_init(&workspace, view->num_vertices, breadth_first)) {
+        fprintf(stderr, "Error: Memory allocation failed for %s\n", result->algorithm);
+        result->status = SEARCH_OUT_OF_MEMORY;
+        scratch_workspace_free(&workspace);
+        return;
+    }
+
+    long long search_ns = graph_clock_ns();
+    bool found = breadth_first
+                     ? graph_view_breadth_first_workspace(view, start, end, options->limits, &workspace)
+                     : graph_view_best_first_workspace(view, start, end, options, &workspace);
+    long long reconstruct_ns = graph_clock_ns();
+
+    result->stats = workspace.stats;
+    result->status = workspace.status;
+    if (found) {
+        result->path = path_reconstruct(workspace.parent, start, end, &result->path_length);
+        result->found = (result->path != NULL);
+        result->total_weight = result->found ? workspace.dist[end] : 0.0;
+    }
+
+    long long end_ns = graph_clock_ns();
+    SearchStats* stats = &result->stats;
+    stats->init_ns = search_ns - start_ns;
+    stats->search_ns = reconstruct_ns - search_ns;
+    stats->reconstruct_ns = end_ns - reconstruct_ns;
+    stats->bytes_allocated += scratch_workspace_bytes(&workspace);
+    result->time_ms = (end_ns - start_ns) / 1e6;
+
+    scratch_workspace_free(&workspace);
+}
+
+void graph_view_breadth_first(const GraphView* view, int start, int end,
+                              const SearchLimits* limits, PathResult* result) {
+    GraphViewSearchOptions options;
+    graph_view_search_options_init(&options);
+    options.limits = limits;
+    scratch_search(view, start, end, true, &options, result);
+}
+
+void graph_view_best_first(const GraphView* view, int start, int end,
+                           const GraphViewSearchOptions* options, PathResult* result) {
+    scratch_search(view, start, end, false, options, result);
+}
+
+// Result named after the search; *valid tells whether both endpoints exist
+static PathResult* view_result(const GraphView* view, int start, int end, const char* name,
+                               bool* valid) {
+    PathResult* result = path_result_create();
+    if (!result) return NULL;
+
+    result->algorithm = name;
+    *valid = view_valid_vertex(view, start) && view_valid_vertex(view, end);
+    if (!*valid) {
+        fprintf(stderr, "Error: Invalid start or end vertex\n");
+    }
+    return result;
+}
+
+PathResult* graph_view_bfs(const GraphView* view, int start, int end) {
+    bool valid;
+    PathResult* result = view_result(view, start, end, "BFS (view)", &valid);
+    if (result && valid) {
+        graph_view_breadth_first(view, start, end, NULL, result);
+    }
+    return result;
+}
+
+PathResult* graph_view_dijkstra(const GraphView* view, int start, int end) {
+    bool valid;
+    PathResult* result = view_result(view, start, end, "Dijkstra (view)", &valid);
+    if (result) result->suboptimality_bound = 1.0;
+    if (result && valid) {
+        GraphViewSearchOptions options;
+        graph_view_search_options_init(&options);
+        graph_view_best_first(view, start, end, &options, result);
+    }
+    return result;
+}
+
+PathResult* graph_view_astar(const GraphView* view, int start, int end) {
+    bool valid;
+    PathResult* result = view_result(view, start, end, "A* (view)", &valid);
+    // Without a heuristic this is Dijkstra; otherwise only the view can vouch for it
+    bool exact = view && (!view->heuristic || view->heuristic_admissible);
+    if (result && exact) result->suboptimality_bound = 1.0;
+    if (result && valid) {
+        GraphViewSearchOptions options;
+        graph_view_search_options_init(&options);
+        options.heuristic = view->heuristic;
+        options.heuristic_data = view->data;
+        graph_view_best_first(view, start, end, &options, result);
+    }
+    return result;
+}
@@ -0,0 +1,183 @@
+#include "grid_graph.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#define SQRT2 1.41421356237309504880
+
+// Straight moves first, then diagonals with the two straight cells they pass
+static const int STRAIGHT_DX[4] = { 1, -1, 0, 0 };
+static const int STRAIGHT_DY[4] = { 0, 0, 1, -1 };
+static const int DIAGONAL_DX[4] = { 1, 1, -1, -1 };
+static const int DIAGONAL_DY[4] = { 1, -1, 1, -1 };
+
+GridGraph* grid_graph_create(int width, int height, bool diagonal) {
+    if (width <= 0 || height <= 0 || (long long)width * height > INT32_MAX) {
+        fprintf(stderr, "Error: Invalid grid size %dx%d\n", width, height);
+        return NULL;
+    }
+
+    GridGraph* grid = (GridGraph*)malloc(sizeof(GridGraph));
+    if (!grid) {
+        fprintf(stderr, "Error: Memory allocation failed for grid graph\n");
+        return NULL;
+    }
+
+    size_t cells = (size_t)width * height;
+    grid->width = width;
+    grid->height = height;
+    grid->diagonal = diagonal;
+    grid->blocked = (uint64_t*)calloc((cells + 63) / 64, sizeof(uint64_t));
+    grid->costs = NULL;
+    grid->min_cost = 1.0;
+
+    if (!grid->blocked) {
+        fprintf(stderr, "Error: Memory allocation failed for grid bitmap\n");
+        free(grid);
+        return NULL;
+    }
+
+    return grid;
+}
+
+void grid_graph_destroy(GridGraph* grid) {
+    if (!grid) return;
+    free(grid->blocked);
+    free(grid->costs);
+    free(grid);
+}
+
+static inline bool grid_in_bounds(const GridGraph* grid, int x, int y) {
+    return x >= 0 && y >= 0 && x < grid->width && y < grid->height;
+}
+
+static inline bool cell_open(const GridGraph* grid, int x, int y) {
+    if (!grid_in_bounds(grid, x, y)) return false;
+    size_t cell = (size_t)y * grid->width + x;
+    return !(grid->blocked[cell >> 6] & (1ULL << (cell & 63)));
+}
+
+static inline double cell_cost(const GridGraph* grid, int cell) {
+    return grid->costs ? grid->costs[cell] : 1.0;
+}
+
+bool grid_graph_set_blocked(GridGraph* grid, int x, int y, bool blocked) {
+    if (!grid || !grid_in_bounds(grid, x, y)) return false;
+    size_t cell = (size_t)y * grid->width + x;
+    if (blocked) {
+        grid->blocked[cell >> 6] |= 1ULL << (cell & 63);
+    } else {
+        grid->blocked[cell >> 6] &= ~(1ULL << (cell & 63));
+    }
+    return true;
+}
+
+bool grid_graph_is_open(const GridGraph* grid, int x, int y) {
+    return grid && cell_open(grid, x, y);
+}
+
+bool grid_graph_set_cost(GridGraph* grid, int x, int y, double cost) {
+    if (!grid || !grid_in_bounds(grid, x, y)) return false;
+    if (!(cost > 0.0)) {
+        fprintf(stderr, "Error: Grid cell cost must be positive\n");
+        return false;
+    }
+
+    if (!grid->costs) {
+        size_t cells = (size_t)grid->width * grid->height;
+        grid->costs = (float*)malloc(cells * sizeof(float));
+        if (!grid->costs) {
+            fprintf(stderr, "Error: Memory allocation failed for grid costs\n");
+            return false;
+        }
+        for (size_t i = 0; i < cells; i++) {
+            grid->costs[i] = 1.0f;
+        }
+    }
+
+    grid->costs[(size_t)y * grid->width + x] = (float)cost;
+    // Costs are stored as float, so bound by the rounded value
+    double stored = grid->costs[(size_t)y * grid->width + x];
+    if (stored < grid->min_cost) grid->min_cost = stored;
+    return true;
+}
+
+double grid_graph_get_cost(const GridGraph* grid, int x, int y) {
+    if (!grid || !grid_in_bounds(grid, x, y)) return 0.0;
+    return cell_cost(grid, y * grid->width + x);
+}
+
+size_t grid_graph_memory_usage(const GridGraph* grid) {
+    if (!grid) return 0;
+    size_t cells = (size_t)grid->width * grid->height;
+    size_t bytes = sizeof(GridGraph) + ((cells + 63) / 64) * sizeof(uint64_t);
+    if (grid->costs) bytes += cells * sizeof(float);
+    return bytes;
+}
+
+static int grid_neighbors(const void* data, int vertex, int* dests, double* weights,
+                          int capacity) {
+    const GridGraph* grid = (const GridGraph*)data;
+    int x = vertex % grid->width;
+    int y = vertex / grid->width;
+    int degree = 0;
+
+    // Blocked cells have no edges, matching an explicit grid graph
+    if (!cell_open(grid, x, y)) return 0;
+
+    bool straight_open[4];
+    for (int d = 0; d < 4; d++) {
+        int nx = x + STRAIGHT_DX[d];
+        int ny = y + STRAIGHT_DY[d];
+        straight_open[d] = cell_open(grid, nx, ny);
+        if (!straight_open[d]) continue;
+        if (degree < capacity) {
+            int cell = ny * grid->width + nx;
+            dests[degree] = cell;
+            weights[degree] = cell_cost(grid, cell);
+        }
+        degree++;
+    }
+
+    if (!grid->diagonal) return degree;
+
+    for (int d = 0; d < 4; d++) {
+        int dx = DIAGONAL_DX[d];
+        int dy = DIAGONAL_DY[d];
+        // No corner cutting: both straight cells beside the move must be open
+        bool horizontal = straight_open[dx > 0 ? 0 : 1];
+        bool vertical = straight_open[dy > 0 ? 2 : 3];
+        if (!horizontal || !vertical || !cell_open(grid, x + dx, y + dy)) continue;
+        if (degree < capacity) {
+            int cell = (y + dy) * grid->width + (x + dx);
+            dests[degree] = cell;
+            weights[degree] = cell_cost(grid, cell) * SQRT2;
+        }
+        degree++;
+    }
+
+    return degree;
+}
+
+static double grid_heuristic(const void* data, int from, int to) {
+    const GridGraph* grid = (const GridGraph*)data;
+    int dx = abs(from % grid->width - to % grid->width);
+    int dy = abs(from / grid->width - to / grid->width);
+
+    if (!grid->diagonal) return grid->min_cost * (dx + dy);
+
+    int straight = abs(dx - dy);
+    int diagonal = dx < dy ? dx : dy;
+    return grid->min_cost * (straight + diagonal * SQRT2);
+}
+
+GraphView grid_graph_view(const GridGraph* grid) {
+    GraphView view;
+    view.data = grid;
+    view.num_vertices = grid ? grid->width * grid->height : 0;
+    view.neighbors = grid_neighbors;
+    view.heuristic = grid_heuristic;
+    // Every move costs at least min_cost per unit of octile distance
+    view.heuristic_admissible = true;
+    return view;
+}
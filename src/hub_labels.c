@@ -0,0 +1,677 @@
+#define _POSIX_C_SOURCE 200809L
+#include "hub_labels.h"
+#include "search_workspace.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <float.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define HUB_LABEL_MAGIC "GPHUBLB1"
+#define HUB_LABEL_FORMAT_VERSION 1
+#define HUB_LABEL_ALIGN 64              // Every array starts on a cache line
+#define HUB_LABEL_BLOCK 4               // Label segments are padded to a multiple of this
+#define HUB_LABEL_SENTINEL INT32_MAX    // Padding rank, larger than any real hub
+
+// File and memory image header (64 bytes)
+typedef struct {
+    char magic[8];
+    uint32_t format_version;
+    uint32_t is_directed;
+    int64_t num_vertices;
+    uint64_t forward_entries;   // Including padding
+    uint64_t backward_entries;  // 0 when undirected: backward labels are the forward ones
+    uint64_t image_size;
+    uint8_t reserved[16];
+} HubLabelHeader;
+
+// One direction of labels. The label of v is entries [offsets[v], offsets[v+1]):
+// hub ranks ascending, then at least one sentinel.
+typedef struct {
+    const int64_t* offsets;     // n + 1
+    const int32_t* hubs;
+    const double* dists;
+    const int32_t* parents;     // Neighbour of v on its shortest path to/from the hub (-1 at the hub)
+} HubLabelSet;
+
+struct HubLabels {
+    int num_vertices;
+    bool is_directed;
+    const int32_t* order;       // Rank -> vertex
+    HubLabelSet forward;        // Hubs v reaches, distance v -> hub
+    HubLabelSet backward;       // Hubs reaching v, distance hub -> v
+    void* image;                // Header plus arrays
+    size_t image_size;
+    bool mapped;                // image is an mmap of a saved file
+};
+
+// Growable label of one vertex during construction
+typedef struct {
+    int* hubs;
+    double* dists;
+    int* parents;
+    int size;
+    int capacity;
+} LabelVector;
+
+// Flat copy of one direction of the adjacency lists
+typedef struct {
+    int* offsets;                // n + 1
+    int* dests;
+    double* weights;
+} FlatAdjacency;
+
+static size_t align_up(size_t size) {
+    return (size + HUB_LABEL_ALIGN - 1) & ~(size_t)(HUB_LABEL_ALIGN - 1);
+}
+
+static int64_t padded_length(int size) {
+    return ((int64_t)size + HUB_LABEL_BLOCK) / HUB_LABEL_BLOCK * HUB_LABEL_BLOCK;
+}
+
+// Place one label set at pos within the image; returns the position after it.
+// base may be NULL to only measure.
+static size_t layout_set(char* base, size_t pos, int64_t n, uint64_t entries, HubLabelSet* set) {
+    if (base) set->offsets = (const int64_t*)(base + pos);
+    pos = align_up(pos + (n + 1) * sizeof(int64_t));
+    if (base) set->hubs = (const int32_t*)(base + pos);
+    pos = align_up(pos + entries * sizeof(int32_t));
+    if (base) set->dists = (const double*)(base + pos);
+    pos = align_up(pos + entries * sizeof(double));
+    if (base) set->parents = (const int32_t*)(base + pos);
+    return align_up(pos + entries * sizeof(int32_t));
+}
+
+// Point the labels' arrays into an image; returns the image size the header implies
+static size_t layout_image(char* base, const HubLabelHeader* header, HubLabels* labels) {
+    int64_t n = header->num_vertices;
+    size_t pos = align_up(sizeof(HubLabelHeader));
+    if (base) labels->order = (const int32_t*)(base + pos);
+    pos = align_up(pos + n * sizeof(int32_t));
+    pos = layout_set(base, pos, n, header->forward_entries, &labels->forward);
+    if (header->is_directed) {
+        pos = layout_set(base, pos, n, header->backward_entries, &labels->backward);
+    } else if (base) {
+        labels->backward = labels->forward;
+    }
+    return pos;
+}
+
+static bool label_push(LabelVector* label, int hub, double dist, int parent) {
+    if (label->size == label->capacity) {
+        int capacity = label->capacity ? label->capacity * 2 : 4;
+        int* hubs = (int*)realloc(label->hubs, capacity * sizeof(int));
+        if (hubs) label->hubs = hubs;
+        double* dists = (double*)realloc(label->dists, capacity * sizeof(double));
+        if (dists) label->dists = dists;
+        int* parents = (int*)realloc(label->parents, capacity * sizeof(int));
+        if (parents) label->parents = parents;
+        if (!hubs || !dists || !parents) return false;
+        label->capacity = capacity;
+    }
+    label->hubs[label->size] = hub;
+    label->dists[label->size] = dist;
+    label->parents[label->size] = parent;
+    label->size++;
+    return true;
+}
+
+static void labels_free(LabelVector* labels, int n) {
+    if (!labels) return;
+    for (int v = 0; v < n; v++) {
+        free(labels[v].hubs);
+        free(labels[v].dists);
+        free(labels[v].parents);
+    }
+    free(labels);
+}
+
+static void flat_adjacency_free(FlatAdjacency* adjacency) {
+    free(adjacency->offsets);
+    free(adjacency->dests);
+    free(adjacency->weights);
+}
+
+// Out-arcs of the graph, or its in-arcs when reverse is set
+static bool flat_adjacency_build(const Graph* graph, bool reverse, FlatAdjacency* adjacency) {
+    int n = graph->num_vertices;
+    adjacency->offsets = (int*)calloc(n + 1, sizeof(int));
+    if (!adjacency->offsets) return false;
+    for (int u = 0; u < n; u++) {
+        for (Edge* edge = graph->adj_list[u]; edge; edge = edge->next) {
+            adjacency->offsets[(reverse ? edge->dest : u) + 1]++;
+        }
+    }
+    for (int v = 0; v < n; v++) {
+        adjacency->offsets[v + 1] += adjacency->offsets[v];
+    }
+
+    int arcs = adjacency->offsets[n];
+    adjacency->dests = (int*)malloc((arcs > 0 ? arcs : 1) * sizeof(int));
+    adjacency->weights = (double*)malloc((arcs > 0 ? arcs : 1) * sizeof(double));
+    int* fill = (int*)malloc(n * sizeof(int));
+    if (!adjacency->dests || !adjacency->weights || !fill) {
+        free(fill);
+        flat_adjacency_free(adjacency);
+        return false;
+    }
+    memcpy(fill, adjacency->offsets, n * sizeof(int));
+    for (int u = 0; u < n; u++) {
+        for (Edge* edge = graph->adj_list[u]; edge; edge = edge->next) {
+            int from = reverse ? edge->dest : u;
+            int pos = fill[from]++;
+            adjacency->dests[pos] = reverse ? u : edge->dest;
+            adjacency->weights[pos] = edge->weight;
+        }
+    }
+    free(fill);
+    return true;
+}
+
+// State of the construction
+typedef struct {
+    int n;
+    const int* order;
+    SearchWorkspace* workspace;
+    double* hub_dist;            // Per rank: distance through that hub of the current root
+} HubBuilder;
+
+// Dijkstra from the vertex of the given rank over adjacency, adding the rank
+// to target[v] for every vertex v whose distance the labels built so far
+// (source_side of the root against target[v]) do not already cover. Vertices
+// that are covered are not expanded.
+static bool pruned_dijkstra(HubBuilder* builder, int rank, const FlatAdjacency* adjacency,
+                            const LabelVector* source_side, LabelVector* target) {
+    int root = builder->order[rank];
+    const LabelVector* own = &source_side[root];
+    for (int i = 0; i < own->size; i++) {
+        builder->hub_dist[own->hubs[i]] = own->dists[i];
+    }
+
+    SearchWorkspace* workspace = builder->workspace;
+    search_workspace_begin(workspace);
+    unsigned int generation = workspace->generation;
+    MinHeap* heap = workspace->heap;
+    workspace->seen[root] = generation;
+    workspace->dist[root] = 0.0;
+    workspace->parent[root] = -1;
+    bool ok = min_heap_push(heap, root, 0.0);
+
+    while (ok && !min_heap_is_empty(heap)) {
+        int u = min_heap_pop(heap).vertex;
+        if (workspace->closed[u] == generation) continue;
+        workspace->closed[u] = generation;
+        double dist_u = workspace->dist[u];
+
+        LabelVector* label = &target[u];
+        bool covered = false;
+        for (int i = 0; i < label->size && !covered; i++) {
+            covered = builder->hub_dist[label->hubs[i]] + label->dists[i] <= dist_u;
+        }
+        if (covered) continue;
+        if (!label_push(label, rank, dist_u, workspace->parent[u])) {
+            ok = false;
+            break;
+        }
+
+        for (int arc = adjacency->offsets[u]; arc < adjacency->offsets[u + 1]; arc++) {
+            int v = adjacency->dests[arc];
+            if (workspace->closed[v] == generation) continue;
+            double candidate = dist_u + adjacency->weights[arc];
+            if (workspace->seen[v] != generation || candidate < workspace->dist[v]) {
+                workspace->seen[v] = generation;
+                workspace->dist[v] = candidate;
+                workspace->parent[v] = u;
+                if (!min_heap_push(heap, v, candidate)) {
+                    ok = false;
+                    break;
+                }
+            }
+        }
+    }
+
+    min_heap_clear(heap);
+    for (int i = 0; i < own->size; i++) {
+        builder->hub_dist[own->hubs[i]] = DBL_MAX;
+    }
+    return ok;
+}
+
+// Copy growable labels into a packed, sentinel-terminated label set
+static void pack_set(const LabelVector* labels, int n, HubLabelSet* set) {
+    int64_t* offsets = (int64_t*)set->offsets;
+    int32_t* hubs = (int32_t*)set->hubs;
+    double* dists = (double*)set->dists;
+    int32_t* parents = (int32_t*)set->parents;
+
+    int64_t pos = 0;
+    for (int v = 0; v < n; v++) {
+        offsets[v] = pos;
+        const LabelVector* label = &labels[v];
+        int64_t end = pos + padded_length(label->size);
+        for (int i = 0; i < label->size; i++, pos++) {
+            hubs[pos] = label->hubs[i];
+            dists[pos] = label->dists[i];
+            parents[pos] = label->parents[i];
+        }
+        for (; pos < end; pos++) {
+            hubs[pos] = HUB_LABEL_SENTINEL;
+            dists[pos] = DBL_MAX;
+            parents[pos] = -1;
+        }
+    }
+    offsets[n] = pos;
+}
+
+static uint64_t padded_entries(const LabelVector* labels, int n) {
+    uint64_t entries = 0;
+    for (int v = 0; v < n; v++) {
+        entries += padded_length(labels[v].size);
+    }
+    return entries;
+}
+
+static const int* degree_order(const Graph* graph) {
+    int n = graph->num_vertices;
+    int* degree = (int*)calloc(n, sizeof(int));
+    int* order = (int*)malloc(n * sizeof(int));
+    int* bucket_start = NULL;
+    if (!degree || !order) goto fail;
+
+    int max_degree = 0;
+    for (int u = 0; u < n; u++) {
+        for (Edge* edge = graph->adj_list[u]; edge; edge = edge->next) {
+            degree[u]++;
+            if (graph->is_directed) degree[edge->dest]++;
+        }
+    }
+    for (int v = 0; v < n; v++) {
+        if (degree[v] > max_degree) max_degree = degree[v];
+    }
+
+    // Counting sort, highest degree first, ties by vertex id
+    bucket_start = (int*)calloc(max_degree + 2, sizeof(int));
+    if (!bucket_start) goto fail;
+    for (int v = 0; v < n; v++) {
+        bucket_start[max_degree - degree[v] + 1]++;
+    }
+    for (int d = 0; d <= max_degree; d++) {
+        bucket_start[d + 1] += bucket_start[d];
+    }
+    for (int v = 0; v < n; v++) {
+        order[bucket_start[max_degree - degree[v]]++] = v;
+    }
+    free(bucket_start);
+    free(degree);
+    return order;
+
+fail:
+    free(bucket_start);
+    free(degree);
+    free(order);
+    return NULL;
+}
+
+HubLabels* hub_labels_build(const Graph* graph, const int* order) {
+    if (!graph || graph->num_vertices <= 0) {
+        fprintf(stderr, "Error: Graph is NULL or empty\n");
+        return NULL;
+    }
+    int n = graph->num_vertices;
+    for (int u = 0; u < n; u++) {
+        for (Edge* edge = graph->adj_list[u]; edge; edge = edge->next) {
+            if (edge->weight < 0) {
+                fprintf(stderr, "Error: Hub labels require non-negative edge weights\n");
+                return NULL;
+            }
+        }
+    }
+
+    const int* owned_order = NULL;
+    if (order) {
+        bool* listed = (bool*)calloc(n, sizeof(bool));
+        bool valid = listed != NULL;
+        for (int i = 0; valid && i < n; i++) {
+            valid = graph_is_valid_vertex(graph, order[i]) && !listed[order[i]];
+            if (valid) listed[order[i]] = true;
+        }
+        free(listed);
+        if (!valid) {
+            fprintf(stderr, "Error: Hub order must list every vertex exactly once\n");
+            return NULL;
+        }
+    } else {
+        order = owned_order = degree_order(graph);
+        if (!order) {
+            fprintf(stderr, "Error: Memory allocation failed for hub order\n");
+            return NULL;
+        }
+    }
+
+    bool directed = graph->is_directed;
+    HubBuilder builder = {n, order, search_workspace_create(n), (double*)malloc(n * sizeof(double))};
+    LabelVector* forward = (LabelVector*)calloc(n, sizeof(LabelVector));
+    LabelVector* backward = directed ? (LabelVector*)calloc(n, sizeof(LabelVector)) : forward;
+    FlatAdjacency out = {NULL, NULL, NULL};
+    FlatAdjacency in = {NULL, NULL, NULL};
+    bool ok = builder.workspace && builder.hub_dist && forward && backward &&
+              flat_adjacency_build(graph, false, &out) &&
+              (!directed || flat_adjacency_build(graph, true, &in));
+
+    if (ok) {
+        for (int r = 0; r < n; r++) {
+            builder.hub_dist[r] = DBL_MAX;
+        }
+        for (int rank = 0; ok && rank < n; rank++) {
+            if (directed) {
+                // Forward search fills backward labels (distance root -> v),
+                // the reverse search forward labels (distance v -> root)
+                ok = pruned_dijkstra(&builder, rank, &out, forward, backward) &&
+                     pruned_dijkstra(&builder, rank, &in, backward, forward);
+            } else {
+                ok = pruned_dijkstra(&builder, rank, &out, forward, forward);
+            }
+        }
+    }
+
+    HubLabels* labels = NULL;
+    if (ok) {
+        HubLabelHeader header;
+        memset(&header, 0, sizeof(HubLabelHeader));
+        memcpy(header.magic, HUB_LABEL_MAGIC, sizeof(header.magic));
+        header.format_version = HUB_LABEL_FORMAT_VERSION;
+        header.is_directed = directed;
+        header.num_vertices = n;
+        header.forward_entries = padded_entries(forward, n);
+        header.backward_entries = directed ? padded_entries(backward, n) : 0;
+
+        labels = (HubLabels*)calloc(1, sizeof(HubLabels));
+        size_t size = layout_image(NULL, &header, labels);
+        void* image = NULL;
+        if (labels && posix_memalign(&image, HUB_LABEL_ALIGN, size) == 0) {
+            header.image_size = size;
+            memcpy(image, &header, sizeof(HubLabelHeader));
+            layout_image((char*)image, &header, labels);
+            labels->num_vertices = n;
+            labels->is_directed = directed;
+            labels->image = image;
+            labels->image_size = size;
+            memcpy((int32_t*)labels->order, order, n * sizeof(int32_t));
+            pack_set(forward, n, &labels->forward);
+            if (directed) pack_set(backward, n, &labels->backward);
+        } else {
+            free(labels);
+            labels = NULL;
+        }
+    }
+    if (!labels) {
+        fprintf(stderr, "Error: Memory allocation failed for hub labels\n");
+    }
+
+    labels_free(forward, n);
+    if (directed) labels_free(backward, n);
+    flat_adjacency_free(&out);
+    flat_adjacency_free(&in);
+    search_workspace_destroy(builder.workspace);
+    free(builder.hub_dist);
+    free((int*)owned_order);
+    return labels;
+}
+
+void hub_labels_destroy(HubLabels* labels) {
+    if (!labels) return;
+    if (labels->mapped) {
+        munmap(labels->image, labels->image_size);
+    } else {
+        free(labels->image);
+    }
+    free(labels);
+}
+
+// Merge the forward label of start with the backward label of end. Returns
+// the distance; *forward_pos / *backward_pos get the entries of the best hub.
+static double merge_labels(const HubLabels* labels, int start, int end,
+                           int64_t* forward_pos, int64_t* backward_pos) {
+    const HubLabelSet* forward = &labels->forward;
+    const HubLabelSet* backward = &labels->backward;
+    int64_t i = forward->offsets[start];
+    int64_t j = backward->offsets[end];
+    double best = DBL_MAX;
+    *forward_pos = -1;
+    *backward_pos = -1;
+
+    for (;;) {
+        int32_t a = forward->hubs[i];
+        int32_t b = backward->hubs[j];
+        if (a == b) {
+            if (a == HUB_LABEL_SENTINEL) break;
+            double candidate = forward->dists[i] + backward->dists[j];
+            if (candidate < best) {
+                best = candidate;
+                *forward_pos = i;
+                *backward_pos = j;
+            }
+            i++;
+            j++;
+        } else {
+            // Sentinels end both segments, so no bounds checks are needed
+            i += a < b;
+            j += b < a;
+        }
+    }
+    return best;
+}
+
+double hub_labels_distance(const HubLabels* labels, int start, int end) {
+    if (!labels || start < 0 || start >= labels->num_vertices ||
+        end < 0 || end >= labels->num_vertices) {
+        return DBL_MAX;
+    }
+    int64_t forward_pos;
+    int64_t backward_pos;
+    return merge_labels(labels, start, end, &forward_pos, &backward_pos);
+}
+
+// Entry of hub in v's label, or -1
+static int64_t find_hub(const HubLabelSet* set, int v, int32_t hub) {
+    int64_t low = set->offsets[v];
+    int64_t high = set->offsets[v + 1];
+    while (low < high) {
+        int64_t mid = low + (high - low) / 2;
+        if (set->hubs[mid] < hub) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return (low < set->offsets[v + 1] && set->hubs[low] == hub) ? low : -1;
+}
+
+// Follow parent pointers from v to the hub and return how many vertices the
+// walk visits (v and the hub included), or -1 if the labels are inconsistent.
+// Unless out is NULL, the i-th vertex is written to out[i * step], so step -1
+// fills a buffer backwards from out.
+static int walk_to_hub(const HubLabels* labels, const HubLabelSet* set, int v, int64_t pos,
+                       int* out, int step) {
+    int32_t hub = set->hubs[pos];
+    int count = 0;
+    while (count < labels->num_vertices) {
+        if (out) out[(ptrdiff_t)count * step] = v;
+        count++;
+        int parent = set->parents[pos];
+        if (parent < 0) return count;
+        if (parent >= labels->num_vertices) return -1;  // Corrupt file
+        v = parent;
+        pos = find_hub(set, v, hub);
+        if (pos < 0) return -1;
+    }
+    return -1;
+}
+
+PathResult* hub_labels_find_path(const HubLabels* labels, int start, int end) {
+    PathResult* result = path_result_create();
+    if (!result) return NULL;
+
+    result->algorithm = "Hub Labels";
+    result->suboptimality_bound = 1.0;
+
+    if (!labels || start < 0 || start >= labels->num_vertices ||
+        end < 0 || end >= labels->num_vertices) {
+        fprintf(stderr, "Error: Invalid start or end vertex\n");
+        return result;
+    }
+
+    long long start_ns = graph_clock_ns();
+    int64_t forward_pos;
+    int64_t backward_pos;
+    double distance = merge_labels(labels, start, end, &forward_pos, &backward_pos);
+    long long reconstruct_ns = graph_clock_ns();
+    result->stats.search_ns = reconstruct_ns - start_ns;
+    if (forward_pos < 0) {
+        result->time_ms = result->stats.search_ns / 1e6;
+        return result;
+    }
+
+    // start -> hub along forward parents, then end -> hub along backward
+    // parents written backwards; the hub appears in both halves. The walks
+    // are counted first so the only allocation is the path itself.
+    int first = walk_to_hub(labels, &labels->forward, start, forward_pos, NULL, 1);
+    int second = first > 0 ? walk_to_hub(labels, &labels->backward, end, backward_pos, NULL, 1) : -1;
+    if (first > 0 && second > 0) {
+        int length = first + second - 1;
+        result->path = (int*)malloc(length * sizeof(int));
+        if (result->path) {
+            walk_to_hub(labels, &labels->forward, start, forward_pos, result->path, 1);
+            walk_to_hub(labels, &labels->backward, end, backward_pos, result->path + length - 1, -1);
+            result->path_length = length;
+            result->total_weight = distance;
+            result->found = true;
+            result->stats.bytes_allocated = length * sizeof(int);
+        } else {
+            fprintf(stderr, "Error: Memory allocation failed for hub label path\n");
+            result->status = SEARCH_OUT_OF_MEMORY;
+        }
+    } else {
+        fprintf(stderr, "Error: Could not unpack hub label path\n");
+    }
+
+    long long end_ns = graph_clock_ns();
+    result->stats.reconstruct_ns = end_ns - reconstruct_ns;
+    result->time_ms = (end_ns - start_ns) / 1e6;
+    return result;
+}
+
+bool hub_labels_save(const HubLabels* labels, const char* path) {
+    if (!labels || !path) return false;
+
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        fprintf(stderr, "Error: Cannot open %s for writing\n", path);
+        return false;
+    }
+    bool ok = fwrite(labels->image, 1, labels->image_size, file) == labels->image_size;
+    ok = (fclose(file) == 0) && ok;
+    if (!ok) {
+        fprintf(stderr, "Error: Failed to write hub labels to %s\n", path);
+    }
+    return ok;
+}
+
+// Offsets must start at 0, never decrease and stay within the entries, and
+// every segment must end in a sentinel so that merges stop inside it
+static bool label_set_valid(const HubLabelSet* set, int64_t n, uint64_t entries) {
+    if (set->offsets[0] != 0 || set->offsets[n] < 0 || (uint64_t)set->offsets[n] > entries) {
+        return false;
+    }
+    for (int64_t v = 0; v < n; v++) {
+        int64_t begin = set->offsets[v];
+        int64_t end = set->offsets[v + 1];
+        if (end <= begin || set->hubs[end - 1] != HUB_LABEL_SENTINEL) {
+            return false;
+        }
+    }
+    return true;
+}
+
+HubLabels* hub_labels_load(const char* path) {
+    if (!path) return NULL;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "Error: Cannot open hub label file %s\n", path);
+        return NULL;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(HubLabelHeader)) {
+        close(fd);
+        fprintf(stderr, "Error: %s is not a hub label file\n", path);
+        return NULL;
+    }
+    size_t size = (size_t)st.st_size;
+    void* image = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (image == MAP_FAILED) {
+        fprintf(stderr, "Error: Cannot map hub label file %s\n", path);
+        return NULL;
+    }
+
+    const HubLabelHeader* header = (const HubLabelHeader*)image;
+    HubLabels* labels = (HubLabels*)calloc(1, sizeof(HubLabels));
+    bool valid = labels && memcmp(header->magic, HUB_LABEL_MAGIC, sizeof(header->magic)) == 0 &&
+                 header->format_version == HUB_LABEL_FORMAT_VERSION &&
+                 header->num_vertices >= 0 && header->num_vertices <= INT32_MAX &&
+                 header->forward_entries <= size && header->backward_entries <= size &&
+                 header->image_size == size &&
+                 layout_image(NULL, header, labels) == size;
+    if (valid) {
+        // The arrays come from disk: check the offsets before any query trusts them
+        layout_image((char*)image, header, labels);
+        valid = label_set_valid(&labels->forward, header->num_vertices, header->forward_entries) &&
+                (!header->is_directed ||
+                 label_set_valid(&labels->backward, header->num_vertices, header->backward_entries));
+    }
+    if (!valid) {
+        fprintf(stderr, "Error: %s is not a valid hub label file\n", path);
+        munmap(image, size);
+        free(labels);
+        return NULL;
+    }
+
+    labels->num_vertices = (int)header->num_vertices;
+    labels->is_directed = header->is_directed != 0;
+    labels->image = image;
+    labels->image_size = size;
+    labels->mapped = true;
+    return labels;
+}
+
+int hub_labels_num_vertices(const HubLabels* labels) {
+    return labels ? labels->num_vertices : 0;
+}
+
+static int64_t count_hubs(const HubLabelSet* set, int n) {
+    int64_t hubs = 0;
+    for (int v = 0; v < n; v++) {
+        for (int64_t i = set->offsets[v]; set->hubs[i] != HUB_LABEL_SENTINEL; i++) {
+            hubs++;
+        }
+    }
+    return hubs;
+}
+
+double hub_labels_average_size(const HubLabels* labels) {
+    if (!labels || labels->num_vertices == 0) return 0.0;
+    int n = labels->num_vertices;
+    if (!labels->is_directed) {
+        return (double)count_hubs(&labels->forward, n) / n;
+    }
+    return (double)(count_hubs(&labels->forward, n) + count_hubs(&labels->backward, n)) / (2.0 * n);
+}
+
+size_t hub_labels_memory_usage(const HubLabels* labels) {
+    return labels ? sizeof(HubLabels) + labels->image_size : 0;
+}
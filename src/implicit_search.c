@@ -0,0 +1,430 @@
+#include "implicit_search.h"
+#include "min_heap.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define INITIAL_NODES 1024
+#define INITIAL_TABLE 2048   // Power of two, kept at most half full
+#define EMPTY_SLOT -1
+
+// Arena record; the state bytes follow the header
+typedef struct {
+    uint64_t hash;
+    double g;
+    double h;
+    int parent;
+    int closed;
+} NodeHeader;
+
+typedef struct {
+    const ImplicitProblem* problem;
+    size_t node_size;          // Header plus state, rounded up to 8 bytes
+
+    unsigned char* nodes;      // Node arena, addressed by index
+    int num_nodes;
+    int node_capacity;
+
+    int* table;                // Open-addressing hash table of node indices
+    size_t table_capacity;
+
+    MinHeap* open;             // Best-first frontier (NULL for BFS)
+    int* queue;                // BFS frontier
+    int queue_head;
+    int queue_tail;
+    int queue_capacity;
+
+    double weight;             // Heuristic weight
+    bool reopen;               // Reopen closed nodes that get a shorter path
+    size_t memory_limit;
+    size_t peak_memory;
+    bool exhausted;
+
+    int expanding;             // Node whose successors are being emitted
+    SearchStats* stats;
+    long long generated;
+} ImplicitSearch;
+
+static inline NodeHeader* node_at(const ImplicitSearch* search, int index) {
+    return (NodeHeader*)(search->nodes + (size_t)index * search->node_size);
+}
+
+static inline void* node_state(NodeHeader* node) {
+    return (unsigned char*)node + sizeof(NodeHeader);
+}
+
+static uint64_t default_hash(const void* state, size_t size) {
+    // FNV-1a
+    const unsigned char* bytes = (const unsigned char*)state;
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static uint64_t state_hash(const ImplicitSearch* search, const void* state) {
+    const ImplicitProblem* problem = search->problem;
+    uint64_t hash = problem->hash ? problem->hash(state, problem->context)
+                                  : default_hash(state, problem->state_size);
+    // Spread user hashes that only vary in the high or low bits
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+static bool state_equals(const ImplicitSearch* search, const void* a, const void* b) {
+    const ImplicitProblem* problem = search->problem;
+    if (problem->equals) return problem->equals(a, b, problem->context);
+    return memcmp(a, b, problem->state_size) == 0;
+}
+
+static size_t search_memory(const ImplicitSearch* search) {
+    size_t bytes = (size_t)search->node_capacity * search->node_size +
+                   search->table_capacity * sizeof(int) +
+                   (size_t)search->queue_capacity * sizeof(int);
+    if (search->open) bytes += (size_t)search->open->capacity * sizeof(HeapNode);
+    return bytes;
+}
+
+// Record current memory use; false once it passes the limit
+static bool check_memory(ImplicitSearch* search) {
+    size_t bytes = search_memory(search);
+    if (bytes > search->peak_memory) search->peak_memory = bytes;
+    if (search->memory_limit > 0 && bytes > search->memory_limit) {
+        search->exhausted = true;
+        return false;
+    }
+    return true;
+}
+
+// Room for one more node; grows by doubling, clamped to the memory limit
+static bool reserve_node(ImplicitSearch* search) {
+    if (search->num_nodes < search->node_capacity) return true;
+
+    size_t capacity = (size_t)search->node_capacity * 2;
+    if (capacity > INT32_MAX) capacity = INT32_MAX;
+    if (search->memory_limit > 0) {
+        size_t other = search_memory(search) - (size_t)search->node_capacity * search->node_size;
+        size_t fit = search->memory_limit > other ? (search->memory_limit - other) / search->node_size : 0;
+        if (fit < capacity) capacity = fit;
+    }
+    if (capacity <= (size_t)search->node_capacity) {
+        search->exhausted = true;
+        return false;
+    }
+
+    unsigned char* nodes = (unsigned char*)realloc(search->nodes, capacity * search->node_size);
+    if (!nodes) {
+        fprintf(stderr, "Error: Memory allocation failed for search nodes\n");
+        search->exhausted = true;
+        return false;
+    }
+    search->nodes = nodes;
+    search->node_capacity = (int)capacity;
+    return check_memory(search);
+}
+
+static int* table_slot(const ImplicitSearch* search, const void* state, uint64_t hash) {
+    size_t mask = search->table_capacity - 1;
+    for (size_t i = hash & mask;; i = (i + 1) & mask) {
+        int index = search->table[i];
+        if (index == EMPTY_SLOT) return &search->table[i];
+        NodeHeader* node = node_at(search, index);
+        if (node->hash == hash && state_equals(search, node_state(node), state)) {
+            return &search->table[i];
+        }
+    }
+}
+
+static bool grow_table(ImplicitSearch* search) {
+    size_t capacity = search->table_capacity * 2;
+    if (search->memory_limit > 0 &&
+        search_memory(search) + search->table_capacity * sizeof(int) > search->memory_limit) {
+        search->exhausted = true;
+        return false;
+    }
+
+    int* table = (int*)malloc(capacity * sizeof(int));
+    if (!table) {
+        fprintf(stderr, "Error: Memory allocation failed for search hash table\n");
+        search->exhausted = true;
+        return false;
+    }
+    for (size_t i = 0; i < capacity; i++) {
+        table[i] = EMPTY_SLOT;
+    }
+
+    size_t mask = capacity - 1;
+    for (int index = 0; index < search->num_nodes; index++) {
+        size_t i = node_at(search, index)->hash & mask;
+        while (table[i] != EMPTY_SLOT) {
+            i = (i + 1) & mask;
+        }
+        table[i] = index;
+    }
+
+    free(search->table);
+    search->table = table;
+    search->table_capacity = capacity;
+    return check_memory(search);
+}
+
+static bool queue_push(ImplicitSearch* search, int index) {
+    if (search->queue_tail == search->queue_capacity) {
+        int capacity = search->queue_capacity * 2;
+        int* queue = (int*)realloc(search->queue, capacity * sizeof(int));
+        if (!queue) {
+            fprintf(stderr, "Error: Memory allocation failed for search queue\n");
+            search->exhausted = true;
+            return false;
+        }
+        search->queue = queue;
+        search->queue_capacity = capacity;
+        if (!check_memory(search)) return false;
+    }
+    search->queue[search->queue_tail++] = index;
+    return true;
+}
+
+static bool frontier_push(ImplicitSearch* search, int index) {
+    search->stats->heap_pushes++;
+    if (!search->open) return queue_push(search, index);
+
+    NodeHeader* node = node_at(search, index);
+    int old_capacity = search->open->capacity;
+    if (!min_heap_push(search->open, index, node->g + search->weight * node->h)) {
+        search->exhausted = true;
+        return false;
+    }
+    return search->open->capacity == old_capacity || check_memory(search);
+}
+
+// Add start or a successor of search->expanding
+static void add_state(ImplicitSearch* search, const void* state, double g) {
+    if (search->exhausted) return;
+
+    uint64_t hash = state_hash(search, state);
+    int* slot = table_slot(search, state, hash);
+
+    if (*slot != EMPTY_SLOT) {
+        // Known state: BFS keeps the first (shallowest) path
+        NodeHeader* node = node_at(search, *slot);
+        if (!search->open || g >= node->g) return;
+        if (node->closed && !search->reopen) return;
+        node->g = g;
+        node->parent = search->expanding;
+        node->closed = 0;
+        frontier_push(search, *slot);
+        return;
+    }
+
+    if (!reserve_node(search)) return;
+
+    const ImplicitProblem* problem = search->problem;
+    int index = search->num_nodes++;
+    NodeHeader* node = node_at(search, index);
+    memcpy(node_state(node), state, problem->state_size);
+    node->hash = hash;
+    node->g = g;
+    node->h = (search->open && problem->heuristic) ? problem->heuristic(state, problem->context) : 0.0;
+    node->parent = search->expanding;
+    node->closed = 0;
+    *slot = index;
+    search->generated++;
+
+    if ((size_t)search->num_nodes * 2 > search->table_capacity && !grow_table(search)) return;
+    frontier_push(search, index);
+}
+
+static void emit_successor(void* sink, const void* state, double cost) {
+    ImplicitSearch* search = (ImplicitSearch*)sink;
+    search->stats->edges_relaxed++;
+    if (search->exhausted) return;
+
+    double parent_g = node_at(search, search->expanding)->g;
+    add_state(search, state, search->open ? parent_g + cost : parent_g + 1.0);
+}
+
+// Next node to expand, or -1 when the frontier is empty
+static int frontier_pop(ImplicitSearch* search) {
+    if (!search->open) {
+        if (search->queue_head == search->queue_tail) return -1;
+        search->stats->heap_pops++;
+        return search->queue[search->queue_head++];
+    }
+
+    while (!min_heap_is_empty(search->open)) {
+        int index = min_heap_pop(search->open).vertex;
+        search->stats->heap_pops++;
+        if (!node_at(search, index)->closed) return index;
+    }
+    return -1;
+}
+
+static int frontier_size(const ImplicitSearch* search) {
+    return search->open ? search->open->size : search->queue_tail - search->queue_head;
+}
+
+static void reconstruct(const ImplicitSearch* search, int goal, ImplicitResult* result) {
+    size_t state_size = search->problem->state_size;
+    int length = 0;
+    for (int i = goal; i != -1; i = node_at(search, i)->parent) {
+        length++;
+    }
+
+    unsigned char* states = (unsigned char*)malloc((size_t)length * state_size);
+    if (!states) {
+        fprintf(stderr, "Error: Memory allocation failed for path states\n");
+        return;
+    }
+    int position = length - 1;
+    for (int i = goal; i != -1; i = node_at(search, i)->parent) {
+        memcpy(states + (size_t)position * state_size, node_state(node_at(search, i)), state_size);
+        position--;
+    }
+
+    result->states = states;
+    result->path_length = length;
+    result->total_weight = node_at(search, goal)->g;
+    result->found = true;
+}
+
+static ImplicitResult* implicit_search(const ImplicitProblem* problem, const void* start,
+                                       const ImplicitSearchOptions* options, bool best_first,
+                                       double weight, const char* name) {
+    ImplicitResult* result = (ImplicitResult*)calloc(1, sizeof(ImplicitResult));
+    if (!result) {
+        fprintf(stderr, "Error: Memory allocation failed for search result\n");
+        return NULL;
+    }
+    result->algorithm = name;
+
+    if (!problem || !start || problem->state_size == 0 || !problem->successors || !problem->is_goal) {
+        fprintf(stderr, "Error: Implicit problem needs a state size, successors and a goal test\n");
+        return result;
+    }
+    if (weight < 1.0) {
+        fprintf(stderr, "Error: Heuristic weight must be at least 1\n");
+        return result;
+    }
+
+    long long start_ns = graph_clock_ns();
+
+    ImplicitSearch search;
+    memset(&search, 0, sizeof(search));
+    search.problem = problem;
+    search.node_size = (sizeof(NodeHeader) + problem->state_size + 7) & ~(size_t)7;
+    search.weight = weight;
+    search.reopen = (weight == 1.0);
+    search.memory_limit = options ? options->memory_limit : 0;
+    search.expanding = -1;
+    search.stats = &result->stats;
+
+    search.node_capacity = INITIAL_NODES;
+    search.nodes = (unsigned char*)malloc((size_t)search.node_capacity * search.node_size);
+    search.table_capacity = INITIAL_TABLE;
+    search.table = (int*)malloc(search.table_capacity * sizeof(int));
+    if (best_first) {
+        search.open = min_heap_create(INITIAL_NODES);
+    } else {
+        search.queue_capacity = INITIAL_NODES;
+        search.queue = (int*)malloc(search.queue_capacity * sizeof(int));
+    }
+
+    void* expanded = malloc(problem->state_size);
+
+    if (!search.nodes || !search.table || (best_first ? !search.open : !search.queue) || !expanded) {
+        fprintf(stderr, "Error: Memory allocation failed for %s\n", name);
+        free(expanded);
+        free(search.nodes);
+        free(search.table);
+        free(search.queue);
+        min_heap_destroy(search.open);
+        return result;
+    }
+    for (size_t i = 0; i < search.table_capacity; i++) {
+        search.table[i] = EMPTY_SLOT;
+    }
+
+    check_memory(&search);
+    add_state(&search, start, 0.0);
+    result->stats.peak_queue_size = 1;
+
+    long long search_ns = graph_clock_ns();
+    result->stats.init_ns = search_ns - start_ns;
+
+    int goal = -1;
+    while (!search.exhausted) {
+        int index = frontier_pop(&search);
+        if (index == -1) break;
+
+        NodeHeader* node = node_at(&search, index);
+        node->closed = 1;
+        result->stats.vertices_settled++;
+        if (problem->is_goal(node_state(node), problem->context)) {
+            goal = index;
+            break;
+        }
+
+        // The arena may move while successors are added, so expand a copy
+        memcpy(expanded, node_state(node), problem->state_size);
+        search.expanding = index;
+        problem->successors(expanded, emit_successor, &search, problem->context);
+
+        int size = frontier_size(&search);
+        if (size > result->stats.peak_queue_size) result->stats.peak_queue_size = size;
+    }
+
+    long long reconstruct_ns = graph_clock_ns();
+    result->stats.search_ns = reconstruct_ns - search_ns;
+
+    if (goal != -1) {
+        reconstruct(&search, goal, result);
+    } else {
+        result->memory_exhausted = search.exhausted;
+    }
+
+    long long end_ns = graph_clock_ns();
+    result->stats.reconstruct_ns = end_ns - reconstruct_ns;
+    result->stats.bytes_allocated = search.peak_memory;
+    result->states_generated = search.generated;
+    result->time_ms = (end_ns - start_ns) / 1e6;
+
+    free(expanded);
+    free(search.nodes);
+    free(search.table);
+    free(search.queue);
+    min_heap_destroy(search.open);
+    return result;
+}
+
+void implicit_search_options_init(ImplicitSearchOptions* options) {
+    if (!options) return;
+    options->memory_limit = 0;
+    options->weight = 1.0;
+}
+
+ImplicitResult* implicit_bfs(const ImplicitProblem* problem, const void* start,
+                             const ImplicitSearchOptions* options) {
+    return implicit_search(problem, start, options, false, 1.0, "BFS (implicit)");
+}
+
+ImplicitResult* implicit_astar(const ImplicitProblem* problem, const void* start,
+                               const ImplicitSearchOptions* options) {
+    return implicit_search(problem, start, options, true, 1.0, "A* (implicit)");
+}
+
+ImplicitResult* implicit_weighted_astar(const ImplicitProblem* problem, const void* start,
+                                        const ImplicitSearchOptions* options) {
+    double weight = options ? options->weight : 1.0;
+    return implicit_search(problem, start, options, true, weight, "Weighted A* (implicit)");
+}
+
+void implicit_result_destroy(ImplicitResult* result) {
+    if (!result) return;
+    free(result->states);
+    free(result);
+}
@@ -0,0 +1,487 @@
+#include "jps.h"
+#include "min_heap.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+
+#define SQRT2 1.4142135623730951
+#define WEIGHT_TOLERANCE 1e-9
+
+// Neighbour directions: four straight moves, then four diagonals
+static const int DIR_X[8] = {1, -1, 0, 0, 1, -1, 1, -1};
+static const int DIR_Y[8] = {0, 0, 1, -1, 1, 1, -1, -1};
+
+GridMap* grid_map_create(int width, int height, bool diagonal, double cost) {
+    if (width <= 0 || height <= 0 || (long long)width * height > 0x7fffffff || cost <= 0.0) {
+        fprintf(stderr, "Error: Invalid grid dimensions or cost\n");
+        return NULL;
+    }
+
+    GridMap* grid = (GridMap*)malloc(sizeof(GridMap));
+    if (!grid) {
+        fprintf(stderr, "Error: Memory allocation failed for grid\n");
+        return NULL;
+    }
+    grid->blocked = (unsigned char*)calloc((size_t)width * height, 1);
+    if (!grid->blocked) {
+        fprintf(stderr, "Error: Memory allocation failed for grid\n");
+        free(grid);
+        return NULL;
+    }
+    grid->width = width;
+    grid->height = height;
+    grid->diagonal = diagonal;
+    grid->cost = cost;
+    return grid;
+}
+
+void grid_map_destroy(GridMap* grid) {
+    if (!grid) return;
+    free(grid->blocked);
+    free(grid);
+}
+
+bool grid_map_set_blocked(GridMap* grid, int x, int y, bool blocked) {
+    if (!grid || x < 0 || y < 0 || x >= grid->width || y >= grid->height) {
+        return false;
+    }
+    grid->blocked[(size_t)y * grid->width + x] = blocked ? 1 : 0;
+    return true;
+}
+
+bool grid_map_is_open(const GridMap* grid, int x, int y) {
+    return x >= 0 && y >= 0 && x < grid->width && y < grid->height &&
+           !grid->blocked[(size_t)y * grid->width + x];
+}
+
+// Moves the grid permits from an open cell, as a direction bitmask
+static unsigned grid_allowed_moves(const GridMap* grid, int x, int y) {
+    unsigned mask = 0;
+    for (int d = 0; d < 4; d++) {
+        if (grid_map_is_open(grid, x + DIR_X[d], y + DIR_Y[d])) mask |= 1u << d;
+    }
+    if (grid->diagonal) {
+        for (int d = 4; d < 8; d++) {
+            int dx = DIR_X[d];
+            int dy = DIR_Y[d];
+            if (grid_map_is_open(grid, x + dx, y + dy) && grid_map_is_open(grid, x + dx, y) &&
+                grid_map_is_open(grid, x, y + dy)) {
+                mask |= 1u << d;
+            }
+        }
+    }
+    return mask;
+}
+
+static bool weight_matches(double weight, double expected) {
+    return fabs(weight - expected) <= WEIGHT_TOLERANCE * expected;
+}
+
+// Check the graph against a grid of the given width; fills grid on success
+static GridMap* grid_try_width(const Graph* graph, int width, double cost) {
+    int n = graph->num_vertices;
+    if (width <= 0 || n % width != 0) return NULL;
+
+    unsigned char* moves = (unsigned char*)calloc(n, 1);
+    if (!moves) return NULL;
+
+    bool diagonal = false;
+    bool valid = true;
+    for (int u = 0; u < n && valid; u++) {
+        int ux = u % width;
+        int uy = u / width;
+        for (Edge* edge = graph->adj_list[u]; edge; edge = edge->next) {
+            int dx = edge->dest % width - ux;
+            int dy = edge->dest / width - uy;
+            int d = 0;
+            while (d < 8 && (DIR_X[d] != dx || DIR_Y[d] != dy)) d++;
+            bool straight = (d < 4);
+            if (d == 8 || (moves[u] & (1u << d)) ||
+                !weight_matches(edge->weight, straight ? cost : cost * SQRT2)) {
+                valid = false;
+                break;
+            }
+            moves[u] |= (unsigned char)(1u << d);
+            if (!straight) diagonal = true;
+        }
+    }
+
+    GridMap* grid = valid ? grid_map_create(width, n / width, diagonal, cost) : NULL;
+    if (grid) {
+        for (int v = 0; v < n; v++) {
+            grid->blocked[v] = (moves[v] == 0);
+        }
+        // Every move the grid permits must be an edge, and nothing else
+        for (int v = 0; v < n; v++) {
+            if (!grid->blocked[v] && grid_allowed_moves(grid, v % width, v / width) != moves[v]) {
+                grid_map_destroy(grid);
+                grid = NULL;
+                break;
+            }
+        }
+    }
+    free(moves);
+    return grid;
+}
+
+GridMap* grid_map_from_graph(const Graph* graph) {
+    if (!graph || graph->is_directed || graph->num_edges == 0) return NULL;
+
+    // Straight moves are the cheapest edges; vertex gaps other than 1 reveal
+    // the width (w for vertical moves, w - 1 and w + 1 for diagonals)
+    double cost = DBL_MAX;
+    int gaps[3];
+    int num_gaps = 0;
+    for (int u = 0; u < graph->num_vertices; u++) {
+        for (Edge* edge = graph->adj_list[u]; edge; edge = edge->next) {
+            if (edge->weight < cost) cost = edge->weight;
+            int gap = abs(edge->dest - u);
+            if (gap <= 1) continue;
+            int g = 0;
+            while (g < num_gaps && gaps[g] != gap) g++;
+            if (g == num_gaps) {
+                if (num_gaps == 3) return NULL;
+                gaps[num_gaps++] = gap;
+            }
+        }
+    }
+    if (cost <= 0.0) return NULL;
+
+    if (num_gaps == 0) {
+        return grid_try_width(graph, graph->num_vertices, cost);
+    }
+    for (int g = 0; g < num_gaps; g++) {
+        for (int delta = 0; delta <= 2; delta++) {
+            int width = gaps[g] + (delta == 2 ? -1 : delta);
+            GridMap* grid = (width >= 2) ? grid_try_width(graph, width, cost) : NULL;
+            if (grid) return grid;
+        }
+    }
+    return NULL;
+}
+
+Graph* grid_map_to_graph(const GridMap* grid) {
+    if (!grid) return NULL;
+    Graph* graph = graph_create(grid->width * grid->height, true, false);
+    if (!graph) return NULL;
+
+    for (int y = 0; y < grid->height; y++) {
+        for (int x = 0; x < grid->width; x++) {
+            int u = y * grid->width + x;
+            graph_set_coordinates(graph, u, x, y);
+            if (!grid_map_is_open(grid, x, y)) continue;
+
+            // Add each undirected edge once, from its lower-numbered end
+            unsigned moves = grid_allowed_moves(grid, x, y);
+            for (int d = 0; d < 8; d++) {
+                int v = (y + DIR_Y[d]) * grid->width + x + DIR_X[d];
+                if ((moves & (1u << d)) && v > u &&
+                    !graph_add_edge(graph, u, v, d < 4 ? grid->cost : grid->cost * SQRT2)) {
+                    graph_destroy(graph);
+                    return NULL;
+                }
+            }
+        }
+    }
+    return graph;
+}
+
+// Search state shared by the jump functions
+typedef struct {
+    const GridMap* grid;
+    int goal_x;
+    int goal_y;
+} JumpContext;
+
+static inline bool open_cell(const GridMap* grid, int x, int y) {
+    return grid_map_is_open(grid, x, y);
+}
+
+// 8-connected jump from the cell before (x, y) in direction (dx, dy).
+// Returns the next jump point's cell, or -1 when the ray dead-ends.
+static int jump_diagonal_grid(const JumpContext* ctx, int x, int y, int dx, int dy) {
+    const GridMap* grid = ctx->grid;
+    while (true) {
+        if (!open_cell(grid, x, y)) return -1;
+        if (x == ctx->goal_x && y == ctx->goal_y) return y * grid->width + x;
+
+        if (dx != 0 && dy != 0) {
+            // A straight ray from here reaching a jump point makes this one
+            if (jump_diagonal_grid(ctx, x + dx, y, dx, 0) >= 0 ||
+                jump_diagonal_grid(ctx, x, y + dy, 0, dy) >= 0) {
+                return y * grid->width + x;
+            }
+        } else if (dx != 0) {
+            // Forced neighbour: a side cell only reachable through this cell
+            if ((open_cell(grid, x, y - 1) && !open_cell(grid, x - dx, y - 1)) ||
+                (open_cell(grid, x, y + 1) && !open_cell(grid, x - dx, y + 1))) {
+                return y * grid->width + x;
+            }
+        } else {
+            if ((open_cell(grid, x - 1, y) && !open_cell(grid, x - 1, y - dy)) ||
+                (open_cell(grid, x + 1, y) && !open_cell(grid, x + 1, y - dy))) {
+                return y * grid->width + x;
+            }
+        }
+
+        // No corner cutting: a diagonal step needs both straight cells open
+        if (!open_cell(grid, x + dx, y) || !open_cell(grid, x, y + dy)) return -1;
+        x += dx;
+        y += dy;
+    }
+}
+
+// 4-connected jump; vertical rays stop where a horizontal ray finds a jump point
+static int jump_straight_grid(const JumpContext* ctx, int x, int y, int dx, int dy) {
+    const GridMap* grid = ctx->grid;
+    while (true) {
+        if (!open_cell(grid, x, y)) return -1;
+        if (x == ctx->goal_x && y == ctx->goal_y) return y * grid->width + x;
+
+        if (dx != 0) {
+            if ((open_cell(grid, x, y - 1) && !open_cell(grid, x - dx, y - 1)) ||
+                (open_cell(grid, x, y + 1) && !open_cell(grid, x - dx, y + 1))) {
+                return y * grid->width + x;
+            }
+        } else {
+            if ((open_cell(grid, x - 1, y) && !open_cell(grid, x - 1, y - dy)) ||
+                (open_cell(grid, x + 1, y) && !open_cell(grid, x + 1, y - dy))) {
+                return y * grid->width + x;
+            }
+            if (jump_straight_grid(ctx, x + 1, y, 1, 0) >= 0 ||
+                jump_straight_grid(ctx, x - 1, y, -1, 0) >= 0) {
+                return y * grid->width + x;
+            }
+        }
+        x += dx;
+        y += dy;
+    }
+}
+
+// Directions worth exploring from (x, y) when arriving along (dx, dy);
+// (0, 0) means the start cell, where every permitted move is explored
+static int pruned_directions(const GridMap* grid, int x, int y, int dx, int dy, int* dirs_x, int* dirs_y) {
+    int count = 0;
+#define ADD_DIRECTION(ddx, ddy) do { dirs_x[count] = (ddx); dirs_y[count] = (ddy); count++; } while (0)
+
+    if (dx == 0 && dy == 0) {
+        unsigned moves = grid_allowed_moves(grid, x, y);
+        for (int d = 0; d < 8; d++) {
+            if (moves & (1u << d)) ADD_DIRECTION(DIR_X[d], DIR_Y[d]);
+        }
+    } else if (!grid->diagonal) {
+        if (dx != 0) {
+            if (open_cell(grid, x, y - 1)) ADD_DIRECTION(0, -1);
+            if (open_cell(grid, x, y + 1)) ADD_DIRECTION(0, 1);
+            if (open_cell(grid, x + dx, y)) ADD_DIRECTION(dx, 0);
+        } else {
+            if (open_cell(grid, x - 1, y)) ADD_DIRECTION(-1, 0);
+            if (open_cell(grid, x + 1, y)) ADD_DIRECTION(1, 0);
+            if (open_cell(grid, x, y + dy)) ADD_DIRECTION(0, dy);
+        }
+    } else if (dx != 0 && dy != 0) {
+        bool side_y = open_cell(grid, x, y + dy);
+        bool side_x = open_cell(grid, x + dx, y);
+        if (side_y) ADD_DIRECTION(0, dy);
+        if (side_x) ADD_DIRECTION(dx, 0);
+        if (side_y && side_x) ADD_DIRECTION(dx, dy);
+    } else if (dx != 0) {
+        bool next = open_cell(grid, x + dx, y);
+        bool up = open_cell(grid, x, y + 1);
+        bool down = open_cell(grid, x, y - 1);
+        if (next) {
+            ADD_DIRECTION(dx, 0);
+            if (up) ADD_DIRECTION(dx, 1);
+            if (down) ADD_DIRECTION(dx, -1);
+        }
+        if (up) ADD_DIRECTION(0, 1);
+        if (down) ADD_DIRECTION(0, -1);
+    } else {
+        bool next = open_cell(grid, x, y + dy);
+        bool right = open_cell(grid, x + 1, y);
+        bool left = open_cell(grid, x - 1, y);
+        if (next) {
+            ADD_DIRECTION(0, dy);
+            if (right) ADD_DIRECTION(1, dy);
+            if (left) ADD_DIRECTION(-1, dy);
+        }
+        if (right) ADD_DIRECTION(1, 0);
+        if (left) ADD_DIRECTION(-1, 0);
+    }
+#undef ADD_DIRECTION
+    return count;
+}
+
+static int sign(int value) {
+    return (value > 0) - (value < 0);
+}
+
+// Exact cost between two cells on a free grid (octile or Manhattan)
+static double grid_distance(const GridMap* grid, int x1, int y1, int x2, int y2) {
+    int dx = abs(x2 - x1);
+    int dy = abs(y2 - y1);
+    if (!grid->diagonal) {
+        return grid->cost * (dx + dy);
+    }
+    int diag = dx < dy ? dx : dy;
+    int straight = (dx > dy ? dx : dy) - diag;
+    return grid->cost * (straight + SQRT2 * diag);
+}
+
+PathResult* jps_grid_find_path(const GridMap* grid, int start, int end) {
+    PathResult* result = path_result_create();
+    if (!result) return NULL;
+
+    result->algorithm = "Jump Point Search";
+    result->suboptimality_bound = 1.0;
+
+    int n = grid ? grid->width * grid->height : 0;
+    if (start < 0 || start >= n || end < 0 || end >= n) {
+        fprintf(stderr, "Error: Invalid start or end vertex\n");
+        return result;
+    }
+
+    SearchStats* stats = &result->stats;
+    long long start_ns = graph_clock_ns();
+
+    int width = grid->width;
+    double* g = (double*)malloc(n * sizeof(double));
+    int* parent = (int*)malloc(n * sizeof(int));
+    bool* closed = (bool*)calloc(n, sizeof(bool));
+    MinHeap* heap = min_heap_create(1024);
+    if (!g || !parent || !closed || !heap) {
+        fprintf(stderr, "Error: Memory allocation failed for jump point search\n");
+        result->status = SEARCH_OUT_OF_MEMORY;
+        free(g);
+        free(parent);
+        free(closed);
+        min_heap_destroy(heap);
+        return result;
+    }
+    for (int i = 0; i < n; i++) {
+        g[i] = DBL_MAX;
+        parent[i] = -1;
+    }
+
+    JumpContext ctx = {grid, end % width, end / width};
+    bool endpoints_open = !grid->blocked[start] && !grid->blocked[end];
+    if (endpoints_open) {
+        g[start] = 0.0;
+        if (!min_heap_push(heap, start, grid_distance(grid, start % width, start / width,
+                                                      ctx.goal_x, ctx.goal_y))) {
+            result->status = SEARCH_OUT_OF_MEMORY;
+        }
+        stats->heap_pushes = 1;
+        stats->peak_queue_size = 1;
+    }
+
+    long long search_ns = graph_clock_ns();
+    stats->init_ns = search_ns - start_ns;
+
+    int dirs_x[8];
+    int dirs_y[8];
+    while (!min_heap_is_empty(heap) && result->status == SEARCH_COMPLETED) {
+        int u = min_heap_pop(heap).vertex;
+        stats->heap_pops++;
+        if (closed[u]) continue;
+        closed[u] = true;
+        stats->vertices_settled++;
+        if (u == end) break;
+
+        int x = u % width;
+        int y = u / width;
+        int dx = 0;
+        int dy = 0;
+        if (parent[u] >= 0) {
+            dx = sign(x - parent[u] % width);
+            dy = sign(y - parent[u] / width);
+        }
+
+        int count = pruned_directions(grid, x, y, dx, dy, dirs_x, dirs_y);
+        for (int i = 0; i < count; i++) {
+            stats->edges_relaxed++;
+            int next = grid->diagonal
+                ? jump_diagonal_grid(&ctx, x + dirs_x[i], y + dirs_y[i], dirs_x[i], dirs_y[i])
+                : jump_straight_grid(&ctx, x + dirs_x[i], y + dirs_y[i], dirs_x[i], dirs_y[i]);
+            if (next < 0 || closed[next]) continue;
+
+            int nx = next % width;
+            int ny = next / width;
+            double candidate = g[u] + grid_distance(grid, x, y, nx, ny);
+            if (candidate < g[next]) {
+                g[next] = candidate;
+                parent[next] = u;
+                if (!min_heap_push(heap, next,
+                                   candidate + grid_distance(grid, nx, ny, ctx.goal_x, ctx.goal_y))) {
+                    result->status = SEARCH_OUT_OF_MEMORY;  // A dropped jump point could hide the shortest path
+                    break;
+                }
+                stats->heap_pushes++;
+                if (heap->size > stats->peak_queue_size) stats->peak_queue_size = heap->size;
+            }
+        }
+    }
+
+    long long reconstruct_ns = graph_clock_ns();
+    stats->search_ns = reconstruct_ns - search_ns;
+
+    // Expand the jump points into every cell along each straight/diagonal run
+    if (result->status == SEARCH_COMPLETED && endpoints_open && closed[end]) {
+        int count = 1;
+        for (int v = end; parent[v] >= 0; v = parent[v]) {
+            int p = parent[v];
+            int steps_x = abs(v % width - p % width);
+            int steps_y = abs(v / width - p / width);
+            count += steps_x > steps_y ? steps_x : steps_y;
+        }
+        result->path = (int*)malloc(count * sizeof(int));
+        if (result->path) {
+            int index = count;
+            result->path[--index] = end;
+            for (int v = end; parent[v] >= 0; v = parent[v]) {
+                int p = parent[v];
+                int step_x = sign(p % width - v % width);
+                int step_y = sign(p / width - v / width);
+                int cx = v % width;
+                int cy = v / width;
+                while (cy * width + cx != p) {
+                    cx += step_x;
+                    cy += step_y;
+                    result->path[--index] = cy * width + cx;
+                }
+            }
+            result->path_length = count;
+            result->found = true;
+            result->total_weight = g[end];
+        } else {
+            result->status = SEARCH_OUT_OF_MEMORY;
+        }
+    }
+
+    long long end_ns = graph_clock_ns();
+    stats->reconstruct_ns = end_ns - reconstruct_ns;
+    stats->bytes_allocated = n * (sizeof(double) + sizeof(int) + sizeof(bool)) +
+                             heap->capacity * sizeof(HeapNode);
+    result->time_ms = (end_ns - start_ns) / 1e6;
+
+    free(g);
+    free(parent);
+    free(closed);
+    min_heap_destroy(heap);
+    return result;
+}
+
+PathResult* jps_find_path(const Graph* graph, int start, int end) {
+    GridMap* grid = grid_map_from_graph(graph);
+    if (!grid) {
+        PathResult* result = path_result_create();
+        if (result) result->algorithm = "Jump Point Search";
+        fprintf(stderr, "Error: Graph is not a uniform-cost grid\n");
+        return result;
+    }
+    PathResult* result = jps_grid_find_path(grid, start, end);
+    grid_map_destroy(grid);
+    return result;
+}
@@ -1,16 +1,27 @@
+#define _POSIX_C_SOURCE 200809L
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
 #include <string.h>
+#include <signal.h>
 #include "graph.h"
 #include "bfs.h"
 #include "dfs.h"
 #include "dijkstra.h"
 #include "astar.h"
 #include "bellman_ford.h"
+#include "graph_parser.h"
+#include "graph_formats.h"
+#include "jps.h"
+#include "query_server.h"
+#include "graph_snapshot.h"
+#include "parallel.h"
 
 #define MAX_RESULTS 10
 
+// Graphs up to this size are printed after loading from a file
+#define PRINT_GRAPH_LIMIT 50
+
 // Input graph from user
 Graph* input_graph(void) {
     int num_vertices, num_edges;
@@ -92,6 +103,25 @@ Graph* input_graph(void) {
     return graph;
 }
 
+// Load graph (and optional coordinates/query) from a file in the examples format,
+// or from a DIMACS (.gr + .co), Matrix Market (.mtx) or METIS (.graph) file
+Graph* load_graph_file(const char* path, GraphFileInfo* info) {
+    GraphParseError error;
+    Graph* graph = graph_load_file(path, NULL, info, &error);
+    if (!graph) {
+        if (error.line > 0) {
+            fprintf(stderr, "Error: %s:%d: %s\n", path, error.line, error.message);
+        } else {
+            fprintf(stderr, "Error: %s: %s\n", path, error.message);
+        }
+        return NULL;
+    }
+
+    printf("\nLoaded %s: %d vertices, %d edges%s\n", path, graph->num_vertices,
+           graph->num_edges, info->has_coordinates ? ", with coordinates" : "");
+    return graph;
+}
+
 // Input coordinates for vertices (optional, for A*)
 bool input_coordinates(Graph* graph) {
     char input[10];
@@ -143,6 +173,13 @@ int select_algorithms(const Graph* graph, PathResult* (*algorithms[])(const Grap
         algorithms[count++] = dfs_find_path;
     }
 
+    // Uniform-cost grids also get Jump Point Search
+    GridMap* grid = grid_map_from_graph(graph);
+    if (grid) {
+        algorithms[count++] = jps_find_path;
+        grid_map_destroy(grid);
+    }
+
     return count;
 }
 
@@ -172,6 +209,7 @@ void print_statistics(const Graph* graph, int start, int end, PathResult** resul
     PathResult* fastest = NULL;
     PathResult* shortest = NULL;
     PathResult* optimal = NULL;  // Shortest path length (number of edges)
+    PathResult* least_work = NULL;  // Fewest vertices settled
 
     for (int i = 0; i < num_results; i++) {
         if (results[i]->found) {
@@ -185,6 +223,10 @@ void print_statistics(const Graph* graph, int start, int end, PathResult** resul
             if (!optimal || results[i]->path_length < optimal->path_length) {
                 optimal = results[i];
             }
+            if (!least_work ||
+                results[i]->stats.vertices_settled < least_work->stats.vertices_settled) {
+                least_work = results[i];
+            }
         }
     }
 
@@ -199,48 +241,143 @@ void print_statistics(const Graph* graph, int start, int end, PathResult** resul
         printf("Most optimal path: %s (%d edges)\n",
                optimal->algorithm, optimal->path_length - 1);
     }
+    if (least_work) {
+        printf("Least work: %s (%lld vertices settled, %lld edges relaxed)\n",
+               least_work->algorithm, least_work->stats.vertices_settled,
+               least_work->stats.edges_relaxed);
+    }
 
     printf("\n");
     printf("══════════════════════════════════════════════════════════════\n\n");
 }
 
-int main(void) {
-    printf("╔════════════════════════════════════════════════════════════╗\n");
-    printf("║              GraphPath - Graph Pathfinding Tool            ║\n");
-    printf("║                    Version 1.0                             ║\n");
-    printf("╚════════════════════════════════════════════════════════════╝\n");
+// Server stopped by SIGINT/SIGTERM and reloaded by SIGHUP in --serve mode
+static QueryServer* active_server = NULL;
 
-    // Input graph
-    Graph* graph = input_graph();
-    if (!graph) {
-        fprintf(stderr, "Failed to create graph\n");
-        return 1;
+static void handle_server_signal(int signum) {
+    if (signum == SIGHUP) {
+        query_server_reload(active_server);
+    } else {
+        query_server_stop(active_server);
     }
+}
 
-    // Display graph
-    graph_print(graph);
+// graphpath --serve SOCKET FILE [THREADS [TIMEOUT_MS]]: answer queries until
+// interrupted; SIGHUP reloads FILE without interrupting queries
+int run_server(int argc, char* argv[]) {
+    if (argc < 4) {
+        fprintf(stderr, "Usage: %s --serve <socket> <graph-file> [threads [timeout-ms]]\n", argv[0]);
+        return 1;
+    }
 
-    // Optionally input coordinates for A* algorithm
-    if (graph->is_weighted) {
-        input_coordinates(graph);
+    GraphFileInfo info = {0};
+    Graph* graph = load_graph_file(argv[3], &info);
+    if (!graph) {
+        return 1;
     }
 
-    // Input start and end vertices
-    int start, end;
-    printf("Enter start vertex: ");
-    if (scanf("%d", &start) != 1 || !graph_is_valid_vertex(graph, start)) {
-        fprintf(stderr, "Error: Invalid start vertex\n");
+    QueryServerConfig config;
+    query_server_config_init(&config, argv[2]);
+    config.num_threads = (argc > 4) ? atoi(argv[4]) : 0;
+    config.allow_remote_shutdown = true;
+    config.graph_path = argv[3];
+    config.query_timeout_ms = (argc > 5) ? atof(argv[5]) : 0.0;
+
+    // The snapshot manager owns the graph from here on
+    GraphSnapshotManager* graphs =
+        graph_snapshot_manager_create(graph, parallel_resolve_threads(config.num_threads));
+    if (!graphs) {
         graph_destroy(graph);
         return 1;
     }
 
-    printf("Enter end vertex: ");
-    if (scanf("%d", &end) != 1 || !graph_is_valid_vertex(graph, end)) {
-        fprintf(stderr, "Error: Invalid end vertex\n");
-        graph_destroy(graph);
+    QueryServer* server = query_server_create(graphs, &config);
+    if (!server) {
+        graph_snapshot_manager_destroy(graphs);
         return 1;
     }
 
+    active_server = server;
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = handle_server_signal;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+    sigaction(SIGHUP, &action, NULL);
+
+    printf("Serving queries on %s (Ctrl+C to stop, SIGHUP to reload)\n", argv[2]);
+    fflush(stdout);
+    bool ok = query_server_run(server);
+
+    QueryServerStats stats;
+    query_server_get_stats(server, &stats);
+    printf("\nServer stopped: %lld connections, %lld requests, %lld errors, %lld reloads, "
+           "%lld timeouts\n",
+           stats.connections, stats.requests, stats.errors, stats.reloads, stats.timeouts);
+
+    active_server = NULL;
+    query_server_destroy(server);
+    graph_snapshot_manager_destroy(graphs);
+    return ok ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
+    printf("╔════════════════════════════════════════════════════════════╗\n");
+    printf("║              GraphPath - Graph Pathfinding Tool            ║\n");
+    printf("║                    Version 1.0                             ║\n");
+    printf("╚════════════════════════════════════════════════════════════╝\n");
+
+    if (argc > 1 && strcmp(argv[1], "--serve") == 0) {
+        return run_server(argc, argv);
+    }
+
+    // Input graph: from a file argument, or interactively
+    GraphFileInfo info = {0};
+    Graph* graph = NULL;
+    if (argc > 1) {
+        graph = load_graph_file(argv[1], &info);
+        if (!graph) {
+            return 1;
+        }
+        if (graph->num_vertices <= PRINT_GRAPH_LIMIT) {
+            graph_print(graph);
+        }
+    } else {
+        graph = input_graph();
+        if (!graph) {
+            fprintf(stderr, "Failed to create graph\n");
+            return 1;
+        }
+
+        // Display graph
+        graph_print(graph);
+
+        // Optionally input coordinates for A* algorithm
+        if (graph->is_weighted) {
+            input_coordinates(graph);
+        }
+    }
+
+    // Input start and end vertices (unless the file supplied them)
+    int start = info.start;
+    int end = info.end;
+    if (!info.has_query) {
+        printf("Enter start vertex: ");
+        if (scanf("%d", &start) != 1 || !graph_is_valid_vertex(graph, start)) {
+            fprintf(stderr, "Error: Invalid start vertex\n");
+            graph_destroy(graph);
+            return 1;
+        }
+
+        printf("Enter end vertex: ");
+        if (scanf("%d", &end) != 1 || !graph_is_valid_vertex(graph, end)) {
+            fprintf(stderr, "Error: Invalid end vertex\n");
+            graph_destroy(graph);
+            return 1;
+        }
+    }
+
     // Select algorithms
     PathResult* (*algorithms[MAX_RESULTS])(const Graph*, int, int);
     int num_algorithms = select_algorithms(graph, algorithms);
@@ -0,0 +1,86 @@
+#include "min_heap.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// Create a heap with the given initial capacity (grows on demand)
+MinHeap* min_heap_create(int capacity) {
+    if (capacity < 16) capacity = 16;
+
+    MinHeap* heap = (MinHeap*)malloc(sizeof(MinHeap));
+    if (!heap) return NULL;
+
+    heap->nodes = (HeapNode*)malloc(capacity * sizeof(HeapNode));
+    if (!heap->nodes) {
+        free(heap);
+        return NULL;
+    }
+
+    heap->size = 0;
+    heap->capacity = capacity;
+    return heap;
+}
+
+void min_heap_destroy(MinHeap* heap) {
+    if (!heap) return;
+    free(heap->nodes);
+    free(heap);
+}
+
+bool min_heap_is_empty(const MinHeap* heap) {
+    return heap->size == 0;
+}
+
+void min_heap_clear(MinHeap* heap) {
+    heap->size = 0;
+}
+
+bool min_heap_push(MinHeap* heap, int vertex, double key) {
+    // Check if heap needs to grow
+    if (heap->size >= heap->capacity) {
+        int new_capacity = heap->capacity * 2;
+        HeapNode* new_nodes = (HeapNode*)realloc(heap->nodes, new_capacity * sizeof(HeapNode));
+        if (!new_nodes) {
+            fprintf(stderr, "Warning: Failed to grow heap\n");
+            return false;
+        }
+        heap->nodes = new_nodes;
+        heap->capacity = new_capacity;
+    }
+
+    // Sift up with a hole instead of repeated swaps
+    int index = heap->size++;
+    while (index > 0) {
+        int parent = (index - 1) / 2;
+        if (heap->nodes[parent].key <= key) {
+            break;
+        }
+        heap->nodes[index] = heap->nodes[parent];
+        index = parent;
+    }
+    heap->nodes[index].vertex = vertex;
+    heap->nodes[index].key = key;
+    return true;
+}
+
+HeapNode min_heap_pop(MinHeap* heap) {
+    HeapNode min = heap->nodes[0];
+    HeapNode last = heap->nodes[--heap->size];
+
+    // Sift the last element down from the root
+    int index = 0;
+    int size = heap->size;
+    while (true) {
+        int child = 2 * index + 1;
+        if (child >= size) break;
+        if (child + 1 < size && heap->nodes[child + 1].key < heap->nodes[child].key) {
+            child++;
+        }
+        if (last.key <= heap->nodes[child].key) break;
+        heap->nodes[index] = heap->nodes[child];
+        index = child;
+    }
+    if (size > 0) {
+        heap->nodes[index] = last;
+    }
+    return min;
+}
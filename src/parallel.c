@@ -0,0 +1,224 @@
+#define _POSIX_C_SOURCE 200809L
+#include "parallel.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <unistd.h>
+
+// Arguments for one block of a parallel_for
+typedef struct {
+    ParallelBody body;
+    void* context;
+    size_t begin;
+    size_t end;
+    int thread_id;
+} ParallelTask;
+
+static void* parallel_task_run(void* arg) {
+    ParallelTask* task = (ParallelTask*)arg;
+    task->body(task->begin, task->end, task->thread_id, task->context);
+    return NULL;
+}
+
+int parallel_default_threads(void) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    return cpus > 0 ? (int)cpus : 1;
+}
+
+int parallel_resolve_threads(int requested) {
+    return requested > 0 ? requested : parallel_default_threads();
+}
+
+int parallel_for(int num_threads, size_t count, ParallelBody body, void* context) {
+    num_threads = parallel_resolve_threads(num_threads);
+    if (count == 0) return 0;
+    if ((size_t)num_threads > count) num_threads = (int)count;
+
+    ParallelTask* tasks = (ParallelTask*)malloc(num_threads * sizeof(ParallelTask));
+    pthread_t* threads = (pthread_t*)malloc(num_threads * sizeof(pthread_t));
+    if (!tasks || !threads || num_threads == 1) {
+        // Run inline when single-threaded (or when bookkeeping could not be allocated)
+        free(tasks);
+        free(threads);
+        body(0, count, 0, context);
+        return 1;
+    }
+
+    size_t chunk = count / num_threads;
+    size_t extra = count % num_threads;
+    size_t begin = 0;
+    for (int t = 0; t < num_threads; t++) {
+        size_t size = chunk + ((size_t)t < extra ? 1 : 0);
+        tasks[t].body = body;
+        tasks[t].context = context;
+        tasks[t].begin = begin;
+        tasks[t].end = begin + size;
+        tasks[t].thread_id = t;
+        begin += size;
+    }
+
+    // Spawn blocks 1..n-1; block 0 runs on the caller. Blocks that fail to
+    // spawn run inline so the loop always completes.
+    char* spawned = (char*)calloc(num_threads, 1);
+    for (int t = 1; t < num_threads; t++) {
+        if (spawned && pthread_create(&threads[t], NULL, parallel_task_run, &tasks[t]) == 0) {
+            spawned[t] = 1;
+        } else {
+            parallel_task_run(&tasks[t]);
+        }
+    }
+    parallel_task_run(&tasks[0]);
+    for (int t = 1; t < num_threads; t++) {
+        if (spawned && spawned[t]) {
+            pthread_join(threads[t], NULL);
+        }
+    }
+
+    free(spawned);
+    free(tasks);
+    free(threads);
+    return num_threads;
+}
+
+struct ParallelPool {
+    int num_threads;             // Started workers plus the caller
+    pthread_t* workers;
+    pthread_mutex_t lock;
+    pthread_cond_t work_ready;
+    pthread_cond_t work_done;
+    unsigned long round;         // Incremented per loop; workers wait for a new one
+    int pending;                 // Workers still inside the current round
+    bool stopping;
+
+    // Current loop
+    ParallelBody body;
+    void* context;
+    size_t count;
+    int blocks;
+};
+
+// Arguments of one pool worker
+typedef struct {
+    ParallelPool* pool;
+    int thread_id;
+} PoolWorker;
+
+// Block t of [0, count) split into blocks contiguous pieces, as parallel_for does
+static void parallel_block(size_t count, int blocks, int t, size_t* begin, size_t* end) {
+    size_t chunk = count / blocks;
+    size_t extra = count % blocks;
+    *begin = (size_t)t * chunk + ((size_t)t < extra ? (size_t)t : extra);
+    *end = *begin + chunk + ((size_t)t < extra ? 1 : 0);
+}
+
+static void* pool_worker_main(void* arg) {
+    PoolWorker* worker = (PoolWorker*)arg;
+    ParallelPool* pool = worker->pool;
+    int thread_id = worker->thread_id;
+    free(worker);
+
+    unsigned long seen = 0;
+    pthread_mutex_lock(&pool->lock);
+    while (true) {
+        while (pool->round == seen && !pool->stopping) {
+            pthread_cond_wait(&pool->work_ready, &pool->lock);
+        }
+        if (pool->stopping) break;
+        seen = pool->round;
+        ParallelBody body = pool->body;
+        void* context = pool->context;
+        size_t count = pool->count;
+        int blocks = pool->blocks;
+        pthread_mutex_unlock(&pool->lock);
+
+        if (thread_id < blocks) {
+            size_t begin;
+            size_t end;
+            parallel_block(count, blocks, thread_id, &begin, &end);
+            body(begin, end, thread_id, context);
+        }
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->pending == 0) pthread_cond_signal(&pool->work_done);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+ParallelPool* parallel_pool_create(int num_threads) {
+    num_threads = parallel_resolve_threads(num_threads);
+    ParallelPool* pool = (ParallelPool*)calloc(1, sizeof(ParallelPool));
+    if (!pool) return NULL;
+    pool->workers = (pthread_t*)malloc(num_threads * sizeof(pthread_t));
+    if (!pool->workers) {
+        free(pool);
+        return NULL;
+    }
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->work_ready, NULL);
+    pthread_cond_init(&pool->work_done, NULL);
+
+    // Workers that fail to start shrink the pool; the caller always takes part
+    pool->num_threads = 1;
+    for (int t = 1; t < num_threads; t++) {
+        PoolWorker* worker = (PoolWorker*)malloc(sizeof(PoolWorker));
+        if (!worker) break;
+        worker->pool = pool;
+        worker->thread_id = pool->num_threads;
+        if (pthread_create(&pool->workers[pool->num_threads], NULL, pool_worker_main, worker) != 0) {
+            free(worker);
+            break;
+        }
+        pool->num_threads++;
+    }
+    return pool;
+}
+
+void parallel_pool_destroy(ParallelPool* pool) {
+    if (!pool) return;
+    pthread_mutex_lock(&pool->lock);
+    pool->stopping = true;
+    pthread_cond_broadcast(&pool->work_ready);
+    pthread_mutex_unlock(&pool->lock);
+    for (int t = 1; t < pool->num_threads; t++) {
+        pthread_join(pool->workers[t], NULL);
+    }
+    pthread_cond_destroy(&pool->work_done);
+    pthread_cond_destroy(&pool->work_ready);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->workers);
+    free(pool);
+}
+
+int parallel_pool_for(ParallelPool* pool, size_t count, ParallelBody body, void* context) {
+    if (count == 0) return 0;
+    int blocks = pool->num_threads;
+    if ((size_t)blocks > count) blocks = (int)count;
+    if (blocks == 1) {
+        body(0, count, 0, context);
+        return 1;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    pool->body = body;
+    pool->context = context;
+    pool->count = count;
+    pool->blocks = blocks;
+    pool->pending = pool->num_threads - 1;
+    pool->round++;
+    pthread_cond_broadcast(&pool->work_ready);
+    pthread_mutex_unlock(&pool->lock);
+
+    size_t begin;
+    size_t end;
+    parallel_block(count, blocks, 0, &begin, &end);
+    body(begin, end, 0, context);
+
+    pthread_mutex_lock(&pool->lock);
+    while (pool->pending > 0) {
+        pthread_cond_wait(&pool->work_done, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return blocks;
+}
@@ -0,0 +1,727 @@
+#include "parallel_components.h"
+#include "parallel.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+
+// Fewest vertices worth a worker thread of their own
+#define COMPONENTS_GRAIN 4096
+
+// Afforest: neighbours linked per vertex before the dominant component is
+// sampled, and how many vertices the sample looks at
+#define AFFOREST_NEIGHBOR_ROUNDS 2
+#define AFFOREST_SAMPLES 1024
+
+// Trimming rounds between pivot steps; long chains are left to forward-backward
+#define SCC_TRIM_ROUNDS 4
+
+// Frontier entries a BFS worker gathers before claiming space in the shared queue
+#define FRONTIER_BUFFER 256
+
+// Flat adjacency (destinations only)
+typedef struct {
+    int* offsets;                // n + 1
+    int* dests;
+} Csr;
+
+static int component_threads(int requested, int num_vertices) {
+    int threads = parallel_resolve_threads(requested);
+    int useful = num_vertices / COMPONENTS_GRAIN + 1;
+    return threads < useful ? threads : useful;
+}
+
+static void csr_free(Csr* csr) {
+    free(csr->offsets);
+    free(csr->dests);
+    csr->offsets = NULL;
+    csr->dests = NULL;
+}
+
+// ---------------------------------------------------------------------------
+// Adjacency flattening
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    const Graph* graph;
+    const Csr* forward;
+    Csr* target;
+    atomic_int* cursor;          // Reverse build: next free slot per vertex
+} CsrBuildContext;
+
+static void count_out_degrees(size_t begin, size_t end, int thread_id, void* arg) {
+    (void)thread_id;
+    CsrBuildContext* ctx = (CsrBuildContext*)arg;
+    for (size_t v = begin; v < end; v++) {
+        int degree = 0;
+        for (Edge* edge = ctx->graph->adj_list[v]; edge; edge = edge->next) {
+            degree++;
+        }
+        ctx->target->offsets[v + 1] = degree;
+    }
+}
+
+static void fill_out_arcs(size_t begin, size_t end, int thread_id, void* arg) {
+    (void)thread_id;
+    CsrBuildContext* ctx = (CsrBuildContext*)arg;
+    for (size_t v = begin; v < end; v++) {
+        int pos = ctx->target->offsets[v];
+        for (Edge* edge = ctx->graph->adj_list[v]; edge; edge = edge->next) {
+            ctx->target->dests[pos++] = edge->dest;
+        }
+    }
+}
+
+static void count_in_degrees(size_t begin, size_t end, int thread_id, void* arg) {
+    (void)thread_id;
+    CsrBuildContext* ctx = (CsrBuildContext*)arg;
+    const Csr* forward = ctx->forward;
+    for (size_t u = begin; u < end; u++) {
+        for (int arc = forward->offsets[u]; arc < forward->offsets[u + 1]; arc++) {
+            atomic_fetch_add_explicit(&ctx->cursor[forward->dests[arc]], 1, memory_order_relaxed);
+        }
+    }
+}
+
+static void fill_in_arcs(size_t begin, size_t end, int thread_id, void* arg) {
+    (void)thread_id;
+    CsrBuildContext* ctx = (CsrBuildContext*)arg;
+    const Csr* forward = ctx->forward;
+    for (size_t u = begin; u < end; u++) {
+        for (int arc = forward->offsets[u]; arc < forward->offsets[u + 1]; arc++) {
+            int pos = atomic_fetch_add_explicit(&ctx->cursor[forward->dests[arc]], 1,
+                                                memory_order_relaxed);
+            ctx->target->dests[pos] = (int)u;
+        }
+    }
+}
+
+static bool csr_build(const Graph* graph, int threads, Csr* csr) {
+    int n = graph->num_vertices;
+    csr->offsets = (int*)malloc((n + 1) * sizeof(int));
+    csr->dests = NULL;
+    if (!csr->offsets) return false;
+
+    CsrBuildContext ctx = {graph, NULL, csr, NULL};
+    csr->offsets[0] = 0;
+    parallel_for(threads, n, count_out_degrees, &ctx);
+    for (int v = 0; v < n; v++) {
+        csr->offsets[v + 1] += csr->offsets[v];
+    }
+    csr->dests = (int*)malloc((csr->offsets[n] > 0 ? csr->offsets[n] : 1) * sizeof(int));
+    if (!csr->dests) {
+        csr_free(csr);
+        return false;
+    }
+    parallel_for(threads, n, fill_out_arcs, &ctx);
+    return true;
+}
+
+static bool csr_build_reverse(const Csr* forward, int n, int threads, Csr* reverse) {
+    reverse->offsets = (int*)malloc((n + 1) * sizeof(int));
+    reverse->dests = (int*)malloc((forward->offsets[n] > 0 ? forward->offsets[n] : 1) * sizeof(int));
+    atomic_int* cursor = (atomic_int*)malloc((n > 0 ? n : 1) * sizeof(atomic_int));
+    if (!reverse->offsets || !reverse->dests || !cursor) {
+        csr_free(reverse);
+        free(cursor);
+        return false;
+    }
+
+    for (int v = 0; v < n; v++) {
+        atomic_init(&cursor[v], 0);
+    }
+    CsrBuildContext ctx = {NULL, forward, reverse, cursor};
+    parallel_for(threads, n, count_in_degrees, &ctx);
+    reverse->offsets[0] = 0;
+    for (int v = 0; v < n; v++) {
+        reverse->offsets[v + 1] = reverse->offsets[v] + atomic_load_explicit(&cursor[v], memory_order_relaxed);
+        atomic_store_explicit(&cursor[v], reverse->offsets[v], memory_order_relaxed);
+    }
+    parallel_for(threads, n, fill_in_arcs, &ctx);
+    free(cursor);
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Relabelling: representative vertices -> dense labels and sizes
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    int* labels;                 // In: representative per vertex; out: dense label
+    int* index;                  // Dense label of each representative
+    int* block_counts;           // Representatives per worker block
+    atomic_int* sizes;
+} RelabelContext;
+
+static void count_representatives(size_t begin, size_t end, int thread_id, void* arg) {
+    RelabelContext* ctx = (RelabelContext*)arg;
+    int count = 0;
+    for (size_t v = begin; v < end; v++) {
+        if (ctx->labels[v] == (int)v) {
+            ctx->index[v] = count++;
+        }
+    }
+    ctx->block_counts[thread_id] = count;
+}
+
+static void offset_representatives(size_t begin, size_t end, int thread_id, void* arg) {
+    RelabelContext* ctx = (RelabelContext*)arg;
+    int offset = ctx->block_counts[thread_id];
+    for (size_t v = begin; v < end; v++) {
+        if (ctx->labels[v] == (int)v) {
+            ctx->index[v] += offset;
+        }
+    }
+}
+
+static void assign_labels(size_t begin, size_t end, int thread_id, void* arg) {
+    (void)thread_id;
+    RelabelContext* ctx = (RelabelContext*)arg;
+    for (size_t v = begin; v < end; v++) {
+        int label = ctx->index[ctx->labels[v]];
+        ctx->labels[v] = label;
+        atomic_fetch_add_explicit(&ctx->sizes[label], 1, memory_order_relaxed);
+    }
+}
+
+// Turn result->labels (each vertex's representative, which is its own
+// representative) into dense labels and fill in the sizes
+static bool relabel(ComponentResult* result, int threads) {
+    int n = result->num_vertices;
+    RelabelContext ctx;
+    ctx.labels = result->labels;
+    ctx.index = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    ctx.block_counts = (int*)calloc(threads, sizeof(int));
+    ctx.sizes = NULL;
+    if (!ctx.index || !ctx.block_counts) {
+        free(ctx.index);
+        free(ctx.block_counts);
+        return false;
+    }
+
+    int used = parallel_for(threads, n, count_representatives, &ctx);
+    int total = 0;
+    for (int t = 0; t < used; t++) {
+        int count = ctx.block_counts[t];
+        ctx.block_counts[t] = total;
+        total += count;
+    }
+    parallel_for(threads, n, offset_representatives, &ctx);
+
+    ctx.sizes = (atomic_int*)malloc((total > 0 ? total : 1) * sizeof(atomic_int));
+    result->sizes = (int*)malloc((total > 0 ? total : 1) * sizeof(int));
+    if (!ctx.sizes || !result->sizes) {
+        free(ctx.index);
+        free(ctx.block_counts);
+        free(ctx.sizes);
+        return false;
+    }
+    for (int c = 0; c < total; c++) {
+        atomic_init(&ctx.sizes[c], 0);
+    }
+    parallel_for(threads, n, assign_labels, &ctx);
+
+    result->num_components = total;
+    result->largest = -1;
+    for (int c = 0; c < total; c++) {
+        result->sizes[c] = atomic_load_explicit(&ctx.sizes[c], memory_order_relaxed);
+        if (result->largest < 0 || result->sizes[c] > result->sizes[result->largest]) {
+            result->largest = c;
+        }
+    }
+
+    free(ctx.index);
+    free(ctx.block_counts);
+    free(ctx.sizes);
+    return true;
+}
+
+static ComponentResult* component_result_create(int num_vertices, const char* algorithm) {
+    ComponentResult* result = (ComponentResult*)calloc(1, sizeof(ComponentResult));
+    if (!result) return NULL;
+    result->labels = (int*)malloc((num_vertices > 0 ? num_vertices : 1) * sizeof(int));
+    if (!result->labels) {
+        free(result);
+        return NULL;
+    }
+    result->num_vertices = num_vertices;
+    result->largest = -1;
+    result->algorithm = algorithm;
+    return result;
+}
+
+void component_result_destroy(ComponentResult* result) {
+    if (!result) return;
+    free(result->labels);
+    free(result->sizes);
+    free(result);
+}
+
+// ---------------------------------------------------------------------------
+// Connected components (Afforest)
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    const Csr* csr;
+    atomic_int* comp;            // Parent pointers; comp[v] <= v always
+    int* labels;
+    int neighbor;                // Sampling round: which neighbour to link
+    int skip;                    // Final phase: component left alone (-1: none)
+} AfforestContext;
+
+// Hook the trees of u and v together, always pointing the higher root at the
+// lower one so no cycle can form
+static void afforest_link(atomic_int* comp, int u, int v) {
+    int p1 = atomic_load_explicit(&comp[u], memory_order_relaxed);
+    int p2 = atomic_load_explicit(&comp[v], memory_order_relaxed);
+    while (p1 != p2) {
+        int high = p1 > p2 ? p1 : p2;
+        int low = p1 + p2 - high;
+        int p_high = atomic_load_explicit(&comp[high], memory_order_relaxed);
+        if (p_high == low) break;
+        if (p_high == high) {
+            int expected = high;
+            if (atomic_compare_exchange_strong(&comp[high], &expected, low)) break;
+        }
+        p1 = atomic_load_explicit(&comp[atomic_load_explicit(&comp[high], memory_order_relaxed)],
+                                  memory_order_relaxed);
+        p2 = atomic_load_explicit(&comp[low], memory_order_relaxed);
+    }
+}
+
+static void afforest_compress(size_t begin, size_t end, int thread_id, void* arg) {
+    (void)thread_id;
+    AfforestContext* ctx = (AfforestContext*)arg;
+    for (size_t v = begin; v < end; v++) {
+        for (;;) {
+            int parent = atomic_load_explicit(&ctx->comp[v], memory_order_relaxed);
+            int grandparent = atomic_load_explicit(&ctx->comp[parent], memory_order_relaxed);
+            if (parent == grandparent) break;
+            atomic_store_explicit(&ctx->comp[v], grandparent, memory_order_relaxed);
+        }
+    }
+}
+
+static void afforest_sample_round(size_t begin, size_t end, int thread_id, void* arg) {
+    (void)thread_id;
+    AfforestContext* ctx = (AfforestContext*)arg;
+    for (size_t v = begin; v < end; v++) {
+        int arc = ctx->csr->offsets[v] + ctx->neighbor;
+        if (arc < ctx->csr->offsets[v + 1]) {
+            afforest_link(ctx->comp, (int)v, ctx->csr->dests[arc]);
+        }
+    }
+}
+
+static void afforest_finish(size_t begin, size_t end, int thread_id, void* arg) {
+    (void)thread_id;
+    AfforestContext* ctx = (AfforestContext*)arg;
+    for (size_t v = begin; v < end; v++) {
+        if (atomic_load_explicit(&ctx->comp[v], memory_order_relaxed) == ctx->skip) continue;
+        int arc_end = ctx->csr->offsets[v + 1];
+        for (int arc = ctx->csr->offsets[v] + AFFOREST_NEIGHBOR_ROUNDS; arc < arc_end; arc++) {
+            afforest_link(ctx->comp, (int)v, ctx->csr->dests[arc]);
+        }
+    }
+}
+
+static void afforest_export(size_t begin, size_t end, int thread_id, void* arg) {
+    (void)thread_id;
+    AfforestContext* ctx = (AfforestContext*)arg;
+    for (size_t v = begin; v < end; v++) {
+        ctx->labels[v] = atomic_load_explicit(&ctx->comp[v], memory_order_relaxed);
+    }
+}
+
+static int compare_ints(const void* a, const void* b) {
+    int x = *(const int*)a;
+    int y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+// Most frequent root among a fixed pseudo-random sample of vertices
+static int afforest_dominant(atomic_int* comp, int n) {
+    int samples = n < AFFOREST_SAMPLES ? n : AFFOREST_SAMPLES;
+    int roots[AFFOREST_SAMPLES];
+    unsigned int seed = 0x9e3779b9u;
+    for (int i = 0; i < samples; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        roots[i] = atomic_load_explicit(&comp[seed % (unsigned int)n], memory_order_relaxed);
+    }
+    qsort(roots, samples, sizeof(int), compare_ints);
+
+    int best = roots[0];
+    int best_run = 0;
+    for (int i = 0; i < samples;) {
+        int j = i;
+        while (j < samples && roots[j] == roots[i]) j++;
+        if (j - i > best_run) {
+            best_run = j - i;
+            best = roots[i];
+        }
+        i = j;
+    }
+    return best;
+}
+
+ComponentResult* parallel_connected_components(const Graph* graph, int num_threads) {
+    if (!graph) {
+        fprintf(stderr, "Error: Graph is NULL\n");
+        return NULL;
+    }
+
+    long long start_ns = graph_clock_ns();
+    int n = graph->num_vertices;
+    int threads = component_threads(num_threads, n);
+    ComponentResult* result = component_result_create(n, "Afforest");
+    if (!result) {
+        fprintf(stderr, "Error: Memory allocation failed for component labels\n");
+        return NULL;
+    }
+
+    Csr csr;
+    atomic_int* comp = (atomic_int*)malloc((n > 0 ? n : 1) * sizeof(atomic_int));
+    if (!comp || !csr_build(graph, threads, &csr)) {
+        fprintf(stderr, "Error: Memory allocation failed for connected components\n");
+        free(comp);
+        component_result_destroy(result);
+        return NULL;
+    }
+    for (int v = 0; v < n; v++) {
+        atomic_init(&comp[v], v);
+    }
+
+    AfforestContext ctx = {&csr, comp, result->labels, 0, -1};
+
+    // Link a few neighbours per vertex: this already merges most of any
+    // large component
+    for (int round = 0; round < AFFOREST_NEIGHBOR_ROUNDS; round++) {
+        ctx.neighbor = round;
+        parallel_for(threads, n, afforest_sample_round, &ctx);
+        parallel_for(threads, n, afforest_compress, &ctx);
+    }
+
+    // With symmetric adjacency, every remaining edge into the dominant
+    // component is also seen from its other endpoint, so that component's
+    // own edges can be skipped. Directed arcs are only seen once.
+    if (n > 0 && !graph->is_directed) {
+        ctx.skip = afforest_dominant(comp, n);
+    }
+    parallel_for(threads, n, afforest_finish, &ctx);
+    parallel_for(threads, n, afforest_compress, &ctx);
+    parallel_for(threads, n, afforest_export, &ctx);
+
+    free(comp);
+    csr_free(&csr);
+
+    if (!relabel(result, threads)) {
+        fprintf(stderr, "Error: Memory allocation failed for component sizes\n");
+        component_result_destroy(result);
+        return NULL;
+    }
+    result->threads_used = threads;
+    result->time_ms = (graph_clock_ns() - start_ns) / 1e6;
+    return result;
+}
+
+// ---------------------------------------------------------------------------
+// Strongly connected components (trimming + forward-backward)
+// ---------------------------------------------------------------------------
+
+#define MARK_FORWARD 1
+#define MARK_BACKWARD 2
+
+typedef struct {
+    const Csr* out;
+    const Csr* in;
+    int* scc;                    // Representative vertex, -1 while undecided
+    int* color;                  // Subproblem of each undecided vertex
+    unsigned char* trimmed;
+    atomic_uchar* marks;         // MARK_* bits of the current round
+    atomic_int* pivots;          // Per subproblem
+    atomic_uchar* used_colors;
+    const int* color_map;
+    atomic_int decided;          // Vertices given a component this step
+
+    // Current BFS level
+    const Csr* bfs_csr;
+    unsigned char bfs_mark;
+    const int* frontier;
+    int* next;
+    atomic_int next_size;
+} SccContext;
+
+static unsigned int pivot_priority(int v) {
+    return (unsigned int)v * 2654435761u;  // Odd multiplier: distinct per vertex
+}
+
+static bool has_open_neighbor(const SccContext* ctx, const Csr* csr, int v) {
+    int color = ctx->color[v];
+    for (int arc = csr->offsets[v]; arc < csr->offsets[v + 1]; arc++) {
+        int w = csr->dests[arc];
+        if (w != v && ctx->scc[w] < 0 && ctx->color[w] == color) return true;
+    }
+    return false;
+}
+
+// A vertex with no in- or out-arc inside its subproblem is a component by itself
+static void trim_mark(size_t begin, size_t end, int thread_id, void* arg) {
+    (void)thread_id;
+    SccContext* ctx = (SccContext*)arg;
+    for (size_t v = begin; v < end; v++) {
+        ctx->trimmed[v] = ctx->scc[v] < 0 &&
+            (!has_open_neighbor(ctx, ctx->out, (int)v) || !has_open_neighbor(ctx, ctx->in, (int)v));
+    }
+}
+
+static void trim_apply(size_t begin, size_t end, int thread_id, void* arg) {
+    (void)thread_id;
+    SccContext* ctx = (SccContext*)arg;
+    int count = 0;
+    for (size_t v = begin; v < end; v++) {
+        if (ctx->trimmed[v]) {
+            ctx->scc[v] = (int)v;
+            count++;
+        }
+    }
+    atomic_fetch_add_explicit(&ctx->decided, count, memory_order_relaxed);
+}
+
+static void choose_pivots(size_t begin, size_t end, int thread_id, void* arg) {
+    (void)thread_id;
+    SccContext* ctx = (SccContext*)arg;
+    for (size_t v = begin; v < end; v++) {
+        if (ctx->scc[v] >= 0) continue;
+        atomic_int* pivot = &ctx->pivots[ctx->color[v]];
+        unsigned int priority = pivot_priority((int)v);
+        int current = atomic_load_explicit(pivot, memory_order_relaxed);
+        while (current < 0 || pivot_priority(current) < priority) {
+            if (atomic_compare_exchange_weak(pivot, &current, (int)v)) break;
+        }
+    }
+}
+
+static void bfs_expand(size_t begin, size_t end, int thread_id, void* arg) {
+    (void)thread_id;
+    SccContext* ctx = (SccContext*)arg;
+    const Csr* csr = ctx->bfs_csr;
+    int buffer[FRONTIER_BUFFER];
+    int buffered = 0;
+
+    for (size_t i = begin; i < end; i++) {
+        int u = ctx->frontier[i];
+        int color = ctx->color[u];
+        for (int arc = csr->offsets[u]; arc < csr->offsets[u + 1]; arc++) {
+            int w = csr->dests[arc];
+            if (ctx->scc[w] >= 0 || ctx->color[w] != color) continue;
+            if (atomic_fetch_or_explicit(&ctx->marks[w], ctx->bfs_mark, memory_order_relaxed) &
+                ctx->bfs_mark) {
+                continue;
+            }
+            if (buffered == FRONTIER_BUFFER) {
+                int pos = atomic_fetch_add_explicit(&ctx->next_size, buffered, memory_order_relaxed);
+                memcpy(ctx->next + pos, buffer, buffered * sizeof(int));
+                buffered = 0;
+            }
+            buffer[buffered++] = w;
+        }
+    }
+    if (buffered > 0) {
+        int pos = atomic_fetch_add_explicit(&ctx->next_size, buffered, memory_order_relaxed);
+        memcpy(ctx->next + pos, buffer, buffered * sizeof(int));
+    }
+}
+
+// FW-BW runs many short loops (trimming rounds, one per BFS level), so it keeps
+// its threads in a pool; without one (single thread, or the pool could not
+// start) the loops run inline
+static void scc_for(ParallelPool* pool, size_t count, ParallelBody body, void* arg) {
+    if (pool) {
+        parallel_pool_for(pool, count, body, arg);
+    } else {
+        body(0, count, 0, arg);
+    }
+}
+
+// Level-synchronous BFS from every pivot at once, staying inside each
+// pivot's subproblem
+static void scc_reach(SccContext* ctx, ParallelPool* pool, const Csr* csr, unsigned char mark,
+                      const int* pivots, int num_pivots, int* frontier, int* next) {
+    for (int i = 0; i < num_pivots; i++) {
+        frontier[i] = pivots[i];
+        atomic_fetch_or_explicit(&ctx->marks[pivots[i]], mark, memory_order_relaxed);
+    }
+    int size = num_pivots;
+    ctx->bfs_csr = csr;
+    ctx->bfs_mark = mark;
+    while (size > 0) {
+        ctx->frontier = frontier;
+        ctx->next = next;
+        atomic_store_explicit(&ctx->next_size, 0, memory_order_relaxed);
+        // Small frontiers are not worth waking the workers for
+        if (size < COMPONENTS_GRAIN) {
+            bfs_expand(0, size, 0, ctx);
+        } else {
+            scc_for(pool, size, bfs_expand, ctx);
+        }
+        size = atomic_load_explicit(&ctx->next_size, memory_order_relaxed);
+        int* swap = frontier;
+        frontier = next;
+        next = swap;
+    }
+}
+
+// Forward and backward set: one component. The rest splits into three new
+// subproblems per old one (forward only, backward only, neither).
+static void split_subproblems(size_t begin, size_t end, int thread_id, void* arg) {
+    (void)thread_id;
+    SccContext* ctx = (SccContext*)arg;
+    int count = 0;
+    for (size_t v = begin; v < end; v++) {
+        if (ctx->scc[v] >= 0) continue;
+        int marks = atomic_load_explicit(&ctx->marks[v], memory_order_relaxed);
+        atomic_store_explicit(&ctx->marks[v], 0, memory_order_relaxed);
+        if (marks == (MARK_FORWARD | MARK_BACKWARD)) {
+            ctx->scc[v] = atomic_load_explicit(&ctx->pivots[ctx->color[v]], memory_order_relaxed);
+            count++;
+        } else {
+            ctx->color[v] = ctx->color[v] * 3 + marks;
+            atomic_store_explicit(&ctx->used_colors[ctx->color[v]], 1, memory_order_relaxed);
+        }
+    }
+    atomic_fetch_add_explicit(&ctx->decided, count, memory_order_relaxed);
+}
+
+static void compact_colors(size_t begin, size_t end, int thread_id, void* arg) {
+    (void)thread_id;
+    SccContext* ctx = (SccContext*)arg;
+    for (size_t v = begin; v < end; v++) {
+        if (ctx->scc[v] < 0) {
+            ctx->color[v] = ctx->color_map[ctx->color[v]];
+        }
+    }
+}
+
+static int scc_decide(SccContext* ctx, ParallelPool* pool, int n, ParallelBody body) {
+    atomic_store_explicit(&ctx->decided, 0, memory_order_relaxed);
+    scc_for(pool, n, body, ctx);
+    return atomic_load_explicit(&ctx->decided, memory_order_relaxed);
+}
+
+ComponentResult* parallel_strong_components(const Graph* graph, int num_threads) {
+    if (!graph) {
+        fprintf(stderr, "Error: Graph is NULL\n");
+        return NULL;
+    }
+
+    long long start_ns = graph_clock_ns();
+    int n = graph->num_vertices;
+    int threads = component_threads(num_threads, n);
+    ComponentResult* result = component_result_create(n, "FW-BW");
+    if (!result) {
+        fprintf(stderr, "Error: Memory allocation failed for component labels\n");
+        return NULL;
+    }
+
+    size_t slots = n > 0 ? n : 1;
+    Csr out = {NULL, NULL};
+    Csr in = {NULL, NULL};
+    SccContext ctx;
+    memset(&ctx, 0, sizeof(SccContext));
+    ctx.scc = result->labels;
+    ctx.color = (int*)calloc(slots, sizeof(int));
+    ctx.trimmed = (unsigned char*)malloc(slots);
+    ctx.marks = (atomic_uchar*)malloc(slots * sizeof(atomic_uchar));
+    int* frontier = (int*)malloc(slots * sizeof(int));
+    int* next = (int*)malloc(slots * sizeof(int));
+    int* pivot_list = (int*)malloc(slots * sizeof(int));
+    bool ok = ctx.color && ctx.trimmed && ctx.marks && frontier && next && pivot_list &&
+              csr_build(graph, threads, &out);
+    if (ok && graph->is_directed) {
+        ok = csr_build_reverse(&out, n, threads, &in);
+    }
+    ctx.out = &out;
+    ctx.in = graph->is_directed ? &in : &out;
+
+    ParallelPool* pool = (ok && threads > 1) ? parallel_pool_create(threads) : NULL;
+    int remaining = n;
+    int num_colors = 1;
+    if (ok) {
+        for (int v = 0; v < n; v++) {
+            ctx.scc[v] = -1;
+            atomic_init(&ctx.marks[v], 0);
+        }
+    }
+
+    while (ok && remaining > 0) {
+        for (int round = 0; round < SCC_TRIM_ROUNDS && remaining > 0; round++) {
+            scc_for(pool, n, trim_mark, &ctx);
+            int trimmed = scc_decide(&ctx, pool, n, trim_apply);
+            remaining -= trimmed;
+            if (trimmed == 0) break;
+        }
+        if (remaining == 0) break;
+
+        // One pivot per subproblem that still has undecided vertices
+        ctx.pivots = (atomic_int*)malloc(num_colors * sizeof(atomic_int));
+        ctx.used_colors = (atomic_uchar*)malloc(3 * (size_t)num_colors * sizeof(atomic_uchar));
+        int* color_map = (int*)malloc(3 * (size_t)num_colors * sizeof(int));
+        if (!ctx.pivots || !ctx.used_colors || !color_map) {
+            free(color_map);
+            ok = false;
+            break;
+        }
+        for (int c = 0; c < num_colors; c++) {
+            atomic_init(&ctx.pivots[c], -1);
+        }
+        for (int c = 0; c < 3 * num_colors; c++) {
+            atomic_init(&ctx.used_colors[c], 0);
+        }
+        scc_for(pool, n, choose_pivots, &ctx);
+        int num_pivots = 0;
+        for (int c = 0; c < num_colors; c++) {
+            int pivot = atomic_load_explicit(&ctx.pivots[c], memory_order_relaxed);
+            if (pivot >= 0) pivot_list[num_pivots++] = pivot;
+        }
+
+        scc_reach(&ctx, pool, ctx.out, MARK_FORWARD, pivot_list, num_pivots, frontier, next);
+        scc_reach(&ctx, pool, ctx.in, MARK_BACKWARD, pivot_list, num_pivots, frontier, next);
+        remaining -= scc_decide(&ctx, pool, n, split_subproblems);
+
+        int next_colors = 0;
+        for (int c = 0; c < 3 * num_colors; c++) {
+            color_map[c] = next_colors;
+            if (atomic_load_explicit(&ctx.used_colors[c], memory_order_relaxed)) next_colors++;
+        }
+        ctx.color_map = color_map;
+        scc_for(pool, n, compact_colors, &ctx);
+        num_colors = next_colors > 0 ? next_colors : 1;
+
+        free(color_map);
+        free(ctx.pivots);
+        free(ctx.used_colors);
+        ctx.pivots = NULL;
+        ctx.used_colors = NULL;
+    }
+
+    parallel_pool_destroy(pool);
+    free(ctx.pivots);
+    free(ctx.used_colors);
+    free(ctx.color);
+    free(ctx.trimmed);
+    free(ctx.marks);
+    free(frontier);
+    free(next);
+    free(pivot_list);
+    csr_free(&out);
+    csr_free(&in);
+
+    if (!ok || !relabel(result, threads)) {
+        fprintf(stderr, "Error: Memory allocation failed for strongly connected components\n");
+        component_result_destroy(result);
+        return NULL;
+    }
+    result->threads_used = threads;
+    result->time_ms = (graph_clock_ns() - start_ns) / 1e6;
+    return result;
+}
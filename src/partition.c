@@ -0,0 +1,196 @@
+#include "partition.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    int* offsets;                // n + 1, symmetric adjacency without self-loops
+    int* adj;
+    int* mark;                   // Piece currently being split
+    int* visit;                  // BFS stamp
+    int* queue;
+    int* scratch;
+    int next_mark;
+    int next_stamp;
+    const int* max_sizes;
+    int num_levels;
+    Partition* partition;
+} Bisection;
+
+static bool symmetric_adjacency(const Graph* graph, Bisection* b) {
+    int n = graph->num_vertices;
+    b->offsets = (int*)calloc(n + 1, sizeof(int));
+    if (!b->offsets) return false;
+    for (int u = 0; u < n; u++) {
+        for (Edge* edge = graph->adj_list[u]; edge; edge = edge->next) {
+            if (edge->dest == u) continue;
+            b->offsets[u + 1]++;
+            b->offsets[edge->dest + 1]++;
+        }
+    }
+    for (int v = 0; v < n; v++) {
+        b->offsets[v + 1] += b->offsets[v];
+    }
+
+    int total = b->offsets[n];
+    b->adj = (int*)malloc((total > 0 ? total : 1) * sizeof(int));
+    int* fill = (int*)malloc(n * sizeof(int));
+    if (!b->adj || !fill) {
+        free(fill);
+        return false;
+    }
+    memcpy(fill, b->offsets, n * sizeof(int));
+    for (int u = 0; u < n; u++) {
+        for (Edge* edge = graph->adj_list[u]; edge; edge = edge->next) {
+            if (edge->dest == u) continue;
+            b->adj[fill[u]++] = edge->dest;
+            b->adj[fill[edge->dest]++] = u;
+        }
+    }
+    free(fill);
+    return true;
+}
+
+// BFS inside piece m, stamping reached vertices and appending them to out;
+// returns the number appended
+static int piece_bfs(Bisection* b, int source, int m, int stamp, int* out) {
+    int head = 0;
+    int tail = 0;
+    out[tail++] = source;
+    b->visit[source] = stamp;
+    while (head < tail) {
+        int u = out[head++];
+        for (int i = b->offsets[u]; i < b->offsets[u + 1]; i++) {
+            int w = b->adj[i];
+            if (b->mark[w] == m && b->visit[w] != stamp) {
+                b->visit[w] = stamp;
+                out[tail++] = w;
+            }
+        }
+    }
+    return tail;
+}
+
+// Split vertices[0..count) and give every level whose size limit the piece
+// fits (and no larger piece already covered) a new cell
+static void bisect(Bisection* b, int* vertices, int count, int assigned_from) {
+    Partition* partition = b->partition;
+    int n = partition->num_vertices;
+    int fits_from = assigned_from;
+    while (fits_from > 0 && count <= b->max_sizes[fits_from - 1]) {
+        fits_from--;
+    }
+    for (int level = fits_from; level < assigned_from; level++) {
+        int cell = partition->num_cells[level]++;
+        for (int i = 0; i < count; i++) {
+            partition->cells[level * n + vertices[i]] = cell;
+        }
+    }
+    if (fits_from == 0) return;
+
+    // BFS order of the piece, each component from a pseudo-peripheral vertex
+    int m = b->next_mark++;
+    for (int i = 0; i < count; i++) {
+        b->mark[vertices[i]] = m;
+    }
+    int order_stamp = b->next_stamp++;
+    int ordered = 0;
+    for (int i = 0; i < count; i++) {
+        int v = vertices[i];
+        if (b->visit[v] == order_stamp) continue;
+        int reached = piece_bfs(b, v, m, b->next_stamp++, b->queue);
+        ordered += piece_bfs(b, b->queue[reached - 1], m, order_stamp, b->scratch + ordered);
+    }
+    memcpy(vertices, b->scratch, count * sizeof(int));
+
+    int half = count / 2;
+    bisect(b, vertices, half, fits_from);
+    bisect(b, vertices + half, count - half, fits_from);
+}
+
+Partition* partition_create(const Graph* graph, const int* max_cell_sizes, int num_levels) {
+    if (!graph || !max_cell_sizes || num_levels <= 0) {
+        fprintf(stderr, "Error: Invalid partition parameters\n");
+        return NULL;
+    }
+    for (int level = 0; level < num_levels; level++) {
+        if (max_cell_sizes[level] < 1 || (level > 0 && max_cell_sizes[level] <= max_cell_sizes[level - 1])) {
+            fprintf(stderr, "Error: Cell sizes must be positive and strictly increasing\n");
+            return NULL;
+        }
+    }
+
+    int n = graph->num_vertices;
+    Partition* partition = (Partition*)calloc(1, sizeof(Partition));
+    Bisection b;
+    memset(&b, 0, sizeof(Bisection));
+    int* vertices = (int*)malloc(n * sizeof(int));
+    bool ok = partition && vertices;
+    if (ok) {
+        partition->num_vertices = n;
+        partition->num_levels = num_levels;
+        partition->cells = (int*)malloc((size_t)num_levels * n * sizeof(int));
+        partition->num_cells = (int*)calloc(num_levels, sizeof(int));
+        b.mark = (int*)malloc(n * sizeof(int));
+        b.visit = (int*)malloc(n * sizeof(int));
+        b.queue = (int*)malloc(n * sizeof(int));
+        b.scratch = (int*)malloc(n * sizeof(int));
+        ok = partition->cells && partition->num_cells && b.mark && b.visit && b.queue &&
+             b.scratch && symmetric_adjacency(graph, &b);
+    }
+    if (ok) {
+        for (int v = 0; v < n; v++) {
+            b.mark[v] = -1;
+            b.visit[v] = -1;
+            vertices[v] = v;
+        }
+        b.max_sizes = max_cell_sizes;
+        b.num_levels = num_levels;
+        b.partition = partition;
+        bisect(&b, vertices, n, num_levels);
+    }
+
+    free(b.offsets);
+    free(b.adj);
+    free(b.mark);
+    free(b.visit);
+    free(b.queue);
+    free(b.scratch);
+    free(vertices);
+    if (!ok) {
+        fprintf(stderr, "Error: Memory allocation failed for partition\n");
+        partition_destroy(partition);
+        return NULL;
+    }
+    return partition;
+}
+
+void partition_destroy(Partition* partition) {
+    if (!partition) return;
+    free(partition->cells);
+    free(partition->num_cells);
+    free(partition);
+}
+
+int partition_cell(const Partition* partition, int level, int vertex) {
+    if (!partition || level < 0 || level >= partition->num_levels ||
+        vertex < 0 || vertex >= partition->num_vertices) {
+        return -1;
+    }
+    return partition->cells[level * partition->num_vertices + vertex];
+}
+
+int partition_cut_arcs(const Partition* partition, const Graph* graph, int level) {
+    if (!partition || !graph || level < 0 || level >= partition->num_levels ||
+        graph->num_vertices != partition->num_vertices) {
+        return -1;
+    }
+    const int* cells = partition->cells + (size_t)level * partition->num_vertices;
+    int cut = 0;
+    for (int u = 0; u < graph->num_vertices; u++) {
+        for (Edge* edge = graph->adj_list[u]; edge; edge = edge->next) {
+            if (cells[u] != cells[edge->dest]) cut++;
+        }
+    }
+    return cut;
+}
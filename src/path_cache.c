@@ -0,0 +1,288 @@
+#include "path_cache.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+
+#define MAX_SHARDS 16
+#define MIN_ENTRIES_PER_SHARD 16
+#define NO_ENTRY -1
+
+typedef struct {
+    PathResult* result;          // NULL while the slot is free
+    PathFinderFunc finder;
+    unsigned long long version;  // Graph version the result was computed on
+    int start;
+    int end;
+    int next;                    // Bucket chain, or free list while unused
+    bool referenced;             // CLOCK bit, set on every hit
+} CacheEntry;
+
+typedef struct {
+    pthread_mutex_t lock;
+    CacheEntry* entries;
+    int capacity;
+    int used;                    // Slots handed out so far (high-water mark)
+    int free_head;               // Slots released by invalidation
+    int* buckets;                // Heads of the hash chains
+    size_t bucket_mask;
+    int hand;                    // CLOCK hand
+    PathCacheStats stats;
+} CacheShard;
+
+struct PathCache {
+    CacheShard* shards;
+    int num_shards;
+};
+
+static uint64_t cache_hash(PathFinderFunc finder, int start, int end) {
+    uint64_t h = ((uint64_t)(uint32_t)start << 32) | (uint32_t)end;
+    h ^= (uint64_t)(uintptr_t)finder * 0x9E3779B97F4A7C15ULL;
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    return h;
+}
+
+PathCache* path_cache_create(size_t capacity) {
+    if (capacity == 0 || capacity > INT32_MAX) {
+        fprintf(stderr, "Error: Invalid path cache capacity %zu\n", capacity);
+        return NULL;
+    }
+
+    PathCache* cache = (PathCache*)calloc(1, sizeof(PathCache));
+    if (!cache) {
+        fprintf(stderr, "Error: Memory allocation failed for path cache\n");
+        return NULL;
+    }
+
+    // Small caches stay in one shard so CLOCK sees every entry
+    cache->num_shards = 1;
+    while (cache->num_shards < MAX_SHARDS &&
+           capacity / (size_t)(cache->num_shards * 2) >= MIN_ENTRIES_PER_SHARD) {
+        cache->num_shards *= 2;
+    }
+    cache->shards = (CacheShard*)calloc(cache->num_shards, sizeof(CacheShard));
+    if (!cache->shards) {
+        fprintf(stderr, "Error: Memory allocation failed for path cache\n");
+        free(cache);
+        return NULL;
+    }
+
+    for (int s = 0; s < cache->num_shards; s++) {
+        CacheShard* shard = &cache->shards[s];
+        shard->capacity = (int)((capacity + cache->num_shards - 1) / cache->num_shards);
+        size_t num_buckets = 1;
+        while (num_buckets < (size_t)shard->capacity * 2) {
+            num_buckets <<= 1;
+        }
+        shard->entries = (CacheEntry*)calloc(shard->capacity, sizeof(CacheEntry));
+        shard->buckets = (int*)malloc(num_buckets * sizeof(int));
+        pthread_mutex_init(&shard->lock, NULL);
+        if (!shard->entries || !shard->buckets) {
+            fprintf(stderr, "Error: Memory allocation failed for path cache\n");
+            cache->num_shards = s + 1;
+            path_cache_destroy(cache);
+            return NULL;
+        }
+        for (size_t b = 0; b < num_buckets; b++) {
+            shard->buckets[b] = NO_ENTRY;
+        }
+        shard->bucket_mask = num_buckets - 1;
+        shard->free_head = NO_ENTRY;
+    }
+    return cache;
+}
+
+void path_cache_destroy(PathCache* cache) {
+    if (!cache) return;
+    for (int s = 0; s < cache->num_shards; s++) {
+        CacheShard* shard = &cache->shards[s];
+        if (shard->entries) {
+            for (int i = 0; i < shard->used; i++) {
+                path_result_destroy(shard->entries[i].result);
+            }
+        }
+        free(shard->entries);
+        free(shard->buckets);
+        pthread_mutex_destroy(&shard->lock);
+    }
+    free(cache->shards);
+    free(cache);
+}
+
+// Index of the entry for a key, or NO_ENTRY
+static int shard_find(const CacheShard* shard, uint64_t hash, PathFinderFunc finder, int start, int end) {
+    for (int index = shard->buckets[hash & shard->bucket_mask]; index != NO_ENTRY;
+         index = shard->entries[index].next) {
+        const CacheEntry* entry = &shard->entries[index];
+        if (entry->start == start && entry->end == end && entry->finder == finder) {
+            return index;
+        }
+    }
+    return NO_ENTRY;
+}
+
+// Unlink an entry from its chain and free its result
+static void shard_remove(CacheShard* shard, int index) {
+    CacheEntry* entry = &shard->entries[index];
+    uint64_t hash = cache_hash(entry->finder, entry->start, entry->end);
+    int* link = &shard->buckets[hash & shard->bucket_mask];
+    while (*link != index) {
+        link = &shard->entries[*link].next;
+    }
+    *link = entry->next;
+    path_result_destroy(entry->result);
+    entry->result = NULL;
+    shard->stats.entries--;
+}
+
+// A free slot: unused, released, or the CLOCK victim
+static int shard_allocate(CacheShard* shard) {
+    if (shard->free_head != NO_ENTRY) {
+        int index = shard->free_head;
+        shard->free_head = shard->entries[index].next;
+        return index;
+    }
+    if (shard->used < shard->capacity) {
+        return shard->used++;
+    }
+
+    // Every entry is live: sweep, giving referenced entries a second chance
+    while (shard->entries[shard->hand].referenced) {
+        shard->entries[shard->hand].referenced = false;
+        shard->hand = (shard->hand + 1) % shard->capacity;
+    }
+    int victim = shard->hand;
+    shard->hand = (shard->hand + 1) % shard->capacity;
+    shard_remove(shard, victim);
+    shard->stats.evictions++;
+    return victim;
+}
+
+static CacheShard* cache_shard(PathCache* cache, uint64_t hash) {
+    // High bits pick the shard, low bits the bucket
+    return &cache->shards[(hash >> 48) & (uint64_t)(cache->num_shards - 1)];
+}
+
+PathResult* path_cache_lookup(PathCache* cache, const Graph* graph, int start, int end,
+                              PathFinderFunc finder) {
+    if (!cache || !graph || !finder) return NULL;
+
+    long long start_ns = graph_clock_ns();
+    uint64_t hash = cache_hash(finder, start, end);
+    CacheShard* shard = cache_shard(cache, hash);
+    PathResult* copy = NULL;
+
+    pthread_mutex_lock(&shard->lock);
+    int index = shard_find(shard, hash, finder, start, end);
+    if (index != NO_ENTRY && shard->entries[index].version != graph->version) {
+        // Computed on an earlier graph: drop it now instead of waiting for CLOCK
+        shard_remove(shard, index);
+        shard->entries[index].next = shard->free_head;
+        shard->free_head = index;
+        shard->stats.stale++;
+        index = NO_ENTRY;
+    }
+    if (index != NO_ENTRY) {
+        shard->entries[index].referenced = true;
+        copy = path_result_clone(shard->entries[index].result);
+    }
+    if (copy) {
+        shard->stats.hits++;
+    } else {
+        shard->stats.misses++;
+    }
+    pthread_mutex_unlock(&shard->lock);
+
+    if (copy) {
+        memset(&copy->stats, 0, sizeof(SearchStats));
+        copy->time_ms = (graph_clock_ns() - start_ns) / 1e6;
+    }
+    return copy;
+}
+
+bool path_cache_insert(PathCache* cache, const Graph* graph, int start, int end,
+                       PathFinderFunc finder, const PathResult* result) {
+    if (!cache || !graph || !finder || !result) return false;
+
+    // Copy outside the lock
+    PathResult* copy = path_result_clone(result);
+    if (!copy) return false;
+
+    uint64_t hash = cache_hash(finder, start, end);
+    CacheShard* shard = cache_shard(cache, hash);
+
+    pthread_mutex_lock(&shard->lock);
+    int index = shard_find(shard, hash, finder, start, end);
+    if (index != NO_ENTRY) {
+        // Another thread cached it first, or it is stale: replace in place
+        path_result_destroy(shard->entries[index].result);
+    } else {
+        index = shard_allocate(shard);
+        int* head = &shard->buckets[hash & shard->bucket_mask];
+        shard->entries[index].next = *head;
+        *head = index;
+        shard->entries[index].start = start;
+        shard->entries[index].end = end;
+        shard->entries[index].finder = finder;
+        shard->stats.entries++;
+    }
+    shard->entries[index].result = copy;
+    shard->entries[index].version = graph->version;
+    shard->entries[index].referenced = false;
+    pthread_mutex_unlock(&shard->lock);
+    return true;
+}
+
+PathResult* path_cache_find_path(PathCache* cache, const Graph* graph, int start, int end,
+                                 PathFinderFunc finder) {
+    PathResult* result = path_cache_lookup(cache, graph, start, end, finder);
+    if (result || !finder) {
+        return result;
+    }
+
+    result = finder(graph, start, end);
+    if (result) {
+        path_cache_insert(cache, graph, start, end, finder, result);
+    }
+    return result;
+}
+
+void path_cache_clear(PathCache* cache) {
+    if (!cache) return;
+    for (int s = 0; s < cache->num_shards; s++) {
+        CacheShard* shard = &cache->shards[s];
+        pthread_mutex_lock(&shard->lock);
+        for (int i = 0; i < shard->used; i++) {
+            path_result_destroy(shard->entries[i].result);
+            shard->entries[i].result = NULL;
+            shard->entries[i].referenced = false;
+        }
+        for (size_t b = 0; b <= shard->bucket_mask; b++) {
+            shard->buckets[b] = NO_ENTRY;
+        }
+        shard->used = 0;
+        shard->free_head = NO_ENTRY;
+        shard->hand = 0;
+        shard->stats.entries = 0;
+        pthread_mutex_unlock(&shard->lock);
+    }
+}
+
+void path_cache_get_stats(PathCache* cache, PathCacheStats* stats) {
+    if (!stats) return;
+    memset(stats, 0, sizeof(PathCacheStats));
+    if (!cache) return;
+    for (int s = 0; s < cache->num_shards; s++) {
+        CacheShard* shard = &cache->shards[s];
+        pthread_mutex_lock(&shard->lock);
+        stats->hits += shard->stats.hits;
+        stats->misses += shard->stats.misses;
+        stats->stale += shard->stats.stale;
+        stats->evictions += shard->stats.evictions;
+        stats->entries += shard->stats.entries;
+        pthread_mutex_unlock(&shard->lock);
+    }
+}
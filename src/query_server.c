@@ -0,0 +1,808 @@
+#define _POSIX_C_SOURCE 200809L
+#include "query_server.h"
+#include "parallel.h"
+#include "search_workspace.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdatomic.h>
+#include <poll.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+#define DEFAULT_MAX_PENDING 4096
+#define LISTEN_BACKLOG 128
+#define READ_BATCH 64          // Requests read per recv() call
+#define MAX_OUTPUT_BACKLOG (1 << 20)  // Unsent response bytes before reads pause
+#define SHUTDOWN_FLUSH_MS 1000 // How long shutdown waits on a client that does not read
+
+// One client connection. Shared by the I/O thread and the workers answering
+// its requests; freed when the last reference is released. Sockets are
+// non-blocking: workers queue responses in out and send what the socket
+// takes, and the I/O thread flushes the rest when it becomes writable.
+typedef struct Connection {
+    int fd;
+    int refs;                  // Protected by the server lock
+    bool read_closed;          // EOF seen; protected by the server lock
+    pthread_mutex_t write_lock;
+    bool write_failed;         // Protected by write_lock, like out
+    unsigned char* out;        // Responses not yet sent
+    size_t out_sent;           // Bytes of out already sent
+    size_t out_size;
+    size_t out_capacity;
+    size_t buffered;           // Bytes of unqueued requests in buffer
+    unsigned char buffer[READ_BATCH * sizeof(QueryRequest)];
+} Connection;
+
+typedef struct {
+    Connection* connection;
+    QueryRequest request;
+} QueryJob;
+
+struct QueryServer {
+    GraphSnapshotManager* graphs;
+    char* socket_path;
+    char* graph_path;          // NULL when reloads are refused
+    int listen_fd;
+    int wake_pipe[2];
+    atomic_int stopping;       // Lock-free, so safe to set from a signal handler
+    atomic_int reload_requested;
+    atomic_int reload_active;  // A reload thread is loading or publishing
+    bool reload_started;       // reload_thread needs joining (I/O thread only)
+    pthread_t reload_thread;
+    bool allow_remote_shutdown;
+    double query_timeout_ms;
+    int num_threads;
+
+    // Bounded job ring shared by the I/O thread and the workers. The I/O
+    // thread never waits for space: it stops reading until a worker wakes it.
+    pthread_mutex_t lock;
+    pthread_cond_t not_empty;
+    QueryJob* jobs;
+    int capacity;
+    int head;
+    int count;
+    bool draining;
+
+    QueryServerStats stats;    // Protected by lock
+};
+
+// Per-worker state: its own workspace and response buffer
+typedef struct {
+    QueryServer* server;
+    int reader;                // Snapshot reader slot
+    SearchWorkspace* workspace;
+    unsigned char* response;
+    size_t response_capacity;
+} QueryWorker;
+
+void query_server_config_init(QueryServerConfig* config, const char* socket_path) {
+    if (!config) return;
+    config->socket_path = socket_path;
+    config->num_threads = 0;
+    config->max_pending = 0;
+    config->allow_remote_shutdown = false;
+    config->graph_path = NULL;
+    config->query_timeout_ms = 0.0;
+}
+
+// Send all bytes, retrying on partial writes and signals
+static bool send_all(int fd, const void* data, size_t size) {
+    const unsigned char* p = (const unsigned char*)data;
+    while (size > 0) {
+        ssize_t sent = send(fd, p, size, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        p += sent;
+        size -= (size_t)sent;
+    }
+    return true;
+}
+
+// Receive exactly size bytes; false on EOF or error
+static bool recv_all(int fd, void* data, size_t size) {
+    unsigned char* p = (unsigned char*)data;
+    while (size > 0) {
+        ssize_t got = recv(fd, p, size, 0);
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) return false;
+        p += got;
+        size -= (size_t)got;
+    }
+    return true;
+}
+
+// Drop one reference; the caller holds server->lock
+static void connection_release_locked(Connection* connection) {
+    if (--connection->refs == 0) {
+        close(connection->fd);
+        pthread_mutex_destroy(&connection->write_lock);
+        free(connection->out);
+        free(connection);
+    }
+}
+
+// Send queued output until the socket would block; the caller holds write_lock
+static void connection_flush_locked(Connection* connection) {
+    while (connection->out_sent < connection->out_size) {
+        ssize_t sent = send(connection->fd, connection->out + connection->out_sent,
+                            connection->out_size - connection->out_sent, MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (sent < 0) {
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) connection->write_failed = true;
+            break;
+        }
+        connection->out_sent += (size_t)sent;
+    }
+    if (connection->out_sent == connection->out_size || connection->write_failed) {
+        connection->out_sent = 0;
+        connection->out_size = 0;
+    }
+}
+
+// Queue a response behind earlier ones and send what the socket takes now.
+// Returns false if the connection failed. The caller holds write_lock.
+static bool connection_write_locked(Connection* connection, const void* data, size_t size) {
+    if (connection->write_failed) return false;
+    if (connection->out_size + size > connection->out_capacity && connection->out_sent > 0) {
+        connection->out_size -= connection->out_sent;
+        memmove(connection->out, connection->out + connection->out_sent, connection->out_size);
+        connection->out_sent = 0;
+    }
+    if (connection->out_size + size > connection->out_capacity) {
+        size_t capacity = connection->out_capacity ? connection->out_capacity * 2 : 4096;
+        while (capacity < connection->out_size + size) capacity *= 2;
+        unsigned char* grown = (unsigned char*)realloc(connection->out, capacity);
+        if (!grown) {
+            fprintf(stderr, "Error: Memory allocation failed for response queue\n");
+            connection->write_failed = true;
+            connection->out_sent = 0;
+            connection->out_size = 0;
+            return false;
+        }
+        connection->out = grown;
+        connection->out_capacity = capacity;
+    }
+    memcpy(connection->out + connection->out_size, data, size);
+    connection->out_size += size;
+    connection_flush_locked(connection);
+    return !connection->write_failed;
+}
+
+// Unsent bytes, or SIZE_MAX once writing failed
+static size_t connection_backlog(Connection* connection) {
+    pthread_mutex_lock(&connection->write_lock);
+    size_t backlog = connection->write_failed ? SIZE_MAX : connection->out_size - connection->out_sent;
+    pthread_mutex_unlock(&connection->write_lock);
+    return backlog;
+}
+
+static bool set_nonblocking(int fd) {
+    int flags = fcntl(fd, F_GETFL);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+QueryServer* query_server_create(GraphSnapshotManager* graphs, const QueryServerConfig* config) {
+    if (!graphs || !config || !config->socket_path) {
+        fprintf(stderr, "Error: Query server needs a graph and a socket path\n");
+        return NULL;
+    }
+
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (strlen(config->socket_path) >= sizeof(address.sun_path)) {
+        fprintf(stderr, "Error: Socket path too long: %s\n", config->socket_path);
+        return NULL;
+    }
+    strcpy(address.sun_path, config->socket_path);
+
+    QueryServer* server = (QueryServer*)calloc(1, sizeof(QueryServer));
+    if (!server) {
+        fprintf(stderr, "Error: Memory allocation failed for query server\n");
+        return NULL;
+    }
+    server->graphs = graphs;
+    server->listen_fd = -1;
+    server->wake_pipe[0] = server->wake_pipe[1] = -1;
+    server->allow_remote_shutdown = config->allow_remote_shutdown;
+    server->query_timeout_ms = config->query_timeout_ms;
+    server->num_threads = parallel_resolve_threads(config->num_threads);
+    server->capacity = config->max_pending > 0 ? config->max_pending : DEFAULT_MAX_PENDING;
+    server->socket_path = (char*)malloc(strlen(config->socket_path) + 1);
+    server->jobs = (QueryJob*)malloc(server->capacity * sizeof(QueryJob));
+    pthread_mutex_init(&server->lock, NULL);
+    pthread_cond_init(&server->not_empty, NULL);
+
+    if (!server->socket_path || !server->jobs) {
+        fprintf(stderr, "Error: Memory allocation failed for query server\n");
+        query_server_destroy(server);
+        return NULL;
+    }
+    strcpy(server->socket_path, config->socket_path);
+    if (config->graph_path) {
+        server->graph_path = (char*)malloc(strlen(config->graph_path) + 1);
+        if (!server->graph_path) {
+            fprintf(stderr, "Error: Memory allocation failed for query server\n");
+            query_server_destroy(server);
+            return NULL;
+        }
+        strcpy(server->graph_path, config->graph_path);
+    }
+
+    // A full wake-up pipe already means a pending wake-up, so writes never block
+    if (pipe(server->wake_pipe) != 0 || !set_nonblocking(server->wake_pipe[1])) {
+        fprintf(stderr, "Error: Cannot create wake-up pipe: %s\n", strerror(errno));
+        query_server_destroy(server);
+        return NULL;
+    }
+
+    // Replace a stale socket from an earlier run, but never another kind of file
+    struct stat st;
+    if (lstat(config->socket_path, &st) == 0) {
+        if (!S_ISSOCK(st.st_mode)) {
+            fprintf(stderr, "Error: %s exists and is not a socket\n", config->socket_path);
+            query_server_destroy(server);
+            return NULL;
+        }
+        unlink(config->socket_path);
+    }
+
+    server->listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (server->listen_fd < 0 ||
+        bind(server->listen_fd, (struct sockaddr*)&address, sizeof(address)) != 0 ||
+        listen(server->listen_fd, LISTEN_BACKLOG) != 0) {
+        fprintf(stderr, "Error: Cannot listen on %s: %s\n", config->socket_path, strerror(errno));
+        if (server->listen_fd >= 0) {
+            close(server->listen_fd);
+            server->listen_fd = -1;
+        }
+        query_server_destroy(server);
+        return NULL;
+    }
+    return server;
+}
+
+// Wake the I/O thread (async-signal-safe)
+static void wake_io_thread(QueryServer* server) {
+    if (server->wake_pipe[1] >= 0) {
+        char byte = 1;
+        ssize_t ignored = write(server->wake_pipe[1], &byte, 1);
+        (void)ignored;
+    }
+}
+
+void query_server_stop(QueryServer* server) {
+    if (!server) return;
+    atomic_store(&server->stopping, 1);
+    wake_io_thread(server);
+}
+
+void query_server_reload(QueryServer* server) {
+    if (!server) return;
+    atomic_store(&server->reload_requested, 1);
+    wake_io_thread(server);
+}
+
+// Background reload: workers keep answering from the old snapshot meanwhile
+static void* reload_main(void* arg) {
+    QueryServer* server = (QueryServer*)arg;
+    GraphParseError error;
+    unsigned long long version = graph_snapshot_reload_file(server->graphs, server->graph_path, &error);
+    if (version) {
+        // Free the replaced graph here rather than on a query path
+        graph_snapshot_synchronize(server->graphs);
+        pthread_mutex_lock(&server->lock);
+        server->stats.reloads++;
+        pthread_mutex_unlock(&server->lock);
+    } else {
+        fprintf(stderr, "Error: Reload of %s failed: %s\n", server->graph_path, error.message);
+    }
+
+    // Let the I/O thread pick up requests that arrived while we were busy
+    atomic_store(&server->reload_active, 0);
+    wake_io_thread(server);
+    return NULL;
+}
+
+// Start a reload thread if one was requested and none is running (I/O thread)
+static void start_pending_reload(QueryServer* server) {
+    if (atomic_load(&server->reload_active) || !atomic_exchange(&server->reload_requested, 0)) {
+        return;
+    }
+    if (server->reload_started) {
+        pthread_join(server->reload_thread, NULL);
+        server->reload_started = false;
+    }
+    atomic_store(&server->reload_active, 1);
+    if (pthread_create(&server->reload_thread, NULL, reload_main, server) != 0) {
+        fprintf(stderr, "Error: Failed to start reload thread\n");
+        atomic_store(&server->reload_active, 0);
+        return;
+    }
+    server->reload_started = true;
+}
+
+void query_server_get_stats(QueryServer* server, QueryServerStats* stats) {
+    if (!server || !stats) return;
+    pthread_mutex_lock(&server->lock);
+    *stats = server->stats;
+    pthread_mutex_unlock(&server->lock);
+}
+
+// Answer one request into the worker's buffer; returns the response size
+static size_t answer_request(QueryWorker* worker, const Graph* graph, unsigned long long version,
+                             const QueryRequest* request, bool* error) {
+    QueryServer* server = worker->server;
+    QueryResponseHeader header;
+    memset(&header, 0, sizeof(header));
+    header.id = request->id;
+    header.version = (uint64_t)version;
+    header.status = QUERY_STATUS_OK;
+    size_t size = sizeof(header);
+
+    switch (request->op) {
+        case QUERY_OP_PING:
+            break;
+
+        case QUERY_OP_SHUTDOWN:
+            if (server->allow_remote_shutdown) {
+                query_server_stop(server);
+            } else {
+                header.status = QUERY_STATUS_REFUSED;
+            }
+            break;
+
+        case QUERY_OP_RELOAD:
+            if (server->graph_path) {
+                query_server_reload(server);
+            } else {
+                header.status = QUERY_STATUS_REFUSED;
+            }
+            break;
+
+        case QUERY_OP_PATH:
+        case QUERY_OP_DISTANCE: {
+            if (request->algorithm > QUERY_ALGO_BFS ||
+                !graph_is_valid_vertex(graph, request->start) ||
+                !graph_is_valid_vertex(graph, request->end)) {
+                header.status = QUERY_STATUS_BAD_REQUEST;
+                *error = true;
+                break;
+            }
+
+            WorkspaceAlgorithm algorithm = (request->algorithm == QUERY_ALGO_ASTAR) ? WORKSPACE_ASTAR
+                                         : (request->algorithm == QUERY_ALGO_BFS) ? WORKSPACE_BFS
+                                         : WORKSPACE_DIJKSTRA;
+            SearchLimits limits;
+            search_limits_init(&limits);
+            if (server->query_timeout_ms > 0.0) {
+                search_limits_set_budget(&limits, server->query_timeout_ms);
+            }
+
+            double distance = 0.0;
+            if (!search_workspace_find_path_limited(worker->workspace, graph, request->start,
+                                                    request->end, algorithm, &limits, &distance)) {
+                switch (worker->workspace->status) {
+                    case SEARCH_COMPLETED:
+                        header.status = QUERY_STATUS_NOT_FOUND;
+                        break;
+                    case SEARCH_OUT_OF_MEMORY:
+                        header.status = QUERY_STATUS_ERROR;
+                        *error = true;
+                        break;
+                    default:
+                        header.status = QUERY_STATUS_TIMED_OUT;
+                        break;
+                }
+                break;
+            }
+
+            header.distance = distance;
+            if (request->op == QUERY_OP_PATH) {
+                header.path_length = (uint32_t)worker->workspace->path_length;
+                for (int i = 0; i < worker->workspace->path_length; i++) {
+                    int32_t vertex = worker->workspace->path[i];
+                    memcpy(worker->response + size + i * sizeof(int32_t), &vertex, sizeof(int32_t));
+                }
+                size += header.path_length * sizeof(int32_t);
+            }
+            break;
+        }
+
+        default:
+            header.status = QUERY_STATUS_BAD_REQUEST;
+            *error = true;
+            break;
+    }
+
+    memcpy(worker->response, &header, sizeof(header));
+    return size;
+}
+
+static void* worker_main(void* arg) {
+    QueryWorker* worker = (QueryWorker*)arg;
+    QueryServer* server = worker->server;
+
+    while (true) {
+        pthread_mutex_lock(&server->lock);
+        while (server->count == 0 && !server->draining) {
+            pthread_cond_wait(&server->not_empty, &server->lock);
+        }
+        if (server->count == 0) {
+            pthread_mutex_unlock(&server->lock);
+            break;
+        }
+        QueryJob job = server->jobs[server->head];
+        bool was_full = (server->count == server->capacity);
+        server->head = (server->head + 1) % server->capacity;
+        server->count--;
+        server->stats.requests++;
+        pthread_mutex_unlock(&server->lock);
+        if (was_full) wake_io_thread(server);  // Reads paused for lack of space
+
+        // Pin the current snapshot for this request only, so a reload never
+        // waits on more than one query per worker
+        unsigned long long version = 0;
+        const Graph* graph = graph_snapshot_acquire(server->graphs, worker->reader, &version);
+        bool error = false;
+        worker->workspace->status = SEARCH_COMPLETED;  // Only searches below change it
+        size_t size = sizeof(QueryResponseHeader);
+        size_t needed = size + (size_t)graph->num_vertices * sizeof(int32_t);
+        if (needed > worker->response_capacity) {
+            unsigned char* grown = (unsigned char*)realloc(worker->response, needed);
+            if (grown) {
+                worker->response = grown;
+                worker->response_capacity = needed;
+            }
+        }
+        if (needed <= worker->response_capacity) {
+            size = answer_request(worker, graph, version, &job.request, &error);
+        } else {
+            QueryResponseHeader header = {.id = job.request.id, .status = QUERY_STATUS_ERROR};
+            memcpy(worker->response, &header, sizeof(header));
+            error = true;
+        }
+        graph_snapshot_release(server->graphs, worker->reader);
+
+        // Never block on the client: what the socket does not take now is
+        // left for the I/O thread
+        pthread_mutex_lock(&job.connection->write_lock);
+        if (!connection_write_locked(job.connection, worker->response, size)) {
+            error = true;
+        }
+        bool wake = error || job.connection->out_size > job.connection->out_sent;
+        pthread_mutex_unlock(&job.connection->write_lock);
+
+        pthread_mutex_lock(&server->lock);
+        if (error) server->stats.errors++;
+        if (worker->workspace->status == SEARCH_TIMED_OUT) server->stats.timeouts++;
+        // The I/O thread closes a finished connection once its last answer is out
+        if (job.connection->read_closed && job.connection->refs == 2) wake = true;
+        connection_release_locked(job.connection);
+        pthread_mutex_unlock(&server->lock);
+        if (wake) wake_io_thread(server);
+    }
+    return NULL;
+}
+
+// Queue the complete requests in the connection buffer while the ring has
+// space; the rest stay buffered and the connection is not read meanwhile
+static void enqueue_requests(QueryServer* server, Connection* connection) {
+    size_t complete = connection->buffered / sizeof(QueryRequest);
+    if (complete == 0) return;
+
+    size_t queued = 0;
+    pthread_mutex_lock(&server->lock);
+    while (queued < complete && server->count < server->capacity) {
+        QueryJob* job = &server->jobs[(server->head + server->count) % server->capacity];
+        job->connection = connection;
+        memcpy(&job->request, connection->buffer + queued * sizeof(QueryRequest), sizeof(QueryRequest));
+        connection->refs++;
+        server->count++;
+        queued++;
+        pthread_cond_signal(&server->not_empty);
+    }
+    pthread_mutex_unlock(&server->lock);
+
+    size_t used = queued * sizeof(QueryRequest);
+    memmove(connection->buffer, connection->buffer + used, connection->buffered - used);
+    connection->buffered -= used;
+}
+
+// Stop reading a connection (I/O thread). Requests already buffered are still
+// answered unless the connection failed.
+static void connection_close_read(QueryServer* server, Connection* connection, bool failed) {
+    if (failed) {
+        connection->buffered = 0;
+        pthread_mutex_lock(&connection->write_lock);
+        connection->write_failed = true;
+        connection->out_sent = 0;
+        connection->out_size = 0;
+        pthread_mutex_unlock(&connection->write_lock);
+    }
+    pthread_mutex_lock(&server->lock);
+    connection->read_closed = true;
+    pthread_mutex_unlock(&server->lock);
+}
+
+// Flush queued output of every connection that has some, waiting at most
+// SHUTDOWN_FLUSH_MS for a client that does not read (shutdown only)
+static void flush_connections(Connection** connections, int num_connections, struct pollfd* fds) {
+    while (true) {
+        int waiting = 0;
+        for (int i = 0; i < num_connections; i++) {
+            size_t backlog = connection_backlog(connections[i]);
+            fds[i].fd = (backlog > 0 && backlog != SIZE_MAX) ? connections[i]->fd : -1;
+            fds[i].events = POLLOUT;
+            fds[i].revents = 0;
+            if (fds[i].fd >= 0) waiting++;
+        }
+        if (waiting == 0) return;
+
+        int ready = poll(fds, num_connections, SHUTDOWN_FLUSH_MS);
+        if (ready < 0 && errno == EINTR) continue;
+        if (ready <= 0) return;
+        for (int i = 0; i < num_connections; i++) {
+            if (!fds[i].revents) continue;
+            pthread_mutex_lock(&connections[i]->write_lock);
+            if (fds[i].revents & POLLOUT) {
+                connection_flush_locked(connections[i]);
+            } else {
+                connections[i]->write_failed = true;
+            }
+            pthread_mutex_unlock(&connections[i]->write_lock);
+        }
+    }
+}
+
+bool query_server_run(QueryServer* server) {
+    if (!server) return false;
+
+    int num_workers = server->num_threads;
+    pthread_t* threads = (pthread_t*)calloc(num_workers, sizeof(pthread_t));
+    QueryWorker* workers = (QueryWorker*)calloc(num_workers, sizeof(QueryWorker));
+    Connection** connections = NULL;
+    struct pollfd* fds = NULL;
+    int num_connections = 0;
+    int connection_capacity = 0;
+    int started = 0;
+    bool ok = (threads && workers);
+
+    // Size per-worker state for the current graph; reloads grow it on demand
+    int num_vertices = 0;
+    size_t response_capacity = sizeof(QueryResponseHeader);
+    for (int t = 0; ok && t < num_workers; t++) {
+        workers[t].reader = -1;
+    }
+    for (int t = 0; ok && t < num_workers; t++) {
+        workers[t].server = server;
+        workers[t].reader = graph_snapshot_reader_register(server->graphs);
+        if (workers[t].reader >= 0 && t == 0) {
+            const Graph* graph = graph_snapshot_acquire(server->graphs, workers[t].reader, NULL);
+            num_vertices = graph->num_vertices;
+            response_capacity += (size_t)num_vertices * sizeof(int32_t);
+            graph_snapshot_release(server->graphs, workers[t].reader);
+        }
+        workers[t].workspace = search_workspace_create(num_vertices);
+        workers[t].response = (unsigned char*)malloc(response_capacity);
+        workers[t].response_capacity = response_capacity;
+        if (workers[t].reader < 0 || !workers[t].workspace || !workers[t].response ||
+            pthread_create(&threads[t], NULL, worker_main, &workers[t]) != 0) {
+            fprintf(stderr, "Error: Failed to start query worker %d\n", t);
+            ok = false;
+            break;
+        }
+        started++;
+    }
+
+    // I/O loop: accept connections, read pipelined requests and flush answers
+    // the workers could not send. Nothing here blocks on a client: a client
+    // that stops reading only stops its own connection from being read.
+    while (ok && !atomic_load(&server->stopping)) {
+        if (num_connections + 2 > connection_capacity) {
+            int capacity = connection_capacity ? connection_capacity * 2 : 16;
+            Connection** grown = (Connection**)realloc(connections, capacity * sizeof(Connection*));
+            struct pollfd* grown_fds = (struct pollfd*)realloc(fds, (capacity + 2) * sizeof(struct pollfd));
+            if (grown) connections = grown;
+            if (grown_fds) fds = grown_fds;
+            if (!grown || !grown_fds) {
+                fprintf(stderr, "Error: Memory allocation failed for connections\n");
+                break;
+            }
+            connection_capacity = capacity;
+        }
+
+        fds[0].fd = server->wake_pipe[0];
+        fds[0].events = POLLIN;
+        fds[1].fd = server->listen_fd;
+        fds[1].events = POLLIN;
+        for (int i = num_connections - 1; i >= 0; i--) {
+            Connection* connection = connections[i];
+            enqueue_requests(server, connection);
+            size_t backlog = connection_backlog(connection);
+
+            // Done once it failed, or once the client closed and every answer is out
+            pthread_mutex_lock(&server->lock);
+            if (backlog == SIZE_MAX ||
+                (connection->read_closed && connection->refs == 1 && backlog == 0 &&
+                 connection->buffered < sizeof(QueryRequest))) {
+                connections[i] = connections[--num_connections];
+                connection_release_locked(connection);
+            }
+            pthread_mutex_unlock(&server->lock);
+        }
+        for (int i = 0; i < num_connections; i++) {
+            Connection* connection = connections[i];
+            size_t backlog = connection_backlog(connection);
+
+            // Read only while the ring took everything and the client keeps up
+            short events = 0;
+            if (!connection->read_closed && connection->buffered < sizeof(QueryRequest) &&
+                backlog <= MAX_OUTPUT_BACKLOG) {
+                events |= POLLIN;
+            }
+            if (backlog > 0) events |= POLLOUT;
+            fds[i + 2].fd = events ? connection->fd : -1;
+            fds[i + 2].events = events;
+        }
+
+        int ready = poll(fds, num_connections + 2, -1);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            fprintf(stderr, "Error: poll failed: %s\n", strerror(errno));
+            break;
+        }
+        if (atomic_load(&server->stopping)) break;
+        if (fds[0].revents & POLLIN) {
+            char drain[64];
+            ssize_t ignored = read(server->wake_pipe[0], drain, sizeof(drain));
+            (void)ignored;
+            start_pending_reload(server);
+        }
+
+        for (int i = 0; i < num_connections; i++) {
+            short events = fds[i + 2].revents;
+            if (!events) continue;
+
+            Connection* connection = connections[i];
+            if (events & POLLOUT) {
+                pthread_mutex_lock(&connection->write_lock);
+                connection_flush_locked(connection);
+                pthread_mutex_unlock(&connection->write_lock);
+            }
+            if (events & POLLIN) {
+                ssize_t got = recv(connection->fd, connection->buffer + connection->buffered,
+                                   sizeof(connection->buffer) - connection->buffered, 0);
+                if (got > 0) {
+                    connection->buffered += (size_t)got;
+                    enqueue_requests(server, connection);
+                } else if (got == 0) {
+                    connection_close_read(server, connection, false);
+                } else if (errno != EINTR && errno != EAGAIN && errno != EWOULDBLOCK) {
+                    connection_close_read(server, connection, true);
+                }
+            } else if (events & (POLLERR | POLLHUP | POLLNVAL)) {
+                // The client is gone: nothing more can be delivered
+                connection_close_read(server, connection, true);
+            }
+        }
+
+        if (fds[1].revents & POLLIN) {
+            int fd = accept(server->listen_fd, NULL, NULL);
+            if (fd >= 0) {
+                Connection* connection = (Connection*)calloc(1, sizeof(Connection));
+                if (!connection || !set_nonblocking(fd)) {
+                    free(connection);
+                    close(fd);
+                } else {
+                    connection->fd = fd;
+                    connection->refs = 1;
+                    pthread_mutex_init(&connection->write_lock, NULL);
+                    connections[num_connections++] = connection;
+                    pthread_mutex_lock(&server->lock);
+                    server->stats.connections++;
+                    pthread_mutex_unlock(&server->lock);
+                }
+            }
+        }
+    }
+
+    // Graceful shutdown: stop reading, let the workers drain the queue, then
+    // deliver the answers to clients that are still reading
+    pthread_mutex_lock(&server->lock);
+    for (int i = 0; i < num_connections; i++) {
+        shutdown(connections[i]->fd, SHUT_RD);
+        connections[i]->read_closed = true;
+    }
+    server->draining = true;
+    pthread_cond_broadcast(&server->not_empty);
+    pthread_mutex_unlock(&server->lock);
+
+    for (int t = 0; t < started; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    if (fds) flush_connections(connections, num_connections, fds);
+    pthread_mutex_lock(&server->lock);
+    for (int i = 0; i < num_connections; i++) {
+        connection_release_locked(connections[i]);
+    }
+    pthread_mutex_unlock(&server->lock);
+
+    if (server->reload_started) {
+        pthread_join(server->reload_thread, NULL);
+        server->reload_started = false;
+    }
+    for (int t = 0; workers && t < num_workers; t++) {
+        if (workers[t].reader >= 0) {
+            graph_snapshot_reader_unregister(server->graphs, workers[t].reader);
+        }
+        search_workspace_destroy(workers[t].workspace);
+        free(workers[t].response);
+    }
+
+    free(connections);
+    free(fds);
+    free(threads);
+    free(workers);
+    return ok;
+}
+
+void query_server_destroy(QueryServer* server) {
+    if (!server) return;
+    if (server->listen_fd >= 0) {
+        close(server->listen_fd);
+        unlink(server->socket_path);
+    }
+    if (server->wake_pipe[0] >= 0) close(server->wake_pipe[0]);
+    if (server->wake_pipe[1] >= 0) close(server->wake_pipe[1]);
+    pthread_mutex_destroy(&server->lock);
+    pthread_cond_destroy(&server->not_empty);
+    free(server->jobs);
+    free(server->socket_path);
+    free(server->graph_path);
+    free(server);
+}
+
+int query_client_connect(const char* socket_path) {
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (!socket_path || strlen(socket_path) >= sizeof(address.sun_path)) {
+        fprintf(stderr, "Error: Invalid socket path\n");
+        return -1;
+    }
+    strcpy(address.sun_path, socket_path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    if (connect(fd, (struct sockaddr*)&address, sizeof(address)) != 0) {
+        fprintf(stderr, "Error: Cannot connect to %s: %s\n", socket_path, strerror(errno));
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+bool query_client_send(int fd, const QueryRequest* request) {
+    return request && send_all(fd, request, sizeof(QueryRequest));
+}
+
+bool query_client_receive(int fd, QueryResponseHeader* header, int32_t* path, int path_capacity) {
+    if (!header || !recv_all(fd, header, sizeof(QueryResponseHeader))) {
+        return false;
+    }
+    for (uint32_t i = 0; i < header->path_length; i++) {
+        int32_t vertex;
+        if (!recv_all(fd, &vertex, sizeof(vertex))) return false;
+        if (path && (int)i < path_capacity) path[i] = vertex;
+    }
+    return true;
+}
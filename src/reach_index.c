@@ -0,0 +1,444 @@
+#include "reach_index.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+struct ReachIndex {
+    pthread_mutex_t lock;            // Serialises lazy rebuilds
+    atomic_ullong built_version;     // Graph version the labels describe (0: none yet)
+    int num_traversals;
+    int num_vertices;
+    int num_components;
+    int* component;                  // Vertex -> component; Tarjan numbers sinks first
+    int* dag_offsets;                // Condensation DAG (CSR, duplicate arcs merged)
+    int* dag_targets;
+    int* low;                        // num_traversals x num_components GRAIL labels:
+    int* rank;                       // [low, rank] intervals of post-order ranks
+};
+
+static void free_labels(struct ReachIndex* index) {
+    free(index->component);
+    free(index->dag_offsets);
+    free(index->dag_targets);
+    free(index->low);
+    free(index->rank);
+    index->component = NULL;
+    index->dag_offsets = NULL;
+    index->dag_targets = NULL;
+    index->low = NULL;
+    index->rank = NULL;
+    index->num_vertices = 0;
+    index->num_components = 0;
+}
+
+// Iterative Tarjan: fills component[] and returns the component count (-1 on
+// allocation failure). Components are numbered in reverse topological order,
+// so every DAG arc goes from a higher to a lower number.
+static int tarjan_components(const Graph* graph, int* component) {
+    int n = graph->num_vertices;
+    int* order = (int*)malloc(n * sizeof(int));
+    int* low = (int*)malloc(n * sizeof(int));
+    int* scc_stack = (int*)malloc(n * sizeof(int));
+    int* call_vertex = (int*)malloc(n * sizeof(int));
+    Edge** call_edge = (Edge**)malloc(n * sizeof(Edge*));
+    bool* on_stack = (bool*)calloc(n, sizeof(bool));
+
+    int count = -1;
+    if (!order || !low || !scc_stack || !call_vertex || !call_edge || !on_stack) {
+        goto cleanup;
+    }
+
+    for (int v = 0; v < n; v++) {
+        order[v] = -1;
+    }
+
+    count = 0;
+    int counter = 0;
+    int scc_top = 0;
+    for (int root = 0; root < n; root++) {
+        if (order[root] != -1) continue;
+
+        int call_top = 0;
+        order[root] = low[root] = counter++;
+        scc_stack[scc_top++] = root;
+        on_stack[root] = true;
+        call_vertex[call_top] = root;
+        call_edge[call_top++] = graph->adj_list[root];
+
+        while (call_top > 0) {
+            int v = call_vertex[call_top - 1];
+            Edge* edge = call_edge[call_top - 1];
+
+            if (edge) {
+                call_edge[call_top - 1] = edge->next;
+                int w = edge->dest;
+                if (order[w] == -1) {
+                    order[w] = low[w] = counter++;
+                    scc_stack[scc_top++] = w;
+                    on_stack[w] = true;
+                    call_vertex[call_top] = w;
+                    call_edge[call_top++] = graph->adj_list[w];
+                } else if (on_stack[w] && order[w] < low[v]) {
+                    low[v] = order[w];
+                }
+                continue;
+            }
+
+            call_top--;
+            if (low[v] == order[v]) {
+                int w;
+                do {
+                    w = scc_stack[--scc_top];
+                    on_stack[w] = false;
+                    component[w] = count;
+                } while (w != v);
+                count++;
+            }
+            if (call_top > 0) {
+                int parent = call_vertex[call_top - 1];
+                if (low[v] < low[parent]) low[parent] = low[v];
+            }
+        }
+    }
+
+cleanup:
+    free(order);
+    free(low);
+    free(scc_stack);
+    free(call_vertex);
+    free(call_edge);
+    free(on_stack);
+    return count;
+}
+
+// Condensation DAG in CSR form with duplicate arcs merged
+static bool build_dag(struct ReachIndex* index, const Graph* graph) {
+    int n = graph->num_vertices;
+    int c = index->num_components;
+
+    // Group vertices by component (counting sort)
+    int* first = (int*)calloc(c + 1, sizeof(int));
+    int* members = (int*)malloc(n * sizeof(int));
+    int* marker = (int*)malloc(c * sizeof(int));
+    index->dag_offsets = (int*)calloc(c + 1, sizeof(int));
+    if (!first || !members || !marker || !index->dag_offsets) {
+        free(first);
+        free(members);
+        free(marker);
+        return false;
+    }
+
+    for (int v = 0; v < n; v++) {
+        first[index->component[v] + 1]++;
+    }
+    for (int i = 0; i < c; i++) {
+        first[i + 1] += first[i];
+        marker[i] = -1;
+    }
+    for (int v = 0; v < n; v++) {
+        members[first[index->component[v]]++] = v;
+    }
+    for (int i = c; i > 0; i--) {
+        first[i] = first[i - 1];
+    }
+    first[0] = 0;
+
+    // Two passes: count arcs, then fill them
+    for (int pass = 0; pass < 2; pass++) {
+        int arcs = 0;
+        for (int i = 0; i < c; i++) {
+            marker[i] = -1;
+        }
+        for (int u = 0; u < c; u++) {
+            index->dag_offsets[u] = arcs;
+            for (int k = first[u]; k < first[u + 1]; k++) {
+                for (Edge* edge = graph->adj_list[members[k]]; edge; edge = edge->next) {
+                    int w = index->component[edge->dest];
+                    if (w == u || marker[w] == u) continue;
+                    marker[w] = u;
+                    if (pass == 1) index->dag_targets[arcs] = w;
+                    arcs++;
+                }
+            }
+        }
+        index->dag_offsets[c] = arcs;
+
+        if (pass == 0) {
+            index->dag_targets = (int*)malloc((arcs > 0 ? arcs : 1) * sizeof(int));
+            if (!index->dag_targets) break;
+        }
+    }
+
+    free(first);
+    free(members);
+    free(marker);
+    return index->dag_targets != NULL;
+}
+
+static unsigned int xorshift(unsigned int* state) {
+    unsigned int x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+// One randomised post-order traversal of the DAG: rank is the post-order
+// number, low the smallest rank reachable from the component
+static bool label_traversal(struct ReachIndex* index, int t, int* in_degree) {
+    int c = index->num_components;
+    int* rank = index->rank + (size_t)t * c;
+    int* low = index->low + (size_t)t * c;
+    int* stack = (int*)malloc(c * sizeof(int));
+    int* next_child = (int*)malloc(c * sizeof(int));
+    int* child_offset = (int*)malloc(c * sizeof(int));
+    if (!stack || !next_child || !child_offset) {
+        free(stack);
+        free(next_child);
+        free(child_offset);
+        return false;
+    }
+
+    unsigned int seed = 0x9E3779B9u * (unsigned int)(t + 1);
+    bool reverse = (t % 2) == 1;
+    for (int i = 0; i < c; i++) {
+        rank[i] = 0;   // 0: not visited yet
+    }
+
+    int next_rank = 1;
+    int root_offset = (int)(xorshift(&seed) % (unsigned int)c);
+    for (int r = 0; r < c; r++) {
+        int root = reverse ? (root_offset + c - r) % c : (root_offset + r) % c;
+        if (in_degree[root] != 0 || rank[root] != 0) continue;
+
+        int top = 0;
+        stack[top] = root;
+        next_child[root] = 0;
+        child_offset[root] = (int)xorshift(&seed);
+        low[root] = INT32_MAX;
+        rank[root] = -1;  // On the stack
+        top++;
+
+        while (top > 0) {
+            int u = stack[top - 1];
+            int begin = index->dag_offsets[u];
+            int degree = index->dag_offsets[u + 1] - begin;
+
+            if (next_child[u] < degree) {
+                int k = (int)(((unsigned int)child_offset[u] + (unsigned int)next_child[u]) % (unsigned int)degree);
+                if (reverse) k = degree - 1 - k;
+                next_child[u]++;
+                int w = index->dag_targets[begin + k];
+                if (rank[w] == 0) {
+                    stack[top++] = w;
+                    next_child[w] = 0;
+                    child_offset[w] = (int)xorshift(&seed);
+                    low[w] = INT32_MAX;
+                    rank[w] = -1;
+                } else if (low[w] < low[u]) {
+                    low[u] = low[w];
+                }
+                continue;
+            }
+
+            top--;
+            rank[u] = next_rank++;
+            if (rank[u] < low[u]) low[u] = rank[u];
+            if (top > 0) {
+                int parent = stack[top - 1];
+                if (low[u] < low[parent]) low[parent] = low[u];
+            }
+        }
+    }
+
+    free(stack);
+    free(next_child);
+    free(child_offset);
+    return true;
+}
+
+static bool build_index(struct ReachIndex* index, const Graph* graph) {
+    free_labels(index);
+
+    int n = graph->num_vertices;
+    index->component = (int*)malloc(n * sizeof(int));
+    if (!index->component) return false;
+
+    int count = tarjan_components(graph, index->component);
+    if (count < 0) return false;
+    index->num_vertices = n;
+    index->num_components = count;
+
+    if (!build_dag(index, graph)) return false;
+
+    size_t labels = (size_t)index->num_traversals * count;
+    index->low = (int*)malloc(labels * sizeof(int));
+    index->rank = (int*)malloc(labels * sizeof(int));
+    int* in_degree = (int*)calloc(count, sizeof(int));
+    if (!index->low || !index->rank || !in_degree) {
+        free(in_degree);
+        return false;
+    }
+
+    for (int a = 0; a < index->dag_offsets[count]; a++) {
+        in_degree[index->dag_targets[a]]++;
+    }
+
+    bool ok = true;
+    for (int t = 0; t < index->num_traversals && ok; t++) {
+        ok = label_traversal(index, t, in_degree);
+    }
+    free(in_degree);
+    return ok;
+}
+
+// The graph's index, rebuilt first if the graph changed (NULL if unavailable)
+static struct ReachIndex* current_index(const Graph* graph) {
+    struct ReachIndex* index = graph ? graph->reach_index : NULL;
+    if (!index) return NULL;
+
+    if (atomic_load_explicit(&index->built_version, memory_order_acquire) == graph->version) {
+        return index;
+    }
+
+    // Double-checked: concurrent readers of a changed graph rebuild only once
+    pthread_mutex_lock(&index->lock);
+    bool ok = true;
+    if (atomic_load_explicit(&index->built_version, memory_order_relaxed) != graph->version) {
+        ok = build_index(index, graph);
+        if (ok) {
+            atomic_store_explicit(&index->built_version, graph->version, memory_order_release);
+        } else {
+            fprintf(stderr, "Error: Memory allocation failed for reachability index\n");
+            free_labels(index);
+            atomic_store_explicit(&index->built_version, 0, memory_order_release);
+        }
+    }
+    pthread_mutex_unlock(&index->lock);
+    return ok ? index : NULL;
+}
+
+bool reach_index_attach(Graph* graph, int num_traversals) {
+    if (!graph) return false;
+    if (graph->reach_index) return true;
+
+    struct ReachIndex* index = (struct ReachIndex*)calloc(1, sizeof(struct ReachIndex));
+    if (!index) {
+        fprintf(stderr, "Error: Memory allocation failed for reachability index\n");
+        return false;
+    }
+    pthread_mutex_init(&index->lock, NULL);
+    atomic_init(&index->built_version, 0);
+    index->num_traversals = num_traversals > 0 ? num_traversals : REACH_INDEX_DEFAULT_TRAVERSALS;
+    graph->reach_index = index;
+    return true;
+}
+
+void reach_index_detach(Graph* graph) {
+    if (!graph || !graph->reach_index) return;
+    struct ReachIndex* index = graph->reach_index;
+    free_labels(index);
+    pthread_mutex_destroy(&index->lock);
+    free(index);
+    graph->reach_index = NULL;
+}
+
+// Label check between two components
+static ReachAnswer component_query(const struct ReachIndex* index, int u, int v) {
+    if (u == v) return REACH_YES;
+    if (u < v) return REACH_NO;   // Arcs only lead to lower component numbers
+
+    int c = index->num_components;
+    for (int t = 0; t < index->num_traversals; t++) {
+        const int* low = index->low + (size_t)t * c;
+        const int* rank = index->rank + (size_t)t * c;
+        if (low[v] < low[u] || rank[v] > rank[u]) return REACH_NO;
+    }
+    return REACH_MAYBE;
+}
+
+ReachAnswer reach_index_query(const Graph* graph, int start, int end) {
+    if (!graph_is_valid_vertex(graph, start) || !graph_is_valid_vertex(graph, end)) {
+        return REACH_MAYBE;
+    }
+    const struct ReachIndex* index = current_index(graph);
+    if (!index) return REACH_MAYBE;
+    return component_query(index, index->component[start], index->component[end]);
+}
+
+bool reach_index_reachable(const Graph* graph, int start, int end) {
+    if (!graph_is_valid_vertex(graph, start) || !graph_is_valid_vertex(graph, end)) {
+        return false;
+    }
+    const struct ReachIndex* index = current_index(graph);
+    if (!index) {
+        fprintf(stderr, "Error: Graph has no reachability index\n");
+        return false;
+    }
+
+    int source = index->component[start];
+    int target = index->component[end];
+    ReachAnswer answer = component_query(index, source, target);
+    if (answer != REACH_MAYBE) return answer == REACH_YES;
+
+    // DFS over the DAG, skipping components whose labels rule out the target
+    int c = index->num_components;
+    bool* visited = (bool*)calloc(c, sizeof(bool));
+    int* stack = (int*)malloc(c * sizeof(int));
+    if (!visited || !stack) {
+        fprintf(stderr, "Error: Memory allocation failed for reachability search\n");
+        free(visited);
+        free(stack);
+        return false;
+    }
+
+    bool found = false;
+    int top = 0;
+    stack[top++] = source;
+    visited[source] = true;
+    while (top > 0 && !found) {
+        int u = stack[--top];
+        for (int a = index->dag_offsets[u]; a < index->dag_offsets[u + 1]; a++) {
+            int w = index->dag_targets[a];
+            if (visited[w]) continue;
+            visited[w] = true;
+            if (w == target) {
+                found = true;
+                break;
+            }
+            if (component_query(index, w, target) != REACH_NO) stack[top++] = w;
+        }
+    }
+
+    free(visited);
+    free(stack);
+    return found;
+}
+
+int reach_index_num_components(const Graph* graph) {
+    const struct ReachIndex* index = current_index(graph);
+    return index ? index->num_components : -1;
+}
+
+int reach_index_component(const Graph* graph, int vertex) {
+    if (!graph_is_valid_vertex(graph, vertex)) return -1;
+    const struct ReachIndex* index = current_index(graph);
+    return index ? index->component[vertex] : -1;
+}
+
+size_t reach_index_memory_usage(const Graph* graph) {
+    const struct ReachIndex* index = graph ? graph->reach_index : NULL;
+    if (!index) return 0;
+    size_t bytes = sizeof(*index);
+    if (index->component) {
+        size_t c = index->num_components;
+        bytes += (size_t)index->num_vertices * sizeof(int) + (c + 1) * sizeof(int) +
+                 (size_t)index->dag_offsets[c] * sizeof(int) +
+                 2 * (size_t)index->num_traversals * c * sizeof(int);
+    }
+    return bytes;
+}
@@ -0,0 +1,141 @@
+#include "search_workspace.h"
+#include "graph_view.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+SearchWorkspace* search_workspace_create(int num_vertices) {
+    SearchWorkspace* workspace = (SearchWorkspace*)calloc(1, sizeof(SearchWorkspace));
+    if (!workspace) {
+        fprintf(stderr, "Error: Memory allocation failed for search workspace\n");
+        return NULL;
+    }
+
+    workspace->heap = min_heap_create(1024);
+    if (!workspace->heap || !search_workspace_reserve(workspace, num_vertices)) {
+        search_workspace_destroy(workspace);
+        return NULL;
+    }
+    return workspace;
+}
+
+void search_workspace_destroy(SearchWorkspace* workspace) {
+    if (!workspace) return;
+    free(workspace->dist);
+    free(workspace->parent);
+    free(workspace->seen);
+    free(workspace->closed);
+    free(workspace->queue);
+    free(workspace->path);
+    min_heap_destroy(workspace->heap);
+    free(workspace);
+}
+
+bool search_workspace_reserve(SearchWorkspace* workspace, int num_vertices) {
+    if (!workspace || num_vertices < 0) return false;
+    if (num_vertices <= workspace->capacity) return true;
+
+    double* dist = (double*)realloc(workspace->dist, num_vertices * sizeof(double));
+    if (dist) workspace->dist = dist;
+    int* parent = (int*)realloc(workspace->parent, num_vertices * sizeof(int));
+    if (parent) workspace->parent = parent;
+    unsigned int* seen = (unsigned int*)realloc(workspace->seen, num_vertices * sizeof(unsigned int));
+    if (seen) workspace->seen = seen;
+    unsigned int* closed = (unsigned int*)realloc(workspace->closed, num_vertices * sizeof(unsigned int));
+    if (closed) workspace->closed = closed;
+    int* queue = (int*)realloc(workspace->queue, num_vertices * sizeof(int));
+    if (queue) workspace->queue = queue;
+    int* path = (int*)realloc(workspace->path, num_vertices * sizeof(int));
+    if (path) workspace->path = path;
+
+    if (!dist || !parent || !seen || !closed || !queue || !path) {
+        fprintf(stderr, "Error: Memory allocation failed for search workspace\n");
+        return false;
+    }
+
+    // New entries must not match any live generation
+    memset(seen + workspace->capacity, 0, (num_vertices - workspace->capacity) * sizeof(unsigned int));
+    memset(closed + workspace->capacity, 0, (num_vertices - workspace->capacity) * sizeof(unsigned int));
+    workspace->capacity = num_vertices;
+    return true;
+}
+
+void search_workspace_begin(SearchWorkspace* workspace) {
+    if (workspace->generation == UINT_MAX) {
+        // Wrapped: stale stamps could alias the new generation, so clear once
+        memset(workspace->seen, 0, workspace->capacity * sizeof(unsigned int));
+        memset(workspace->closed, 0, workspace->capacity * sizeof(unsigned int));
+        workspace->generation = 0;
+    }
+    workspace->generation++;
+    workspace->path_length = 0;
+    workspace->status = SEARCH_COMPLETED;
+    min_heap_clear(workspace->heap);
+    memset(&workspace->stats, 0, sizeof(SearchStats));
+}
+
+// Copy the parent chain ending at end into workspace->path
+static void build_path(SearchWorkspace* workspace, int end) {
+    int count = 0;
+    for (int v = end; v != -1; v = workspace->parent[v]) {
+        count++;
+    }
+    int index = count;
+    for (int v = end; v != -1; v = workspace->parent[v]) {
+        workspace->path[--index] = v;
+    }
+    workspace->path_length = count;
+}
+
+bool search_workspace_find_path_limited(SearchWorkspace* workspace, const Graph* graph,
+                                        int start, int end, WorkspaceAlgorithm algorithm,
+                                        const SearchLimits* limits, double* distance) {
+    if (!workspace || !graph_is_valid_vertex(graph, start) || !graph_is_valid_vertex(graph, end)) {
+        return false;
+    }
+    if (!search_workspace_reserve(workspace, graph->num_vertices)) {
+        workspace->status = SEARCH_OUT_OF_MEMORY;
+        return false;
+    }
+    if (graph_path_ruled_out(graph, start, end)) {
+        search_workspace_begin(workspace);
+        return false;  // Proven unreachable by the graph's index
+    }
+
+    long long start_ns = graph_clock_ns();
+    search_workspace_begin(workspace);
+
+    // The same kernels as the one-shot searches, on this workspace's arrays
+    GraphView view = graph_view_from_graph(graph);
+    bool found;
+    if (algorithm == WORKSPACE_BFS) {
+        found = graph_view_breadth_first_workspace(&view, start, end, limits, workspace);
+    } else {
+        GraphViewSearchOptions options;
+        graph_view_search_options_init(&options);
+        options.limits = limits;
+        if (algorithm == WORKSPACE_ASTAR) {
+            options.heuristic = view.heuristic;  // NULL without coordinates
+            options.heuristic_data = view.data;
+        }
+        found = graph_view_best_first_workspace(&view, start, end, &options, workspace);
+    }
+
+    long long reconstruct_ns = graph_clock_ns();
+    if (found) {
+        *distance = workspace->dist[end];
+        build_path(workspace, end);
+    }
+    long long end_ns = graph_clock_ns();
+
+    workspace->stats.search_ns = reconstruct_ns - start_ns;
+    workspace->stats.reconstruct_ns = end_ns - reconstruct_ns;
+    return found;
+}
+
+bool search_workspace_find_path(SearchWorkspace* workspace, const Graph* graph,
+                                int start, int end, WorkspaceAlgorithm algorithm,
+                                double* distance) {
+    return search_workspace_find_path_limited(workspace, graph, start, end, algorithm, NULL, distance);
+}
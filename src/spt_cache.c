@@ -0,0 +1,303 @@
+#include "spt_cache.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+
+static bool spt_reserve(ShortestPathTree* tree, int num_vertices) {
+    if (num_vertices <= tree->capacity) return true;
+
+    double* dist = (double*)realloc(tree->dist, num_vertices * sizeof(double));
+    if (dist) tree->dist = dist;
+    int* parent = (int*)realloc(tree->parent, num_vertices * sizeof(int));
+    if (parent) tree->parent = parent;
+    bool* settled = (bool*)realloc(tree->settled, num_vertices * sizeof(bool));
+    if (settled) tree->settled = settled;
+
+    if (!dist || !parent || !settled) {
+        fprintf(stderr, "Error: Memory allocation failed for shortest path tree\n");
+        return false;
+    }
+    tree->capacity = num_vertices;
+    return true;
+}
+
+bool spt_reset(ShortestPathTree* tree, const Graph* graph, int source) {
+    if (!tree || !graph_is_valid_vertex(graph, source)) {
+        fprintf(stderr, "Error: Invalid source vertex\n");
+        return false;
+    }
+
+    long long start_ns = graph_clock_ns();
+    int n = graph->num_vertices;
+    if (!spt_reserve(tree, n)) return false;
+
+    for (int i = 0; i < n; i++) {
+        tree->dist[i] = DBL_MAX;
+        tree->parent[i] = -1;
+    }
+    memset(tree->settled, 0, n * sizeof(bool));
+    min_heap_clear(tree->frontier);
+
+    tree->source = source;
+    tree->graph_version = graph->version;
+    tree->num_settled = 0;
+    tree->dist[source] = 0.0;
+    if (!min_heap_push(tree->frontier, source, 0.0)) {
+        tree->graph_version = 0;
+        return false;
+    }
+
+    memset(&tree->stats, 0, sizeof(SearchStats));
+    tree->stats.heap_pushes = 1;
+    tree->stats.peak_queue_size = 1;
+    tree->stats.bytes_allocated = tree->capacity * (sizeof(double) + sizeof(int) + sizeof(bool)) +
+                                  tree->frontier->capacity * sizeof(HeapNode);
+    tree->stats.init_ns = graph_clock_ns() - start_ns;
+    return true;
+}
+
+ShortestPathTree* spt_create(const Graph* graph, int source) {
+    ShortestPathTree* tree = (ShortestPathTree*)calloc(1, sizeof(ShortestPathTree));
+    if (!tree) {
+        fprintf(stderr, "Error: Memory allocation failed for shortest path tree\n");
+        return NULL;
+    }
+    tree->frontier = min_heap_create(1024);
+    if (!tree->frontier || !spt_reset(tree, graph, source)) {
+        spt_destroy(tree);
+        return NULL;
+    }
+    return tree;
+}
+
+void spt_destroy(ShortestPathTree* tree) {
+    if (!tree) return;
+    free(tree->dist);
+    free(tree->parent);
+    free(tree->settled);
+    min_heap_destroy(tree->frontier);
+    free(tree);
+}
+
+// Restart the tree if it was grown on another graph state. Returns false
+// when it cannot be used (e.g. the source vertex no longer exists).
+static bool spt_revalidate(ShortestPathTree* tree, const Graph* graph, bool* restarted) {
+    *restarted = false;
+    if (tree->graph_version == graph->version) {
+        return true;
+    }
+    *restarted = true;
+    return spt_reset(tree, graph, tree->source);
+}
+
+// Resume the Dijkstra loop until target is settled. A failed push would leave
+// a vertex out of the frontier, so the tree is dropped (restarted on next use)
+// and false returned.
+static bool spt_expand(ShortestPathTree* tree, const Graph* graph, int target) {
+    SearchStats* stats = &tree->stats;
+    MinHeap* frontier = tree->frontier;
+
+    while (!tree->settled[target] && !min_heap_is_empty(frontier)) {
+        int u = min_heap_pop(frontier).vertex;
+        stats->heap_pops++;
+        if (tree->settled[u]) continue;
+        tree->settled[u] = true;
+        tree->num_settled++;
+        stats->vertices_settled++;
+
+        double dist_u = tree->dist[u];
+        for (Edge* edge = graph->adj_list[u]; edge; edge = edge->next) {
+            int v = edge->dest;
+            stats->edges_relaxed++;
+            if (!tree->settled[v] && dist_u + edge->weight < tree->dist[v]) {
+                tree->dist[v] = dist_u + edge->weight;
+                tree->parent[v] = u;
+                if (!min_heap_push(frontier, v, tree->dist[v])) {
+                    tree->graph_version = 0;
+                    return false;
+                }
+                stats->heap_pushes++;
+            }
+        }
+        if (frontier->size > stats->peak_queue_size) stats->peak_queue_size = frontier->size;
+    }
+    return true;
+}
+
+bool spt_settle(ShortestPathTree* tree, const Graph* graph, int target) {
+    bool restarted;
+    if (!tree || !graph_is_valid_vertex(graph, target) || !spt_revalidate(tree, graph, &restarted)) {
+        return false;
+    }
+    return spt_expand(tree, graph, target) && tree->settled[target];
+}
+
+PathResult* spt_find_path(ShortestPathTree* tree, const Graph* graph, int target) {
+    PathResult* result = path_result_create();
+    if (!result) return NULL;
+
+    result->algorithm = "Dijkstra (resumable)";
+    result->suboptimality_bound = 1.0;
+
+    if (!tree || !graph_is_valid_vertex(graph, target)) {
+        fprintf(stderr, "Error: Invalid start or end vertex\n");
+        return result;
+    }
+
+    long long start_ns = graph_clock_ns();
+    bool restarted;
+    if (!spt_revalidate(tree, graph, &restarted)) {
+        return result;
+    }
+    SearchStats before = tree->stats;
+
+    long long search_ns = graph_clock_ns();
+    bool expanded = spt_expand(tree, graph, target);
+    long long reconstruct_ns = graph_clock_ns();
+
+    if (!expanded) {
+        result->status = SEARCH_OUT_OF_MEMORY;
+    } else if (tree->settled[target]) {
+        result->path = path_reconstruct(tree->parent, tree->source, target, &result->path_length);
+        result->found = (result->path != NULL);
+        result->total_weight = tree->dist[target];
+    }
+    long long end_ns = graph_clock_ns();
+
+    // Report the work of this call only
+    SearchStats* stats = &result->stats;
+    stats->vertices_settled = tree->stats.vertices_settled - before.vertices_settled;
+    stats->edges_relaxed = tree->stats.edges_relaxed - before.edges_relaxed;
+    stats->heap_pushes = tree->stats.heap_pushes - before.heap_pushes;
+    stats->heap_pops = tree->stats.heap_pops - before.heap_pops;
+    stats->peak_queue_size = tree->stats.peak_queue_size;
+    stats->bytes_allocated = restarted ? tree->stats.bytes_allocated : 0;
+    stats->init_ns = search_ns - start_ns;
+    stats->search_ns = reconstruct_ns - search_ns;
+    stats->reconstruct_ns = end_ns - reconstruct_ns;
+    result->time_ms = (end_ns - start_ns) / 1e6;
+    return result;
+}
+
+struct SptCache {
+    ShortestPathTree** trees;
+    long long* last_used;            // LRU ticks, parallel to trees
+    int num_trees;
+    int max_trees;
+    long long tick;
+    SptCacheStats stats;
+};
+
+SptCache* spt_cache_create(int max_trees) {
+    if (max_trees <= 0) {
+        fprintf(stderr, "Error: SPT cache needs room for at least one tree\n");
+        return NULL;
+    }
+    SptCache* cache = (SptCache*)calloc(1, sizeof(SptCache));
+    if (!cache) {
+        fprintf(stderr, "Error: Memory allocation failed for SPT cache\n");
+        return NULL;
+    }
+    cache->trees = (ShortestPathTree**)calloc(max_trees, sizeof(ShortestPathTree*));
+    cache->last_used = (long long*)calloc(max_trees, sizeof(long long));
+    if (!cache->trees || !cache->last_used) {
+        fprintf(stderr, "Error: Memory allocation failed for SPT cache\n");
+        spt_cache_destroy(cache);
+        return NULL;
+    }
+    cache->max_trees = max_trees;
+    return cache;
+}
+
+void spt_cache_destroy(SptCache* cache) {
+    if (!cache) return;
+    for (int i = 0; i < cache->num_trees; i++) {
+        spt_destroy(cache->trees[i]);
+    }
+    free(cache->trees);
+    free(cache->last_used);
+    free(cache);
+}
+
+// Tree for source: cached, new, or the least recently used one restarted
+static ShortestPathTree* spt_cache_tree(SptCache* cache, const Graph* graph, int source) {
+    if (!cache || !graph_is_valid_vertex(graph, source)) {
+        fprintf(stderr, "Error: Invalid source vertex\n");
+        return NULL;
+    }
+
+    int lru = 0;
+    for (int i = 0; i < cache->num_trees; i++) {
+        if (cache->trees[i]->source == source) {
+            // A tree grown on another graph state restarts, which is a miss
+            cache->last_used[i] = ++cache->tick;
+            if (cache->trees[i]->graph_version == graph->version) {
+                cache->stats.tree_hits++;
+            } else {
+                cache->stats.tree_misses++;
+            }
+            return cache->trees[i];
+        }
+        if (cache->last_used[i] < cache->last_used[lru]) lru = i;
+    }
+
+    cache->stats.tree_misses++;
+    if (cache->num_trees < cache->max_trees) {
+        ShortestPathTree* tree = spt_create(graph, source);
+        if (!tree) return NULL;
+        cache->trees[cache->num_trees] = tree;
+        cache->last_used[cache->num_trees++] = ++cache->tick;
+        return tree;
+    }
+
+    // Reuse the evicted tree's arrays
+    cache->stats.evictions++;
+    if (!spt_reset(cache->trees[lru], graph, source)) return NULL;
+    cache->last_used[lru] = ++cache->tick;
+    return cache->trees[lru];
+}
+
+PathResult* spt_cache_find_path(SptCache* cache, const Graph* graph, int start, int end) {
+    if (!graph_is_valid_vertex(graph, end)) {
+        PathResult* result = path_result_create();
+        if (result) result->algorithm = "Dijkstra (resumable)";
+        fprintf(stderr, "Error: Invalid start or end vertex\n");
+        return result;
+    }
+
+    long long hits = cache ? cache->stats.tree_hits : 0;
+    ShortestPathTree* tree = spt_cache_tree(cache, graph, start);
+    if (tree && cache->stats.tree_hits > hits && tree->graph_version == graph->version &&
+        tree->settled[end]) {
+        cache->stats.settled_hits++;
+    }
+    return spt_find_path(tree, graph, end);
+}
+
+bool spt_cache_distances(SptCache* cache, const Graph* graph, int source,
+                         const int* targets, int num_targets, double* distances) {
+    if (!targets || !distances || num_targets < 0) return false;
+    ShortestPathTree* tree = spt_cache_tree(cache, graph, source);
+    if (!tree) return false;
+
+    for (int i = 0; i < num_targets; i++) {
+        if (spt_settle(tree, graph, targets[i])) {
+            distances[i] = tree->dist[targets[i]];
+        } else if (tree->graph_version != graph->version) {
+            return false;  // Dropped after running out of memory
+        } else {
+            distances[i] = DBL_MAX;
+        }
+    }
+    return true;
+}
+
+void spt_cache_get_stats(const SptCache* cache, SptCacheStats* stats) {
+    if (!stats) return;
+    if (!cache) {
+        memset(stats, 0, sizeof(SptCacheStats));
+        return;
+    }
+    *stats = cache->stats;
+}
@@ -0,0 +1,230 @@
+#include "union_find.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+UnionFind* union_find_create(int count) {
+    if (count < 0) return NULL;
+
+    UnionFind* uf = (UnionFind*)calloc(1, sizeof(UnionFind));
+    if (!uf) {
+        fprintf(stderr, "Error: Memory allocation failed for union-find\n");
+        return NULL;
+    }
+    if (!union_find_grow(uf, count)) {
+        union_find_destroy(uf);
+        return NULL;
+    }
+    return uf;
+}
+
+void union_find_destroy(UnionFind* uf) {
+    if (!uf) return;
+    free(uf->parent);
+    free(uf->rank);
+    free(uf->size);
+    free(uf);
+}
+
+bool union_find_grow(UnionFind* uf, int count) {
+    if (!uf) return false;
+    if (count <= uf->count) return true;
+
+    int capacity = count > 0 ? count : 1;
+    int* parent = (int*)realloc(uf->parent, capacity * sizeof(int));
+    if (parent) uf->parent = parent;
+    int* rank = (int*)realloc(uf->rank, capacity * sizeof(int));
+    if (rank) uf->rank = rank;
+    int* size = (int*)realloc(uf->size, capacity * sizeof(int));
+    if (size) uf->size = size;
+    if (!parent || !rank || !size) {
+        fprintf(stderr, "Error: Memory allocation failed for union-find\n");
+        return false;
+    }
+
+    for (int i = uf->count; i < count; i++) {
+        uf->parent[i] = i;
+        uf->rank[i] = 0;
+        uf->size[i] = 1;
+    }
+    uf->num_sets += count - uf->count;
+    uf->count = count;
+    return true;
+}
+
+void union_find_reset(UnionFind* uf) {
+    if (!uf) return;
+    for (int i = 0; i < uf->count; i++) {
+        uf->parent[i] = i;
+        uf->rank[i] = 0;
+        uf->size[i] = 1;
+    }
+    uf->num_sets = uf->count;
+}
+
+int union_find_find(UnionFind* uf, int x) {
+    int root = x;
+    while (uf->parent[root] != root) {
+        root = uf->parent[root];
+    }
+    while (uf->parent[x] != root) {
+        int next = uf->parent[x];
+        uf->parent[x] = root;
+        x = next;
+    }
+    return root;
+}
+
+int union_find_root(const UnionFind* uf, int x) {
+    while (uf->parent[x] != x) {
+        x = uf->parent[x];
+    }
+    return x;
+}
+
+bool union_find_unite(UnionFind* uf, int a, int b) {
+    a = union_find_find(uf, a);
+    b = union_find_find(uf, b);
+    if (a == b) return false;
+
+    if (uf->rank[a] < uf->rank[b]) {
+        int temp = a;
+        a = b;
+        b = temp;
+    }
+    uf->parent[b] = a;
+    uf->size[a] += uf->size[b];
+    if (uf->rank[a] == uf->rank[b]) uf->rank[a]++;
+    uf->num_sets--;
+    return true;
+}
+
+struct GraphComponents {
+    pthread_mutex_t lock;           // Serialises lazy rebuilds
+    atomic_ullong version;          // Graph version the sets describe (0: stale)
+    UnionFind* uf;
+};
+
+GraphComponents* graph_components_create(int num_vertices, unsigned long long version) {
+    GraphComponents* components = (GraphComponents*)malloc(sizeof(GraphComponents));
+    if (!components) {
+        fprintf(stderr, "Error: Memory allocation failed for graph components\n");
+        return NULL;
+    }
+    components->uf = union_find_create(num_vertices);
+    if (!components->uf) {
+        free(components);
+        return NULL;
+    }
+    pthread_mutex_init(&components->lock, NULL);
+    atomic_init(&components->version, version);
+    return components;
+}
+
+void graph_components_destroy(GraphComponents* components) {
+    if (!components) return;
+    union_find_destroy(components->uf);
+    pthread_mutex_destroy(&components->lock);
+    free(components);
+}
+
+void graph_components_note_edge(Graph* graph, int src, int dest, unsigned long long previous_version) {
+    GraphComponents* components = graph->components;
+    if (!components || atomic_load_explicit(&components->version, memory_order_relaxed) != previous_version) {
+        return;
+    }
+    union_find_unite(components->uf, src, dest);
+    atomic_store_explicit(&components->version, graph->version, memory_order_release);
+}
+
+void graph_components_note_vertex(Graph* graph, unsigned long long previous_version) {
+    GraphComponents* components = graph->components;
+    if (!components || atomic_load_explicit(&components->version, memory_order_relaxed) != previous_version) {
+        return;
+    }
+    if (union_find_grow(components->uf, graph->num_vertices)) {
+        atomic_store_explicit(&components->version, graph->version, memory_order_release);
+    }
+}
+
+void graph_components_note_unchanged(Graph* graph, unsigned long long previous_version) {
+    GraphComponents* components = graph->components;
+    if (!components || atomic_load_explicit(&components->version, memory_order_relaxed) != previous_version) {
+        return;
+    }
+    atomic_store_explicit(&components->version, graph->version, memory_order_release);
+}
+
+// Sets for the current graph, rebuilt first if a change made them stale
+static const UnionFind* current_sets(const Graph* graph) {
+    GraphComponents* components = graph ? graph->components : NULL;
+    if (!components) return NULL;
+
+    if (atomic_load_explicit(&components->version, memory_order_acquire) == graph->version) {
+        return components->uf;
+    }
+
+    pthread_mutex_lock(&components->lock);
+    bool ok = true;
+    if (atomic_load_explicit(&components->version, memory_order_relaxed) != graph->version) {
+        UnionFind* uf = components->uf;
+        if (uf->count > graph->num_vertices) {
+            uf->count = graph->num_vertices;
+        }
+        ok = union_find_grow(uf, graph->num_vertices);
+        if (ok) {
+            union_find_reset(uf);
+            for (int v = 0; v < graph->num_vertices; v++) {
+                for (Edge* edge = graph->adj_list[v]; edge; edge = edge->next) {
+                    union_find_unite(uf, v, edge->dest);
+                }
+            }
+            // Flatten so concurrent readers find roots in one step
+            for (int v = 0; v < uf->count; v++) {
+                union_find_find(uf, v);
+            }
+            atomic_store_explicit(&components->version, graph->version, memory_order_release);
+        }
+    }
+    pthread_mutex_unlock(&components->lock);
+    return ok ? components->uf : NULL;
+}
+
+bool graph_components_warm(const Graph* graph) {
+    return !graph || !graph->components || current_sets(graph) != NULL;
+}
+
+bool graph_components_current(const Graph* graph) {
+    GraphComponents* components = graph ? graph->components : NULL;
+    return components &&
+           atomic_load_explicit(&components->version, memory_order_acquire) == graph->version;
+}
+
+int graph_num_components(const Graph* graph) {
+    const UnionFind* uf = current_sets(graph);
+    return uf ? uf->num_sets : -1;
+}
+
+int graph_component_size(const Graph* graph, int vertex) {
+    if (!graph_is_valid_vertex(graph, vertex)) return -1;
+    const UnionFind* uf = current_sets(graph);
+    return uf ? uf->size[union_find_root(uf, vertex)] : -1;
+}
+
+int graph_component_id(const Graph* graph, int vertex) {
+    if (!graph_is_valid_vertex(graph, vertex)) return -1;
+    const UnionFind* uf = current_sets(graph);
+    return uf ? union_find_root(uf, vertex) : -1;
+}
+
+int graph_components_connected(const Graph* graph, int u, int v) {
+    if (!graph_is_valid_vertex(graph, u) || !graph_is_valid_vertex(graph, v)) return -1;
+    const UnionFind* uf = current_sets(graph);
+    if (!uf) return -1;
+    return union_find_root(uf, u) == union_find_root(uf, v) ? 1 : 0;
+}
+
+bool graph_same_component(const Graph* graph, int u, int v) {
+    return graph_components_connected(graph, u, v) == 1;
+}
@@ -1,14 +1,45 @@
+#define _POSIX_C_SOURCE 200809L
 #include <stdio.h>
 #include <stdlib.h>
 #include <assert.h>
 #include <stdbool.h>
 #include <math.h>
+#include <string.h>
+#include <limits.h>
+#include <float.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <unistd.h>
 #include "graph.h"
 #include "bfs.h"
 #include "dfs.h"
 #include "dijkstra.h"
 #include "astar.h"
 #include "bellman_ford.h"
+#include "compressed_graph.h"
+#include "float_graph.h"
+#include "graph_builder.h"
+#include "graph_parser.h"
+#include "graph_formats.h"
+#include "graph_generators.h"
+#include "search_workspace.h"
+#include "query_server.h"
+#include "graph_snapshot.h"
+#include "path_cache.h"
+#include "spt_cache.h"
+#include "distance_table.h"
+#include "jps.h"
+#include "grid_graph.h"
+#include "implicit_search.h"
+#include "reach_index.h"
+#include "union_find.h"
+#include "parallel_components.h"
+#include "parallel.h"
+#include "hub_labels.h"
+#include "cch.h"
+#include "crp.h"
+#include "arc_flags.h"
+#include "dynamic_sssp.h"
 
 #define TEST_PASSED printf(" ")
 #define TEST_FAILED printf(" ")
@@ -540,6 +571,2618 @@ void test_coordinates(void) {
     printf("Coordinate functions test passed\n");
 }
 
+// Test compressed adjacency against the linked-list graph
+void test_compressed_graph(void) {
+    printf("Testing compressed graph... ");
+
+    // 20x20 weighted grid with a few long-range edges
+    int side = 20;
+    Graph* graph = graph_create(side * side, true, false);
+    for (int r = 0; r < side; r++) {
+        for (int c = 0; c < side; c++) {
+            int v = r * side + c;
+            if (c + 1 < side) graph_add_edge(graph, v, v + 1, 1.0 + (v % 7));
+            if (r + 1 < side) graph_add_edge(graph, v, v + side, 2.0 + (v % 5));
+        }
+    }
+    graph_add_edge(graph, 0, side * side - 1, 500.0);
+    graph_add_edge(graph, 5, 390, 3.5);
+    for (int k = 0; k < 40; k++) {
+        graph_add_edge(graph, 200, (k * 37) % 400, 1.0 + k);  // Long list with mixed gaps
+    }
+
+    CompressedGraph* exact = compressed_graph_create(graph, COMPRESSED_WEIGHTS_EXACT);
+    CompressedGraph* quantized = compressed_graph_create(graph, COMPRESSED_WEIGHTS_QUANTIZED);
+    assert(exact != NULL && quantized != NULL);
+    assert(exact->num_arcs == 2 * graph->num_edges);
+    assert(compressed_graph_memory_usage(quantized) < graph_memory_usage(graph) / 4);
+    // Few distinct weights: exact mode stores 16-bit dictionary codes, not doubles
+    assert(exact->weight_values != NULL && exact->weights == NULL);
+    assert(compressed_graph_memory_usage(exact) < graph_memory_usage(graph) / 4);
+
+    // Decoded lists are sorted and match the original adjacency
+    int dests[64];
+    double weights[64];
+    int degree = compressed_graph_neighbors(exact, 5, dests, weights);
+    assert(degree == 4);
+    for (int k = 1; k < degree; k++) {
+        assert(dests[k - 1] <= dests[k]);
+    }
+    assert(dests[degree - 1] == 390 && weights[degree - 1] == 3.5);
+
+    int expected = 0;
+    for (Edge* edge = graph->adj_list[200]; edge; edge = edge->next) {
+        expected++;
+    }
+    degree = compressed_graph_neighbors(exact, 200, dests, weights);
+    assert(degree == expected);
+    for (int k = 1; k < degree; k++) {
+        assert(dests[k - 1] <= dests[k]);
+    }
+
+    int queries[][2] = {{0, 399}, {17, 222}, {390, 5}, {123, 123}};
+    for (int i = 0; i < 4; i++) {
+        int s = queries[i][0];
+        int t = queries[i][1];
+        PathResult* reference = dijkstra_find_path(graph, s, t);
+        PathResult* compressed = compressed_dijkstra_find_path(exact, s, t);
+        PathResult* approx = compressed_dijkstra_find_path(quantized, s, t);
+        PathResult* bfs_ref = bfs_find_path(graph, s, t);
+        PathResult* bfs_comp = compressed_bfs_find_path(exact, s, t);
+
+        assert(compressed->found && approx->found && bfs_comp->found);
+        assert(fabs(compressed->total_weight - reference->total_weight) < 1e-9);
+        assert(fabs(approx->total_weight - reference->total_weight) < 0.01 * compressed->path_length + 1e-9);
+        assert(bfs_comp->path_length == bfs_ref->path_length);
+        assert(compressed->suboptimality_bound == 1.0 && approx->suboptimality_bound == 0.0);
+        assert(bfs_comp->suboptimality_bound == 0.0);  // Fewest edges on a weighted graph
+
+        path_result_destroy(reference);
+        path_result_destroy(compressed);
+        path_result_destroy(approx);
+        path_result_destroy(bfs_ref);
+        path_result_destroy(bfs_comp);
+    }
+
+    compressed_graph_destroy(exact);
+    compressed_graph_destroy(quantized);
+    graph_destroy(graph);
+
+    // Too many distinct weights for 16-bit codes: exact mode falls back to doubles
+    int chain_length = 70000;
+    Graph* chain = graph_create(chain_length, true, true);
+    for (int v = 0; v + 1 < chain_length; v++) {
+        graph_add_edge(chain, v, v + 1, 1.0 + v * 1e-3);
+    }
+    CompressedGraph* wide = compressed_graph_create(chain, COMPRESSED_WEIGHTS_EXACT);
+    assert(wide && wide->weights != NULL && wide->weight_values == NULL);
+    degree = compressed_graph_neighbors(wide, 12345, dests, weights);
+    assert(degree == 1 && dests[0] == 12346 && weights[0] == 1.0 + 12345 * 1e-3);
+    compressed_graph_destroy(wide);
+    graph_destroy(chain);
+
+    TEST_PASSED;
+    printf("Compressed graph test passed\n");
+}
+
+// Test float32 and uint16 weight storage against the double path
+void test_float_weights(void) {
+    printf("Testing reduced-precision weights... ");
+
+    Graph* graph = graph_create(5, true, true);
+    graph_add_edge(graph, 0, 1, 4.0);
+    graph_add_edge(graph, 0, 2, 1.0);
+    graph_add_edge(graph, 2, 1, 2.0);
+    graph_add_edge(graph, 1, 3, 1.0);
+    graph_add_edge(graph, 2, 3, 5.0);
+    graph_add_edge(graph, 3, 4, 3.0);
+    for (int i = 0; i < 5; i++) {
+        graph_set_coordinates(graph, i, i * 0.5, 0.0);
+    }
+
+    FloatGraph* f32 = float_graph_create(graph, FLOAT_WEIGHTS_F32);
+    FloatGraph* u16 = float_graph_create(graph, FLOAT_WEIGHTS_U16);
+    assert(f32 != NULL && u16 != NULL);
+    assert(u16->weight_scale == 1.0f);  // Small integers are stored exactly
+
+    PathResult* result = float_dijkstra_find_path(f32, 0, 4);
+    assert(result->found == true);
+    assert(result->total_weight == 7.0);  // 0->2->1->3->4
+    path_result_destroy(result);
+
+    result = float_astar_find_path(u16, 0, 4, FLOAT_HEURISTIC_EUCLIDEAN);
+    assert(result->found == true);
+    assert(result->total_weight == 7.0);
+    path_result_destroy(result);
+
+    result = float_dijkstra_find_path(u16, 4, 0);
+    assert(result->found == false);
+    assert(result->status == SEARCH_COMPLETED);  // Unreachable, not out of memory
+    path_result_destroy(result);
+
+    WeightAccuracyReport report;
+    assert(float_graph_accuracy_report(graph, u16, 50, 42, &report) == true);
+    assert(report.num_queries == 50);
+    assert(report.found_mismatches == 0);
+    assert(report.max_abs_error == 0.0);
+
+    // Fractional weights go through a uniform step and stay close
+    graph_add_edge(graph, 4, 0, 0.123456);
+    FloatGraph* scaled = float_graph_create(graph, FLOAT_WEIGHTS_U16);
+    assert(scaled->weight_scale < 1.0f);
+    assert(float_graph_accuracy_report(graph, scaled, 50, 7, &report) == true);
+    assert(report.found_mismatches == 0);
+    assert(report.max_rel_error < 1e-3);
+
+    // Weights equal to the Euclidean length can round below it; the heuristic
+    // is scaled down so A* still matches Dijkstra on the stored weights
+    Graph* line = graph_create(40, true, true);
+    for (int i = 0; i < 40; i++) {
+        graph_set_coordinates(line, i, i * 0.37, (i % 3) * 0.11);
+    }
+    for (int i = 0; i + 1 < 40; i++) {
+        double dx = 0.37;
+        double dy = ((i + 1) % 3 - i % 3) * 0.11;
+        graph_add_edge(line, i, i + 1, sqrt(dx * dx + dy * dy));
+        if (i + 2 < 40) graph_add_edge(line, i, i + 2, 2.5);
+    }
+    graph_add_edge(line, 0, 39, 100.0);
+    FloatGraph* rounded = float_graph_create(line, FLOAT_WEIGHTS_U16);
+    assert(rounded->euclidean_scale > 0.9f && rounded->euclidean_scale <= 1.0f);
+    PathResult* exact = float_dijkstra_find_path(rounded, 0, 39);
+    result = float_astar_find_path(rounded, 0, 39, FLOAT_HEURISTIC_EUCLIDEAN);
+    assert(strcmp(result->algorithm, "A* (uint16 weights, Euclidean)") == 0);
+    assert(result->found && result->total_weight == exact->total_weight);
+    path_result_destroy(result);
+    path_result_destroy(exact);
+    float_graph_destroy(rounded);
+    graph_destroy(line);
+
+    float_graph_destroy(f32);
+    float_graph_destroy(u16);
+    float_graph_destroy(scaled);
+    graph_destroy(graph);
+    TEST_PASSED;
+    printf("Reduced-precision weights test passed\n");
+}
+
+// Test parallel bulk construction from an edge array
+void test_bulk_build(void) {
+    printf("Testing bulk graph construction... ");
+
+    EdgeInput edges[] = {
+        {0, 1, 4.0}, {0, 2, 1.0}, {2, 1, 2.0}, {1, 3, 1.0},
+        {2, 3, 5.0}, {0, 1, 3.0}, {3, 3, 1.0}
+    };
+    size_t num_edges = sizeof(edges) / sizeof(edges[0]);
+
+    GraphBuildOptions options;
+    graph_build_options_init(&options);
+    options.num_threads = 3;
+    options.deduplicate = true;
+
+    // Undirected with duplicate 0-1 and a self-loop
+    Graph* graph = graph_build_from_edges(5, true, false, edges, num_edges, &options);
+    assert(graph != NULL);
+    assert(graph->num_edges == 6);  // The 0-1 duplicate is merged
+    assert(graph->adj_list[0]->dest == 1 && graph->adj_list[0]->weight == 3.0);
+    assert(graph->adj_list[4] == NULL);
+
+    PathResult* result = dijkstra_find_path(graph, 3, 0);
+    assert(result->found == true);
+    assert(result->total_weight == 4.0);  // 3->1->0 or 3->1->2->0
+    path_result_destroy(result);
+
+    // Pooled edges can still be removed and mixed with regular insertions
+    assert(graph_remove_edge(graph, 1, 2) == true);
+    assert(graph_add_edge(graph, 3, 4, 1.0) == true);
+    assert(graph_remove_vertex(graph, 0) == true);
+    graph_destroy(graph);
+
+    // Directed build matches graph_add_edge for every query
+    int side = 12;
+    int n = side * side;
+    EdgeInput* grid = (EdgeInput*)malloc(4 * n * sizeof(EdgeInput));
+    Graph* reference = graph_create(n, true, true);
+    size_t count = 0;
+    for (int v = 0; v < n; v++) {
+        int right = (v % side + 1 < side) ? v + 1 : -1;
+        int down = (v + side < n) ? v + side : -1;
+        if (right >= 0) {
+            grid[count++] = (EdgeInput){v, right, 1.0 + v % 3};
+            grid[count++] = (EdgeInput){right, v, 2.0};
+        }
+        if (down >= 0) {
+            grid[count++] = (EdgeInput){v, down, 1.5};
+            grid[count++] = (EdgeInput){down, v, 1.0 + v % 4};
+        }
+    }
+    for (size_t i = 0; i < count; i++) {
+        graph_add_edge(reference, grid[i].src, grid[i].dest, grid[i].weight);
+    }
+    options.deduplicate = false;
+    options.sort_neighbors = true;
+    Graph* built = graph_build_from_edges(n, true, true, grid, count, &options);
+    assert(built != NULL);
+    assert(built->num_edges == reference->num_edges);
+    for (int t = 0; t < n; t += 7) {
+        PathResult* a = dijkstra_find_path(reference, 0, t);
+        PathResult* b = dijkstra_find_path(built, 0, t);
+        assert(a->found == b->found && a->total_weight == b->total_weight);
+        path_result_destroy(a);
+        path_result_destroy(b);
+    }
+
+    // Without sorting, a multi-threaded build keeps every list in input order
+    int fan = 500;
+    EdgeInput* star = (EdgeInput*)malloc(fan * sizeof(EdgeInput));
+    for (int i = 0; i < fan; i++) {
+        star[i] = (EdgeInput){0, (i * 37) % (fan - 1) + 1, (double)i};
+    }
+    options.num_threads = 4;
+    options.sort_neighbors = false;
+    Graph* ordered = graph_build_from_edges(fan, true, false, star, fan, &options);
+    assert(ordered != NULL);
+    int position = 0;
+    for (Edge* e = ordered->adj_list[0]; e; e = e->next, position++) {
+        assert(e->dest == star[position].dest && e->weight == (double)position);
+    }
+    assert(position == fan);
+    graph_destroy(ordered);
+    free(star);
+
+    // Out-of-range endpoints are rejected
+    EdgeInput bad = {0, 99, 1.0};
+    assert(graph_build_from_edges(3, true, true, &bad, 1, NULL) == NULL);
+
+    free(grid);
+    graph_destroy(reference);
+    graph_destroy(built);
+    TEST_PASSED;
+    printf("Bulk graph construction test passed\n");
+}
+
+// Test the text parser on valid input, error lines and the parallel path
+void test_graph_parser(void) {
+    printf("Testing graph file parser... ");
+
+    const char* text =
+        "5\n"
+        "y\n"
+        "n\n"
+        "4\n"
+        "0 1 2.5\n"
+        "1 2 1e-1\r\n"
+        "  2 3 -0.75\n"
+        "3 4 10\n"
+        "y\n"
+        "0 0\n1 0\n2 0\n3 0\n4 0\n"
+        "0\n"
+        "4\n";
+    GraphFileInfo info;
+    GraphParseError error;
+    Graph* graph = graph_parse_buffer(text, strlen(text), NULL, &info, &error);
+    assert(graph != NULL);
+    assert(graph->num_vertices == 5 && graph->num_edges == 4);
+    assert(graph->is_weighted == true && graph->is_directed == false);
+    assert(info.has_coordinates == true && graph_has_coordinates(graph));
+    assert(info.has_query == true && info.start == 0 && info.end == 4);
+    PathResult* result = dijkstra_find_path(graph, 0, 4);
+    assert(result->found && fabs(result->total_weight - 11.85) < 1e-12);
+    path_result_destroy(result);
+    graph_destroy(graph);
+
+    // Blank and comment lines, several edges per line and glued comments
+    const char* loose =
+        "4\ny\ny\n4\n"
+        "0 1 1.5 1 2 2.0\n"
+        "\n"
+        "# c\n"
+        "2 3 1.5#c\n"
+        "3 0 4\n"
+        "0\n3\n";
+    graph = graph_parse_buffer(loose, strlen(loose), NULL, &info, &error);
+    assert(graph != NULL && graph->num_edges == 4);
+    assert(info.has_query && info.start == 0 && info.end == 3);
+    result = dijkstra_find_path(graph, 0, 3);
+    assert(result->found && result->total_weight == 5.0);
+    path_result_destroy(result);
+    graph_destroy(graph);
+    const char* too_many = "3\nn\ny\n1\n0 1 1 2\n";
+    assert(graph_parse_buffer(too_many, strlen(too_many), NULL, NULL, &error) == NULL);
+    assert(error.line == 5);
+
+    // Unweighted lines: pairs, or one triple; 6 values could be either
+    const char* pairs = "4\nn\ny\n3\n0 1 1 2\n2 3 9\n";
+    graph = graph_parse_buffer(pairs, strlen(pairs), NULL, NULL, &error);
+    assert(graph != NULL && graph->num_edges == 3);
+    assert(graph->adj_list[2]->dest == 3 && graph->adj_list[2]->weight == 1.0);
+    graph_destroy(graph);
+    const char* ambiguous = "4\nn\ny\n2\n0 1 5 1 2 7\n";
+    assert(graph_parse_buffer(ambiguous, strlen(ambiguous), NULL, NULL, &error) == NULL);
+    assert(error.line == 5);
+
+    // Errors carry the offending line
+    const char* bad_vertex = "3\nn\ny\n2\n0 1\n1 7\n";
+    assert(graph_parse_buffer(bad_vertex, strlen(bad_vertex), NULL, NULL, &error) == NULL);
+    assert(error.line == 6);
+    const char* missing_weight = "3\ny\ny\n2\n0 1 1.0\n1 2\n";
+    assert(graph_parse_buffer(missing_weight, strlen(missing_weight), NULL, NULL, &error) == NULL);
+    assert(error.line == 6);
+    const char* short_file = "3\nn\nn\n3\n0 1\n";
+    assert(graph_parse_buffer(short_file, strlen(short_file), NULL, NULL, &error) == NULL);
+    assert(error.line == 6);
+
+    // Number scanner agrees with strtod
+    const char* numbers[] = {"0", "-3.25", "1e10", "123456789.123456789", "4.9e-324", "0.1", "7E+2"};
+    for (int i = 0; i < 7; i++) {
+        double value = 0.0;
+        const char* end = numbers[i] + strlen(numbers[i]);
+        assert(graph_scan_double(numbers[i], end, &value) == end);
+        assert(value == strtod(numbers[i], NULL));
+    }
+    long long integer;
+    assert(graph_scan_int("12x", "12x" + 3, &integer) == NULL);
+
+    // Shipped examples load and carry their queries
+    graph = graph_parse_file("examples/grid_graph.txt", NULL, &info, &error);
+    assert(graph != NULL && info.has_query && info.start == 0 && info.end == 8);
+    graph_destroy(graph);
+    graph = graph_parse_file("examples/disconnected.txt", NULL, &info, &error);
+    assert(graph != NULL && info.has_query && !info.has_coordinates && info.end == 3);
+    graph_destroy(graph);
+
+    // Chunked multithreaded parse matches a single-threaded one
+    int n = 1000;
+    int m = 150000;
+    size_t capacity = (size_t)m * 24 + 64;
+    char* big = (char*)malloc(capacity);
+    size_t length = (size_t)sprintf(big, "%d\ny\ny\n%d\n", n, m);
+    for (int i = 0; i < m; i++) {
+        length += (size_t)sprintf(big + length, "%d %d %d.%d%s", i % n, (i * 7 + 3) % n, i % 13, i % 10,
+                                  (i % 5 == 0) ? " " : (i % 7 == 0) ? "\n\n# gap\n" : "\n");
+    }
+    length += (size_t)sprintf(big + length, "\n0\n1\n");
+    GraphParseOptions options;
+    graph_parse_options_init(&options);
+    options.num_threads = 4;
+    options.sort_neighbors = true;
+    Graph* parallel = graph_parse_buffer(big, length, &options, &info, &error);
+    assert(info.has_query && info.start == 0 && info.end == 1);
+    options.num_threads = 1;
+    Graph* serial = graph_parse_buffer(big, length, &options, NULL, &error);
+    assert(parallel != NULL && serial != NULL);
+    assert(parallel->num_edges == m && serial->num_edges == m);
+    for (int v = 0; v < n; v++) {
+        Edge* a = parallel->adj_list[v];
+        Edge* b = serial->adj_list[v];
+        while (a && b) {
+            assert(a->dest == b->dest && a->weight == b->weight);
+            a = a->next;
+            b = b->next;
+        }
+        assert(a == NULL && b == NULL);
+    }
+    graph_destroy(parallel);
+    graph_destroy(serial);
+
+    // An error deep in a later chunk still reports its exact line
+    char* broken = strstr(big + length / 2, "\n") + 1;
+    while (*broken < '0' || *broken > '9') broken = strchr(broken, '\n') + 1;
+    broken[0] = 'x';
+    int expected_line = 1;
+    for (char* p = big; p < broken; p++) {
+        if (*p == '\n') expected_line++;
+    }
+    options.num_threads = 4;
+    assert(graph_parse_buffer(big, length, &options, NULL, &error) == NULL);
+    assert(error.line == expected_line);
+    free(big);
+
+    TEST_PASSED;
+    printf("Graph file parser test passed\n");
+}
+
+// Test the DIMACS, Matrix Market and METIS loaders
+void test_graph_formats(void) {
+    printf("Testing benchmark graph formats... ");
+
+    GraphParseError error;
+    assert(graph_format_detect("roads/USA-road-d.NY.gr", NULL, 0) == GRAPH_FORMAT_DIMACS);
+    assert(graph_format_detect("bcsstk01.MTX", NULL, 0) == GRAPH_FORMAT_MATRIX_MARKET);
+    assert(graph_format_detect("4elt.graph", NULL, 0) == GRAPH_FORMAT_METIS);
+    assert(graph_format_detect("examples/cycle.txt", NULL, 0) == GRAPH_FORMAT_TEXT);
+    assert(graph_format_detect("dump", "%%MatrixMarket matrix", 21) == GRAPH_FORMAT_MATRIX_MARKET);
+    assert(graph_format_detect("dump", "c road\np sp 1 0\n", 16) == GRAPH_FORMAT_DIMACS);
+
+    // DIMACS: 1-based ids, directed and weighted
+    const char* gr =
+        "c sample\n"
+        "p sp 3 3\n"
+        "a 1 2 5\n"
+        "a 2 3 4\r\n"
+        "a 1 3 12\n";
+    Graph* graph = graph_parse_dimacs(gr, strlen(gr), NULL, &error);
+    assert(graph != NULL);
+    assert(graph->num_vertices == 3 && graph->num_edges == 3);
+    assert(graph->is_directed && graph->is_weighted);
+    PathResult* result = dijkstra_find_path(graph, 0, 2);
+    assert(result->found && result->total_weight == 9.0);
+    path_result_destroy(result);
+
+    const char* co = "c coords\np aux sp co 3\nv 1 0 0\nv 2 3 4\nv 3 6 8\n";
+    assert(graph_parse_dimacs_coordinates(graph, co, strlen(co), &error));
+    assert(graph_has_coordinates(graph) && graph_euclidean_distance(graph, 0, 1) == 5.0);
+    const char* co_wrong = "p aux sp co 4\n";
+    assert(!graph_parse_dimacs_coordinates(graph, co_wrong, strlen(co_wrong), &error));
+    assert(error.line == 1);
+    graph_destroy(graph);
+
+    const char* gr_bad = "p sp 3 2\na 1 2 1\na 1 4 1\n";
+    assert(graph_parse_dimacs(gr_bad, strlen(gr_bad), NULL, &error) == NULL && error.line == 3);
+    const char* gr_short = "p sp 3 3\na 1 2 1\n";
+    assert(graph_parse_dimacs(gr_short, strlen(gr_short), NULL, &error) == NULL);
+
+    // Matrix Market: symmetric real matrix becomes an undirected weighted graph
+    const char* mtx =
+        "%%MatrixMarket matrix coordinate real symmetric\n"
+        "% lower triangle only\n"
+        "4 4 4\n"
+        "2 1 1.5\n"
+        "3 2 2.5\n"
+        "4 3 0.5\n"
+        "4 4 9\n";
+    graph = graph_parse_matrix_market(mtx, strlen(mtx), NULL, &error);
+    assert(graph != NULL);
+    assert(graph->num_vertices == 4 && graph->num_edges == 4);
+    assert(!graph->is_directed && graph->is_weighted);
+    result = dijkstra_find_path(graph, 3, 0);
+    assert(result->found && result->total_weight == 4.5);
+    path_result_destroy(result);
+    graph_destroy(graph);
+
+    const char* pattern = "%%MatrixMarket matrix coordinate pattern general\n3 3 2\n1 2\n2 3\n";
+    graph = graph_parse_matrix_market(pattern, strlen(pattern), NULL, &error);
+    assert(graph != NULL && graph->is_directed && !graph->is_weighted);
+    result = bfs_find_path(graph, 0, 2);
+    assert(result->found && result->path_length == 3);
+    path_result_destroy(result);
+    result = bfs_find_path(graph, 2, 0);
+    assert(!result->found);
+    path_result_destroy(result);
+    graph_destroy(graph);
+
+    const char* dense = "%%MatrixMarket matrix array real general\n2 2\n1\n2\n3\n4\n";
+    assert(graph_parse_matrix_market(dense, strlen(dense), NULL, &error) == NULL);
+    const char* mtx_bad = "%%MatrixMarket matrix coordinate integer general\n2 2 2\n1 2 3\n2 5 1\n";
+    assert(graph_parse_matrix_market(mtx_bad, strlen(mtx_bad), NULL, &error) == NULL);
+    assert(error.line == 4);
+
+    // METIS: each edge listed at both endpoints, blank line = isolated vertex
+    const char* metis =
+        "% weighted path plus an isolated vertex\n"
+        "4 2 001\n"
+        "2 3\n"
+        "1 3 3 4\n"
+        "2 4\n"
+        "\n";
+    graph = graph_parse_metis(metis, strlen(metis), NULL, &error);
+    assert(graph != NULL);
+    assert(graph->num_vertices == 4 && graph->num_edges == 2);
+    assert(!graph->is_directed && graph->is_weighted);
+    result = dijkstra_find_path(graph, 0, 2);
+    assert(result->found && result->total_weight == 7.0);
+    path_result_destroy(result);
+    result = dijkstra_find_path(graph, 0, 3);
+    assert(!result->found);
+    path_result_destroy(result);
+    graph_destroy(graph);
+
+    const char* metis_vw = "3 2 011 2\n1 1 2 5\n2 2 1 5 3 1\n3 3 2 1\n";
+    graph = graph_parse_metis(metis_vw, strlen(metis_vw), NULL, &error);
+    assert(graph != NULL && graph->num_edges == 2);
+    graph_destroy(graph);
+    const char* asymmetric = "3 2\n2\n1 3\n\n";
+    assert(graph_parse_metis(asymmetric, strlen(asymmetric), NULL, &error) == NULL);
+
+    // The shipped DIMACS sample picks up its .co file
+    GraphFileInfo info;
+    graph = graph_load_file("examples/road_sample.gr", NULL, &info, &error);
+    assert(graph != NULL && graph->num_vertices == 6 && graph->num_edges == 14);
+    assert(info.has_coordinates && graph_has_coordinates(graph));
+    assert(graph->coords[3].x == 12.0 && graph->coords[3].y == 13.0);
+    result = astar_euclidean(graph, 0, 4);
+    assert(result->found && result->total_weight == 20.0);
+    path_result_destroy(result);
+    graph_destroy(graph);
+    graph = graph_load_file("examples/linear.txt", NULL, &info, &error);
+    assert(graph != NULL);
+    graph_destroy(graph);
+
+    TEST_PASSED;
+    printf("Benchmark graph formats test passed\n");
+}
+
+// Test per-query search counters and phase timings
+void test_search_stats(void) {
+    printf("Testing search statistics... ");
+
+    // Path 0 - 1 - 2 - 3
+    Graph* graph = graph_create(4, true, false);
+    graph_add_edge(graph, 0, 1, 1.0);
+    graph_add_edge(graph, 1, 2, 1.0);
+    graph_add_edge(graph, 2, 3, 1.0);
+
+    PathResult* result = bfs_find_path(graph, 0, 3);
+    assert(result->found);
+    assert(result->stats.vertices_settled == 4);
+    assert(result->stats.edges_relaxed == 5);
+    assert(result->stats.heap_pushes == 4 && result->stats.heap_pops == 4);
+    assert(result->stats.peak_queue_size == 1);
+    assert(result->stats.bytes_allocated > 0);
+    path_result_destroy(result);
+
+    result = dijkstra_find_path(graph, 0, 3);
+    assert(result->found);
+    assert(result->stats.vertices_settled == 4);
+    assert(result->stats.edges_relaxed == 5);
+    assert(result->stats.heap_pushes == 4 && result->stats.heap_pops == 4);
+    assert(result->stats.init_ns >= 0 && result->stats.search_ns >= 0 &&
+           result->stats.reconstruct_ns >= 0);
+    long long phases = result->stats.init_ns + result->stats.search_ns + result->stats.reconstruct_ns;
+    assert(fabs(result->time_ms - phases / 1e6) < 1e-9);
+    path_result_destroy(result);
+
+    result = bellman_ford_find_path(graph, 0, 3);
+    assert(result->found && result->stats.vertices_settled == 4);
+    assert(result->stats.edges_relaxed % 6 == 0 && result->stats.edges_relaxed > 0);
+    path_result_destroy(result);
+
+    // Invalid queries leave the counters zeroed
+    result = dfs_find_path(graph, 0, 9);
+    assert(!result->found && result->stats.vertices_settled == 0 && result->time_ms == 0.0);
+    path_result_destroy(result);
+
+    // The monotonic clock never goes backwards
+    long long before = graph_clock_ns();
+    assert(graph_clock_ns() >= before);
+
+    graph_destroy(graph);
+    TEST_PASSED;
+    printf("Search statistics test passed\n");
+}
+
+// Test the synthetic graph generators
+void test_graph_generators(void) {
+    printf("Testing synthetic graph generators... ");
+
+    // Grid: exact edge count, lattice coordinates
+    Graph* grid = graph_generate_grid(20, 10, 5.0, 7);
+    assert(grid != NULL && grid->num_vertices == 200);
+    assert(grid->num_edges == 2 * 20 * 10 - 20 - 10);
+    assert(graph_has_coordinates(grid) && grid->coords[45].x == 5.0 && grid->coords[45].y == 2.0);
+    for (int v = 0; v < grid->num_vertices; v++) {
+        for (Edge* e = grid->adj_list[v]; e; e = e->next) {
+            assert(e->weight >= 1.0 && e->weight <= 5.0);
+        }
+    }
+
+    // Same seed, same graph
+    Graph* again = graph_generate_grid(20, 10, 5.0, 7);
+    for (int v = 0; v < grid->num_vertices; v++) {
+        Edge* a = grid->adj_list[v];
+        Edge* b = again->adj_list[v];
+        while (a && b) {
+            assert(a->dest == b->dest && a->weight == b->weight);
+            a = a->next;
+            b = b->next;
+        }
+        assert(a == NULL && b == NULL);
+    }
+    graph_destroy(again);
+    graph_destroy(grid);
+
+    // Geometric: average degree close to the request, weights are distances
+    Graph* geo = graph_generate_geometric(5000, 8.0, 11);
+    assert(geo != NULL && geo->num_vertices == 5000);
+    double avg_degree = 2.0 * geo->num_edges / geo->num_vertices;
+    assert(avg_degree > 6.0 && avg_degree < 9.0);
+    Edge* first = geo->adj_list[0];
+    assert(first && fabs(first->weight - graph_euclidean_distance(geo, 0, first->dest)) < 1e-9);
+    graph_destroy(geo);
+
+    // R-MAT: power-of-two vertex count, skewed degrees, no duplicate arcs
+    Graph* rmat = graph_generate_rmat(10, 8, 0.57, 0.19, 0.19, 3);
+    assert(rmat != NULL && rmat->num_vertices == 1024 && rmat->is_directed);
+    assert(rmat->num_edges > 0 && rmat->num_edges <= 8 * 1024);
+    int max_degree = 0;
+    for (int v = 0; v < rmat->num_vertices; v++) {
+        int degree = 0;
+        for (Edge* e = rmat->adj_list[v]; e; e = e->next) {
+            assert(!e->next || e->next->dest > e->dest);
+            degree++;
+        }
+        if (degree > max_degree) max_degree = degree;
+    }
+    assert(max_degree > 4 * rmat->num_edges / rmat->num_vertices);
+    assert(graph_generate_rmat(10, 8, 0.6, 0.3, 0.3, 3) == NULL);
+    graph_destroy(rmat);
+
+    // Road: connected, and Euclidean A* stays exact
+    Graph* road = graph_generate_road(40, 30, 5);
+    assert(road != NULL && road->num_vertices == 1200);
+    assert(road->num_edges < 2 * 40 * 30 - 40 - 30);
+    PathResult* reach = bfs_find_path(road, 0, road->num_vertices - 1);
+    assert(reach->found);
+    path_result_destroy(reach);
+    for (int q = 0; q < 20; q++) {
+        int s = (q * 97) % road->num_vertices;
+        int t = (q * 389 + 17) % road->num_vertices;
+        PathResult* exact = dijkstra_find_path(road, s, t);
+        PathResult* guided = astar_euclidean(road, s, t);
+        assert(exact->found && guided->found);
+        assert(fabs(exact->total_weight - guided->total_weight) < 1e-9);
+        assert(guided->stats.vertices_settled <= exact->stats.vertices_settled);
+        path_result_destroy(exact);
+        path_result_destroy(guided);
+    }
+    graph_destroy(road);
+
+    TEST_PASSED;
+    printf("Synthetic graph generators test passed\n");
+}
+
+// Test reusable search workspaces
+void test_search_workspace(void) {
+    printf("Testing search workspace reuse... ");
+
+    Graph* road = graph_generate_road(30, 20, 9);
+    SearchWorkspace* workspace = search_workspace_create(road->num_vertices);
+    assert(workspace != NULL);
+
+    // Many queries through one workspace match fresh searches
+    for (int q = 0; q < 50; q++) {
+        int s = (q * 131) % road->num_vertices;
+        int t = (q * 257 + 3) % road->num_vertices;
+        PathResult* expected = dijkstra_find_path(road, s, t);
+        double distance = 0.0;
+        assert(search_workspace_find_path(workspace, road, s, t, WORKSPACE_DIJKSTRA, &distance));
+        assert(fabs(distance - expected->total_weight) < 1e-9);
+        assert(workspace->path[0] == s && workspace->path[workspace->path_length - 1] == t);
+
+        assert(search_workspace_find_path(workspace, road, s, t, WORKSPACE_ASTAR, &distance));
+        assert(fabs(distance - expected->total_weight) < 1e-9);
+
+        PathResult* hops = bfs_find_path(road, s, t);
+        assert(search_workspace_find_path(workspace, road, s, t, WORKSPACE_BFS, &distance));
+        assert(workspace->path_length == hops->path_length);
+        path_result_destroy(hops);
+        path_result_destroy(expected);
+    }
+
+    // Generation wrap clears stale stamps
+    workspace->generation = UINT_MAX;
+    double distance = 0.0;
+    assert(search_workspace_find_path(workspace, road, 0, road->num_vertices - 1, WORKSPACE_DIJKSTRA, &distance));
+    assert(workspace->generation == 1);
+
+    // Unreachable and invalid queries
+    Graph* split = graph_create(3, true, false);
+    graph_add_edge(split, 0, 1, 2.0);
+    assert(!search_workspace_find_path(workspace, split, 0, 2, WORKSPACE_DIJKSTRA, &distance));
+    assert(!search_workspace_find_path(workspace, split, 0, 7, WORKSPACE_BFS, &distance));
+    graph_destroy(split);
+
+    search_workspace_destroy(workspace);
+    graph_destroy(road);
+
+    TEST_PASSED;
+    printf("Search workspace reuse test passed\n");
+}
+
+static void* run_query_server(void* arg) {
+    query_server_run((QueryServer*)arg);
+    return NULL;
+}
+
+// Test the Unix socket query server end to end
+void test_query_server(void) {
+    printf("Testing query server... ");
+
+    Graph* road = graph_generate_road(20, 20, 4);
+    GraphSnapshotManager* graphs = graph_snapshot_manager_create(road, 4);
+    char socket_path[64];
+    snprintf(socket_path, sizeof(socket_path), "/tmp/graphpath_test_%ld.sock", (long)getpid());
+
+    QueryServerConfig config;
+    query_server_config_init(&config, socket_path);
+    config.num_threads = 3;
+    config.max_pending = 8;    // Small queue exercises backpressure
+    config.allow_remote_shutdown = true;
+    QueryServer* server = query_server_create(graphs, &config);
+    assert(server != NULL);
+
+    pthread_t thread;
+    assert(pthread_create(&thread, NULL, run_query_server, server) == 0);
+
+    int fd = query_client_connect(socket_path);
+    assert(fd >= 0);
+
+    // Pipeline a batch of requests, then collect responses in any order
+    enum { NUM_QUERIES = 64 };
+    double expected[NUM_QUERIES];
+    bool answered[NUM_QUERIES] = {false};
+    for (int q = 0; q < NUM_QUERIES; q++) {
+        QueryRequest request = {0};
+        request.id = (uint32_t)q;
+        request.op = (q % 2) ? QUERY_OP_PATH : QUERY_OP_DISTANCE;
+        request.algorithm = (q % 3 == 0) ? QUERY_ALGO_ASTAR : QUERY_ALGO_DIJKSTRA;
+        request.start = (q * 37) % road->num_vertices;
+        request.end = (q * 101 + 5) % road->num_vertices;
+        PathResult* result = dijkstra_find_path(road, request.start, request.end);
+        expected[q] = result->total_weight;
+        path_result_destroy(result);
+        assert(query_client_send(fd, &request));
+    }
+
+    int32_t path[400];
+    for (int i = 0; i < NUM_QUERIES; i++) {
+        QueryResponseHeader header;
+        assert(query_client_receive(fd, &header, path, 400));
+        assert(header.id < NUM_QUERIES && !answered[header.id]);
+        answered[header.id] = true;
+        assert(header.status == QUERY_STATUS_OK);
+        assert(fabs(header.distance - expected[header.id]) < 1e-9);
+        assert((header.id % 2) ? header.path_length > 0 : header.path_length == 0);
+    }
+
+    // Ping, bad requests, and a reload without a configured graph file
+    QueryRequest ping = {.id = 500, .op = QUERY_OP_PING};
+    QueryRequest bad = {.id = 501, .op = QUERY_OP_PATH, .start = 0, .end = 99999};
+    QueryRequest reload = {.id = 503, .op = QUERY_OP_RELOAD};
+    assert(query_client_send(fd, &ping) && query_client_send(fd, &bad) && query_client_send(fd, &reload));
+    for (int i = 0; i < 3; i++) {
+        QueryResponseHeader header;
+        assert(query_client_receive(fd, &header, NULL, 0));
+        assert(header.status == (header.id == 500 ? QUERY_STATUS_OK
+                               : header.id == 501 ? QUERY_STATUS_BAD_REQUEST : QUERY_STATUS_REFUSED));
+    }
+
+    // The header carries the full 64-bit snapshot version without padding
+    assert(sizeof(QueryResponseHeader) == 32);
+
+    // Remote shutdown drains and stops the server
+    QueryRequest stop = {.id = 502, .op = QUERY_OP_SHUTDOWN};
+    QueryResponseHeader header;
+    assert(query_client_send(fd, &stop));
+    assert(query_client_receive(fd, &header, NULL, 0) && header.id == 502 && header.version == 1);
+    pthread_join(thread, NULL);
+    close(fd);
+
+    QueryServerStats stats;
+    query_server_get_stats(server, &stats);
+    assert(stats.connections == 1 && stats.requests == NUM_QUERIES + 4 && stats.errors == 1);
+    query_server_destroy(server);
+    assert(access(socket_path, F_OK) != 0);
+    graph_snapshot_manager_destroy(graphs);
+
+    TEST_PASSED;
+    printf("Query server test passed\n");
+}
+
+// Test that a client which pipelines without reading cannot stall the server
+void test_query_server_backpressure(void) {
+    printf("Testing query server with a client that does not read... ");
+
+    Graph* road = graph_generate_road(20, 20, 4);
+    GraphSnapshotManager* graphs = graph_snapshot_manager_create(road, 2);
+    char socket_path[64];
+    snprintf(socket_path, sizeof(socket_path), "/tmp/graphpath_stall_%ld.sock", (long)getpid());
+
+    QueryServerConfig config;
+    query_server_config_init(&config, socket_path);
+    config.num_threads = 2;
+    config.max_pending = 8;
+    QueryServer* server = query_server_create(graphs, &config);
+    assert(server != NULL);
+    pthread_t thread;
+    assert(pthread_create(&thread, NULL, run_query_server, server) == 0);
+
+    // Far more requests than the ring holds, and more answers than the
+    // socket buffers take; none of them is read
+    enum { NUM_STALLED = 3000 };
+    int stalled = query_client_connect(socket_path);
+    assert(stalled >= 0);
+    for (int q = 0; q < NUM_STALLED; q++) {
+        QueryRequest request = {.id = (uint32_t)q, .op = QUERY_OP_PATH,
+                                .start = 0, .end = road->num_vertices - 1};
+        assert(query_client_send(stalled, &request));
+    }
+
+    // Wait until every request was answered into the server's queue
+    QueryServerStats stats;
+    struct timespec delay = {0, 1000000};
+    do {
+        nanosleep(&delay, NULL);
+        query_server_get_stats(server, &stats);
+    } while (stats.requests < NUM_STALLED);
+
+    // Other clients are still served, and the server still stops
+    int fd = query_client_connect(socket_path);
+    assert(fd >= 0);
+    QueryRequest ping = {.id = 7, .op = QUERY_OP_PING};
+    QueryResponseHeader header;
+    assert(query_client_send(fd, &ping));
+    assert(query_client_receive(fd, &header, NULL, 0) && header.id == 7 && header.status == QUERY_STATUS_OK);
+    query_server_stop(server);
+    pthread_join(thread, NULL);
+
+    query_server_get_stats(server, &stats);
+    assert(stats.connections == 2 && stats.errors == 0);
+    close(stalled);
+    close(fd);
+    query_server_destroy(server);
+    graph_snapshot_manager_destroy(graphs);
+
+    TEST_PASSED;
+    printf("Query server backpressure test passed\n");
+}
+
+typedef struct {
+    GraphSnapshotManager* graphs;
+    atomic_int* done;
+    long long reads;
+} SnapshotReaderArgs;
+
+// Each published graph is a path whose last edge weight equals its version
+static void* snapshot_reader(void* arg) {
+    SnapshotReaderArgs* args = (SnapshotReaderArgs*)arg;
+    int reader = graph_snapshot_reader_register(args->graphs);
+    assert(reader >= 0);
+    while (!atomic_load(args->done)) {
+        unsigned long long version = 0;
+        const Graph* graph = graph_snapshot_acquire(args->graphs, reader, &version);
+        int last = graph->num_vertices - 2;
+        assert(graph->adj_list[last] && graph->adj_list[last]->weight == (double)version);
+        graph_snapshot_release(args->graphs, reader);
+        args->reads++;
+    }
+    graph_snapshot_reader_unregister(args->graphs, reader);
+    return NULL;
+}
+
+static Graph* make_versioned_path(int n, unsigned long long version) {
+    Graph* graph = graph_create(n, true, true);
+    for (int v = 0; v + 1 < n; v++) {
+        graph_add_edge(graph, v, v + 1, (v + 2 == n) ? (double)version : 1.0);
+    }
+    return graph;
+}
+
+// Test epoch-based graph snapshots
+void test_graph_snapshot(void) {
+    printf("Testing graph snapshots... ");
+
+    GraphSnapshotManager* graphs = graph_snapshot_manager_create(make_versioned_path(10, 1), 4);
+    assert(graphs != NULL && graph_snapshot_version(graphs) == 1);
+
+    // A pinned reader keeps the old version alive across publishes
+    int reader = graph_snapshot_reader_register(graphs);
+    unsigned long long version = 0;
+    const Graph* pinned = graph_snapshot_acquire(graphs, reader, &version);
+    assert(version == 1);
+    assert(graph_snapshot_publish(graphs, make_versioned_path(20, 2)) == 2);
+    assert(graph_snapshot_reclaim(graphs) == 1);
+    assert(pinned->num_vertices == 10 && pinned->adj_list[8]->weight == 1.0);
+    graph_snapshot_release(graphs, reader);
+    assert(graph_snapshot_reclaim(graphs) == 0);
+
+    // New guards see the new version
+    const Graph* current = graph_snapshot_acquire(graphs, reader, &version);
+    assert(version == 2 && current->num_vertices == 20);
+    graph_snapshot_release(graphs, reader);
+    graph_snapshot_reader_unregister(graphs, reader);
+
+    // Readers never observe a freed or torn graph while a writer keeps swapping
+    enum { NUM_READERS = 3 };
+    atomic_int done = 0;
+    pthread_t threads[NUM_READERS];
+    SnapshotReaderArgs args[NUM_READERS];
+    for (int t = 0; t < NUM_READERS; t++) {
+        args[t] = (SnapshotReaderArgs){graphs, &done, 0};
+        assert(pthread_create(&threads[t], NULL, snapshot_reader, &args[t]) == 0);
+    }
+    for (unsigned long long v = 3; v <= 200; v++) {
+        assert(graph_snapshot_publish(graphs, make_versioned_path(10 + (int)(v % 7), v)) == v);
+    }
+    atomic_store(&done, 1);
+    for (int t = 0; t < NUM_READERS; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    graph_snapshot_synchronize(graphs);
+    assert(graph_snapshot_reclaim(graphs) == 0 && graph_snapshot_version(graphs) == 200);
+
+    // Reload from a file; a bad file leaves the current version in place
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/graphpath_snapshot_%ld.txt", (long)getpid());
+    FILE* file = fopen(path, "w");
+    fprintf(file, "3\ny\ny\n2\n0 1 4\n1 2 5\n");
+    fclose(file);
+    GraphParseError error;
+    assert(graph_snapshot_reload_file(graphs, path, &error) == 201);
+    assert(graph_snapshot_reload_file(graphs, "/nonexistent/graph.txt", &error) == 0);
+    assert(graph_snapshot_version(graphs) == 201);
+    remove(path);
+
+    graph_snapshot_manager_destroy(graphs);
+
+    TEST_PASSED;
+    printf("Graph snapshots test passed\n");
+}
+
+// Test reloading the served graph while the server keeps answering
+void test_query_server_reload(void) {
+    printf("Testing query server reload... ");
+
+    char graph_path[64];
+    char socket_path[64];
+    snprintf(graph_path, sizeof(graph_path), "/tmp/graphpath_reload_%ld.txt", (long)getpid());
+    snprintf(socket_path, sizeof(socket_path), "/tmp/graphpath_reload_%ld.sock", (long)getpid());
+    FILE* file = fopen(graph_path, "w");
+    fprintf(file, "3\ny\nn\n2\n0 1 4\n1 2 5\n");
+    fclose(file);
+
+    GraphParseError error;
+    Graph* graph = graph_load_file(graph_path, NULL, NULL, &error);
+    GraphSnapshotManager* graphs = graph_snapshot_manager_create(graph, 2);
+    QueryServerConfig config;
+    query_server_config_init(&config, socket_path);
+    config.num_threads = 2;
+    config.allow_remote_shutdown = true;
+    config.graph_path = graph_path;
+    QueryServer* server = query_server_create(graphs, &config);
+    assert(server != NULL);
+    pthread_t thread;
+    assert(pthread_create(&thread, NULL, run_query_server, server) == 0);
+
+    int fd = query_client_connect(socket_path);
+    QueryRequest query = {.id = 1, .op = QUERY_OP_DISTANCE, .start = 0, .end = 2};
+    QueryResponseHeader header;
+    assert(query_client_send(fd, &query) && query_client_receive(fd, &header, NULL, 0));
+    assert(header.version == 1 && header.distance == 9.0);
+
+    // New weights on disk, then reload; queries keep being answered meanwhile
+    file = fopen(graph_path, "w");
+    fprintf(file, "3\ny\nn\n2\n0 1 1\n1 2 1\n");
+    fclose(file);
+    QueryRequest reload = {.id = 2, .op = QUERY_OP_RELOAD};
+    assert(query_client_send(fd, &reload) && query_client_receive(fd, &header, NULL, 0));
+    assert(header.status == QUERY_STATUS_OK);
+
+    for (int attempt = 0; attempt < 10000; attempt++) {
+        assert(query_client_send(fd, &query) && query_client_receive(fd, &header, NULL, 0));
+        assert(header.status == QUERY_STATUS_OK);
+        assert(header.version == 1 ? header.distance == 9.0 : header.distance == 2.0);
+        if (header.version == 2) break;
+    }
+    assert(header.version == 2);
+
+    QueryRequest stop = {.id = 3, .op = QUERY_OP_SHUTDOWN};
+    assert(query_client_send(fd, &stop) && query_client_receive(fd, &header, NULL, 0));
+    pthread_join(thread, NULL);
+    close(fd);
+
+    QueryServerStats stats;
+    query_server_get_stats(server, &stats);
+    assert(stats.reloads == 1);
+    query_server_destroy(server);
+    graph_snapshot_manager_destroy(graphs);
+    remove(graph_path);
+
+    TEST_PASSED;
+    printf("Query server reload test passed\n");
+}
+
+typedef struct {
+    PathCache* cache;
+    const Graph* graph;
+} PathCacheWorkerArgs;
+
+static void* path_cache_worker(void* arg) {
+    PathCacheWorkerArgs* args = (PathCacheWorkerArgs*)arg;
+    for (int q = 0; q < 400; q++) {
+        int s = (q % 10) * 7;
+        int t = 99 - (q % 13);
+        PathResult* result = path_cache_find_path(args->cache, args->graph, s, t, dijkstra_find_path);
+        assert(result && result->found);
+        assert(result->path[0] == s && result->path[result->path_length - 1] == t);
+        path_result_destroy(result);
+    }
+    return NULL;
+}
+
+// Test the path result cache
+void test_path_cache(void) {
+    printf("Testing path cache... ");
+
+    Graph* grid = graph_generate_grid(10, 10, 9.0, 21);
+    PathCache* cache = path_cache_create(64);
+    assert(cache != NULL);
+
+    // Miss, then hit with an identical answer and no search work
+    PathResult* first = path_cache_find_path(cache, grid, 0, 99, dijkstra_find_path);
+    PathResult* second = path_cache_find_path(cache, grid, 0, 99, dijkstra_find_path);
+    assert(first->found && second->found);
+    assert(first->total_weight == second->total_weight && first->path_length == second->path_length);
+    assert(memcmp(first->path, second->path, first->path_length * sizeof(int)) == 0);
+    assert(first->stats.vertices_settled > 0 && second->stats.vertices_settled == 0);
+    path_result_destroy(first);
+    path_result_destroy(second);
+
+    // The algorithm is part of the key
+    assert(path_cache_lookup(cache, grid, 0, 99, bfs_find_path) == NULL);
+
+    PathCacheStats stats;
+    path_cache_get_stats(cache, &stats);
+    assert(stats.hits == 1 && stats.misses == 2 && stats.entries == 1);
+
+    // Any modification bumps the version and invalidates the entry
+    unsigned long long version = grid->version;
+    graph_add_edge(grid, 0, 99, 1.0);
+    assert(grid->version != version);
+    PathResult* updated = path_cache_find_path(cache, grid, 0, 99, dijkstra_find_path);
+    assert(updated->total_weight == 1.0);
+    path_result_destroy(updated);
+    path_cache_get_stats(cache, &stats);
+    assert(stats.stale == 1 && stats.entries == 1);
+
+    // Versions are never shared between graphs
+    Graph* other = graph_generate_grid(10, 10, 9.0, 21);
+    assert(other->version != grid->version);
+    assert(path_cache_lookup(cache, other, 0, 99, dijkstra_find_path) == NULL);
+    graph_destroy(other);
+
+    // Bounded: CLOCK keeps frequently hit entries
+    path_cache_clear(cache);
+    for (int q = 0; q < 200; q++) {
+        PathResult* hot = path_cache_find_path(cache, grid, 1, 50, dijkstra_find_path);
+        PathResult* cold = path_cache_find_path(cache, grid, 2, q % 98 + 1, dijkstra_find_path);
+        path_result_destroy(hot);
+        path_result_destroy(cold);
+    }
+    path_cache_get_stats(cache, &stats);
+    assert(stats.entries <= 64 && stats.evictions > 0);
+    PathResult* hot = path_cache_lookup(cache, grid, 1, 50, dijkstra_find_path);
+    assert(hot != NULL);
+    path_result_destroy(hot);
+    path_cache_destroy(cache);
+
+    // Concurrent lookups and inserts on a sharded cache
+    cache = path_cache_create(1024);
+    PathCacheWorkerArgs args = {cache, grid};
+    pthread_t threads[4];
+    for (int t = 0; t < 4; t++) {
+        assert(pthread_create(&threads[t], NULL, path_cache_worker, &args) == 0);
+    }
+    for (int t = 0; t < 4; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    path_cache_get_stats(cache, &stats);
+    assert(stats.hits + stats.misses == 1600 && stats.entries <= 130 && stats.hits >= 1600 - 4 * 130);
+    path_cache_destroy(cache);
+    graph_destroy(grid);
+
+    TEST_PASSED;
+    printf("Path cache test passed\n");
+}
+
+// Test resumable shortest-path trees and their cache
+void test_spt_cache(void) {
+    printf("Testing shortest-path tree cache... ");
+
+    Graph* road = graph_generate_road(30, 30, 13);
+    int n = road->num_vertices;
+    SptCache* cache = spt_cache_create(2);
+    assert(cache != NULL);
+
+    // Same answers as fresh Dijkstra, with far less work on repeats
+    long long fresh_work = 0;
+    long long cached_work = 0;
+    for (int q = 0; q < 40; q++) {
+        int t = (q * 211 + 7) % n;
+        PathResult* expected = dijkstra_find_path(road, 5, t);
+        PathResult* result = spt_cache_find_path(cache, road, 5, t);
+        assert(result->found == expected->found);
+        assert(fabs(result->total_weight - expected->total_weight) < 1e-9);
+        assert(result->path[0] == 5 && result->path[result->path_length - 1] == t);
+        fresh_work += expected->stats.vertices_settled;
+        cached_work += result->stats.vertices_settled;
+        path_result_destroy(expected);
+        path_result_destroy(result);
+    }
+    assert(cached_work <= n && cached_work < fresh_work);
+
+    // A settled target costs no expansion at all
+    PathResult* again = spt_cache_find_path(cache, road, 5, (7 * 211 + 7) % n);
+    assert(again->found && again->stats.vertices_settled == 0);
+    path_result_destroy(again);
+
+    SptCacheStats stats;
+    spt_cache_get_stats(cache, &stats);
+    assert(stats.tree_misses == 1 && stats.tree_hits == 40 && stats.settled_hits >= 1);
+
+    // One-to-many distances
+    int targets[4] = {0, n - 1, 17, 450};
+    double distances[4];
+    assert(spt_cache_distances(cache, road, 0, targets, 4, distances));
+    for (int i = 0; i < 4; i++) {
+        PathResult* expected = dijkstra_find_path(road, 0, targets[i]);
+        assert(fabs(distances[i] - expected->total_weight) < 1e-9);
+        path_result_destroy(expected);
+    }
+
+    // LRU eviction with two trees, and restart after the graph changes
+    PathResult* other = spt_cache_find_path(cache, road, 99, 100);
+    path_result_destroy(other);
+    spt_cache_get_stats(cache, &stats);
+    assert(stats.evictions == 1);
+
+    graph_add_edge(road, 99, 800, 0.5);
+    PathResult* updated = spt_cache_find_path(cache, road, 99, 800);
+    assert(updated->found && updated->total_weight == 0.5 && updated->path_length == 2);
+    path_result_destroy(updated);
+    spt_cache_get_stats(cache, &stats);
+    assert(stats.tree_hits == 40 && stats.tree_misses == 4);  // The restart is a miss
+
+    // Unreachable targets
+    Graph* split = graph_create(4, true, true);
+    graph_add_edge(split, 0, 1, 1.0);
+    int far[2] = {1, 3};
+    double far_distances[2];
+    assert(spt_cache_distances(cache, split, 0, far, 2, far_distances));
+    assert(far_distances[0] == 1.0 && far_distances[1] == DBL_MAX);
+    PathResult* none = spt_cache_find_path(cache, split, 0, 3);
+    assert(!none->found);
+    path_result_destroy(none);
+    graph_destroy(split);
+
+    spt_cache_destroy(cache);
+    graph_destroy(road);
+
+    TEST_PASSED;
+    printf("Shortest-path tree cache test passed\n");
+}
+
+// Test the many-to-many distance table
+void test_distance_table(void) {
+    printf("Testing distance table... ");
+
+    Graph* road = graph_generate_road(25, 25, 17);
+    int sources[6] = {0, 100, 313, 624, 100, 42};
+    int targets[5] = {624, 7, 7, 0, 400};
+    double distances[30];
+    int* paths[30];
+    int path_lengths[30];
+    long long settled = 0;
+
+    DistanceTableOptions options;
+    distance_table_options_init(&options);
+    options.num_threads = 3;
+    options.paths = paths;
+    options.path_lengths = path_lengths;
+    options.vertices_settled = &settled;
+    assert(distance_table_compute(road, sources, 6, targets, 5, distances, &options));
+    assert(settled > 0);
+
+    // Every cell matches a point-to-point search, duplicates included
+    for (int i = 0; i < 6; i++) {
+        for (int j = 0; j < 5; j++) {
+            PathResult* expected = dijkstra_find_path(road, sources[i], targets[j]);
+            assert(fabs(distances[i * 5 + j] - expected->total_weight) < 1e-9);
+            int* path = paths[i * 5 + j];
+            assert(path[0] == sources[i] && path[path_lengths[i * 5 + j] - 1] == targets[j]);
+            double weight = 0.0;
+            for (int k = 0; k + 1 < path_lengths[i * 5 + j]; k++) {
+                for (Edge* e = road->adj_list[path[k]]; e; e = e->next) {
+                    if (e->dest == path[k + 1]) {
+                        weight += e->weight;
+                        break;
+                    }
+                }
+            }
+            assert(fabs(weight - distances[i * 5 + j]) < 1e-9);
+            path_result_destroy(expected);
+        }
+    }
+    distance_table_free_paths(paths, 30);
+
+    // Distances only, single thread, unreachable pairs
+    Graph* split = graph_create(4, true, true);
+    graph_add_edge(split, 0, 1, 2.5);
+    int from[2] = {0, 1};
+    int to[2] = {1, 3};
+    double small[4];
+    assert(distance_table_compute(split, from, 2, to, 2, small, NULL));
+    assert(small[0] == 2.5 && small[1] == DBL_MAX && small[2] == 0.0 && small[3] == DBL_MAX);
+    to[1] = 9;
+    assert(!distance_table_compute(split, from, 2, to, 2, small, NULL));
+    graph_destroy(split);
+    graph_destroy(road);
+
+    TEST_PASSED;
+    printf("Distance table test passed\n");
+}
+
+// Test Jump Point Search on grids
+void test_jump_point_search(void) {
+    printf("Testing jump point search... ");
+
+    // Recognise the example grid and agree with Dijkstra on it
+    Graph* example = graph_create(9, true, false);
+    int grid_edges[12][2] = {{0, 1}, {1, 2}, {0, 3}, {1, 4}, {2, 5}, {3, 4},
+                             {4, 5}, {3, 6}, {4, 7}, {5, 8}, {6, 7}, {7, 8}};
+    for (int i = 0; i < 12; i++) {
+        graph_add_edge(example, grid_edges[i][0], grid_edges[i][1], 1.0);
+    }
+    GridMap* detected = grid_map_from_graph(example);
+    assert(detected && detected->width == 3 && detected->height == 3 && !detected->diagonal);
+    PathResult* jps = jps_find_path(example, 0, 8);
+    assert(jps->found && jps->total_weight == 4.0 && jps->path_length == 5);
+    path_result_destroy(jps);
+    grid_map_destroy(detected);
+
+    // A missing grid edge (a wall between open cells) is not a uniform grid
+    graph_remove_edge(example, 4, 5);
+    assert(grid_map_from_graph(example) == NULL);
+    graph_destroy(example);
+
+    // Random obstacle maps, 4- and 8-connected: same costs as Dijkstra
+    unsigned seed = 12345;
+    for (int trial = 0; trial < 40; trial++) {
+        int width = 5 + trial % 17;
+        int height = 4 + (trial * 7) % 13;
+        GridMap* grid = grid_map_create(width, height, trial % 2 == 1, 1.0 + trial % 3);
+        for (int c = 0; c < width * height; c++) {
+            seed = seed * 1103515245u + 12345u;
+            grid->blocked[c] = ((seed >> 16) % 100) < 25;
+        }
+        Graph* graph = grid_map_to_graph(grid);
+        for (int q = 0; q < 15; q++) {
+            seed = seed * 1103515245u + 12345u;
+            int s = (seed >> 8) % (width * height);
+            int t = (seed >> 20) % (width * height);
+            PathResult* result = jps_grid_find_path(grid, s, t);
+            PathResult* expected = dijkstra_find_path(graph, s, t);
+            bool reachable = !grid->blocked[s] && !grid->blocked[t] && (s == t || expected->found);
+            assert(result->found == reachable && result->status == SEARCH_COMPLETED);
+            if (reachable) {
+                assert(fabs(result->total_weight - expected->total_weight) < 1e-9);
+                assert(result->path[0] == s && result->path[result->path_length - 1] == t);
+                for (int k = 0; k + 1 < result->path_length; k++) {
+                    bool adjacent = false;
+                    for (Edge* e = graph->adj_list[result->path[k]]; e; e = e->next) {
+                        adjacent |= (e->dest == result->path[k + 1]);
+                    }
+                    assert(adjacent);
+                }
+            }
+            path_result_destroy(result);
+            path_result_destroy(expected);
+        }
+        grid_map_destroy(grid);
+        graph_destroy(graph);
+    }
+
+    // Open map: far fewer expansions than A*
+    GridMap* open = grid_map_create(128, 128, false, 1.0);
+    for (int y = 10; y < 118; y++) {
+        grid_map_set_blocked(open, 64, y, true);
+    }
+    Graph* open_graph = grid_map_to_graph(open);
+    GridMap* round_trip = grid_map_from_graph(open_graph);
+    assert(round_trip && round_trip->width == 128 && round_trip->blocked[20 * 128 + 64]);
+    grid_map_destroy(round_trip);
+    PathResult* fast = jps_grid_find_path(open, 0, 128 * 128 - 1);
+    PathResult* slow = astar_manhattan(open_graph, 0, 128 * 128 - 1);
+    assert(fast->found && fast->total_weight == slow->total_weight);
+    assert(fast->path_length == slow->path_length);
+    assert(fast->stats.vertices_settled * 10 < slow->stats.vertices_settled);
+    path_result_destroy(fast);
+    path_result_destroy(slow);
+    graph_destroy(open_graph);
+    grid_map_destroy(open);
+
+    TEST_PASSED;
+    printf("Jump point search test passed\n");
+}
+
+// Test implicit grid graphs and the graph view
+void test_grid_graph(void) {
+    printf("Testing implicit grid graph... ");
+
+    // Random obstacle maps: view searches agree with the explicit graph
+    unsigned seed = 777;
+    for (int trial = 0; trial < 20; trial++) {
+        int width = 6 + trial % 11;
+        int height = 5 + (trial * 5) % 9;
+        bool diagonal = trial % 2 == 1;
+        GridGraph* grid = grid_graph_create(width, height, diagonal);
+        GridMap* map = grid_map_create(width, height, diagonal, 1.0);
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                seed = seed * 1103515245u + 12345u;
+                bool blocked = ((seed >> 16) % 100) < 25;
+                grid_graph_set_blocked(grid, x, y, blocked);
+                grid_map_set_blocked(map, x, y, blocked);
+            }
+        }
+        Graph* graph = grid_map_to_graph(map);
+        GraphView view = grid_graph_view(grid);
+        GraphView adjacency = graph_view_from_graph(graph);
+        assert(view.num_vertices == width * height);
+
+        for (int q = 0; q < 10; q++) {
+            seed = seed * 1103515245u + 12345u;
+            int s = (seed >> 8) % (width * height);
+            int t = (seed >> 20) % (width * height);
+            PathResult* expected = dijkstra_find_path(graph, s, t);
+            PathResult* dijkstra = graph_view_dijkstra(&view, s, t);
+            PathResult* astar = graph_view_astar(&view, s, t);
+            PathResult* bfs = graph_view_bfs(&view, s, t);
+            PathResult* explicit_bfs = bfs_find_path(graph, s, t);
+            PathResult* wrapped = graph_view_astar(&adjacency, s, t);
+            assert(dijkstra->found == expected->found && astar->found == expected->found);
+            assert(bfs->found == expected->found && wrapped->found == expected->found);
+            // Only the grid's heuristic is known to be admissible
+            assert(astar->suboptimality_bound == 1.0 && wrapped->suboptimality_bound == 0.0);
+            if (expected->found) {
+                assert(fabs(dijkstra->total_weight - expected->total_weight) < 1e-9);
+                assert(fabs(astar->total_weight - expected->total_weight) < 1e-9);
+                assert(fabs(wrapped->total_weight - expected->total_weight) < 1e-9);
+                assert(bfs->path_length == explicit_bfs->path_length);
+                assert(astar->stats.vertices_settled <= dijkstra->stats.vertices_settled);
+            }
+            path_result_destroy(expected);
+            path_result_destroy(dijkstra);
+            path_result_destroy(astar);
+            path_result_destroy(bfs);
+            path_result_destroy(explicit_bfs);
+            path_result_destroy(wrapped);
+        }
+        grid_graph_destroy(grid);
+        grid_map_destroy(map);
+        graph_destroy(graph);
+    }
+
+    // Per-cell costs: a cheap detour beats the expensive straight line
+    GridGraph* costly = grid_graph_create(5, 3, false);
+    for (int x = 1; x < 4; x++) {
+        assert(grid_graph_set_cost(costly, x, 1, 10.0));
+    }
+    assert(grid_graph_get_cost(costly, 2, 1) == 10.0 && grid_graph_get_cost(costly, 2, 0) == 1.0);
+    assert(!grid_graph_set_cost(costly, 2, 1, 0.0) && !grid_graph_set_cost(costly, 9, 9, 1.0));
+    GraphView costly_view = grid_graph_view(costly);
+    PathResult* detour = graph_view_astar(&costly_view, 5, 9);
+    assert(detour->found && detour->total_weight == 6.0 && detour->path_length == 7);
+    path_result_destroy(detour);
+    grid_graph_destroy(costly);
+
+    // Out-of-range cells are blocked and searches reject bad vertices
+    GridGraph* small = grid_graph_create(4, 4, true);
+    assert(!grid_graph_is_open(small, -1, 0) && !grid_graph_set_blocked(small, 4, 0, true));
+    assert(grid_graph_create(0, 5, false) == NULL);
+    GraphView small_view = grid_graph_view(small);
+    PathResult* invalid = graph_view_dijkstra(&small_view, 0, 16);
+    assert(!invalid->found);
+    path_result_destroy(invalid);
+    grid_graph_destroy(small);
+
+    // A 2000x2000 grid costs about one bit per cell
+    GridGraph* large = grid_graph_create(2000, 2000, true);
+    assert(grid_graph_memory_usage(large) < 2000 * 2000 / 8 + 1024);
+    for (int y = 0; y < 1990; y++) {
+        grid_graph_set_blocked(large, 1000, y, true);
+    }
+    GraphView large_view = grid_graph_view(large);
+    PathResult* across = graph_view_astar(&large_view, 0, 2000 * 2000 - 1);
+    assert(across->found && across->total_weight > 1999 * sqrt(2.0));
+    path_result_destroy(across);
+    grid_graph_destroy(large);
+
+    TEST_PASSED;
+    printf("Implicit grid graph test passed\n");
+}
+
+// 8-puzzle: tiles 1..8 and blank 0, goal 1 2 3 / 4 5 6 / 7 8 0
+typedef struct {
+    unsigned char tiles[9];
+} PuzzleState;
+
+static void puzzle_successors(const void* state, ImplicitEmitFunc emit, void* sink, void* context) {
+    (void)context;
+    const PuzzleState* puzzle = (const PuzzleState*)state;
+    int blank = 0;
+    while (puzzle->tiles[blank] != 0) blank++;
+    int moves[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+    for (int m = 0; m < 4; m++) {
+        int x = blank % 3 + moves[m][0];
+        int y = blank / 3 + moves[m][1];
+        if (x < 0 || y < 0 || x > 2 || y > 2) continue;
+        PuzzleState next = *puzzle;
+        next.tiles[blank] = next.tiles[y * 3 + x];
+        next.tiles[y * 3 + x] = 0;
+        emit(sink, &next, 1.0);
+    }
+}
+
+static bool puzzle_is_goal(const void* state, void* context) {
+    (void)context;
+    static const unsigned char goal[9] = {1, 2, 3, 4, 5, 6, 7, 8, 0};
+    return memcmp(((const PuzzleState*)state)->tiles, goal, 9) == 0;
+}
+
+static double puzzle_manhattan(const void* state, void* context) {
+    (void)context;
+    const PuzzleState* puzzle = (const PuzzleState*)state;
+    int total = 0;
+    for (int i = 0; i < 9; i++) {
+        int tile = puzzle->tiles[i];
+        if (tile == 0) continue;
+        total += abs(i % 3 - (tile - 1) % 3) + abs(i / 3 - (tile - 1) / 3);
+    }
+    return total;
+}
+
+// Unbounded lattice with a wall at x == 5 for |y| <= 30
+typedef struct {
+    int x;
+    int y;
+} LatticeState;
+
+static void lattice_successors(const void* state, ImplicitEmitFunc emit, void* sink, void* context) {
+    (void)context;
+    const LatticeState* cell = (const LatticeState*)state;
+    int moves[4][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+    for (int m = 0; m < 4; m++) {
+        LatticeState next = {cell->x + moves[m][0], cell->y + moves[m][1]};
+        if (next.x == 5 && abs(next.y) <= 30) continue;
+        emit(sink, &next, 1.0);
+    }
+}
+
+static bool lattice_is_goal(const void* state, void* context) {
+    const LatticeState* cell = (const LatticeState*)state;
+    const LatticeState* goal = (const LatticeState*)context;
+    return cell->x == goal->x && cell->y == goal->y;
+}
+
+static uint64_t lattice_hash(const void* state, void* context) {
+    (void)context;
+    const LatticeState* cell = (const LatticeState*)state;
+    return (uint64_t)(uint32_t)cell->x * 0x9E3779B97F4A7C15ULL ^ (uint32_t)cell->y;
+}
+
+static bool lattice_equals(const void* a, const void* b, void* context) {
+    (void)context;
+    const LatticeState* p = (const LatticeState*)a;
+    const LatticeState* q = (const LatticeState*)b;
+    return p->x == q->x && p->y == q->y;
+}
+
+static double lattice_manhattan(const void* state, void* context) {
+    const LatticeState* cell = (const LatticeState*)state;
+    const LatticeState* goal = (const LatticeState*)context;
+    return abs(cell->x - goal->x) + abs(cell->y - goal->y);
+}
+
+// Test callback-driven search over implicit state spaces
+void test_implicit_search(void) {
+    printf("Testing implicit graph search... ");
+
+    // One of the hardest 8-puzzle instances: 31 moves
+    ImplicitProblem puzzle = {0};
+    puzzle.state_size = sizeof(PuzzleState);
+    puzzle.successors = puzzle_successors;
+    puzzle.is_goal = puzzle_is_goal;
+    puzzle.heuristic = puzzle_manhattan;
+    PuzzleState start = {{8, 6, 7, 2, 5, 4, 3, 0, 1}};
+
+    ImplicitResult* astar = implicit_astar(&puzzle, &start, NULL);
+    ImplicitResult* bfs = implicit_bfs(&puzzle, &start, NULL);
+    assert(astar->found && astar->total_weight == 31.0 && astar->path_length == 32);
+    assert(bfs->found && bfs->total_weight == 31.0 && bfs->path_length == 32);
+    assert(astar->stats.vertices_settled < bfs->stats.vertices_settled);
+    assert(memcmp(astar->states, &start, sizeof(PuzzleState)) == 0);
+    assert(puzzle_is_goal((PuzzleState*)astar->states + 31, NULL));
+    for (int i = 0; i < 31; i++) {
+        // Consecutive states differ by one blank move
+        const PuzzleState* a = (const PuzzleState*)astar->states + i;
+        const PuzzleState* b = (const PuzzleState*)astar->states + i + 1;
+        int differing = 0;
+        for (int k = 0; k < 9; k++) differing += a->tiles[k] != b->tiles[k];
+        assert(differing == 2);
+    }
+
+    // Weighted A*: within the bound, usually with far less work
+    ImplicitSearchOptions options;
+    implicit_search_options_init(&options);
+    options.weight = 2.0;
+    ImplicitResult* weighted = implicit_weighted_astar(&puzzle, &start, &options);
+    assert(weighted->found && weighted->total_weight >= 31.0 && weighted->total_weight <= 62.0);
+    assert(weighted->stats.vertices_settled < astar->stats.vertices_settled);
+    implicit_result_destroy(weighted);
+
+    // A memory cap stops BFS before the state space is exhausted
+    options.weight = 1.0;
+    options.memory_limit = 64 * 1024;
+    ImplicitResult* capped = implicit_bfs(&puzzle, &start, &options);
+    assert(!capped->found && capped->memory_exhausted && capped->states == NULL);
+    assert(capped->stats.bytes_allocated <= 64 * 1024 + 64 * 1024);
+    implicit_result_destroy(capped);
+
+    // Unsolvable permutation: the whole reachable half is explored
+    PuzzleState unsolvable = {{2, 1, 3, 4, 5, 6, 7, 8, 0}};
+    ImplicitResult* none = implicit_astar(&puzzle, &unsolvable, NULL);
+    assert(!none->found && !none->memory_exhausted && none->states_generated == 181440);
+    implicit_result_destroy(none);
+    implicit_result_destroy(astar);
+    implicit_result_destroy(bfs);
+
+    // Custom hash and equality on an unbounded lattice around a wall
+    LatticeState goal = {12, 3};
+    LatticeState origin = {0, 0};
+    ImplicitProblem lattice = {0};
+    lattice.state_size = sizeof(LatticeState);
+    lattice.successors = lattice_successors;
+    lattice.is_goal = lattice_is_goal;
+    lattice.hash = lattice_hash;
+    lattice.equals = lattice_equals;
+    lattice.heuristic = lattice_manhattan;
+    lattice.context = &goal;
+    ImplicitResult* around = implicit_astar(&lattice, &origin, NULL);
+    assert(around->found && around->total_weight == 12 + 31 + 28);
+    implicit_result_destroy(around);
+
+    // Missing callbacks are rejected
+    ImplicitProblem empty = {0};
+    ImplicitResult* invalid = implicit_astar(&empty, &origin, NULL);
+    assert(!invalid->found && !invalid->memory_exhausted);
+    implicit_result_destroy(invalid);
+
+    TEST_PASSED;
+    printf("Implicit graph search test passed\n");
+}
+
+static void count_anytime_solution(const PathResult* result, void* context) {
+    double* last = (double*)context;
+    // Each reported solution is no worse than the previous one
+    assert(result->found && result->total_weight <= last[0] + 1e-9);
+    assert(result->suboptimality_bound <= last[1] + 1e-9);
+    last[0] = result->total_weight;
+    last[1] = result->suboptimality_bound;
+    last[2] += 1.0;
+}
+
+// Test weighted A* and anytime repairing A*
+void test_bounded_suboptimal_astar(void) {
+    printf("Testing weighted and anytime A*... ");
+
+    Graph* graph = graph_generate_geometric(3000, 8.0, 99);
+    unsigned seed = 4242;
+    for (int q = 0; q < 20; q++) {
+        seed = seed * 1103515245u + 12345u;
+        int s = (seed >> 8) % 3000;
+        int t = (seed >> 18) % 3000;
+        PathResult* exact = astar_euclidean(graph, s, t);
+        // Edge weights here are the Euclidean lengths, so the caller may vouch for
+        // the heuristic; the search itself cannot know that
+        PathResult* weighted = astar_weighted(graph, s, t, graph_euclidean_distance, 1.5, true);
+        PathResult* unvouched = astar_weighted(graph, s, t, graph_euclidean_distance, 1.5, false);
+        PathResult* anytime = astar_anytime(graph, s, t, graph_euclidean_distance, NULL);
+        assert(exact->suboptimality_bound == 0.0 && unvouched->suboptimality_bound == 0.0);
+        assert(weighted->suboptimality_bound == 1.5 && anytime->suboptimality_bound == 0.0);
+        assert(weighted->found == exact->found && anytime->found == exact->found);
+        if (exact->found) {
+            assert(weighted->total_weight <= 1.5 * exact->total_weight + 1e-9);
+            assert(weighted->total_weight >= exact->total_weight - 1e-9);
+            // Without a time budget ARA* runs down to weight 1
+            assert(fabs(anytime->total_weight - exact->total_weight) < 1e-9);
+        }
+        path_result_destroy(exact);
+        path_result_destroy(weighted);
+        path_result_destroy(unvouched);
+        path_result_destroy(anytime);
+    }
+
+    // Weighted A* settles fewer vertices on a long query
+    PathResult* exact = astar_euclidean(graph, 0, 2999);
+    PathResult* greedy = astar_weighted(graph, 0, 2999, graph_euclidean_distance, 3.0, true);
+    assert(exact->found && greedy->found);
+    assert(greedy->stats.vertices_settled <= exact->stats.vertices_settled);
+
+    // Solutions improve monotonically and their bounds are honest
+    double last[3] = {DBL_MAX, DBL_MAX, 0.0};
+    AnytimeAStarOptions options;
+    anytime_astar_options_init(&options);
+    options.initial_weight = 5.0;
+    options.weight_step = 1.0;
+    options.admissible = true;
+    options.on_solution = count_anytime_solution;
+    options.context = last;
+    PathResult* anytime = astar_anytime(graph, 0, 2999, graph_euclidean_distance, &options);
+    assert(anytime->found && last[2] >= 1.0 && anytime->suboptimality_bound == 1.0);
+    assert(fabs(anytime->total_weight - exact->total_weight) < 1e-9);
+    path_result_destroy(anytime);
+
+    // The budget also limits the first search
+    options.on_solution = NULL;
+    options.time_budget_ms = 1e-6;
+    anytime = astar_anytime(graph, 0, 2999, graph_euclidean_distance, &options);
+    assert(!anytime->found && anytime->status == SEARCH_TIMED_OUT);
+    path_result_destroy(anytime);
+    path_result_destroy(exact);
+    path_result_destroy(greedy);
+
+    // Invalid weights are rejected; DFS makes no optimality promise
+    PathResult* invalid = astar_weighted(graph, 0, 1, graph_euclidean_distance, 0.5, true);
+    assert(!invalid->found);
+    path_result_destroy(invalid);
+    PathResult* dfs = dfs_find_path(graph, 0, 1);
+    assert(dfs->suboptimality_bound == 0.0);
+    path_result_destroy(dfs);
+
+    // Only exact searches claim a bound of 1
+    PathResult* dijkstra = dijkstra_find_path(graph, 0, 1);
+    PathResult* zero = astar_zero(graph, 0, 1);
+    PathResult* manhattan = astar_manhattan(graph, 0, 1);
+    PathResult* hops = bfs_find_path(graph, 0, 1);
+    assert(dijkstra->suboptimality_bound == 1.0 && zero->suboptimality_bound == 1.0);
+    assert(manhattan->suboptimality_bound == 0.0 && hops->suboptimality_bound == 0.0);
+    path_result_destroy(dijkstra);
+    path_result_destroy(zero);
+    path_result_destroy(manhattan);
+    path_result_destroy(hops);
+
+    graph_destroy(graph);
+    TEST_PASSED;
+    printf("Weighted and anytime A* test passed\n");
+}
+
+static void* cancel_after_delay(void* arg) {
+    struct timespec delay = {0, 20 * 1000000L};
+    nanosleep(&delay, NULL);
+    cancel_token_cancel((CancelToken*)arg);
+    return NULL;
+}
+
+// Test search deadlines and cancellation
+void test_search_limits(void) {
+    printf("Testing search deadlines and cancellation... ");
+
+    // Directed copy of a grid: an undirected graph would reject the isolated
+    // target below through its connected components without searching
+    Graph* grid = graph_generate_grid(300, 300, 10.0, 17);
+    Graph* graph = graph_create(grid->num_vertices, true, true);
+    for (int v = 0; v < grid->num_vertices; v++) {
+        for (Edge* edge = grid->adj_list[v]; edge; edge = edge->next) {
+            graph_add_edge(graph, v, edge->dest, edge->weight);
+        }
+        graph_set_coordinates(graph, v, grid->coords[v].x, grid->coords[v].y);
+    }
+    graph_destroy(grid);
+    int far = graph->num_vertices - 1;
+    // Isolated target: every search would otherwise explore the whole grid
+    assert(graph_add_vertex(graph));
+    int unreachable = graph->num_vertices - 1;
+
+    // An expired deadline stops every search within one check interval
+    SearchLimits expired;
+    search_limits_init(&expired);
+    expired.deadline_ns = graph_clock_ns() - 1;
+    PathResult* limited[5] = {
+        dijkstra_find_path_limited(graph, 0, unreachable, &expired),
+        astar_find_path_limited(graph, 0, unreachable, graph_euclidean_distance, "A*", &expired),
+        bfs_find_path_limited(graph, 0, unreachable, &expired),
+        dfs_find_path_limited(graph, 0, unreachable, &expired),
+        bellman_ford_find_path_limited(graph, 0, unreachable, &expired),
+    };
+    for (int i = 0; i < 5; i++) {
+        assert(limited[i]->status == SEARCH_TIMED_OUT);
+        assert(!limited[i]->found && limited[i]->path == NULL);
+        assert(limited[i]->stats.vertices_settled <= SEARCH_LIMITS_CHECK_INTERVAL ||
+               i == 4);
+        path_result_destroy(limited[i]);
+    }
+
+    // A cancelled token reports cancellation, not "not found"
+    CancelToken* token = cancel_token_create();
+    SearchLimits cancelled;
+    search_limits_init(&cancelled);
+    cancelled.cancel = token;
+    cancel_token_cancel(token);
+    assert(cancel_token_is_cancelled(token));
+    PathResult* stopped = dijkstra_find_path_limited(graph, 0, unreachable, &cancelled);
+    assert(stopped->status == SEARCH_CANCELLED && !stopped->found);
+    path_result_destroy(stopped);
+
+    // Generous or absent limits give the normal answer
+    cancel_token_reset(token);
+    search_limits_set_budget(&cancelled, 60000.0);
+    PathResult* exact = dijkstra_find_path(graph, 0, far);
+    PathResult* bounded = dijkstra_find_path_limited(graph, 0, far, &cancelled);
+    PathResult* unlimited = bfs_find_path_limited(graph, 0, far, NULL);
+    assert(exact->status == SEARCH_COMPLETED && bounded->status == SEARCH_COMPLETED);
+    assert(bounded->found && bounded->total_weight == exact->total_weight);
+    assert(unlimited->found && unlimited->status == SEARCH_COMPLETED);
+    path_result_destroy(exact);
+    path_result_destroy(bounded);
+    path_result_destroy(unlimited);
+
+    // Cancel a long Bellman-Ford from another thread
+    search_limits_init(&cancelled);
+    cancelled.cancel = token;
+    pthread_t canceller;
+    pthread_create(&canceller, NULL, cancel_after_delay, token);
+    PathResult* slow = bellman_ford_find_path_limited(graph, far, 0, &cancelled);
+    pthread_join(canceller, NULL);
+    assert(slow->status == SEARCH_CANCELLED && !slow->found);
+    path_result_destroy(slow);
+    cancel_token_destroy(token);
+
+    // Reusable workspaces report the status of their last query
+    SearchWorkspace* workspace = search_workspace_create(graph->num_vertices);
+    double distance = 0.0;
+    assert(!search_workspace_find_path_limited(workspace, graph, 0, unreachable, WORKSPACE_DIJKSTRA,
+                                               &expired, &distance));
+    assert(workspace->status == SEARCH_TIMED_OUT);
+    assert(search_workspace_find_path_limited(workspace, graph, 0, far, WORKSPACE_BFS,
+                                              NULL, &distance));
+    assert(workspace->status == SEARCH_COMPLETED);
+    search_workspace_destroy(workspace);
+
+    graph_destroy(graph);
+    TEST_PASSED;
+    printf("Search deadlines and cancellation test passed\n");
+}
+
+// Test the SCC/GRAIL reachability index
+void test_reach_index(void) {
+    printf("Testing reachability index... ");
+
+    // Sparse random digraph: many small SCCs and many unreachable pairs
+    int n = 150;
+    Graph* graph = graph_create(n, true, true);
+    unsigned seed = 99;
+    for (int i = 0; i < 220; i++) {
+        seed = seed * 1103515245u + 12345u;
+        int u = (seed >> 8) % n;
+        seed = seed * 1103515245u + 12345u;
+        int v = (seed >> 8) % n;
+        if (u != v) graph_add_edge(graph, u, v, 1.0 + (seed >> 20) % 5);
+    }
+
+    // Ground truth before any index exists
+    bool* reachable = (bool*)malloc(n * n * sizeof(bool));
+    for (int s = 0; s < n; s++) {
+        for (int t = 0; t < n; t++) {
+            PathResult* result = bfs_find_path(graph, s, t);
+            reachable[s * n + t] = result->found;
+            path_result_destroy(result);
+        }
+    }
+
+    assert(reach_index_query(graph, 0, 1) == REACH_MAYBE);
+    assert(reach_index_num_components(graph) == -1);
+    assert(reach_index_attach(graph, 0));
+
+    int unreachable = 0;
+    int rejected = 0;
+    for (int s = 0; s < n; s++) {
+        for (int t = 0; t < n; t++) {
+            ReachAnswer answer = reach_index_query(graph, s, t);
+            bool truth = reachable[s * n + t];
+            if (answer == REACH_NO) assert(!truth);
+            if (answer == REACH_YES) assert(truth);
+            assert(reach_index_reachable(graph, s, t) == truth);
+            if (!truth) {
+                unreachable++;
+                if (answer == REACH_NO) rejected++;
+            }
+        }
+    }
+    assert(unreachable > 0 && rejected * 10 >= unreachable * 9);
+    assert(reach_index_num_components(graph) > 1);
+    assert(reach_index_memory_usage(graph) > 0);
+
+    // Searches return not-found without exploring when the index rules it out
+    int s = -1;
+    int t = -1;
+    for (int i = 0; i < n * n && s < 0; i++) {
+        if (reach_index_query(graph, i / n, i % n) == REACH_NO) {
+            s = i / n;
+            t = i % n;
+        }
+    }
+    assert(s >= 0);
+    PathResult* skipped = dijkstra_find_path(graph, s, t);
+    assert(!skipped->found && skipped->status == SEARCH_COMPLETED);
+    assert(skipped->stats.vertices_settled == 0);
+    path_result_destroy(skipped);
+
+    // Mutations rebuild the index lazily
+    graph_add_edge(graph, s, t, 1.0);
+    assert(reach_index_query(graph, s, t) != REACH_NO);
+    assert(reach_index_reachable(graph, s, t));
+    PathResult* direct = dijkstra_find_path(graph, s, t);
+    assert(direct->found && direct->total_weight <= 1.0);
+    path_result_destroy(direct);
+
+    // A cycle through every vertex collapses everything into one component
+    for (int v = 0; v < n; v++) {
+        graph_add_edge(graph, v, (v + 1) % n, 1.0);
+    }
+    assert(reach_index_num_components(graph) == 1);
+    assert(reach_index_query(graph, 5, 3) == REACH_YES);
+    assert(reach_index_component(graph, 7) == reach_index_component(graph, 70));
+
+    reach_index_detach(graph);
+    assert(reach_index_num_components(graph) == -1);
+    free(reachable);
+    graph_destroy(graph);
+
+    // Deep chain: the iterative Tarjan needs no recursion
+    Graph* chain = graph_create(200000, false, true);
+    for (int v = 0; v + 1 < 200000; v++) {
+        graph_add_edge(chain, v, v + 1, 1.0);
+    }
+    reach_index_attach(chain, 2);
+    assert(reach_index_num_components(chain) == 200000);
+    assert(reach_index_query(chain, 199999, 0) == REACH_NO);
+    assert(reach_index_reachable(chain, 0, 199999));
+    graph_destroy(chain);
+
+    TEST_PASSED;
+    printf("Reachability index test passed\n");
+}
+
+// Test union-find connected components
+void test_union_find(void) {
+    printf("Testing union-find connectivity... ");
+
+    UnionFind* uf = union_find_create(6);
+    assert(uf && uf->num_sets == 6);
+    assert(union_find_unite(uf, 0, 1));
+    assert(union_find_unite(uf, 2, 3));
+    assert(!union_find_unite(uf, 1, 0));
+    assert(union_find_unite(uf, 1, 3));
+    assert(uf->num_sets == 3);
+    assert(union_find_find(uf, 0) == union_find_find(uf, 2));
+    assert(union_find_root(uf, 3) == union_find_find(uf, 1));
+    assert(uf->size[union_find_find(uf, 2)] == 4);
+    assert(union_find_grow(uf, 8) && uf->num_sets == 5);
+    union_find_reset(uf);
+    assert(uf->num_sets == 8 && union_find_find(uf, 3) == 3);
+    union_find_destroy(uf);
+
+    // Two triangles and an isolated vertex
+    Graph* graph = graph_create(7, true, false);
+    graph_add_edge(graph, 0, 1, 1.0);
+    graph_add_edge(graph, 1, 2, 1.0);
+    graph_add_edge(graph, 2, 0, 1.0);
+    graph_add_edge(graph, 3, 4, 1.0);
+    graph_add_edge(graph, 4, 5, 1.0);
+    graph_add_edge(graph, 5, 3, 1.0);
+    assert(graph_num_components(graph) == 3);
+    assert(graph_component_size(graph, 4) == 3);
+    assert(graph_component_size(graph, 6) == 1);
+    assert(graph_same_component(graph, 0, 2));
+    assert(!graph_same_component(graph, 0, 3));
+    assert(graph_component_id(graph, 0) == graph_component_id(graph, 1));
+    assert(graph_component_size(graph, 7) == -1);
+
+    // Cross-component queries are rejected before any search work
+    PathResult* skipped = dijkstra_find_path(graph, 0, 4);
+    assert(!skipped->found && skipped->stats.vertices_settled == 0);
+    path_result_destroy(skipped);
+    skipped = bfs_find_path(graph, 6, 1);
+    assert(!skipped->found && skipped->stats.vertices_settled == 0);
+    path_result_destroy(skipped);
+
+    // Insertions merge components incrementally
+    graph_add_edge(graph, 2, 3, 1.0);
+    assert(graph_num_components(graph) == 2);
+    assert(graph_component_size(graph, 0) == 6);
+    PathResult* joined = dijkstra_find_path(graph, 0, 4);
+    assert(joined->found && joined->total_weight == 3.0);
+    path_result_destroy(joined);
+
+    assert(graph_add_vertex(graph));
+    assert(graph_num_components(graph) == 3);
+    assert(graph_component_size(graph, 7) == 1);
+
+    // A removal splits a component; the sets are rebuilt on the next query
+    graph_remove_edge(graph, 2, 3);
+    assert(graph_num_components(graph) == 4);
+    assert(!graph_same_component(graph, 1, 5));
+    graph_remove_edge(graph, 0, 1);
+    assert(graph_num_components(graph) == 4);
+    graph_remove_edge(graph, 0, 2);
+    assert(graph_num_components(graph) == 5);
+    assert(graph_component_size(graph, 1) == 2);
+    graph_destroy(graph);
+
+    // Bulk builds, coordinates and publication leave no rebuild for a query
+    EdgeInput edges[3] = {{0, 1, 1.0}, {1, 2, 1.0}, {3, 4, 1.0}};
+    graph = graph_build_from_edges(5, true, false, edges, 3, NULL);
+    assert(graph && graph_components_current(graph));
+    assert(graph_set_coordinates(graph, 2, 1.0, 2.0) && graph_components_current(graph));
+    graph_remove_edge(graph, 0, 1);
+    assert(!graph_components_current(graph));
+    GraphSnapshotManager* graphs = graph_snapshot_manager_create(graph, 1);
+    assert(graph_components_current(graph));
+    graph = graph_create(4, true, false);
+    graph_add_edge(graph, 0, 1, 1.0);
+    graph_remove_edge(graph, 0, 1);
+    assert(!graph_components_current(graph));
+    assert(graph_snapshot_publish(graphs, graph) == 2 && graph_components_current(graph));
+    assert(graph_num_components(graph) == 4);
+    graph_snapshot_manager_destroy(graphs);
+
+    // Directed graphs have no undirected components
+    Graph* directed = graph_create(3, false, true);
+    graph_add_edge(directed, 0, 1, 1.0);
+    assert(graph_num_components(directed) == -1);
+    assert(!graph_same_component(directed, 0, 1));
+    PathResult* one_way = bfs_find_path(directed, 0, 1);
+    assert(one_way->found);
+    path_result_destroy(one_way);
+    graph_destroy(directed);
+
+    TEST_PASSED;
+    printf("Union-find connectivity test passed\n");
+}
+
+// Two labelings describe the same partition of the vertices
+static bool same_partition(const int* a, const int* b, int n, int num_labels) {
+    int* a_to_b = (int*)malloc(num_labels * sizeof(int));
+    for (int c = 0; c < num_labels; c++) a_to_b[c] = -1;
+    bool same = true;
+    for (int v = 0; v < n && same; v++) {
+        if (a_to_b[a[v]] < 0) a_to_b[a[v]] = b[v];
+        same = a_to_b[a[v]] == b[v];
+    }
+    free(a_to_b);
+    return same;
+}
+
+static void count_pool_block(size_t begin, size_t end, int thread_id, void* context) {
+    (void)thread_id;
+    int* hits = (int*)context;
+    for (size_t i = begin; i < end; i++) hits[i]++;
+}
+
+// Test parallel connected and strongly connected components
+void test_parallel_components(void) {
+    printf("Testing parallel connected and strong components... ");
+
+    // Sparse random graphs large enough to split across workers
+    int n = 30000;
+    Graph* undirected = graph_create(n, false, false);
+    Graph* directed = graph_create(n, false, true);
+    unsigned seed = 2024;
+    for (int i = 0; i < 26000; i++) {
+        seed = seed * 1103515245u + 12345u;
+        int u = (seed >> 8) % n;
+        seed = seed * 1103515245u + 12345u;
+        int v = (seed >> 8) % n;
+        graph_add_edge(undirected, u, v, 1.0);
+        graph_add_edge(directed, u, v, 1.0);
+        graph_add_edge(directed, v, (v * 7 + 3) % n, 1.0);
+    }
+
+    int* expected = (int*)malloc(n * sizeof(int));
+    ComponentResult* cc = parallel_connected_components(undirected, 4);
+    assert(cc && cc->num_components == graph_num_components(undirected));
+    assert(cc->threads_used == 4);
+    for (int v = 0; v < n; v++) {
+        expected[v] = graph_component_id(undirected, v);
+        assert(cc->sizes[cc->labels[v]] == graph_component_size(undirected, v));
+    }
+    assert(same_partition(cc->labels, expected, n, cc->num_components));
+    int total = 0;
+    for (int c = 0; c < cc->num_components; c++) {
+        assert(cc->sizes[c] <= cc->sizes[cc->largest]);
+        total += cc->sizes[c];
+    }
+    assert(total == n);
+
+    // Thread count does not change the answer
+    ComponentResult* serial = parallel_connected_components(undirected, 1);
+    assert(serial->threads_used == 1 && serial->num_components == cc->num_components);
+    assert(same_partition(serial->labels, cc->labels, n, serial->num_components));
+    component_result_destroy(serial);
+
+    // Strong components match the sequential Tarjan in the reachability index
+    assert(reach_index_attach(directed, 1));
+    ComponentResult* scc = parallel_strong_components(directed, 4);
+    assert(scc && scc->num_components == reach_index_num_components(directed));
+    assert(scc->num_components > 1 && scc->sizes[scc->largest] > 1);
+    for (int v = 0; v < n; v++) {
+        expected[v] = reach_index_component(directed, v);
+    }
+    assert(same_partition(scc->labels, expected, n, scc->num_components));
+    component_result_destroy(scc);
+
+    // On an undirected graph strong components are the connected ones
+    scc = parallel_strong_components(undirected, 2);
+    assert(scc->num_components == cc->num_components);
+    assert(same_partition(scc->labels, cc->labels, n, scc->num_components));
+    component_result_destroy(scc);
+    component_result_destroy(cc);
+
+    // Weak components of a directed chain; strong components of a cycle
+    Graph* chain = graph_create(5, false, true);
+    for (int v = 0; v + 1 < 5; v++) graph_add_edge(chain, v + 1, v, 1.0);
+    ComponentResult* weak = parallel_connected_components(chain, 2);
+    assert(weak->num_components == 1 && weak->sizes[0] == 5);
+    ComponentResult* strong = parallel_strong_components(chain, 2);
+    assert(strong->num_components == 5);
+    component_result_destroy(strong);
+    graph_add_edge(chain, 0, 4, 1.0);
+    strong = parallel_strong_components(chain, 2);
+    assert(strong->num_components == 1);
+    component_result_destroy(strong);
+    component_result_destroy(weak);
+
+    assert(parallel_strong_components(NULL, 0) == NULL);
+
+    // A pool runs many short loops on the same threads, each index once per loop
+    ParallelPool* pool = parallel_pool_create(4);
+    int hits[10] = {0};
+    for (int round = 0; round < 1000; round++) {
+        assert(parallel_pool_for(pool, 10, count_pool_block, hits) >= 1);
+    }
+    for (int i = 0; i < 10; i++) assert(hits[i] == 1000);
+    assert(parallel_pool_for(pool, 0, count_pool_block, hits) == 0);
+    parallel_pool_destroy(pool);
+
+    graph_destroy(chain);
+    free(expected);
+    graph_destroy(undirected);
+    graph_destroy(directed);
+    TEST_PASSED;
+    printf("Parallel components test passed\n");
+}
+
+// Weight of a vertex sequence using the cheapest edge between consecutive
+// vertices, or -1 if some step is not an edge
+static double path_weight_in_graph(const Graph* graph, const int* path, int length) {
+    double total = 0.0;
+    for (int i = 0; i + 1 < length; i++) {
+        double best = -1.0;
+        for (Edge* edge = graph->adj_list[path[i]]; edge; edge = edge->next) {
+            if (edge->dest == path[i + 1] && (best < 0 || edge->weight < best)) best = edge->weight;
+        }
+        if (best < 0) return -1.0;
+        total += best;
+    }
+    return total;
+}
+
+// Read size bytes at pos of a file into old (if non-NULL), then overwrite
+// them with bytes (if non-NULL)
+static bool hub_file_patch(const char* path, size_t pos, const void* bytes, void* old, size_t size) {
+    FILE* file = fopen(path, "r+b");
+    if (!file) return false;
+    bool ok = fseek(file, (long)pos, SEEK_SET) == 0;
+    if (ok && old) ok = fread(old, 1, size, file) == size;
+    if (ok && bytes) ok = fseek(file, (long)pos, SEEK_SET) == 0 && fwrite(bytes, 1, size, file) == size;
+    return (fclose(file) == 0) && ok;
+}
+
+// Test the hub labelling distance oracle
+void test_hub_labels(void) {
+    printf("Testing hub labels... ");
+
+    // Random weighted graphs, one directed and one undirected
+    for (int directed = 0; directed <= 1; directed++) {
+        int n = 300;
+        Graph* graph = graph_create(n, true, directed);
+        unsigned seed = 77 + directed;
+        for (int i = 0; i < 900; i++) {
+            seed = seed * 1103515245u + 12345u;
+            int u = (seed >> 8) % n;
+            seed = seed * 1103515245u + 12345u;
+            int v = (seed >> 8) % n;
+            graph_add_edge(graph, u, v, 1.0 + (seed >> 16) % 20);
+        }
+
+        HubLabels* labels = hub_labels_build(graph, NULL);
+        assert(labels && hub_labels_num_vertices(labels) == n);
+        assert(hub_labels_average_size(labels) >= 1.0);
+        assert(hub_labels_memory_usage(labels) > 0);
+
+        char path[64];
+        snprintf(path, sizeof(path), "/tmp/graphpath_hubs_%ld.bin", (long)getpid());
+        assert(hub_labels_save(labels, path));
+        HubLabels* mapped = hub_labels_load(path);
+        assert(mapped && hub_labels_num_vertices(mapped) == n);
+
+        for (int s = 0; s < n; s += 7) {
+            for (int t = 0; t < n; t += 5) {
+                PathResult* exact = dijkstra_find_path(graph, s, t);
+                double distance = hub_labels_distance(labels, s, t);
+                assert(hub_labels_distance(mapped, s, t) == distance);
+                if (!exact->found) {
+                    assert(distance == DBL_MAX);
+                } else {
+                    assert(fabs(distance - exact->total_weight) < 1e-9);
+                    PathResult* unpacked = hub_labels_find_path(mapped, s, t);
+                    assert(unpacked->found && unpacked->path[0] == s &&
+                           unpacked->path[unpacked->path_length - 1] == t);
+                    assert(fabs(path_weight_in_graph(graph, unpacked->path, unpacked->path_length) -
+                                exact->total_weight) < 1e-9);
+                    path_result_destroy(unpacked);
+                }
+                path_result_destroy(exact);
+            }
+        }
+        hub_labels_destroy(mapped);
+
+        // Corrupt label offsets or a missing sentinel are rejected on load.
+        // Header, order and the forward offsets and hubs each start on a 64-byte line.
+        size_t offsets_pos = 64 + (n * sizeof(int32_t) + 63) / 64 * 64;
+        size_t hubs_pos = offsets_pos + ((n + 1) * sizeof(int64_t) + 63) / 64 * 64;
+        int64_t first_end;
+        assert(hub_file_patch(path, offsets_pos + sizeof(int64_t), NULL, &first_end, sizeof(first_end)));
+        int64_t beyond = INT64_MAX / 2;
+        assert(hub_file_patch(path, offsets_pos + sizeof(int64_t), &beyond, NULL, sizeof(beyond)));
+        assert(hub_labels_load(path) == NULL);
+        assert(hub_file_patch(path, offsets_pos + sizeof(int64_t), &first_end, NULL, sizeof(first_end)));
+        int32_t hub = 0;
+        assert(hub_file_patch(path, hubs_pos + (first_end - 1) * sizeof(int32_t), &hub, NULL, sizeof(hub)));
+        assert(hub_labels_load(path) == NULL);
+        remove(path);
+
+        // A caller-supplied order gives the same distances
+        int* order = (int*)malloc(n * sizeof(int));
+        for (int i = 0; i < n; i++) order[i] = n - 1 - i;
+        HubLabels* reordered = hub_labels_build(graph, order);
+        for (int s = 0; s < n; s += 11) {
+            for (int t = 0; t < n; t += 3) {
+                assert(hub_labels_distance(reordered, s, t) == hub_labels_distance(labels, s, t));
+            }
+        }
+        hub_labels_destroy(reordered);
+        order[0] = order[1];
+        assert(hub_labels_build(graph, order) == NULL);
+        free(order);
+
+        hub_labels_destroy(labels);
+        graph_destroy(graph);
+    }
+
+    // Unreachable pairs, invalid queries and negative weights
+    Graph* small = graph_create(3, true, true);
+    graph_add_edge(small, 0, 1, 2.0);
+    HubLabels* labels = hub_labels_build(small, NULL);
+    assert(hub_labels_distance(labels, 0, 1) == 2.0);
+    assert(hub_labels_distance(labels, 1, 0) == DBL_MAX);
+    assert(hub_labels_distance(labels, 0, 3) == DBL_MAX);
+    PathResult* none = hub_labels_find_path(labels, 0, 2);
+    assert(!none->found);
+    path_result_destroy(none);
+    hub_labels_destroy(labels);
+    graph_add_edge(small, 1, 2, -1.0);
+    assert(hub_labels_build(small, NULL) == NULL);
+    graph_destroy(small);
+    assert(hub_labels_load("/nonexistent/hubs.bin") == NULL);
+
+    TEST_PASSED;
+    printf("Hub labels test passed\n");
+}
+
+// Test customizable contraction hierarchies
+void test_cch(void) {
+    printf("Testing customizable contraction hierarchies... ");
+
+    // Weight edits keep the topology; undirected edges change both ways
+    Graph* small = graph_create(3, true, false);
+    graph_add_edge(small, 0, 1, 4.0);
+    unsigned long long version = small->version;
+    assert(graph_set_edge_weight(small, 1, 0, 2.5));
+    assert(small->version != version);
+    assert(small->adj_list[0]->weight == 2.5 && small->adj_list[1]->weight == 2.5);
+    assert(!graph_set_edge_weight(small, 1, 2, 1.0));
+    assert(graph_num_components(small) == 2);
+    graph_destroy(small);
+
+    Graph* road = graph_generate_road(40, 40, 5);
+    Graph* directed = graph_create(500, true, true);
+    unsigned seed = 31;
+    for (int i = 0; i < 2000; i++) {
+        seed = seed * 1103515245u + 12345u;
+        int u = (seed >> 8) % 500;
+        seed = seed * 1103515245u + 12345u;
+        int v = (seed >> 8) % 500;
+        graph_add_edge(directed, u, v, 1.0 + (seed >> 16) % 50);
+    }
+
+    Graph* graphs[2] = {road, directed};
+    for (int g = 0; g < 2; g++) {
+        Graph* graph = graphs[g];
+        int n = graph->num_vertices;
+        CchIndex* cch = cch_create(graph);
+        assert(cch && cch_num_arcs(cch) >= graph->num_edges / 2);
+        assert(cch_num_levels(cch) > 1 && cch_memory_usage(cch) > 0);
+        assert(cch_distance(cch, 0, 1) == DBL_MAX);  // Not customized yet
+        assert(cch_customize(cch, graph, NULL, 4));
+
+        for (int round = 0; round < 2; round++) {
+            for (int s = 0; s < n; s += n / 23) {
+                for (int t = n - 1; t >= 0; t -= n / 17) {
+                    PathResult* exact = dijkstra_find_path(graph, s, t);
+                    PathResult* fast = cch_find_path(cch, s, t);
+                    assert(fast->found == exact->found);
+                    if (exact->found) {
+                        assert(fabs(fast->total_weight - exact->total_weight) < 1e-6);
+                        assert(fast->path[0] == s && fast->path[fast->path_length - 1] == t);
+                        assert(fabs(path_weight_in_graph(graph, fast->path, fast->path_length) -
+                                    exact->total_weight) < 1e-6);
+                        assert(cch_distance(cch, s, t) == fast->total_weight);
+                    }
+                    path_result_destroy(fast);
+                    path_result_destroy(exact);
+                }
+            }
+
+            // Traffic update: change a third of the weights, then re-customize
+            for (int u = 0; u < n; u += 3) {
+                Edge* edge = graph->adj_list[u];
+                if (edge) graph_set_edge_weight(graph, u, edge->dest, edge->weight * 3.0 + 1.0);
+            }
+            assert(cch_customize(cch, graph, NULL, 2));
+        }
+
+        // External weights in adjacency order: all ones gives hop counts
+        int arcs = 0;
+        for (int u = 0; u < n; u++) {
+            for (Edge* edge = graph->adj_list[u]; edge; edge = edge->next) arcs++;
+        }
+        double* ones = (double*)malloc(arcs * sizeof(double));
+        for (int i = 0; i < arcs; i++) ones[i] = 1.0;
+        assert(cch_customize(cch, graph, ones, 0));
+        PathResult* hops = bfs_find_path(graph, 0, n - 1);
+        if (hops->found) assert(cch_distance(cch, 0, n - 1) == hops->path_length - 1);
+        path_result_destroy(hops);
+        ones[0] = -1.0;
+        assert(!cch_customize(cch, graph, ones, 1));
+        free(ones);
+        cch_destroy(cch);
+    }
+
+    // A different topology is rejected
+    CchIndex* cch = cch_create(directed);
+    graph_add_edge(directed, 0, 499, 1.0);
+    assert(!cch_customize(cch, directed, NULL, 1));
+    assert(cch_rank(cch, 0) >= 0 && cch_rank(cch, 500) == -1);
+    cch_destroy(cch);
+
+    graph_destroy(road);
+    graph_destroy(directed);
+    TEST_PASSED;
+    printf("Customizable contraction hierarchies test passed\n");
+}
+
+// Test multilevel overlay routing
+void test_crp(void) {
+    printf("Testing multilevel overlay routing... ");
+    Graph* road = graph_generate_road(40, 40, 9);
+    Graph* directed = graph_create(600, true, true);
+    unsigned seed = 77;
+    for (int i = 0; i < 2400; i++) {
+        seed = seed * 1103515245u + 12345u;
+        int u = (seed >> 8) % 600;
+        seed = seed * 1103515245u + 12345u;
+        int v = (seed >> 8) % 600;
+        graph_add_edge(directed, u, v, 1.0 + (seed >> 16) % 50);
+    }
+
+    // Partition: nested cells within their size bounds
+    int sizes[3] = {32, 128, 512};
+    int bad_sizes[2] = {64, 64};
+    assert(!partition_create(road, bad_sizes, 2));
+    Partition* partition = partition_create(road, sizes, 3);
+    assert(partition && partition->num_cells[0] > partition->num_cells[1]);
+    assert(partition->num_cells[1] > partition->num_cells[2] && partition->num_cells[2] >= 4);
+    for (int l = 0; l < 3; l++) {
+        int* counts = (int*)calloc(partition->num_cells[l], sizeof(int));
+        for (int v = 0; v < road->num_vertices; v++) counts[partition_cell(partition, l, v)]++;
+        for (int c = 0; c < partition->num_cells[l]; c++) assert(counts[c] > 0 && counts[c] <= sizes[l]);
+        free(counts);
+    }
+    for (int u = 0; u < road->num_vertices; u++) {
+        for (int v = u + 1; v < road->num_vertices; v += 37) {
+            if (partition_cell(partition, 0, u) == partition_cell(partition, 0, v)) {
+                assert(partition_cell(partition, 2, u) == partition_cell(partition, 2, v));
+            }
+        }
+    }
+    assert(partition_cut_arcs(partition, road, 0) >= partition_cut_arcs(partition, road, 2));
+    assert(partition_cut_arcs(partition, road, 2) > 0);
+    assert(partition_cell(partition, 3, 0) == -1);
+    partition_destroy(partition);
+
+    Graph* graphs[2] = {road, directed};
+    for (int g = 0; g < 2; g++) {
+        Graph* graph = graphs[g];
+        int n = graph->num_vertices;
+        CrpEngine* crp = crp_create(graph, sizes, 3);
+        assert(crp && crp_memory_usage(crp) > 0);
+        assert(crp_num_boundary_vertices(crp, 0) >= crp_num_boundary_vertices(crp, 2));
+        PathResult* early = crp_find_path(crp, graph, 0, 1);
+        assert(!early->found);  // Not customized yet
+        path_result_destroy(early);
+        int cells = crp_partition(crp)->num_cells[0] + crp_partition(crp)->num_cells[1] +
+                    crp_partition(crp)->num_cells[2];
+        assert(crp_customize(crp, graph, 4) == cells);
+        assert(crp_customize(crp, graph, 4) == 0);
+
+        // The second round reuses one workspace, grown on first use
+        SearchWorkspace* workspace = search_workspace_create(0);
+        for (int round = 0; round < 2; round++) {
+            for (int s = 0; s < n; s += n / 19) {
+                for (int t = n - 1; t >= 0; t -= n / 13) {
+                    PathResult* exact = dijkstra_find_path(graph, s, t);
+                    PathResult* fast = round ? crp_find_path_with_workspace(crp, graph, workspace, s, t)
+                                             : crp_find_path(crp, graph, s, t);
+                    assert(fast->status == SEARCH_COMPLETED && fast->found == exact->found);
+                    if (exact->found) {
+                        assert(fabs(fast->total_weight - exact->total_weight) < 1e-6);
+                        assert(fast->path[0] == s && fast->path[fast->path_length - 1] == t);
+                        assert(fabs(path_weight_in_graph(graph, fast->path, fast->path_length) -
+                                    exact->total_weight) < 1e-6);
+                    }
+                    path_result_destroy(fast);
+                    path_result_destroy(exact);
+                }
+            }
+
+            // One changed arc re-customizes at most one cell per level
+            Edge* edge = graph->adj_list[n / 2];
+            if (!edge) edge = graph->adj_list[0];
+            int src = edge == graph->adj_list[0] ? 0 : n / 2;
+            graph_set_edge_weight(graph, src, edge->dest, edge->weight * 4.0 + 3.0);
+            int recomputed = crp_customize(crp, graph, 2);
+            assert(recomputed >= 0 && recomputed <= 3);
+        }
+        search_workspace_destroy(workspace);
+
+        // A negative weight is rejected
+        Edge* edge = graph->adj_list[0] ? graph->adj_list[0] : graph->adj_list[1];
+        double weight = edge->weight;
+        edge->weight = -1.0;
+        assert(crp_customize(crp, graph, 1) == -1);
+        edge->weight = weight;
+        crp_destroy(crp);
+    }
+
+    // A different topology is rejected
+    CrpEngine* crp = crp_create(directed, sizes, 3);
+    graph_add_edge(directed, 0, 599, 1.0);
+    assert(crp_customize(crp, directed, 1) == -1);
+    crp_destroy(crp);
+
+    graph_destroy(road);
+    graph_destroy(directed);
+    TEST_PASSED;
+    printf("Multilevel overlay routing test passed\n");
+}
+
+// Test arc flags
+void test_arc_flags(void) {
+    printf("Testing arc flags... ");
+    Graph* road = graph_generate_road(40, 40, 13);
+    Graph* directed = graph_create(500, true, true);
+    unsigned seed = 101;
+    for (int i = 0; i < 2000; i++) {
+        seed = seed * 1103515245u + 12345u;
+        int u = (seed >> 8) % 500;
+        seed = seed * 1103515245u + 12345u;
+        int v = (seed >> 8) % 500;
+        graph_add_edge(directed, u, v, 1.0 + (seed >> 16) % 50);
+    }
+    assert(!arc_flags_build(road, 0, 1));
+
+    Graph* graphs[2] = {road, directed};
+    for (int g = 0; g < 2; g++) {
+        Graph* graph = graphs[g];
+        int n = graph->num_vertices;
+        ArcFlags* flags = arc_flags_build(graph, 16, 4);
+        assert(flags && arc_flags_num_regions(flags) == 16);
+        assert(arc_flags_region(flags, 0) >= 0 && arc_flags_region(flags, n) == -1);
+        assert(arc_flags_density(flags) > 0.0 && arc_flags_density(flags) < 1.0);
+        assert(arc_flags_memory_usage(flags) > 0);
+
+        // Odd targets reuse one workspace
+        SearchWorkspace* workspace = search_workspace_create(0);
+        long long pruned = 0;
+        long long plain = 0;
+        for (int s = 0; s < n; s += n / 19) {
+            for (int t = n - 1; t >= 0; t -= n / 13) {
+                PathResult* exact = dijkstra_find_path(graph, s, t);
+                PathResult* fast = (t % 2) ? arc_flags_find_path_with_workspace(flags, graph, workspace, s, t)
+                                           : arc_flags_find_path(flags, graph, s, t);
+                assert(fast->status == SEARCH_COMPLETED && fast->found == exact->found);
+                if (exact->found) {
+                    assert(fabs(fast->total_weight - exact->total_weight) < 1e-6);
+                    assert(fast->path[0] == s && fast->path[fast->path_length - 1] == t);
+                    assert(fabs(path_weight_in_graph(graph, fast->path, fast->path_length) -
+                                exact->total_weight) < 1e-6);
+                    pruned += fast->stats.vertices_settled;
+                    plain += exact->stats.vertices_settled;
+                }
+                path_result_destroy(fast);
+                path_result_destroy(exact);
+            }
+        }
+        if (g == 0) assert(pruned < plain);
+        search_workspace_destroy(workspace);
+        arc_flags_destroy(flags);
+    }
+
+    // Round trip through a file, then a changed weight makes the flags stale
+    // and the file no longer match
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/graphpath_arcflags_%ld.bin", (long)getpid());
+    ArcFlags* flags = arc_flags_build(road, 8, 0);
+    assert(arc_flags_save(flags, path));
+    ArcFlags* loaded = arc_flags_load(path, road);
+    assert(loaded && arc_flags_num_regions(loaded) == arc_flags_num_regions(flags));
+    assert(arc_flags_density(loaded) == arc_flags_density(flags));
+    PathResult* a = arc_flags_find_path(flags, road, 0, road->num_vertices - 1);
+    PathResult* b = arc_flags_find_path(loaded, road, 0, road->num_vertices - 1);
+    assert(a->found && b->found && a->total_weight == b->total_weight);
+    path_result_destroy(a);
+    path_result_destroy(b);
+    assert(!arc_flags_load(path, directed));
+
+    Edge* edge = road->adj_list[0];
+    graph_set_edge_weight(road, 0, edge->dest, edge->weight + 1.0);
+    PathResult* stale = arc_flags_find_path(flags, road, 0, 1);
+    assert(!stale->found);
+    path_result_destroy(stale);
+    assert(!arc_flags_load(path, road));
+    remove(path);
+    arc_flags_destroy(loaded);
+    arc_flags_destroy(flags);
+
+    graph_destroy(road);
+    graph_destroy(directed);
+    TEST_PASSED;
+    printf("Arc flags test passed\n");
+}
+
+// Every reachable vertex's distance is its parent's plus the cheapest arc, and
+// matches a tree built from scratch
+static void check_dynamic_tree(const DynamicSssp* tree, const Graph* graph) {
+    DynamicSssp* fresh = dynamic_sssp_create(graph, tree->source);
+    assert(fresh);
+    for (int v = 0; v < graph->num_vertices; v++) {
+        double d = dynamic_sssp_distance(tree, v);
+        double expected = dynamic_sssp_distance(fresh, v);
+        assert(d == expected || fabs(d - expected) < 1e-9);
+        int p = tree->parent[v];
+        if (v == tree->source || d == DBL_MAX) {
+            assert(p == -1);
+        } else {
+            int step[2] = {p, v};
+            assert(p >= 0 && fabs(dynamic_sssp_distance(tree, p) + path_weight_in_graph(graph, step, 2) - d) < 1e-9);
+        }
+    }
+    dynamic_sssp_destroy(fresh);
+}
+
+// Test the dynamic shortest path tree
+void test_dynamic_sssp(void) {
+    printf("Testing dynamic shortest path tree... ");
+    assert(!dynamic_sssp_create(NULL, 0));
+
+    Graph* road = graph_generate_road(30, 30, 17);
+    Graph* directed = graph_create(400, true, true);
+    unsigned seed = 5;
+    for (int i = 0; i < 1600; i++) {
+        seed = seed * 1103515245u + 12345u;
+        int u = (seed >> 8) % 400;
+        seed = seed * 1103515245u + 12345u;
+        int v = (seed >> 8) % 400;
+        graph_add_edge(directed, u, v, 1.0 + (seed >> 16) % 20);
+    }
+
+    Graph* graphs[2] = {road, directed};
+    for (int g = 0; g < 2; g++) {
+        Graph* graph = graphs[g];
+        DynamicSssp* tree = dynamic_sssp_create(graph, 7);
+        assert(tree && dynamic_sssp_distance(tree, 7) == 0.0);
+        long long affected = 0;
+        int updates = 0;
+
+        for (int step = 0; step < 300; step++) {
+            seed = seed * 1103515245u + 12345u;
+            int n = graph->num_vertices;
+            int u = (seed >> 8) % n;
+            int kind = (seed >> 20) % 4;
+            Edge* edge = graph->adj_list[u];
+            int v;
+            if (kind == 0 && edge) {
+                // Weight increase (often on the tree)
+                v = edge->dest;
+                graph_set_edge_weight(graph, u, v, edge->weight * 2.0 + 1.0);
+            } else if (kind == 1 && edge) {
+                v = edge->dest;
+                graph_set_edge_weight(graph, u, v, edge->weight * 0.5);
+            } else if (kind == 2 && edge) {
+                v = edge->dest;
+                graph_remove_edge(graph, u, v);
+            } else {
+                seed = seed * 1103515245u + 12345u;
+                v = (seed >> 8) % n;
+                graph_add_edge(graph, u, v, 1.0 + (seed >> 16) % 10);
+            }
+            assert(dynamic_sssp_update_edge(tree, graph, u, v));
+            affected += tree->last_affected;
+            updates++;
+            if (step % 25 == 0) check_dynamic_tree(tree, graph);
+        }
+        check_dynamic_tree(tree, graph);
+        assert(affected < (long long)updates * graph->num_vertices / 10);
+
+        // A new vertex joins through an edge
+        assert(graph_add_vertex(graph));
+        int fresh = graph->num_vertices - 1;
+        assert(dynamic_sssp_update_edge(tree, graph, fresh, 0));  // No arc yet: nothing to do
+        graph_add_edge(graph, 7, fresh, 3.0);
+        assert(dynamic_sssp_update_edge(tree, graph, 7, fresh));
+        assert(dynamic_sssp_distance(tree, fresh) == 3.0 && tree->parent[fresh] == 7);
+        check_dynamic_tree(tree, graph);
+
+        // Paths agree with Dijkstra; an unreported change triggers a recompute
+        PathResult* path = dynamic_sssp_find_path(tree, graph, fresh);
+        assert(path->found && path->path_length == 2 && path->total_weight == 3.0);
+        path_result_destroy(path);
+        graph_set_edge_weight(graph, 7, fresh, 8.0);
+        path = dynamic_sssp_find_path(tree, graph, fresh);
+        PathResult* exact = dijkstra_find_path(graph, 7, fresh);
+        assert(path->found && fabs(path->total_weight - exact->total_weight) < 1e-9);
+        path_result_destroy(exact);
+        path_result_destroy(path);
+        assert(!dynamic_sssp_update_edge(tree, graph, 0, graph->num_vertices));
+        dynamic_sssp_destroy(tree);
+    }
+
+    // A change the tree missed is noticed by the next reported one
+    Graph* small = graph_create(4, true, true);
+    graph_add_edge(small, 0, 1, 1.0);
+    graph_add_edge(small, 1, 2, 1.0);
+    graph_add_edge(small, 0, 2, 10.0);
+    DynamicSssp* tree = dynamic_sssp_create(small, 0);
+    assert(tree && dynamic_sssp_distance(tree, 2) == 2.0);
+    graph_set_edge_weight(small, 1, 2, 50.0);
+    graph_add_edge(small, 0, 3, 1.0);
+    assert(dynamic_sssp_update_edge(tree, small, 0, 3));
+    PathResult* path = dynamic_sssp_find_path(tree, small, 2);
+    assert(path->found && path->total_weight == 10.0);
+    path_result_destroy(path);
+    check_dynamic_tree(tree, small);
+    dynamic_sssp_destroy(tree);
+    graph_destroy(small);
+
+    graph_destroy(road);
+    graph_destroy(directed);
+    TEST_PASSED;
+    printf("Dynamic shortest path tree test passed\n");
+}
+
 int main(void) {
     printf("\n╔═════════════════════════════════════════════════════════════╗\n");
     printf("║                  GraphPath Test Suite                       ║\n");
@@ -579,6 +3222,84 @@ int main(void) {
     test_bellman_ford_basic();
     test_bellman_ford_negative_weights();
 
+    printf("\n--- Compressed Graphs ---\n");
+    test_compressed_graph();
+
+    printf("\n--- Reduced-Precision Weights ---\n");
+    test_float_weights();
+
+    printf("\n--- Bulk Construction ---\n");
+    test_bulk_build();
+
+    printf("\n--- File Parsing ---\n");
+    test_graph_parser();
+
+    printf("\n--- Graph Format Loader Tests ---\n");
+    test_graph_formats();
+
+    printf("\n--- Search Statistics Tests ---\n");
+    test_search_stats();
+
+    printf("\n--- Graph Generator Tests ---\n");
+    test_graph_generators();
+
+    printf("\n--- Query Server Tests ---\n");
+    test_search_workspace();
+    test_query_server();
+    test_query_server_backpressure();
+
+    printf("\n--- Graph Snapshot Tests ---\n");
+    test_graph_snapshot();
+    test_query_server_reload();
+
+    printf("\n--- Path Cache Tests ---\n");
+    test_path_cache();
+
+    printf("\n--- Shortest-Path Tree Cache Tests ---\n");
+    test_spt_cache();
+
+    printf("\n--- Distance Table Tests ---\n");
+    test_distance_table();
+
+    printf("\n--- Jump Point Search Tests ---\n");
+    test_jump_point_search();
+
+    printf("\n--- Implicit Grid Graph Tests ---\n");
+    test_grid_graph();
+
+    printf("\n--- Implicit Search Tests ---\n");
+    test_implicit_search();
+
+    printf("\n--- Bounded-Suboptimal A* Tests ---\n");
+    test_bounded_suboptimal_astar();
+
+    printf("\n--- Search Limit Tests ---\n");
+    test_search_limits();
+
+    printf("\n--- Reachability Index Tests ---\n");
+    test_reach_index();
+
+    printf("\n--- Union-Find Connectivity Tests ---\n");
+    test_union_find();
+
+    printf("\n--- Parallel Component Tests ---\n");
+    test_parallel_components();
+
+    printf("\n--- Hub Label Tests ---\n");
+    test_hub_labels();
+
+    printf("\n--- CCH Tests ---\n");
+    test_cch();
+
+    printf("\n--- CRP Tests ---\n");
+    test_crp();
+
+    printf("\n--- Arc Flags Tests ---\n");
+    test_arc_flags();
+
+    printf("\n--- Dynamic SSSP Tests ---\n");
+    test_dynamic_sssp();
+
     printf("\n--- Performance Tests ---\n");
     test_large_graph();
 